@@ -0,0 +1,755 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <tune_quda.h>
+#include <blas_quda.h>
+#include <kernels/blas_core.cuh>
+#include <kernels/reduce_core.cuh>
+
+/**
+   Expression-template layer over the generic blas and reduction
+   kernels.  A sequence of statements over up to five fields, e.g.,
+
+     using namespace blas::expr;
+     double r2 = eval({&x, &y, &z}, _2 = a * _0 + b * _1, norm2(_2));
+
+   is compiled into a single streaming kernel: each element of the
+   fields is loaded once, the statements are evaluated in order in
+   registers, any reductions are accumulated alongside, and only the
+   fields that are assigned to are stored.  The placeholders _0 .. _4
+   refer to the fields in the order they are passed, a field is only
+   loaded if it is referenced before it is first assigned to, and the
+   same code path is used for both device and host fields.
+
+   The reductions available are norm2(e), reDotProduct(a, b) and
+   cDotProduct(a, b) (which conjugates its first argument).  Their
+   results are packed in statement order into a double, double2,
+   double3 or double4 (a complex dot product occupies two consecutive
+   components), with at most four reduction components per program.
+
+   Since the kernels are instantiated at the call site, this header
+   may only be included from CUDA translation units.  All fields must
+   share the same precision.  The fused CG and BiCGstab updates in
+   blas_quda.cu and reduce_quda.cu are expressed as programs, falling
+   back to their hand-written functors for mixed-precision fields.
+*/
+
+namespace quda
+{
+
+  namespace blas
+  {
+
+    qudaStream_t *getStream();
+
+    namespace expr
+    {
+
+      template <typename T, typename real> struct rebind {
+        using type = real;
+      };
+      template <typename T, typename real> struct rebind<complex<T>, real> {
+        using type = complex<real>;
+      };
+
+      template <typename real> real convert(double a) { return a; }
+      template <typename real> complex<real> convert(const complex<double> &a)
+      {
+        return complex<real>(a.real(), a.imag());
+      }
+
+      template <int k> struct slot;
+      template <> struct slot<0> {
+        template <typename T> __device__ __host__ static T &get(T &x, T &, T &, T &, T &) { return x; }
+      };
+      template <> struct slot<1> {
+        template <typename T> __device__ __host__ static T &get(T &, T &y, T &, T &, T &) { return y; }
+      };
+      template <> struct slot<2> {
+        template <typename T> __device__ __host__ static T &get(T &, T &, T &z, T &, T &) { return z; }
+      };
+      template <> struct slot<3> {
+        template <typename T> __device__ __host__ static T &get(T &, T &, T &, T &w, T &) { return w; }
+      };
+      template <> struct slot<4> {
+        template <typename T> __device__ __host__ static T &get(T &, T &, T &, T &, T &v) { return v; }
+      };
+
+      template <int k, typename E> struct Assign;
+
+      /**
+         @brief Placeholder for the k-th field of a program.  Flops
+         are counted per real number of the fields.
+      */
+      template <int k> struct Slot {
+        static_assert(k >= 0 && k < 5, "at most five fields are supported");
+        static constexpr unsigned int mask = 1u << k;
+        static constexpr bool is_real = false;
+        static constexpr int flops = 0;
+        static std::string str() { return "_" + std::to_string(k); }
+
+        template <typename real> using cast_t = Slot<k>;
+        template <typename real> cast_t<real> cast() const { return *this; }
+
+        template <typename T> __device__ __host__ auto operator()(int i, T &x, T &y, T &z, T &w, T &v) const
+        {
+          return slot<k>::get(x, y, z, w, v)[i];
+        }
+
+        template <typename E> Assign<k, E> operator=(const E &e) const { return {e}; }
+      };
+
+      constexpr Slot<0> _0 {};
+      constexpr Slot<1> _1 {};
+      constexpr Slot<2> _2 {};
+      constexpr Slot<3> _3 {};
+      constexpr Slot<4> _4 {};
+
+      /**
+         @brief Real or complex coefficient, held in double precision
+         on the host and converted to the kernel precision at launch
+      */
+      template <typename T> struct Scalar {
+        static constexpr unsigned int mask = 0;
+        static constexpr bool is_real = std::is_arithmetic<T>::value;
+        static constexpr int flops = 0;
+        static std::string str() { return is_real ? "a" : "c"; }
+        T a;
+
+        template <typename real> using cast_t = Scalar<typename rebind<T, real>::type>;
+        template <typename real> cast_t<real> cast() const { return {convert<real>(a)}; }
+
+        template <typename V> __device__ __host__ T operator()(int, V &, V &, V &, V &, V &) const { return a; }
+      };
+
+#define QUDA_EXPR_BINARY(Name, op, op_str, op_flops)                                                                   \
+  template <typename L, typename R> struct Name {                                                                      \
+    static constexpr unsigned int mask = L::mask | R::mask;                                                            \
+    static constexpr bool is_real = L::is_real && R::is_real;                                                          \
+    static constexpr int flops = L::flops + R::flops + (op_flops);                                                     \
+    static std::string str() { return "(" + L::str() + op_str + R::str() + ")"; }                                      \
+    L l;                                                                                                               \
+    R r;                                                                                                               \
+                                                                                                                       \
+    template <typename real>                                                                                           \
+    using cast_t = Name<typename L::template cast_t<real>, typename R::template cast_t<real>>;                         \
+    template <typename real> cast_t<real> cast() const { return {l.template cast<real>(), r.template cast<real>()}; }  \
+                                                                                                                       \
+    template <typename T> __device__ __host__ auto operator()(int i, T &x, T &y, T &z, T &w, T &v) const               \
+    {                                                                                                                  \
+      return l(i, x, y, z, w, v) op r(i, x, y, z, w, v);                                                               \
+    }                                                                                                                  \
+  };
+
+      QUDA_EXPR_BINARY(Add, +, "+", 1)
+      QUDA_EXPR_BINARY(Sub, -, "-", 1)
+      QUDA_EXPR_BINARY(Mul, *, "*", (L::is_real || R::is_real) ? 1 : 3)
+
+#undef QUDA_EXPR_BINARY
+
+      template <typename E> struct Conj {
+        static constexpr unsigned int mask = E::mask;
+        static constexpr bool is_real = E::is_real;
+        static constexpr int flops = E::flops;
+        static std::string str() { return "conj(" + E::str() + ")"; }
+        E e;
+
+        template <typename real> using cast_t = Conj<typename E::template cast_t<real>>;
+        template <typename real> cast_t<real> cast() const { return {e.template cast<real>()}; }
+
+        template <typename T> __device__ __host__ auto operator()(int i, T &x, T &y, T &z, T &w, T &v) const
+        {
+          return conj(e(i, x, y, z, w, v));
+        }
+      };
+
+      template <typename T> struct is_node : std::false_type {
+      };
+      template <int k> struct is_node<Slot<k>> : std::true_type {
+      };
+      template <typename T> struct is_node<Scalar<T>> : std::true_type {
+      };
+      template <typename L, typename R> struct is_node<Add<L, R>> : std::true_type {
+      };
+      template <typename L, typename R> struct is_node<Sub<L, R>> : std::true_type {
+      };
+      template <typename L, typename R> struct is_node<Mul<L, R>> : std::true_type {
+      };
+      template <typename E> struct is_node<Conj<E>> : std::true_type {
+      };
+
+      template <typename E> typename std::enable_if<is_node<E>::value, E>::type wrap(const E &e) { return e; }
+      inline Scalar<double> wrap(double a) { return {a}; }
+      inline Scalar<complex<double>> wrap(const Complex &a) { return {complex<double>(a.real(), a.imag())}; }
+
+      template <typename L, typename R>
+      using enable_binary_t = typename std::enable_if<is_node<L>::value || is_node<R>::value>::type;
+
+      template <typename L, typename R, typename = enable_binary_t<L, R>> auto operator+(const L &l, const R &r)
+      {
+        return Add<decltype(wrap(l)), decltype(wrap(r))> {wrap(l), wrap(r)};
+      }
+
+      template <typename L, typename R, typename = enable_binary_t<L, R>> auto operator-(const L &l, const R &r)
+      {
+        return Sub<decltype(wrap(l)), decltype(wrap(r))> {wrap(l), wrap(r)};
+      }
+
+      template <typename L, typename R, typename = enable_binary_t<L, R>> auto operator*(const L &l, const R &r)
+      {
+        return Mul<decltype(wrap(l)), decltype(wrap(r))> {wrap(l), wrap(r)};
+      }
+
+      template <typename E, typename = typename std::enable_if<is_node<E>::value>::type> Conj<E> conj(const E &e)
+      {
+        return {e};
+      }
+
+      /**
+         @brief Statement assigning an expression to the k-th field
+      */
+      template <int k, typename E> struct Assign {
+        static constexpr unsigned int reads = E::mask;
+        static constexpr unsigned int writes = 1u << k;
+        static constexpr int n_reduce = 0;
+        static constexpr int flops = E::flops;
+        static std::string str() { return Slot<k>::str() + "=" + E::str(); }
+        E e;
+
+        template <typename real> using cast_t = Assign<k, typename E::template cast_t<real>>;
+        template <typename real> cast_t<real> cast() const { return {e.template cast<real>()}; }
+
+        template <typename sum_t, typename T>
+        __device__ __host__ void operator()(sum_t *, int i, T &x, T &y, T &z, T &w, T &v) const
+        {
+          slot<k>::get(x, y, z, w, v)[i] = e(i, x, y, z, w, v);
+        }
+      };
+
+      /**
+         @brief Statement accumulating the squared norm of an expression
+      */
+      template <typename E> struct Norm2 {
+        static constexpr unsigned int reads = E::mask;
+        static constexpr unsigned int writes = 0;
+        static constexpr int n_reduce = 1;
+        static constexpr int flops = E::flops + 2;
+        static std::string str() { return "norm2(" + E::str() + ")"; }
+        E e;
+
+        template <typename real> using cast_t = Norm2<typename E::template cast_t<real>>;
+        template <typename real> cast_t<real> cast() const { return {e.template cast<real>()}; }
+
+        template <typename sum_t, typename T>
+        __device__ __host__ void operator()(sum_t *sum, int i, T &x, T &y, T &z, T &w, T &v) const
+        {
+          auto a = e(i, x, y, z, w, v);
+          sum[0] += static_cast<sum_t>(a.real()) * static_cast<sum_t>(a.real());
+          sum[0] += static_cast<sum_t>(a.imag()) * static_cast<sum_t>(a.imag());
+        }
+      };
+
+      /**
+         @brief Statement accumulating the real part of the dot product of two expressions
+      */
+      template <typename L, typename R> struct ReDot {
+        static constexpr unsigned int reads = L::mask | R::mask;
+        static constexpr unsigned int writes = 0;
+        static constexpr int n_reduce = 1;
+        static constexpr int flops = L::flops + R::flops + 2;
+        static std::string str() { return "reDot(" + L::str() + "," + R::str() + ")"; }
+        L l;
+        R r;
+
+        template <typename real>
+        using cast_t = ReDot<typename L::template cast_t<real>, typename R::template cast_t<real>>;
+        template <typename real> cast_t<real> cast() const
+        {
+          return {l.template cast<real>(), r.template cast<real>()};
+        }
+
+        template <typename sum_t, typename T>
+        __device__ __host__ void operator()(sum_t *sum, int i, T &x, T &y, T &z, T &w, T &v) const
+        {
+          auto a = l(i, x, y, z, w, v);
+          auto b = r(i, x, y, z, w, v);
+          sum[0] += static_cast<sum_t>(a.real()) * static_cast<sum_t>(b.real());
+          sum[0] += static_cast<sum_t>(a.imag()) * static_cast<sum_t>(b.imag());
+        }
+      };
+
+      /**
+         @brief Statement accumulating the complex dot product (l, r) = l^dagger r of two expressions
+      */
+      template <typename L, typename R> struct CDot {
+        static constexpr unsigned int reads = L::mask | R::mask;
+        static constexpr unsigned int writes = 0;
+        static constexpr int n_reduce = 2;
+        static constexpr int flops = L::flops + R::flops + 4;
+        static std::string str() { return "cDot(" + L::str() + "," + R::str() + ")"; }
+        L l;
+        R r;
+
+        template <typename real>
+        using cast_t = CDot<typename L::template cast_t<real>, typename R::template cast_t<real>>;
+        template <typename real> cast_t<real> cast() const
+        {
+          return {l.template cast<real>(), r.template cast<real>()};
+        }
+
+        template <typename sum_t, typename T>
+        __device__ __host__ void operator()(sum_t *sum, int i, T &x, T &y, T &z, T &w, T &v) const
+        {
+          auto a = l(i, x, y, z, w, v);
+          auto b = r(i, x, y, z, w, v);
+          sum[0] += static_cast<sum_t>(a.real()) * static_cast<sum_t>(b.real());
+          sum[0] += static_cast<sum_t>(a.imag()) * static_cast<sum_t>(b.imag());
+          sum[1] += static_cast<sum_t>(a.real()) * static_cast<sum_t>(b.imag());
+          sum[1] -= static_cast<sum_t>(a.imag()) * static_cast<sum_t>(b.real());
+        }
+      };
+
+      template <typename E, typename = typename std::enable_if<is_node<E>::value>::type> Norm2<E> norm2(const E &e)
+      {
+        return {e};
+      }
+
+      template <typename L, typename R, typename = enable_binary_t<L, R>> auto reDotProduct(const L &l, const R &r)
+      {
+        return ReDot<decltype(wrap(l)), decltype(wrap(r))> {wrap(l), wrap(r)};
+      }
+
+      template <typename L, typename R, typename = enable_binary_t<L, R>> auto cDotProduct(const L &l, const R &r)
+      {
+        return CDot<decltype(wrap(l)), decltype(wrap(r))> {wrap(l), wrap(r)};
+      }
+
+      /**
+         @brief Sequence of statements evaluated in order for each
+         element.  A field is read if a statement references it
+         before it has been assigned to, and written if any statement
+         assigns to it.
+      */
+      template <typename... S> struct Program;
+
+      template <> struct Program<> {
+        static constexpr unsigned int read = 0;
+        static constexpr unsigned int write = 0;
+        static constexpr int n_reduce = 0;
+        static constexpr int flops = 0;
+        static std::string str() { return ""; }
+
+        template <typename real> using cast_t = Program<>;
+        template <typename real> cast_t<real> cast() const { return {}; }
+
+        template <typename sum_t, typename T>
+        __device__ __host__ void operator()(sum_t *, int, T &, T &, T &, T &, T &) const
+        {
+        }
+      };
+
+      template <typename S, typename... Rest> struct Program<S, Rest...> {
+        static constexpr unsigned int read = S::reads | (Program<Rest...>::read & ~S::writes);
+        static constexpr unsigned int write = S::writes | Program<Rest...>::write;
+        static constexpr int n_reduce = S::n_reduce + Program<Rest...>::n_reduce;
+        static constexpr int flops = S::flops + Program<Rest...>::flops;
+        static std::string str() { return S::str() + (sizeof...(Rest) ? ";" + Program<Rest...>::str() : ""); }
+        S s;
+        Program<Rest...> rest;
+
+        template <typename real>
+        using cast_t = Program<typename S::template cast_t<real>, typename Rest::template cast_t<real>...>;
+        template <typename real> cast_t<real> cast() const
+        {
+          return {s.template cast<real>(), rest.template cast<real>()};
+        }
+
+        template <typename sum_t, typename T>
+        __device__ __host__ void operator()(sum_t *sum, int i, T &x, T &y, T &z, T &w, T &v) const
+        {
+          s(sum, i, x, y, z, w, v);
+          rest(sum + S::n_reduce, i, x, y, z, w, v);
+        }
+      };
+
+      inline Program<> program() { return {}; }
+
+      template <typename S, typename... Rest> Program<S, Rest...> program(const S &s, const Rest &... rest)
+      {
+        return {s, program(rest...)};
+      }
+
+      template <typename T, int n> struct reduce_vector {
+        using type = typename VectorType<T, n>::type;
+      };
+      template <typename T> struct reduce_vector<T, 0> {
+        using type = T;
+      };
+      template <typename T> struct reduce_vector<T, 1> {
+        using type = T;
+      };
+
+      template <unsigned int mask>
+      using access
+        = memory_access<(mask & 1) != 0, (mask & 2) != 0, (mask & 4) != 0, (mask & 8) != 0, (mask & 16) != 0>;
+
+      /**
+         @brief Functor adapting a program without reductions to the generic blas kernel
+      */
+      template <typename P> struct BlasProgram : public BlasFunctor {
+        using read_t = access<P::read>;
+        static constexpr read_t read {};
+        using write_t = access<P::write>;
+        static constexpr write_t write {};
+        const P p;
+        BlasProgram(const P &p) : p(p) { ; }
+        template <typename T> __device__ __host__ void operator()(T &x, T &y, T &z, T &w, T &v)
+        {
+#pragma unroll
+          for (int i = 0; i < x.size(); i++) p(static_cast<double *>(nullptr), i, x, y, z, w, v);
+        }
+        constexpr int flops() const { return P::flops; } //! flops per element
+      };
+
+      /**
+         @brief Functor adapting a program with reductions to the generic reduction kernel
+      */
+      template <typename real_reduce_t, typename P>
+      struct ReduceProgram : public ReduceFunctor<typename reduce_vector<real_reduce_t, P::n_reduce>::type> {
+        using reduce_t = typename reduce_vector<real_reduce_t, P::n_reduce>::type;
+        using read_t = access<P::read>;
+        static constexpr read_t read {};
+        using write_t = access<P::write>;
+        static constexpr write_t write {};
+        const P p;
+        ReduceProgram(const P &p) : p(p) { ; }
+        template <typename T> __device__ __host__ void operator()(reduce_t &sum, T &x, T &y, T &z, T &w, T &v)
+        {
+#pragma unroll
+          for (int i = 0; i < x.size(); i++) p(reinterpret_cast<real_reduce_t *>(&sum), i, x, y, z, w, v);
+        }
+        constexpr int flops() const { return P::flops; } //! flops per element
+      };
+
+#ifdef QUDA_FAST_COMPILE_REDUCE
+      constexpr static unsigned int max_block_size() { return 32; }
+#else
+      constexpr static unsigned int max_block_size() { return 1024; }
+#endif
+
+      template <int block_size, typename real, int len, typename Arg>
+      typename std::enable_if<block_size != 32, qudaError_t>::type launch(Arg &arg, const TuneParam &tp,
+                                                                           const qudaStream_t &stream)
+      {
+        if (tp.block.x == block_size)
+          return qudaLaunchKernel(reduceKernel<block_size, real, len, Arg>, tp, stream, arg);
+        else
+          return launch<block_size - 32, real, len>(arg, tp, stream);
+      }
+
+      template <int block_size, typename real, int len, typename Arg>
+      typename std::enable_if<block_size == 32, qudaError_t>::type launch(Arg &arg, const TuneParam &tp,
+                                                                           const qudaStream_t &stream)
+      {
+        if (block_size != tp.block.x) errorQuda("Unexpected block size %d\n", tp.block.x);
+        return qudaLaunchKernel(reduceKernel<block_size, real, len, Arg>, tp, stream, arg);
+      }
+
+      /**
+         @brief Launcher for a program, dispatching to the blas kernel
+         if it has no reductions and to the reduction kernel otherwise
+      */
+      template <typename P, typename store_t, int nSpin> class Fused : public Tunable
+      {
+        static constexpr bool reducing = P::n_reduce > 0;
+        using host_reduce_t = typename reduce_vector<double, P::n_reduce>::type;
+        using reduce_t = typename reduce_vector<device_reduce_t, P::n_reduce>::type;
+
+        const P &p;
+        const int nParity; // for composite fields this includes the number of composites
+        ColorSpinorField &x, &y, &z, &w, &v;
+        const QudaFieldLocation location;
+        host_reduce_t &result;
+        reduce_t partial; // local result prior to the sum over processes
+        std::string name;
+
+        unsigned int sharedBytesPerThread() const { return 0; }
+        unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
+
+        bool tuneSharedBytes() const { return false; }
+
+        // for the streaming kernels, there is no need to tune the grid size, just use max
+        unsigned int minGridSize() const { return reducing ? Tunable::minGridSize() : maxGridSize(); }
+
+        unsigned int maxBlockSize(const TuneParam &param) const
+        {
+          return reducing ? max_block_size() : Tunable::maxBlockSize(param);
+        }
+
+        ColorSpinorField &field(int k) const
+        {
+          ColorSpinorField *f[] = {&x, &y, &z, &w, &v};
+          return *f[k];
+        }
+
+        template <typename store, int N, typename real, int M, typename Q>
+        void applyDevice(const Q &q, TuneParam &tp, const qudaStream_t &stream, int length, std::true_type)
+        {
+          ReduceProgram<device_reduce_t, Q> r(q);
+          ReductionArg<store, N, store, N, decltype(r)> arg(x, y, z, w, v, r, length, nParity, tp);
+          arg.launch_error = launch<max_block_size(), real, M>(arg, tp, stream);
+          if (!commAsyncReduction()) arg.complete(partial, stream);
+        }
+
+        template <typename store, int N, typename real, int M, typename Q>
+        void applyDevice(const Q &q, TuneParam &tp, const qudaStream_t &stream, int length, std::false_type)
+        {
+          BlasProgram<Q> f(q);
+          BlasArg<store, N, store, N, decltype(f)> arg(x, y, z, w, v, f, length, nParity);
+          qudaLaunchKernel(blasKernel<real, M, decltype(arg)>, tp, stream, arg);
+        }
+
+        template <typename store, int N, typename real, int M, typename Q>
+        void applyHost(const Q &q, TuneParam &tp, int length, std::true_type)
+        {
+          ReduceProgram<device_reduce_t, Q> r(q);
+          ReductionArg<store, N, store, N, decltype(r)> arg(x, y, z, w, v, r, length, nParity, tp);
+          partial = reduceCPU<real, M>(arg);
+        }
+
+        template <typename store, int N, typename real, int M, typename Q>
+        void applyHost(const Q &q, TuneParam &tp, int length, std::false_type)
+        {
+          BlasProgram<Q> f(q);
+          BlasArg<store, N, store, N, decltype(f)> arg(x, y, z, w, v, f, length, nParity);
+          blasCPU<real, M>(arg);
+        }
+
+      public:
+        Fused(const P &p, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z, ColorSpinorField &w,
+              ColorSpinorField &v, host_reduce_t &result) :
+          p(p),
+          nParity((x.IsComposite() ? x.CompositeDim() : 1) * x.SiteSubset()),
+          x(x),
+          y(y),
+          z(z),
+          w(w),
+          v(v),
+          location(checkLocation(x, y, z, w, v)),
+          result(result),
+          name("blas::expr:" + P::str())
+        {
+          ::quda::zero(partial);
+          checkLength(x, y, z, w, v);
+          auto prec = checkPrecision(x, y, z, w, v);
+          checkOrder(x, y, z, w, v);
+          if (sizeof(store_t) != prec) errorQuda("Expected precision %lu but received %d", sizeof(store_t), prec);
+          if (name.size() >= TuneKey::name_n) errorQuda("Program %s too long for tuning", name.c_str());
+
+          strcpy(aux, x.AuxString());
+          if (reducing) strcat(aux, nParity == 2 ? ",nParity=2" : ",nParity=1");
+          if (location == QUDA_CPU_FIELD_LOCATION) strcat(aux, ",CPU");
+          if (reducing && commAsyncReduction()) strcat(aux, ",async");
+
+          apply(*getStream());
+
+          blas::bytes += bytes();
+          blas::flops += flops();
+
+          if (reducing) reduce_global(result, partial);
+        }
+
+        TuneKey tuneKey() const { return TuneKey(x.VolString(), name.c_str(), aux); }
+
+        void apply(const qudaStream_t &stream)
+        {
+          constexpr bool site_unroll_check = isFixed<store_t>::value;
+          if (site_unroll_check && (x.Ncolor() != 3 || x.Nspin() == 2))
+            errorQuda("site unroll not supported for nSpin = %d nColor = %d", x.Nspin(), x.Ncolor());
+
+          TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+          if (location == QUDA_CUDA_FIELD_LOCATION) {
+#ifdef JITIFY
+            errorQuda("Fused blas programs are not supported with JITIFY");
+#else
+            if (site_unroll_check) checkNative(x, y, z, w, v); // require native order when using site_unroll
+            using device_store_t = typename device_type_mapper<store_t>::type;
+            using device_real_t = typename mapper<device_store_t>::type;
+            auto p_ = p.template cast<device_real_t>();
+
+            constexpr bool site_unroll = isFixed<device_store_t>::value;
+            constexpr int N = n_vector<device_store_t, true, nSpin, site_unroll>();
+            constexpr int M = site_unroll ? (nSpin == 4 ? 24 : 6) : N; // real numbers per thread
+            const int length = x.Length() / (nParity * M);
+
+            applyDevice<device_store_t, N, device_real_t, M>(p_, tp, stream, length,
+                                                             std::integral_constant<bool, reducing>());
+#endif
+          } else {
+            if (checkOrder(x, y, z, w, v) != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+              errorQuda("CPU Blas functions expect AoS field order");
+
+            using host_store_t = typename host_type_mapper<store_t>::type;
+            using host_real_t = typename mapper<host_store_t>::type;
+            auto p_ = p.template cast<host_real_t>();
+
+            constexpr bool site_unroll = isFixed<host_store_t>::value;
+            constexpr int N = n_vector<host_store_t, false, nSpin, site_unroll>();
+            constexpr int M = N; // if site unrolling then M=N will be 24/6, e.g., full AoS
+            const int length = x.Length() / (nParity * M);
+
+            applyHost<host_store_t, N, host_real_t, M>(p_, tp, length, std::integral_constant<bool, reducing>());
+          }
+        }
+
+        void preTune()
+        {
+          for (int k = 0; k < 5; k++)
+            if (P::write & (1u << k)) field(k).backup();
+        }
+
+        void postTune()
+        {
+          for (int k = 0; k < 5; k++)
+            if (P::write & (1u << k)) field(k).restore();
+        }
+
+        bool advanceTuneParam(TuneParam &param) const
+        {
+          return location == QUDA_CPU_FIELD_LOCATION ? false : Tunable::advanceTuneParam(param);
+        }
+
+        void initTuneParam(TuneParam &param) const
+        {
+          Tunable::initTuneParam(param);
+          if (!reducing) param.grid.y = nParity;
+        }
+
+        void defaultTuneParam(TuneParam &param) const
+        {
+          Tunable::defaultTuneParam(param);
+          if (!reducing) param.grid.y = nParity;
+        }
+
+        long long flops() const { return P::flops * x.Length(); }
+
+        long long bytes() const
+        {
+          long long bytes = 0;
+          for (int k = 0; k < 5; k++)
+            bytes += (((P::read >> k) & 1) + ((P::write >> k) & 1)) * field(k).Bytes();
+          return bytes;
+        }
+
+        int tuningIter() const { return 3; }
+      };
+
+      template <typename P, typename store_t, typename result_t>
+      void instantiate(const P &p, const std::vector<ColorSpinorField *> &f, result_t &result)
+      {
+        // fields that are not bound alias the first field, and are neither loaded nor stored
+        auto &x = *f[0];
+        auto &y = f.size() > 1 && f[1] ? *f[1] : x;
+        auto &z = f.size() > 2 && f[2] ? *f[2] : x;
+        auto &w = f.size() > 3 && f[3] ? *f[3] : x;
+        auto &v = f.size() > 4 && f[4] ? *f[4] : x;
+
+        if (x.Nspin() == 4 || x.Nspin() == 2) {
+#if defined(NSPIN4) || defined(NSPIN2)
+          // Nspin-2 takes Nspin-4 path here, and we check for this later
+          Fused<P, store_t, 4>(p, x, y, z, w, v, result);
+#else
+          errorQuda("blas has not been built for Nspin=%d fields", x.Nspin());
+#endif
+        } else {
+#if defined(NSPIN1)
+          Fused<P, store_t, 1>(p, x, y, z, w, v, result);
+#else
+          errorQuda("blas has not been built for Nspin=%d fields", x.Nspin());
+#endif
+        }
+      }
+
+      /**
+         @brief Whether a set of fields can be bound to a single
+         program: programs are evaluated at a uniform precision, and
+         are not available with JITIFY
+         @param[in] fields The fields to be bound
+      */
+      inline bool fusable(const std::vector<ColorSpinorField *> &fields)
+      {
+#ifdef JITIFY
+        return false;
+#else
+        for (auto f : fields)
+          if (f->Precision() != fields[0]->Precision()) return false;
+        return true;
+#endif
+      }
+
+      /**
+         @brief Evaluate a sequence of statements over a set of fields
+         in a single fused kernel
+         @param[in,out] fields The fields bound to the placeholders _0, _1, ...
+         @param[in] s The statements, evaluated in order for each element
+         @return The reduction results packed in statement order (zero if there are none)
+      */
+      template <typename... S> auto eval(const std::vector<ColorSpinorField *> &fields, const S &... s)
+      {
+        using P = Program<S...>;
+        static_assert(sizeof...(S) > 0, "empty program");
+        if (fields.empty() || !fields[0]) errorQuda("Program %s requires field 0", P::str().c_str());
+        static_assert(P::n_reduce <= 4, "at most four reduction components are supported");
+        constexpr unsigned int used = P::read | P::write;
+        for (int k = 0; k < 5; k++)
+          if ((used & (1u << k)) && (k >= (int)fields.size() || !fields[k]))
+            errorQuda("Program %s requires field %d", P::str().c_str(), k);
+
+        auto &x = *fields[0];
+        for (auto f : fields)
+          if (f && f->Precision() != x.Precision())
+            errorQuda("Program %s requires a uniform precision, received %d and %d", P::str().c_str(), x.Precision(),
+                      f->Precision());
+
+        P p = program(s...);
+        typename reduce_vector<double, P::n_reduce>::type result;
+        ::quda::zero(result);
+
+        if (x.Precision() == QUDA_DOUBLE_PRECISION) {
+#if !(QUDA_PRECISION & 8)
+          if (x.Location() == QUDA_CUDA_FIELD_LOCATION)
+            errorQuda("QUDA_PRECISION=%d does not enable double precision", QUDA_PRECISION);
+#endif
+          instantiate<P, double>(p, fields, result);
+        } else if (x.Precision() == QUDA_SINGLE_PRECISION) {
+#if QUDA_PRECISION & 4
+          instantiate<P, float>(p, fields, result);
+#else
+          errorQuda("QUDA_PRECISION=%d does not enable single precision", QUDA_PRECISION);
+#endif
+        } else if (x.Precision() == QUDA_HALF_PRECISION) {
+#if QUDA_PRECISION & 2
+          instantiate<P, short>(p, fields, result);
+#else
+          errorQuda("QUDA_PRECISION=%d does not enable half precision", QUDA_PRECISION);
+#endif
+        } else if (x.Precision() == QUDA_QUARTER_PRECISION) {
+#if QUDA_PRECISION & 1
+          instantiate<P, int8_t>(p, fields, result);
+#else
+          errorQuda("QUDA_PRECISION=%d does not enable quarter precision", QUDA_PRECISION);
+#endif
+        } else {
+          errorQuda("Unsupported precision %d\n", x.Precision());
+        }
+
+        return result;
+      }
+
+    } // namespace expr
+
+  } // namespace blas
+
+} // namespace quda
@@ -139,7 +139,7 @@ namespace quda
 #ifdef __CUDA_ARCH__
         return __fdividef(fixedMaxValue<store_t>::value, scale);
 #else
-        return fixedMaxValue<store_t>::value / scale;
+        return scale > 0.0f ? fixedMaxValue<store_t>::value / scale : 0.0f;
 #endif
       }
 
@@ -459,20 +459,14 @@ namespace quda
     };
 
     /**
-      @brief host_type_mapper At present we do not support half or
-      quarter precision on the host target.  Thus we use
-      host_type_mapper to promote any half/quarter precision type to
-      double or single to prevent the kernel prior to any kernel being
-      instantiated to reduce template bloat.
+      @brief host_type_mapper Half-precision host fields are stored
+      in the same per-site block-float format as native half fields,
+      so they are run on directly.  Quarter precision is not supported
+      on the host target, so we use host_type_mapper to promote it to
+      double or single prior to any kernel being instantiated to
+      reduce template bloat.
      */
     template <typename T> struct host_type_mapper { using type = T; };
-    template <> struct host_type_mapper<short> {
-#if QUDA_PRECISION & 4
-      using type = float;
-#else
-      using type = double;
-#endif
-    };
     template <> struct host_type_mapper<int8_t> {
 #if QUDA_PRECISION & 4
       using type = float;
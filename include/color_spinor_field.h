@@ -949,7 +949,13 @@ namespace quda {
     void prefetch(QudaFieldLocation mem_space, qudaStream_t stream = 0) const;
   };
 
-  // CPU implementation
+  /**
+     CPU implementation.  Half-precision host fields are stored in
+     space-spin-color order with the per-site norm of the native
+     format, and are supported by copies, blas and reductions.  Their
+     halos are exchanged in single precision, and the host coarse
+     dslash applies to them through single-precision copies.
+  */
   class cpuColorSpinorField : public ColorSpinorField {
 
     friend class cudaColorSpinorField;
@@ -1364,17 +1364,26 @@ namespace quda {
       using Accessor = SpaceSpinorColorOrder<Float, Ns, Nc>;
       using real = typename mapper<Float>::type;
       using complex = complex<real>;
+      using norm_type = float;
       static const int length = 2 * Ns * Nc;
       Float *field;
+      norm_type *norm;
       size_t offset;
+      size_t norm_offset;
       Float *ghost[8];
       int volumeCB;
       int faceVolumeCB[4];
       int stride;
       int nParity;
-      SpaceSpinorColorOrder(const ColorSpinorField &a, int nFace=1, Float *field_=0, float *dummy=0, Float **ghost_=0)
-      : field(field_ ? field_ : (Float*)a.V()), offset(a.Bytes()/(2*sizeof(Float))),
-    volumeCB(a.VolumeCB()), stride(a.Stride()), nParity(a.SiteSubset())
+      SpaceSpinorColorOrder(const ColorSpinorField &a, int nFace = 1, Float *field_ = 0, norm_type *norm_ = 0,
+                            Float **ghost_ = 0) :
+        field(field_ ? field_ : (Float *)a.V()),
+        norm(norm_ ? norm_ : (norm_type *)a.Norm()),
+        offset(a.Bytes() / (2 * sizeof(Float))),
+        norm_offset(a.NormBytes() / (2 * sizeof(norm_type))),
+        volumeCB(a.VolumeCB()),
+        stride(a.Stride()),
+        nParity(a.SiteSubset())
   {
     if (volumeCB != stride) errorQuda("Stride must equal volume for this field order");
     for (int i=0; i<4; i++) {
@@ -1393,36 +1402,44 @@ namespace quda {
     for (int s=0; s<Ns; s++) {
       for (int c = 0; c < Nc; c++) { v[s * Nc + c] = complex(v_.v[(s * Nc + c) * 2 + 0], v_.v[(s * Nc + c) * 2 + 1]); }
     }
-#else
-    for (int s=0; s<Ns; s++) {
-      for (int c=0; c<Nc; c++) {
-        v[s * Nc + c] = complex(field[parity * offset + ((x * Ns + s) * Nc + c) * 2 + 0],
-                                field[parity * offset + ((x * Ns + s) * Nc + c) * 2 + 1]);
-      }
+
+    if (isFixed<Float>::value) {
+      // fixed-point fields carry a per-site norm, as with the native half-precision format
+      real nrm = norm[x + parity * norm_offset] * fixedInvMaxValue<Float>::value;
+      for (int i = 0; i < length / 2; i++) v[i] = nrm * v[i];
     }
+#else
+    // a site is contiguous, so it is converted in one pass through its per-site norm (if any)
+    load_convert(reinterpret_cast<real *>(v), field + parity * offset + x * length, length,
+                 isFixed<Float>::value ? norm[x + parity * norm_offset] : 1.0f);
 #endif
   }
 
   __device__ __host__ inline void save(const complex v[length / 2], int x, int parity = 0)
   {
 #if defined( __CUDA_ARCH__) && !defined(DISABLE_TROVE)
+    real scale_inv = 1.0;
+    if (isFixed<Float>::value) {
+      norm_type scale = 0.0;
+      for (int i = 0; i < length / 2; i++)
+        scale = fmaxf(scale, fmaxf(fabsf((norm_type)v[i].real()), fabsf((norm_type)v[i].imag())));
+      norm[x + parity * norm_offset] = scale;
+      scale_inv = __fdividef(fixedMaxValue<Float>::value, scale);
+    }
+
     typedef S<Float,length> structure;
     trove::coalesced_ptr<structure> field_((structure*)field);
     structure v_;
     for (int s=0; s<Ns; s++) {
       for (int c=0; c<Nc; c++) {
-        v_.v[(s * Nc + c) * 2 + 0] = v[s * Nc + c].real();
-        v_.v[(s * Nc + c) * 2 + 1] = v[s * Nc + c].imag();
+        copy_scaled(v_.v[(s * Nc + c) * 2 + 0], scale_inv * v[s * Nc + c].real());
+        copy_scaled(v_.v[(s * Nc + c) * 2 + 1], scale_inv * v[s * Nc + c].imag());
       }
     }
     field_[parity*volumeCB + x] = v_;
 #else
-    for (int s=0; s<Ns; s++) {
-      for (int c=0; c<Nc; c++) {
-        field[parity * offset + ((x * Ns + s) * Nc + c) * 2 + 0] = v[s * Nc + c].real();
-        field[parity * offset + ((x * Ns + s) * Nc + c) * 2 + 1] = v[s * Nc + c].imag();
-      }
-    }
+    float nrm = store_convert(field + parity * offset + x * length, reinterpret_cast<const real *>(v), length);
+    if (isFixed<Float>::value) norm[x + parity * norm_offset] = nrm;
 #endif
   }
 
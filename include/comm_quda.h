@@ -301,6 +301,19 @@ extern "C" {
   void comm_allreduce_max(double* data);
   void comm_allreduce_min(double* data);
   void comm_allreduce_array(double* data, size_t size);
+
+  /**
+     Sum an array of compensated values over all processes.  The
+     (sum, compensation) pairs are combined with a compensated
+     addition in an MPI reduction tree, so the cost matches that of a
+     double reduction of twice the length.  With
+     QUDA_DETERMINISTIC_REDUCE=1 the values are instead gathered and
+     accumulated in rank order, so the result does not depend on the
+     reduction tree.
+     @param data Array of size (sum, compensation) pairs, overwritten with the global sums
+     @param size Number of compensated values
+  */
+  void comm_allreduce_compensated_array(double *data, size_t size);
   void comm_allreduce_max_array(double* data, size_t size);
   void comm_allreduce_int(int* data);
   void comm_allreduce_xor(uint64_t *data);
@@ -312,6 +325,14 @@ extern "C" {
   void reduceMaxDouble(double &);
   void reduceDouble(double &);
   void reduceDoubleArray(double *, const int len);
+
+  /**
+     Global sum of an array of compensated values (as (sum,
+     compensation) pairs).  If QUDA_REDUCE_CHECK=1 is set, each result
+     is checked for whether its rounding to double could depend on the
+     order of summation.
+  */
+  void reduceCompensatedArray(double *, const int len);
   int commDim(int);
   int commCoords(int);
   int commDimPartitioned(int dir);
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+/**
+   @file compensated.h
+
+   @section DESCRIPTION
+   Compensated (Neumaier) double-precision accumulator, used as the
+   reduction type when QUDA is built with QUDA_REDUCE_MODE=compensated.
+   Each value carries the running sum s together with the rounding
+   error c lost by s, which is computed exactly at each addition using
+   the TwoSum transformation, so the accumulated value s + c is
+   accurate to second order in the unit roundoff irrespective of the
+   number of terms or the order in which they are summed.
+*/
+
+namespace quda
+{
+
+  struct compensated {
+    double s; //! running sum
+    double c; //! accumulated rounding error of the running sum
+
+    __device__ __host__ compensated() : s(0.0), c(0.0) { }
+    __device__ __host__ compensated(double s) : s(s), c(0.0) { }
+    __device__ __host__ compensated(double s, double c) : s(s), c(c) { }
+
+    __device__ __host__ compensated &operator+=(double x)
+    {
+      double t = s + x;
+      double z = t - s;
+      c += (s - (t - z)) + (x - z);
+      s = t;
+      return *this;
+    }
+
+    __device__ __host__ compensated &operator+=(const compensated &x)
+    {
+      *this += x.s;
+      c += x.c;
+      return *this;
+    }
+
+    __device__ __host__ compensated &operator-=(double x) { return *this += -x; }
+
+    /**
+       @return The accumulated value rounded to double
+    */
+    __device__ __host__ double value() const { return s + c; }
+  };
+
+  __device__ __host__ inline compensated operator+(compensated a, const compensated &b) { return a += b; }
+
+  // products and ratios are only formed from values that are not themselves sums, so are done in double
+  __device__ __host__ inline double operator*(const compensated &a, const compensated &b)
+  {
+    return a.value() * b.value();
+  }
+
+  __device__ __host__ inline double operator/(const compensated &a, const compensated &b)
+  {
+    return a.value() / b.value();
+  }
+
+  __device__ __host__ inline bool operator>(const compensated &a, double b) { return a.value() > b; }
+
+  struct compensated2 {
+    compensated x;
+    compensated y;
+  };
+
+  struct compensated3 {
+    compensated x;
+    compensated y;
+    compensated z;
+  };
+
+  struct compensated4 {
+    compensated x;
+    compensated y;
+    compensated z;
+    compensated w;
+  };
+
+  __device__ __host__ inline compensated2 operator+(compensated2 a, const compensated2 &b)
+  {
+    a.x += b.x;
+    a.y += b.y;
+    return a;
+  }
+
+  __device__ __host__ inline compensated3 operator+(compensated3 a, const compensated3 &b)
+  {
+    a.x += b.x;
+    a.y += b.y;
+    a.z += b.z;
+    return a;
+  }
+
+  __device__ __host__ inline compensated4 operator+(compensated4 a, const compensated4 &b)
+  {
+    a.x += b.x;
+    a.y += b.y;
+    a.z += b.z;
+    a.w += b.w;
+    return a;
+  }
+
+  __device__ __host__ inline void zero(compensated &a) { a = compensated(); }
+  __device__ __host__ inline void zero(compensated2 &a) { a = compensated2(); }
+  __device__ __host__ inline void zero(compensated3 &a) { a = compensated3(); }
+  __device__ __host__ inline void zero(compensated4 &a) { a = compensated4(); }
+
+  template <typename T> struct is_compensated : std::false_type {
+  };
+  template <> struct is_compensated<compensated> : std::true_type {
+  };
+  template <> struct is_compensated<compensated2> : std::true_type {
+  };
+  template <> struct is_compensated<compensated3> : std::true_type {
+  };
+  template <> struct is_compensated<compensated4> : std::true_type {
+  };
+
+  /**
+     @brief Conversion of a reduction result to the type returned to
+     the caller: the identity unless the result is compensated, in
+     which case the accumulated value is rounded to double.
+  */
+  template <typename T> __host__ inline void reduce_convert(T &a, const T &b) { a = b; }
+  __host__ inline void reduce_convert(double &a, const compensated &b) { a = b.value(); }
+  __host__ inline void reduce_convert(double2 &a, const compensated2 &b)
+  {
+    a.x = b.x.value();
+    a.y = b.y.value();
+  }
+  __host__ inline void reduce_convert(double3 &a, const compensated3 &b)
+  {
+    a.x = b.x.value();
+    a.y = b.y.value();
+    a.z = b.z.value();
+  }
+  __host__ inline void reduce_convert(double4 &a, const compensated4 &b)
+  {
+    a.x = b.x.value();
+    a.y = b.y.value();
+    a.z = b.z.value();
+    a.w = b.w.value();
+  }
+
+  /**
+     @brief Cheap check of whether value() is the correctly rounded
+     sum, and so is independent of the order of summation and the
+     partitioning of the sum.  The residual e = s + c - value() is
+     exact, while c itself is only known to a relative accuracy set by
+     the number of rounding errors accumulated into it; the rounding
+     to double is stable if |e| is further than this uncertainty from
+     half a unit in the last place, i.e., from a rounding tie.
+
+     The uncertainty has two parts.  Adding the rounding errors into c
+     is itself rounded, with a worst-case error growing linearly in the
+     number of additions: 2^-30 = 2^23 * 2^-53 relative to |c| allows
+     for 2^23 such additions at unit roundoff 2^-53, which exceeds the
+     number of terms any one thread, block tree or rank-order sum
+     accumulates.  Each of those rounding errors is also bounded by the
+     unit roundoff times an error of s, i.e., by roughly 2^-106 |s|, so
+     2^-100 |s| is a floor with a 2^6 margin that keeps the test
+     meaningful when c is zero or has cancelled.
+     @param[in] a Compensated sum
+     @return Whether the rounding of the sum to double is stable
+  */
+  inline bool is_exact(const compensated &a)
+  {
+    double r = a.s + a.c;
+    double e = a.c - (r - a.s);
+    double half_ulp = 0.5 * (std::nextafter(std::fabs(r), INFINITY) - std::fabs(r));
+    double uncertainty = std::ldexp(std::fabs(a.c), -30) + std::ldexp(std::fabs(a.s), -100);
+    return std::fabs(std::fabs(e) - half_ulp) > uncertainty;
+  }
+
+} // namespace quda
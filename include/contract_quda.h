@@ -1,9 +1,52 @@
 #pragma once
 
+#include <vector>
+
 #include <quda_internal.h>
 #include <quda.h>
 
 namespace quda
 {
   void contractQuda(const ColorSpinorField &x, const ColorSpinorField &y, void *result, QudaContractType cType);
+
+  /**
+     @brief Contract x and y, project the result onto a set of spatial
+     momenta and sum it over each timeslice, without writing out the
+     contraction at each site.  Runs on the device or, for host fields
+     in space-spin-color order, with the threaded host implementation.
+     @param[in] x The bra spinor (conjugated)
+     @param[in] y The ket spinor
+     @param[out] result The correlators C(t, p, g) = sum_x exp(-i p.x)
+     C_g(x, t), ordered with t slowest and g fastest, for all global
+     timeslices t
+     @param[in] cType Whether g indexes the open spin elementals
+     (4 * mu + nu) or the DeGrand-Rossi gamma projections
+     @param[in] mom The momenta, as 3 integers per momentum in units of
+     2 pi / L
+     @param[in] gamma The contractions to project, each in [0, 16)
+  */
+  void contractFTQuda(const ColorSpinorField &x, const ColorSpinorField &y, std::vector<Complex> &result,
+                      QudaContractType cType, const std::vector<int> &mom, const std::vector<int> &gamma);
+
+  /**
+     @brief Evaluate the meson and nucleon correlators of two
+     propagators in a single sweep over the lattice, projected onto a
+     set of spatial momenta and summed over each timeslice.  Each
+     propagator is given as 12 host fields in space-spin-color order
+     and the DeGrand-Rossi basis, where field 3 * s + c is the
+     solution for a point source of spin s and color c.
+     @param[in] prop1 The propagator S1 (the doubly represented quark of the nucleon)
+     @param[in] prop2 The propagator S2
+     @param[out] meson The correlators Tr[Gamma_g S1 Gamma_g gamma_5
+     S2^dagger gamma_5] for the 16 gamma structures g of the
+     DeGrand-Rossi contraction, ordered [t][mom][g]
+     @param[out] baryon The 4 x 4 spin matrix of the nucleon correlator
+     with diquark C gamma_5, ordered [t][mom][alpha][alpha'], to be
+     traced with a parity projector by the caller
+     @param[in] mom The momenta, as 3 integers per momentum in units of
+     2 pi / L
+  */
+  void contractPropagatorsQuda(const std::vector<ColorSpinorField *> &prop1,
+                               const std::vector<ColorSpinorField *> &prop2, std::vector<Complex> &meson,
+                               std::vector<Complex> &baryon, const std::vector<int> &mom);
 } // namespace quda
@@ -115,4 +115,47 @@ namespace quda
     a = i2f(b) * fixedInvMaxValue<T2>::value * c;
   }
 
+  /**
+     @brief Load-convert accessor for n contiguous stored components
+     that share one block norm, e.g., a site of a fixed-point host
+     field.  The conversion is a single flat loop over contiguous
+     memory, which the host compiler vectorizes.
+     @param[out] a The converted floating-point components
+     @param[in] b The stored components
+     @param[in] n The number of components
+     @param[in] norm The block norm (ignored unless b is fixed point)
+  */
+  template <typename T1, typename T2>
+  __host__ __device__ inline void load_convert(T1 *a, const T2 *b, int n, float norm)
+  {
+    for (int i = 0; i < n; i++) copy_and_scale(a[i], b[i], norm);
+  }
+
+  /**
+     @brief Store-convert accessor for n contiguous components that
+     share one block norm.  When storing to fixed point, the block
+     norm is the maximum absolute component, which is mapped onto the
+     largest integer, and each component is rounded to nearest.
+     Both passes are flat loops over contiguous memory, which the host
+     compiler vectorizes.
+     @param[out] a The stored components
+     @param[in] b The floating-point components to store
+     @param[in] n The number of components
+     @return The block norm (1.0 unless a is fixed point)
+  */
+  template <typename T1, typename T2>
+  __host__ __device__ inline float store_convert(T1 *a, const T2 *b, int n)
+  {
+    if (!isFixed<T1>::value) {
+      for (int i = 0; i < n; i++) copy(a[i], b[i]);
+      return 1.0f;
+    }
+
+    float max = 0.0f;
+    for (int i = 0; i < n; i++) max = fmaxf(max, fabsf(static_cast<float>(b[i])));
+    const T2 scale = max > 0.0f ? fixedMaxValue<T1>::value / max : 0.0f;
+    for (int i = 0; i < n; i++) a[i] = static_cast<T1>(round(scale * b[i]));
+    return max;
+  }
+
 } // namespace quda
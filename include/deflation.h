@@ -1,6 +1,7 @@
 #pragma once
 
 #include <invert_quda.h>
+#include <transfer.h>
 #include <vector>
 #include <complex_quda.h>
 
@@ -207,6 +208,112 @@ namespace quda {
     }
   };
 
+  /**
+     A compressed representation of a deflation space that exploits
+     the local coherence of the low modes.  The leading n_basis
+     eigenvectors are block orthogonalized, using the same Transfer
+     machinery as multigrid, to form a local basis, and every
+     eigenvector is then stored as its low-precision coarse-grid
+     coefficients with respect to this basis.  Since P^dagger P = 1,
+     deflation is carried out directly on the coarse grid, requiring
+     a single restriction and prolongation per application rather
+     than the reconstruction of each fine-grid eigenvector.
+   */
+  class CompressedDeflationSpace
+  {
+
+  private:
+    /** TimeProfile for the compressed space */
+    TimeProfile profile;
+
+    /** Number of eigenvectors to use when deflating */
+    int n_ev_deflate;
+
+    /** The parity of the eigenvectors if they are single-parity fields */
+    QudaParity parity;
+
+    /** Full-field vectors that define the block basis; only the
+        first element is retained once the transfer operator has
+        been constructed */
+    std::vector<ColorSpinorField *> basis;
+
+    /** Transfer operator that holds the block-orthogonalized basis */
+    Transfer *transfer;
+
+    /** Coarse-grid coefficients of each eigenvector */
+    std::vector<ColorSpinorField *> coeff;
+
+    /** Fine-grid single-precision temporary with the eigenvector geometry */
+    ColorSpinorField *fine_tmp;
+
+    /** Coarse-grid restricted source */
+    ColorSpinorField *coarse_src;
+
+    /** Coarse-grid accumulated deflated solution */
+    ColorSpinorField *coarse_sol;
+
+    /** Coarse-grid working-precision copies of a batch of
+        coefficient vectors (empty if the coefficients are already
+        stored in the working precision) */
+    std::vector<ColorSpinorField *> coarse_tmp;
+
+  public:
+    /**
+       @brief Constructor for CompressedDeflationSpace.  Compresses
+       the given eigenvectors; the input vectors are left untouched
+       and may be freed by the caller on return.
+       @param[in] eig_param The eigensolver parameters
+       @param[in] evecs The eigenvectors to compress
+       @param[in] parity The parity of the eigenvectors if they are
+       single-parity fields
+     */
+    CompressedDeflationSpace(const QudaEigParam &eig_param, const std::vector<ColorSpinorField *> &evecs,
+                             QudaParity parity);
+
+    /**
+       @brief Destructor for CompressedDeflationSpace
+     */
+    virtual ~CompressedDeflationSpace();
+
+    /**
+       @brief Return the number of compressed eigenvectors
+     */
+    int size() const { return coeff.size(); }
+
+    /**
+       @brief Deflate the source, computing sol = sum_i v_i
+       (1/lambda_i) v_i^dagger src over the first n_ev_deflate
+       compressed eigenvectors.
+       @param[in,out] sol The deflated solution vector
+       @param[in] src The vector to deflate
+       @param[in] evals The eigenvalues
+       @param[in] accumulate Whether to accumulate onto or overwrite sol
+     */
+    void deflate(ColorSpinorField &sol, const ColorSpinorField &src, const std::vector<Complex> &evals,
+                 bool accumulate) const;
+
+    /**
+       @brief Reconstruct a fine-grid eigenvector from its compressed
+       representation
+       @param[out] v The reconstructed eigenvector
+       @param[in] i The eigenvector index
+     */
+    void reconstruct(ColorSpinorField &v, int i) const;
+
+    /**
+       @brief Compute the eigenvalues of the reconstructed eigenvectors
+       @param[in] mat The operator whose eigenvalues we are computing
+       @param[in] precision The precision of the fields mat acts upon
+       @param[out] evals The computed eigenvalues
+     */
+    void computeEvals(const DiracMatrix &mat, QudaPrecision precision, std::vector<Complex> &evals) const;
+
+    /**
+       @brief Return the device memory footprint of the compressed space in bytes
+     */
+    size_t Bytes() const;
+  };
+
 } // namespace quda
 
 
@@ -6,6 +6,7 @@
 #include <clover_field.h>
 #include <dslash_quda.h>
 #include <blas_quda.h>
+#include <solver_telemetry.h>
 
 #include <typeinfo>
 
@@ -14,6 +15,9 @@ namespace quda {
   // Forward declare: MG Transfer Class
   class Transfer;
 
+  // Forward declare: MG checkpoint
+  class MGCheckpoint;
+
   // Forward declare: Dirac Op Base Class
   class Dirac;
 
@@ -221,6 +225,21 @@ namespace quda {
     */
     virtual void MdagM(ColorSpinorField &out, const ColorSpinorField &in) const = 0;
 
+    /**
+       @brief Whether the operator has a batched kernel for multi-RHS
+       fields, which loads each link once for several right-hand
+       sides and exchanges all their halos together
+    */
+    virtual bool hasMultiRHS() const { return false; }
+
+    /**
+       @brief Apply M to a multi-RHS field: a five-dimensional field
+       with 4-d preconditioning whose fifth dimension indexes the
+       right-hand sides.  Operators without a batched kernel apply M
+       to each right-hand side in turn.
+    */
+    virtual void MMultiRHS(ColorSpinorField &out, const ColorSpinorField &in) const;
+
     /**
        @brief Apply the local MdagM operator: equivalent to applying zero Dirichlet
               boundary condition to MdagM on each rank. Depending on the number of
@@ -388,6 +407,10 @@ namespace quda {
     virtual void M(ColorSpinorField &out, const ColorSpinorField &in) const;
     virtual void MdagM(ColorSpinorField &out, const ColorSpinorField &in) const;
 
+    // derived operators fall back to the per-RHS application unless they override these
+    virtual bool hasMultiRHS() const { return getDiracType() == QUDA_WILSON_DIRAC; }
+    virtual void MMultiRHS(ColorSpinorField &out, const ColorSpinorField &in) const;
+
     virtual void prepare(ColorSpinorField* &src, ColorSpinorField* &sol,
 			 ColorSpinorField &x, ColorSpinorField &b,
 			 const QudaSolutionType) const;
@@ -430,6 +453,9 @@ namespace quda {
     void M(ColorSpinorField &out, const ColorSpinorField &in) const;
     void MdagM(ColorSpinorField &out, const ColorSpinorField &in) const;
 
+    bool hasMultiRHS() const { return getDiracType() == QUDA_WILSONPC_DIRAC; }
+    void MMultiRHS(ColorSpinorField &out, const ColorSpinorField &in) const;
+
     void prepare(ColorSpinorField* &src, ColorSpinorField* &sol,
 		 ColorSpinorField &x, ColorSpinorField &b,
 		 const QudaSolutionType) const;
@@ -462,6 +488,9 @@ namespace quda {
     virtual void M(ColorSpinorField &out, const ColorSpinorField &in) const;
     virtual void MdagM(ColorSpinorField &out, const ColorSpinorField &in) const;
 
+    virtual bool hasMultiRHS() const { return getDiracType() == QUDA_CLOVER_DIRAC; }
+    virtual void MMultiRHS(ColorSpinorField &out, const ColorSpinorField &in) const;
+
     virtual void prepare(ColorSpinorField* &src, ColorSpinorField* &sol,
 			 ColorSpinorField &x, ColorSpinorField &b,
 			 const QudaSolutionType) const;
@@ -1559,6 +1588,13 @@ public:
     */
     void initializeCoarse();
 
+    /**
+       @brief Restore the coarse gauge fields from a checkpoint into
+       GPU memory, in place of initializeCoarse()
+       @param[in] checkpoint The checkpoint being restored
+    */
+    void restore(MGCheckpoint &checkpoint);
+
     /**
        @brief Create the CPU or GPU coarse gauge fields on demand
        (requires that the fields have been created in the other memory
@@ -1595,8 +1631,10 @@ public:
        @param[in] param Parameters defining this operator
        @param[in] gpu_setup Whether to do the setup on GPU or CPU
        @param[in] mapped Set to true to put Y and X fields in mapped memory
+       @param[in] checkpoint If set, restore the coarse fields from this checkpoint instead of building them
      */
-    DiracCoarse(const DiracParam &param, bool gpu_setup=true, bool mapped=false);
+    DiracCoarse(const DiracParam &param, bool gpu_setup = true, bool mapped = false,
+                MGCheckpoint *checkpoint = nullptr);
 
     /**
        @param[in] param Parameters defining this operator
@@ -1622,6 +1660,13 @@ public:
 
     virtual bool isCoarse() const { return true; }
 
+    /**
+       @brief Write the coarse link, clover, preconditioned link and
+       inverse clover fields to a checkpoint
+       @param[in] checkpoint The checkpoint being written
+     */
+    void save(MGCheckpoint &checkpoint) const;
+
     /**
        @brief Apply the coarse clover operator
        @param[out] out Output field
@@ -1884,7 +1929,15 @@ public:
 			    ColorSpinorField &Tmp1, ColorSpinorField &Tmp2) const = 0;
 
 
-    unsigned long long flops() const { return dirac->Flops(); }
+    /**
+        @brief returns and then zeroes the flopcount of the underlying operator
+    */
+    unsigned long long flops() const
+    {
+      unsigned long long rtn = dirac->Flops();
+      if (rtn && telemetry::active()) telemetry::operatorFlops(dirac->getDiracType(), rtn);
+      return rtn;
+    }
 
 
     QudaMatPCType getMatPCType() const { return dirac->getMatPCType(); }
@@ -1924,6 +1977,16 @@ public:
     if (shift != 0.0) blas::axpy(shift, const_cast<ColorSpinorField &>(in), out);
     }
 
+    /**
+       @brief Apply the operator and potentially a shift to every
+       right-hand side of a multi-RHS field at once
+    */
+    void MultiRHS(ColorSpinorField &out, const ColorSpinorField &in) const
+    {
+      dirac->MMultiRHS(out, in);
+      if (shift != 0.0) blas::axpy(shift, const_cast<ColorSpinorField &>(in), out);
+    }
+
     /**
         If the Dirac Operator's tmp1 member is not set, this provides
         a tmp. The tmp is set as the DiracOperator's tmp before the matrix apply
@@ -85,6 +85,73 @@ namespace quda {
   void ApplyWilsonClover(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, const CloverField &A,
       double kappa, const ColorSpinorField &x, int parity, bool dagger, const int *comm_override, TimeProfile &profile);
 
+  /**
+     @brief Driver for applying the Wilson stencil to a multi-RHS
+     field: a five-dimensional field with 4-d preconditioning whose
+     fifth dimension indexes the right-hand sides.  Each link is
+     loaded once for a tile of right-hand sides, and the halos of all
+     right-hand sides are exchanged together.
+
+     out_s = x_s + kappa * D * in_s
+
+     Host fields (space-spin-color order with a QDP-ordered gauge
+     field) are supported if no dimension is partitioned.
+
+     @param[out] out The output multi-RHS field
+     @param[in] in The input multi-RHS field
+     @param[in] U The gauge field used for the operator
+     @param[in] kappa Scale factor applied
+     @param[in] x Multi-RHS field we accumulate onto to
+     @param[in] parity Destination parity
+     @param[in] dagger Whether this is for the dagger operator
+     @param[in] comm_override Override for which dimensions are partitioned
+     @param[in] profile The TimeProfile used for profiling the dslash
+  */
+  void ApplyWilsonMultiRHS(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double kappa,
+                           const ColorSpinorField &x, int parity, bool dagger, const int *comm_override,
+                           TimeProfile &profile);
+
+  /**
+     @brief Driver for applying the Wilson-clover stencil to a
+     multi-RHS field, with each clover matrix loaded once for a tile
+     of right-hand sides
+
+     out_s = A * x_s + kappa * D * in_s
+
+     @param[out] out The output multi-RHS field
+     @param[in] in Input multi-RHS field that D is applied to
+     @param[in] U The gauge field used for the operator
+     @param[in] A The clover field used for the operator
+     @param[in] kappa Scale factor applied
+     @param[in] x Input multi-RHS field that A is applied to
+     @param[in] parity Destination parity
+     @param[in] dagger Whether this is for the dagger operator
+     @param[in] comm_override Override for which dimensions are partitioned
+     @param[in] profile The TimeProfile used for profiling the dslash
+  */
+  void ApplyWilsonCloverMultiRHS(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                                 const CloverField &A, double kappa, const ColorSpinorField &x, int parity, bool dagger,
+                                 const int *comm_override, TimeProfile &profile);
+
+  /**
+     @brief Copy a four-dimensional field into, or out of, one of the
+     right-hand sides of a multi-RHS field.  Whichever of dst and src
+     is five dimensional is the multi-RHS field.
+     @param[out] dst Destination field
+     @param[in] src Source field
+     @param[in] s Index of the right-hand side in the multi-RHS field
+  */
+  void copyMultiRHS(ColorSpinorField &dst, const ColorSpinorField &src, int s);
+
+  /**
+     @brief Compute the squared norm of each right-hand side of a
+     multi-RHS field in a single pass, so the right-hand sides need not
+     be extracted first.  The result is globally reduced.
+     @param[out] norm The squared norm of each right-hand side
+     @param[in] in The multi-RHS field
+  */
+  void multiRHSNorm2(std::vector<double> &norm, const ColorSpinorField &in);
+
   /**
        @brief Driver for applying the Wilson-clover stencil
 
@@ -425,6 +425,27 @@ namespace quda {
      */
     uint64_t checksum(bool mini = false) const;
 
+    /**
+       @brief Read the field from a NERSC, ILDG (SciDAC/LIME) or MILC
+       binary gauge configuration, with the format detected from the
+       file contents.  Each rank reads only its own sub-volume and
+       the checksums stored in the file are verified.  Defined in
+       lib/gauge_field_io.cpp.
+       @param[in] filename The name of the file to read
+    */
+    void read(char *filename);
+
+    /**
+       @brief Write the field as a binary gauge configuration.  The
+       format is chosen from the extension: ".lime" or ".ildg" gives
+       ILDG, ".milc" gives MILC, and anything else gives NERSC.
+       Double-precision fields are written in double precision,
+       except for MILC which is always single.  Defined in
+       lib/gauge_field_io.cpp.
+       @param[in] filename The name of the file to write
+    */
+    void write(char *filename);
+
     /**
        @brief Create the gauge field, with meta data specified in the
        parameter struct.
@@ -796,6 +817,47 @@ namespace quda {
   */
   uint64_t Checksum(const GaugeField &u, bool mini=false);
 
+  /**
+     @brief Open a streaming checksum.  While the stream is open, the
+     host-side gauge reorder (the CPU path of copyGenericGauge) and
+     GaugeField::read fold the checksum of the field they traverse
+     into the stream, so that a field can be verified without a
+     separate pass over memory.  The result is identical to
+     Checksum() of that field.  Streams do not nest.
+     @param[in] output Whether to checksum the destination of a
+     reorder (e.g., when saving a field) rather than its source
+  */
+  void checksumStreamBegin(bool output = false);
+
+  /**
+     @brief Close the streaming checksum and reduce it over all ranks.
+     This is a collective call.
+     @param[out] checksum The accumulated checksum
+     @return Whether any pass contributed to the stream; if false
+     (e.g., the reorder was done on the device) the caller must fall
+     back to Checksum()
+  */
+  bool checksumStreamEnd(uint64_t &checksum);
+
+  /**
+     @brief Temporarily stop (or restart) accumulating into the open
+     stream, e.g., for a copy of data that has already been summed
+     @param[in] suspend Whether to suspend the stream
+  */
+  void checksumStreamSuspend(bool suspend);
+
+  /**
+     @param[in] output Which side of a reorder is being summed
+     @return Whether a pass over that side should accumulate into the stream
+  */
+  bool checksumStreamActive(bool output);
+
+  /**
+     @brief Fold a partial (rank-local) checksum into the open stream
+     @param[in] checksum The partial checksum
+  */
+  void checksumStreamAccumulate(uint64_t checksum);
+
   /**
      @brief Helper function for determining if the reconstruct of the fields is the same.
      @param[in] a Input field
@@ -830,6 +892,21 @@ namespace quda {
 
 #define checkReconstruct(...) Reconstruct_(__func__, __FILE__, __LINE__, __VA_ARGS__)
 
+  /**
+     @brief Helper function for checking that a field is in an order
+     the site-local gauge kernels support at its location: native on
+     the device, or QDP on the host where they run through launchHost.
+     @param[in] u Input field
+   */
+  inline void KernelOrder_(const char *func, const char *file, int line, const GaugeField &u)
+  {
+    if (u.Location() == QUDA_CUDA_FIELD_LOCATION ? !u.isNative() : u.Order() != QUDA_QDP_GAUGE_ORDER)
+      errorQuda("Order %d with %d reconstruct not supported at location %d (%s:%d in %s())\n", u.Order(),
+                u.Reconstruct(), u.Location(), file, line, func);
+  }
+
+#define checkKernelOrder(u) KernelOrder_(__func__, __FILE__, __LINE__, u)
+
 } // namespace quda
 
 #endif // _GAUGE_QUDA_H
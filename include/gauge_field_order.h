@@ -2162,22 +2162,44 @@ namespace quda {
         __host__ __device__ real &operator[](int i) { return v[i]; }
       };
 
+      /**
+         @brief Number of reals stored per matrix by a legacy-ordered
+         field: only reconstruct-12 and reconstruct-8 are supported
+         for host fields, anything else is stored in full
+         @param[in] recon Reconstruct type
+         @param[in] N Number of reals in the full matrix
+      */
+      constexpr int legacy_recon_length(QudaReconstructType recon, int N)
+      {
+        return (recon == QUDA_RECONSTRUCT_12 || recon == QUDA_RECONSTRUCT_8) ? static_cast<int>(recon) : N;
+      }
+
       /**
          @brief The LegacyOrder defines the ghost zone storage and ordering for
          all cpuGaugeFields, which use the same ghost zone storage.
+         @tparam Float Storage format (e.g., double, float)
+         @tparam length Number of real numbers in each gauge matrix
+         @tparam reconLenParam Number of real numbers stored for each
+         gauge matrix (12 or 8 for compressed fields, which are
+         reconstructed on load using the Reconstruct helpers)
       */
-      template <typename Float, int length> struct LegacyOrder {
-        using Accessor = LegacyOrder<Float, length>;
+      template <typename Float, int length, int reconLenParam = length> struct LegacyOrder {
+        using Accessor = LegacyOrder<Float, length, reconLenParam>;
         using real = typename mapper<Float>::type;
         using complex = complex<real>;
+        static constexpr int reconLen = reconLenParam;
+        Reconstruct<reconLen, Float, QUDA_GHOST_EXCHANGE_INVALID> reconstruct;
         Float *ghost[QUDA_MAX_DIM];
         int faceVolumeCB[QUDA_MAX_DIM];
+        int X[QUDA_MAX_DIM];
+        int R[QUDA_MAX_DIM];
         const int volumeCB;
         const int stride;
         const int geometry;
         const int hasPhase;
 
         LegacyOrder(const GaugeField &u, Float **ghost_) :
+          reconstruct(u),
           volumeCB(u.VolumeCB()),
           stride(u.Stride()),
           geometry(u.Geometry()),
@@ -2189,10 +2211,13 @@ namespace quda {
           for (int i = 0; i < 4; i++) {
             ghost[i] = (ghost_) ? ghost_[i] : (Float *)(u.Ghost()[i]);
             faceVolumeCB[i] = u.SurfaceCB(i) * u.Nface(); // face volume equals surface * depth
+            X[i] = u.X()[i];
+            R[i] = u.R()[i];
           }
         }
 
         LegacyOrder(const LegacyOrder &order) :
+          reconstruct(order.reconstruct),
           volumeCB(order.volumeCB),
           stride(order.stride),
           geometry(order.geometry),
@@ -2201,38 +2226,95 @@ namespace quda {
           for (int i = 0; i < 4; i++) {
             ghost[i] = order.ghost[i];
             faceVolumeCB[i] = order.faceVolumeCB[i];
+            X[i] = order.X[i];
+            R[i] = order.R[i];
+          }
+        }
+
+        template <typename V>
+        __device__ __host__ inline void unpack(complex v[length / 2], const V &v_, int, int, std::true_type) const
+        {
+          for (int i = 0; i < length / 2; i++) v[i] = complex(v_[2 * i + 0], v_[2 * i + 1]);
+        }
+
+        template <typename V>
+        __device__ __host__ inline void unpack(complex v[length / 2], const V &v_, int idx, int dir,
+                                               std::false_type) const
+        {
+          real tmp[reconLen];
+#pragma unroll
+          for (int i = 0; i < reconLen; i++) tmp[i] = v_[i];
+          reconstruct.Unpack(v, tmp, idx, dir, 0, X, R);
+        }
+
+        /**
+           @brief Unpack a gauge matrix from its stored reals,
+           reconstructing it in registers if the field is compressed
+           @param[out] v The unpacked gauge matrix
+           @param[in] v_ The stored reals
+           @param[in] idx Checkerboard index used for the boundary condition
+           @param[in] dir Link direction
+        */
+        template <typename V>
+        __device__ __host__ inline void unpack(complex v[length / 2], const V &v_, int idx, int dir) const
+        {
+          unpack(v, v_, idx, dir, std::integral_constant<bool, reconLen == length>());
+        }
+
+        template <typename V>
+        __device__ __host__ inline void pack(V &v_, const complex v[length / 2], int, std::true_type) const
+        {
+          for (int i = 0; i < length / 2; i++) {
+            v_[2 * i + 0] = (Float)v[i].real();
+            v_[2 * i + 1] = (Float)v[i].imag();
           }
         }
 
+        template <typename V>
+        __device__ __host__ inline void pack(V &v_, const complex v[length / 2], int idx, std::false_type) const
+        {
+          real tmp[reconLen];
+          reconstruct.Pack(tmp, v, idx);
+#pragma unroll
+          for (int i = 0; i < reconLen; i++) v_[i] = (Float)tmp[i];
+        }
+
+        /**
+           @brief Pack a gauge matrix into its stored reals, compressing
+           it if the field is compressed
+           @param[out] v_ The stored reals
+           @param[in] v The gauge matrix
+           @param[in] idx Checkerboard index
+        */
+        template <typename V> __device__ __host__ inline void pack(V &v_, const complex v[length / 2], int idx) const
+        {
+          pack(v_, v, idx, std::integral_constant<bool, reconLen == length>());
+        }
+
         __device__ __host__ inline void loadGhost(complex v[length / 2], int x, int dir, int parity, real phase = 1.0) const
         {
 #if defined( __CUDA_ARCH__) && !defined(DISABLE_TROVE)
-          typedef S<Float, length> structure;
+          typedef S<Float, reconLen> structure;
           trove::coalesced_ptr<structure> ghost_((structure *)ghost[dir]);
           structure v_ = ghost_[parity * faceVolumeCB[dir] + x];
 #else
-          auto v_ = &ghost[dir][(parity * faceVolumeCB[dir] + x) * length];
+          auto v_ = &ghost[dir][(parity * faceVolumeCB[dir] + x) * reconLen];
 #endif
-          for (int i = 0; i < length / 2; i++) v[i] = complex(v_[2 * i + 0], v_[2 * i + 1]);
+          // an offset of volumeCB places the ghost in the pad region for the boundary condition
+          unpack(v, v_, volumeCB + x, dir);
         }
 
         __device__ __host__ inline void saveGhost(const complex v[length / 2], int x, int dir, int parity)
         {
 #if defined( __CUDA_ARCH__) && !defined(DISABLE_TROVE)
-          typedef S<Float, length> structure;
+          typedef S<Float, reconLen> structure;
           trove::coalesced_ptr<structure> ghost_((structure *)ghost[dir]);
           structure v_;
-          for (int i = 0; i < length / 2; i++) {
-            v_[2 * i + 0] = (Float)v[i].real();
-            v_[2 * i + 1] = (Float)v[i].imag();
-          }
+          pack(v_, v, volumeCB + x);
           ghost_[parity * faceVolumeCB[dir] + x] = v_;
 #else
-          auto v_ = &ghost[dir][(parity * faceVolumeCB[dir] + x) * length];
-          for (int i = 0; i < length / 2; i++) {
-            v_[2 * i + 0] = (Float)v[i].real();
-            v_[2 * i + 1] = (Float)v[i].imag();
-          }
+          auto v_ = &ghost[dir][(parity * faceVolumeCB[dir] + x) * reconLen];
+          pack(v_, v, volumeCB + x);
 #endif
         }
 
@@ -2268,37 +2350,31 @@ namespace quda {
           return gauge_ghost_wrapper<real, Accessor>(const_cast<Accessor &>(*this), dim, ghost_idx, parity, phase);
         }
 
-        __device__ __host__ inline void loadGhostEx(complex v[length / 2], int x, int dummy, int dir, int dim, int g,
-                                                    int parity, const int R[]) const
+        __device__ __host__ inline void loadGhostEx(complex v[length / 2], int x, int extended_idx, int dir, int dim,
+                                                    int g, int parity, const int R[]) const
         {
 #if defined( __CUDA_ARCH__) && !defined(DISABLE_TROVE)
-	typedef S<Float,length> structure;
+	typedef S<Float,reconLen> structure;
 	trove::coalesced_ptr<structure> ghost_((structure*)ghost[dim]);
 	structure v_ = ghost_[((dir*2+parity)*R[dim]*faceVolumeCB[dim] + x)*geometry+g];
 #else
-          auto v_ = &ghost[dim][(((dir * 2 + parity) * R[dim] * faceVolumeCB[dim] + x) * geometry + g) * length];
+          auto v_ = &ghost[dim][(((dir * 2 + parity) * R[dim] * faceVolumeCB[dim] + x) * geometry + g) * reconLen];
 #endif
-        for (int i = 0; i < length / 2; i++) v[i] = complex(v_[2 * i + 0], v_[2 * i + 1]);
+          unpack(v, v_, extended_idx, g);
         }
 
-        __device__ __host__ inline void saveGhostEx(const complex v[length / 2], int x, int dummy, int dir, int dim,
-                                                    int g, int parity, const int R[])
+        __device__ __host__ inline void saveGhostEx(const complex v[length / 2], int x, int extended_idx, int dir,
+                                                    int dim, int g, int parity, const int R[])
         {
 #if defined( __CUDA_ARCH__) && !defined(DISABLE_TROVE)
-          typedef S<Float, length> structure;
+          typedef S<Float, reconLen> structure;
           trove::coalesced_ptr<structure> ghost_((structure *)ghost[dim]);
           structure v_;
-          for (int i = 0; i < length / 2; i++) {
-            v_[2 * i + 0] = (Float)v[i].real();
-            v_[2 * i + 1] = (Float)v[i].imag();
-          }
+          pack(v_, v, extended_idx);
           ghost_[((dir * 2 + parity) * R[dim] * faceVolumeCB[dim] + x) * geometry + g] = v_;
 #else
-          auto v_ = &ghost[dim][(((dir * 2 + parity) * R[dim] * faceVolumeCB[dim] + x) * geometry + g) * length];
-          for (int i = 0; i < length / 2; i++) {
-            v_[2 * i + 0] = (Float)v[i].real();
-            v_[2 * i + 1] = (Float)v[i].imag();
-          }
+          auto v_ = &ghost[dim][(((dir * 2 + parity) * R[dim] * faceVolumeCB[dim] + x) * geometry + g) * reconLen];
+          pack(v_, v, extended_idx);
 #endif
         }
       };
@@ -2306,49 +2382,47 @@ namespace quda {
     /**
        struct to define QDP ordered gauge fields:
        [[dim]] [[parity][volumecb][row][col]]
+       where compressed fields store only the first reconLenParam
+       reals of each matrix
     */
-    template <typename Float, int length> struct QDPOrder : public LegacyOrder<Float,length> {
-      using Accessor = QDPOrder<Float, length>;
+    template <typename Float, int length, int reconLenParam = length>
+    struct QDPOrder : public LegacyOrder<Float, length, reconLenParam> {
+      using Accessor = QDPOrder<Float, length, reconLenParam>;
       using real = typename mapper<Float>::type;
       using complex = complex<real>;
+      static constexpr int reconLen = reconLenParam;
       Float *gauge[QUDA_MAX_DIM];
       const int volumeCB;
     QDPOrder(const GaugeField &u, Float *gauge_=0, Float **ghost_=0)
-      : LegacyOrder<Float,length>(u, ghost_), volumeCB(u.VolumeCB())
+      : LegacyOrder<Float,length,reconLen>(u, ghost_), volumeCB(u.VolumeCB())
 	{ for (int i=0; i<4; i++) gauge[i] = gauge_ ? ((Float**)gauge_)[i] : ((Float**)u.Gauge_p())[i]; }
-    QDPOrder(const QDPOrder &order) : LegacyOrder<Float,length>(order), volumeCB(order.volumeCB) {
+    QDPOrder(const QDPOrder &order) : LegacyOrder<Float,length,reconLen>(order), volumeCB(order.volumeCB) {
 	for(int i=0; i<4; i++) gauge[i] = order.gauge[i];
       }
 
       __device__ __host__ inline void load(complex v[length / 2], int x, int dir, int parity, real inphase = 1.0) const
       {
 #if defined( __CUDA_ARCH__) && !defined(DISABLE_TROVE)
-	typedef S<Float,length> structure;
+	typedef S<Float,reconLen> structure;
 	trove::coalesced_ptr<structure> gauge_((structure*)gauge[dir]);
 	structure v_ = gauge_[parity*volumeCB + x];
 #else
-        auto v_ = &gauge[dir][(parity * volumeCB + x) * length];
+        auto v_ = &gauge[dir][(parity * volumeCB + x) * reconLen];
 #endif
-        for (int i = 0; i < length / 2; i++) v[i] = complex(v_[2 * i + 0], v_[2 * i + 1]);
+        this->unpack(v, v_, x, dir);
       }
 
       __device__ __host__ inline void save(const complex v[length / 2], int x, int dir, int parity)
       {
 #if defined( __CUDA_ARCH__) && !defined(DISABLE_TROVE)
-	typedef S<Float,length> structure;
+	typedef S<Float,reconLen> structure;
 	trove::coalesced_ptr<structure> gauge_((structure*)gauge[dir]);
 	structure v_;
-        for (int i = 0; i < length / 2; i++) {
-          v_[2 * i + 0] = (Float)v[i].real();
-          v_[2 * i + 1] = (Float)v[i].imag();
-        }
+        this->pack(v_, v, x);
         gauge_[parity * volumeCB + x] = v_;
 #else
-        auto v_ = &gauge[dir][(parity * volumeCB + x) * length];
-        for (int i = 0; i < length / 2; i++) {
-          v_[2 * i + 0] = (Float)v[i].real();
-          v_[2 * i + 1] = (Float)v[i].imag();
-        }
+        auto v_ = &gauge[dir][(parity * volumeCB + x) * reconLen];
+        this->pack(v_, v, x);
 #endif
       }
 
@@ -2379,10 +2453,10 @@ namespace quda {
        */
       __device__ __host__ inline const gauge_wrapper<real, Accessor> operator()(int dim, int x_cb, int parity) const
       {
-        return gauge_wrapper<real, QDPOrder<Float, length>>(const_cast<Accessor &>(*this), dim, x_cb, parity);
+        return gauge_wrapper<real, Accessor>(const_cast<Accessor &>(*this), dim, x_cb, parity);
       }
 
-      size_t Bytes() const { return length * sizeof(Float); }
+      size_t Bytes() const { return reconLen * sizeof(Float); }
     };
 
     /**
@@ -2454,50 +2528,48 @@ namespace quda {
   /**
      struct to define MILC ordered gauge fields:
      [parity][dim][volumecb][row][col]
+     where compressed fields store only the first reconLenParam reals
+     of each matrix
   */
-  template <typename Float, int length> struct MILCOrder : public LegacyOrder<Float,length> {
-    using Accessor = MILCOrder<Float, length>;
+  template <typename Float, int length, int reconLenParam = length>
+  struct MILCOrder : public LegacyOrder<Float, length, reconLenParam> {
+    using Accessor = MILCOrder<Float, length, reconLenParam>;
     using real = typename mapper<Float>::type;
     using complex = complex<real>;
+    static constexpr int reconLen = reconLenParam;
     Float *gauge;
     const int volumeCB;
     const int geometry;
   MILCOrder(const GaugeField &u, Float *gauge_=0, Float **ghost_=0) :
-    LegacyOrder<Float,length>(u, ghost_), gauge(gauge_ ? gauge_ : (Float*)u.Gauge_p()),
+    LegacyOrder<Float,length,reconLen>(u, ghost_), gauge(gauge_ ? gauge_ : (Float*)u.Gauge_p()),
       volumeCB(u.VolumeCB()), geometry(u.Geometry()) { ; }
-  MILCOrder(const MILCOrder &order) : LegacyOrder<Float,length>(order),
+  MILCOrder(const MILCOrder &order) : LegacyOrder<Float,length,reconLen>(order),
       gauge(order.gauge), volumeCB(order.volumeCB), geometry(order.geometry)
       { ; }
 
       __device__ __host__ inline void load(complex v[length / 2], int x, int dir, int parity, real inphase = 1.0) const
       {
 #if defined( __CUDA_ARCH__) && !defined(DISABLE_TROVE)
-      typedef S<Float,length> structure;
+      typedef S<Float,reconLen> structure;
       trove::coalesced_ptr<structure> gauge_((structure*)gauge);
       structure v_ = gauge_[(parity*volumeCB+x)*geometry + dir];
 #else
-        auto v_ = &gauge[((parity * volumeCB + x) * geometry + dir) * length];
+        auto v_ = &gauge[((parity * volumeCB + x) * geometry + dir) * reconLen];
 #endif
-      for (int i = 0; i < length / 2; i++) v[i] = complex(v_[2 * i + 0], v_[2 * i + 1]);
+      this->unpack(v, v_, x, dir);
     }
 
     __device__ __host__ inline void save(const complex v[length / 2], int x, int dir, int parity)
     {
 #if defined( __CUDA_ARCH__) && !defined(DISABLE_TROVE)
-      typedef S<Float,length> structure;
+      typedef S<Float,reconLen> structure;
       trove::coalesced_ptr<structure> gauge_((structure*)gauge);
       structure v_;
-      for (int i = 0; i < length / 2; i++) {
-        v_[2 * i + 0] = v[i].real();
-        v_[2 * i + 1] = v[i].imag();
-      }
+      this->pack(v_, v, x);
       gauge_[(parity*volumeCB+x)*geometry + dir] = v_;
 #else
-      auto v_ = &gauge[((parity * volumeCB + x) * geometry + dir) * length];
-      for (int i = 0; i < length / 2; i++) {
-        v_[2 * i + 0] = v[i].real();
-        v_[2 * i + 1] = v[i].imag();
-      }
+      auto v_ = &gauge[((parity * volumeCB + x) * geometry + dir) * reconLen];
+      this->pack(v_, v, x);
 #endif
     }
 
@@ -2528,10 +2600,10 @@ namespace quda {
     */
     __device__ __host__ inline const gauge_wrapper<real, Accessor> operator()(int dim, int x_cb, int parity) const
     {
-      return gauge_wrapper<real, MILCOrder<Float, length>>(const_cast<Accessor &>(*this), dim, x_cb, parity);
+      return gauge_wrapper<real, Accessor>(const_cast<Accessor &>(*this), dim, x_cb, parity);
     }
 
-    size_t Bytes() const { return length * sizeof(Float); }
+    size_t Bytes() const { return reconLen * sizeof(Float); }
   };
 
   /**
@@ -3251,15 +3323,24 @@ namespace quda {
   template <typename T, QudaReconstructType recon, int N, QudaStaggeredPhase stag, bool huge_alloc,
             QudaGhostExchange ghostExchange, bool use_inphase>
   struct gauge_mapper<T, recon, N, stag, huge_alloc, ghostExchange, use_inphase, QUDA_MILC_GAUGE_ORDER> {
-    typedef gauge::MILCOrder<T, N> type;
+    typedef gauge::MILCOrder<T, N, gauge::legacy_recon_length(recon, N)> type;
   };
 
   template <typename T, QudaReconstructType recon, int N, QudaStaggeredPhase stag, bool huge_alloc,
             QudaGhostExchange ghostExchange, bool use_inphase>
   struct gauge_mapper<T, recon, N, stag, huge_alloc, ghostExchange, use_inphase, QUDA_QDP_GAUGE_ORDER> {
-    typedef gauge::QDPOrder<T, N> type;
+    typedef gauge::QDPOrder<T, N, gauge::legacy_recon_length(recon, N)> type;
   };
 
+  /**
+     @brief Shorthand for the accessor of a gauge field in a given
+     order, where QUDA_NATIVE_GAUGE_ORDER selects the device order and
+     QUDA_QDP_GAUGE_ORDER the order of host fields
+  */
+  template <typename T, QudaReconstructType recon, QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
+  using gauge_accessor_t = typename gauge_mapper<T, recon, 18, QUDA_STAGGERED_PHASE_NO, gauge::default_huge_alloc,
+                                                 QUDA_GHOST_EXCHANGE_INVALID, false, order>::type;
+
   template<typename T, QudaGaugeFieldOrder order, int Nc> struct gauge_order_mapper { };
   template<typename T, int Nc> struct gauge_order_mapper<T,QUDA_QDP_GAUGE_ORDER,Nc> { typedef gauge::QDPOrder<T, 2*Nc*Nc> type; };
   template<typename T, int Nc> struct gauge_order_mapper<T,QUDA_QDPJIT_GAUGE_ORDER,Nc> { typedef gauge::QDPJITOrder<T, 2*Nc*Nc> type; };
@@ -1,3 +1,4 @@
+#include <vector>
 #include <random_quda.h>
 
 namespace quda
@@ -33,6 +34,37 @@ namespace quda
    */
   double3 plaquette(const GaugeField &U);
 
+  /**
+     @brief Compute the plaquette, clover-leaf field energy and
+     topological charge in a single sweep over the extended gauge
+     field, forming the field strength in registers rather than
+     materializing the Fmunu tensor.  Runs on device fields and, with
+     host threads, on QDP-ordered host fields.
+
+     @param[in] u The extended gauge field
+     @param[out] plaq The total, spatial and temporal plaquette, normalized as in plaquette()
+     @param[out] energy The total, spatial and temporal field energy
+     @param[out] qcharge The total topological charge
+     @param[out] qdensity Optional topological charge at each lattice
+     site, in the precision and location of u (nullptr if not wanted)
+   */
+  void computeGaugeObservables(const GaugeField &u, double plaq[3], double energy[3], double &qcharge,
+                               void *qdensity = nullptr);
+
+  /**
+     @brief Reduce the observables summed over the local lattice by a
+     fused observables kernel over all processes and normalize them as
+     computeGaugeObservables() does
+
+     @param[in] u The extended gauge field they were measured on
+     @param[in,out] obs The local sums of the spatial and temporal
+     plaquette and field energy and of the topological charge (summed over all processes on exit)
+     @param[out] plaq The total, spatial and temporal plaquette
+     @param[out] energy The total, spatial and temporal field energy
+     @param[out] qcharge The total topological charge
+   */
+  void completeGaugeObservables(const GaugeField &u, double obs[5], double plaq[3], double energy[3], double &qcharge);
+
   /**
      @brief Generate Gaussian distributed su(N) or SU(N) fields.  If U
      is a momentum field, then we generate random Gaussian distributed
@@ -41,10 +73,12 @@ namespace quda
      field and exponentiate it, e.g., U = exp(sigma * H), where H is
      the distributed su(n) field and sigma is the width of the
      distribution (sigma = 0 results in a free field, and sigma = 1 has
-     maximum disorder).
+     maximum disorder).  Device fields must be in native order and
+     host fields in QDP order; both give the same field for a given
+     generator.
 
      @param[out] U The output gauge field
-     @param[in] rngstate random states
+     @param[in,out] rngstate random number generator
      @param[in] sigma Width of Gaussian distrubution
   */
 
@@ -97,18 +131,49 @@ namespace quda
 
   /**
      @brief Apply Wilson Flow steps W1, W2, Vt to the gauge field.
-     This routine assumes that the input and output fields are
-     extended, with the input field being exchanged prior to calling
-     this function.  On exit from this routine, the output field will
-     have been exchanged.
+     This routine assumes that the input, output and temporary fields
+     are extended alike, with the input field being exchanged prior to
+     calling this function.  On exit from this routine, the output
+     field will have been exchanged, and the input field overwritten.
      @param[out] dataDs Output smeared field
      @param[in] dataTemp Temp space
-     @param[in] dataOr Input gauge field
+     @param[in,out] dataOr Input gauge field
      @param[in] epsilon Step size
      @param[in] wflow_type Wilson (1x1) or Symanzik improved (2x1) staples
   */
   void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in, double epsilon, QudaWFlowType wflow_type);
 
+  /**
+     @brief Observables of the gauge field at a given flow time
+  */
+  struct WFlowObservables {
+    double t;            // flow time
+    double plaquette[3]; // total, spatial and temporal plaquette
+    double energy[3];    // total, spatial and temporal field energy
+    double qcharge;      // topological charge
+  };
+
+  /**
+     @brief Integrate the gradient flow of the gauge field up to flow
+     time t_max.  Ghost exchanges are skipped where the halo of the
+     extended field still holds valid links from the previous
+     substep, and the measurements are fused with the first substep
+     of the following step.  With a nonzero tolerance, the step size
+     is adapted: each step is compared with an embedded second-order
+     update, and is repeated with a smaller step size if the RMS
+     distance between the two over all links exceeds the tolerance.
+     @param[in,out] u Extended and exchanged gauge field, flowed in place
+     @param[in] epsilon Step size, or initial step size if adaptive
+     @param[in] t_max Flow time to integrate to
+     @param[in] wflow_type Wilson (1x1) or Symanzik improved (2x1) staples
+     @param[in] tol Tolerance for adaptive step size (zero for fixed step size)
+     @param[in] meas_interval Measure the observables at t=0 and after
+     every meas_interval steps (zero for no measurements)
+     @return The measurements made
+  */
+  std::vector<WFlowObservables> WFlowIntegrate(GaugeField &u, double epsilon, double t_max, QudaWFlowType wflow_type,
+                                               double tol = 0.0, int meas_interval = 0);
+
   /**
    * @brief Gauge fixing with overrelaxation with support for single and multi GPU.
    * @param[in,out] data, quda gauge field
@@ -459,6 +459,8 @@ namespace quda {
 
   };
 
+  class CompressedDeflationSpace;
+
   class Solver {
 
   protected:
@@ -476,6 +478,7 @@ namespace quda {
     bool recompute_evals;   /** If true, instruct the solver to recompute evals from an existing deflation space. */
     std::vector<ColorSpinorField *> evecs;     /** Holds the eigenvectors. */
     std::vector<Complex> evals;                /** Holds the eigenvalues. */
+    CompressedDeflationSpace *evecs_compressed; /** Holds the eigenvectors in compressed form (if enabled). */
 
   public:
     Solver(const DiracMatrix &mat, const DiracMatrix &matSloppy, const DiracMatrix &matPrecon,
@@ -563,6 +566,14 @@ namespace quda {
     */
     void PrintSummary(const char *name, int k, double r2, double b2, double r2_tol, double hq_tol);
 
+    /**
+       @brief As above, for solvers that reset blas::flops before
+       printing their summary
+       @param[in] blas_flops The blas flops of the solve
+    */
+    void PrintSummary(const char *name, int k, double r2, double b2, double r2_tol, double hq_tol,
+                      unsigned long long blas_flops);
+
     /**
        @brief Constructs the deflation space and eigensolver
        @param[in] meta A sample ColorSpinorField with which to instantiate
@@ -582,6 +593,28 @@ namespace quda {
     */
     void extendSVDDeflationSpace();
 
+    /**
+       @brief Replaces the eigenvectors with their compressed
+       representation if compress_deflation is requested and this has
+       not already been done.  The uncompressed eigenvectors are freed.
+    */
+    void compressDeflationSpace();
+
+    /**
+       @brief Recompute the eigenvalues of the deflation space,
+       whether it is stored compressed or not
+    */
+    void computeDeflationEvals();
+
+    /**
+       @brief Deflate the source vector using the deflation space,
+       whether it is stored compressed or not
+       @param[in,out] sol The deflated solution vector
+       @param[in] src The vector to deflate
+       @param[in] accumulate Whether to accumulate onto or overwrite sol
+    */
+    void deflate(ColorSpinorField &sol, const ColorSpinorField &src, bool accumulate);
+
     /**
        @brief Injects a deflation space into the solver from the
        vector argument.  Note the input space is reduced to zero size as a
@@ -605,7 +638,13 @@ namespace quda {
     /**
        @brief Returns the size of deflation space
     */
-    int deflationSpaceSize() const { return (int)evecs.size(); };
+    int deflationSpaceSize() const;
+
+    /**
+       @brief Returns the uncompressed deflation space (empty if the
+       space is held compressed or has not been constructed)
+    */
+    const std::vector<ColorSpinorField *> &deflationSpace() const { return evecs; }
 
     /**
        @brief Sets the deflation compute boolean
@@ -632,9 +671,9 @@ namespace quda {
   class CG : public Solver {
 
   private:
-    // pointers to fields to avoid multiple creation overhead
+    // pointers to fields to avoid multiple creation overhead in the block solver (the
+    // single right-hand-side solver checks its temporaries out of the workspace)
     ColorSpinorField *yp, *rp, *rnewp, *pp, *App, *tmpp, *tmp2p, *tmp3p, *rSloppyp, *xSloppyp;
-    std::vector<ColorSpinorField*> p;
     bool init;
 
   public:
@@ -799,11 +838,6 @@ namespace quda {
 
   class BiCGstab : public Solver {
 
-  private:
-    // pointers to fields to avoid multiple creation overhead
-    ColorSpinorField *yp, *rp, *pp, *vp, *tmpp, *tp;
-    bool init;
-
   public:
     BiCGstab(const DiracMatrix &mat, const DiracMatrix &matSloppy, const DiracMatrix &matPrecon,
              const DiracMatrix &matEig, SolverParam &param, TimeProfile &profile);
@@ -922,11 +956,7 @@ namespace quda {
     Complex **beta;
     double *gamma;
 
-    /**
-       Solver uses lazy allocation: this flag to determine whether we have allocated.
-     */
-    bool init;
-
+    // fields checked out of the workspace for the duration of a solve
     ColorSpinorField *rp;       //! residual vector
     ColorSpinorField *tmpp;     //! temporary for mat-vec
     ColorSpinorField *tmp_sloppy; //! temporary for sloppy mat-vec
@@ -935,6 +965,11 @@ namespace quda {
     std::vector<ColorSpinorField*> p;  // GCR direction vectors
     std::vector<ColorSpinorField*> Ap; // mat * direction vectors
 
+    /**
+       @brief Return the fields to the workspace at the end of a solve
+    */
+    void release();
+
   public:
     GCR(const DiracMatrix &mat, const DiracMatrix &matSloppy, const DiracMatrix &matPrecon, const DiracMatrix &matEig,
         SolverParam &param, TimeProfile &profile);
@@ -951,17 +986,13 @@ namespace quda {
     virtual bool hermitian() { return false; } /** GCR is for any linear system */
   };
 
+  /**
+     @brief Minimal residual solver.  Its temporaries are checked out
+     of the workspace arena for the duration of each solve, so the
+     pre- and post-smoothers of every multigrid level share storage.
+   */
   class MR : public Solver {
 
-  private:
-    ColorSpinorField *rp;
-    ColorSpinorField *r_sloppy;
-    ColorSpinorField *Arp;
-    ColorSpinorField *tmpp;
-    ColorSpinorField *tmp_sloppy;
-    ColorSpinorField *x_sloppy;
-    bool init;
-
   public:
     MR(const DiracMatrix &mat, const DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile);
     virtual ~MR();
@@ -1443,6 +1474,7 @@ public:
     bool svd;                              /** Whether this space is for an SVD deflaton */
     std::vector<ColorSpinorField *> evecs; /** Container for the eigenvectors */
     std::vector<Complex> evals;            /** The eigenvalues */
+    CompressedDeflationSpace *compressed = nullptr; /** The compressed eigenvectors (if compression is enabled) */
   };
 
 } // namespace quda
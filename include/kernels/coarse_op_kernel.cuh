@@ -146,6 +146,31 @@ namespace quda {
     }
   };
 
+  /**
+     @brief Owner-computes traversal used by the host coarse-operator
+     build.  Threads are partitioned over coarse aggregates, so each
+     thread owns whole coarse sites and can accumulate into Y / X
+     without atomics, giving results independent of the thread count.
+     Within each aggregate the fine sites are visited in the order
+     given by the coarse_to_fine map (parity ordered, lexicographic
+     within the block), so the working set of an aggregate stays in
+     cache.
+     @param[in] arg Kernel argument
+     @param[in] f Functor applied to each fine site (parity, x_cb)
+   */
+  template <typename Arg, typename Functor> inline void forEachAggregateCPU(const Arg &arg, Functor f)
+  {
+    const int aggregate_size = arg.fineVolumeCB / arg.coarseVolumeCB; // fine sites per aggregate
+#pragma omp parallel for schedule(static)
+    for (int x_coarse = 0; x_coarse < 2 * arg.coarseVolumeCB; x_coarse++) {
+      for (int k = 0; k < aggregate_size; k++) {
+        const int x_fine = arg.coarse_to_fine[x_coarse * aggregate_size + k];
+        const int parity = x_fine >= arg.fineVolumeCB ? 1 : 0;
+        f(parity, x_fine - parity * arg.fineVolumeCB);
+      }
+    }
+  }
+
   /**
      Calculates the matrix UV^{s,c'}_mu(x) = \sum_c U^{c}_mu(x) * V^{s,c}_mu(x+mu)
      Where: mu = dir, s = fine spin, c' = coarse color, c = fine color
@@ -239,17 +264,14 @@ namespace quda {
   void ComputeUVCPU(Arg &arg)
   {
     using TileType = typename Arg::uvTileType;
-    for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
-      for (int x_cb=0; x_cb<arg.fineVolumeCB; x_cb++) {
-        for (int ic = 0; ic < TileType::m; ic += TileType::M)   // fine color
-          for (int jc = 0; jc < TileType::n; jc += TileType::N) // coarse color
-            if (dir == QUDA_FORWARDS) // only for preconditioned clover is V != AV, will need extra logic for staggered KD
-              computeUV<dim,dir>(arg, arg.V, parity, x_cb, ic, jc);
-            else
-              computeUV<dim,dir>(arg, arg.AV, parity, x_cb, ic, jc);
-      } // c/b volume
-    }   // parity
+    forEachAggregateCPU(arg, [&](int parity, int x_cb) {
+      for (int ic = 0; ic < TileType::m; ic += TileType::M)   // fine color
+        for (int jc = 0; jc < TileType::n; jc += TileType::N) // coarse color
+          if (dir == QUDA_FORWARDS) // only for preconditioned clover is V != AV, will need extra logic for staggered KD
+            computeUV<dim, dir>(arg, arg.V, parity, x_cb, ic, jc);
+          else
+            computeUV<dim, dir>(arg, arg.AV, parity, x_cb, ic, jc);
+    });
   }
 
   template<int dim, QudaDirection dir, typename Arg>
@@ -1001,17 +1023,14 @@ namespace quda {
   {
     using Float = typename Arg::Float;
     Gamma<Float, QUDA_DEGRAND_ROSSI_GAMMA_BASIS, dim> gamma;
-    constexpr bool shared_atomic = false; // not supported on CPU
+    constexpr bool shared_atomic = false; // not needed since each thread owns its coarse sites
     constexpr bool parity_flip = true;
 
-    for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
-      for (int x_cb=0; x_cb<arg.fineVolumeCB; x_cb++) { // Loop over fine volume
-	for (int ic=0; ic<arg.vuvTile.m; ic+=arg.vuvTile.M)
-	  for (int jc=0; jc<arg.vuvTile.n; jc+=arg.vuvTile.N)
-	    computeVUV<shared_atomic,parity_flip,dim,dir>(arg, gamma, parity, x_cb, ic, jc, 0, 0);
-      } // c/b volume
-    } // parity
+    forEachAggregateCPU(arg, [&](int parity, int x_cb) {
+      for (int ic = 0; ic < arg.vuvTile.m; ic += arg.vuvTile.M)
+        for (int jc = 0; jc < arg.vuvTile.n; jc += arg.vuvTile.N)
+          computeVUV<shared_atomic, parity_flip, dim, dir>(arg, gamma, parity, x_cb, ic, jc, 0, 0);
+    });
   }
 
   template<bool shared_atomic, bool parity_flip, int dim, QudaDirection dir,
@@ -1162,16 +1181,11 @@ namespace quda {
 
   template <typename Arg>
   void ComputeCoarseCloverCPU(Arg &arg) {
-    for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
-      for (int x_cb=0; x_cb<arg.fineVolumeCB; x_cb++) {
-        for (int jc_c=0; jc_c<Arg::coarseColor; jc_c++) {
-          for (int ic_c=0; ic_c<Arg::coarseColor; ic_c++) {
-            computeCoarseClover(arg, parity, x_cb, ic_c, jc_c);
-          }
-        }
-      } // c/b volume
-    } // parity
+    forEachAggregateCPU(arg, [&](int parity, int x_cb) {
+      for (int jc_c = 0; jc_c < Arg::coarseColor; jc_c++) {
+        for (int ic_c = 0; ic_c < Arg::coarseColor; ic_c++) { computeCoarseClover(arg, parity, x_cb, ic_c, jc_c); }
+      }
+    });
   }
 
   template <typename Arg>
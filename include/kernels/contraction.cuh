@@ -1,10 +1,14 @@
 #pragma once
 
+#include <vector>
+
 #include <color_spinor_field_order.h>
 #include <index_helper.cuh>
 #include <quda_matrix.h>
 #include <matrix_field.h>
 #include <su3_project.cuh>
+#include <cub_helper.cuh>
+#include <atomic.cuh>
 
 namespace quda
 {
@@ -62,32 +66,19 @@ namespace quda
     arg.s.save(A, x_cb, parity);
   }
 
-  template <typename real, typename Arg> __global__ void computeDegrandRossiContraction(Arg arg)
+  /**
+     @brief Spin contract the open spin elementals with the 16 Dirac
+     structures in the DeGrand-Rossi basis
+     @param[out] A The 16 gamma projections, in the layout of enum_quda.h
+     @param[in] spin_elem The open spin elementals <x_mu | y_nu>
+  */
+  template <typename real, int nSpin>
+  __device__ __host__ inline void degrandRossiContract(complex<real> A[nSpin * nSpin],
+                                                       const complex<real> spin_elem[nSpin][nSpin])
   {
-    int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
-    int parity = threadIdx.y + blockIdx.y * blockDim.y;
-    const int nSpin = arg.nSpin;
-    const int nColor = arg.nColor;
-
-    if (x_cb >= arg.threads) return;
-
-    typedef ColorSpinor<real, nColor, nSpin> Vector;
-
-    Vector x = arg.x(x_cb, parity);
-    Vector y = arg.y(x_cb, parity);
-
     complex<real> I(0.0, 1.0);
-    complex<real> spin_elem[nSpin][nSpin];
     complex<real> result_local(0.0, 0.0);
 
-    // Color contract: <\phi(x)_{\mu} | \phi(y)_{\nu}>
-    // The Bra is conjugated
-    for (int mu = 0; mu < nSpin; mu++) {
-      for (int nu = 0; nu < nSpin; nu++) { spin_elem[mu][nu] = innerProduct(x, y, mu, nu); }
-    }
-
-    complex<real> A[nSpin * nSpin];
-
     // Spin contract: <\phi(x)_{\mu} \Gamma_{mu,nu}^{rho,tau} \phi(y)_{\nu}>
     // The rho index runs slowest.
     // Layout is defined in enum_quda.h: G_idx = 4*rho + tau
@@ -228,7 +219,528 @@ namespace quda
     result_local += spin_elem[2][2];
     result_local += spin_elem[3][3];
     A[G_idx++] = result_local;
+  }
+
+  template <typename real, typename Arg> __global__ void computeDegrandRossiContraction(Arg arg)
+  {
+    int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
+    int parity = threadIdx.y + blockIdx.y * blockDim.y;
+    const int nSpin = arg.nSpin;
+    const int nColor = arg.nColor;
+
+    if (x_cb >= arg.threads) return;
+
+    typedef ColorSpinor<real, nColor, nSpin> Vector;
+
+    Vector x = arg.x(x_cb, parity);
+    Vector y = arg.y(x_cb, parity);
+
+    complex<real> spin_elem[nSpin][nSpin];
+
+    // Color contract: <\phi(x)_{\mu} | \phi(y)_{\nu}>
+    // The Bra is conjugated
+    for (int mu = 0; mu < nSpin; mu++) {
+      for (int nu = 0; nu < nSpin; nu++) { spin_elem[mu][nu] = innerProduct(x, y, mu, nu); }
+    }
+
+    complex<real> A[nSpin * nSpin];
+    degrandRossiContract<real, nSpin>(A, spin_elem);
 
     arg.s.save(A, x_cb, parity);
   }
+
+  /**
+     Number of momenta handled by a single launch of the
+     momentum-projected contraction: this bounds the size of the
+     kernel argument, and longer lists are processed in batches
+  */
+  constexpr int contraction_ft_max_mom = 64;
+
+  /**
+     @brief Parameter structure for the contraction projected onto
+     spatial momenta and summed over timeslices.  The 16 contractions
+     of each site (open spin elementals or DeGrand-Rossi projections)
+     are multiplied by exp(-i p.x) for each momentum p and summed over
+     the timeslice, so only the n_mom x n_gamma correlator values of
+     each local timeslice are written out.
+   */
+  template <typename real_, typename F_, QudaContractType type_> struct ContractionFTArg {
+    using real = real_;
+    using F = F_;
+    static constexpr QudaContractType type = type_;
+    static constexpr int nSpin = 4;
+    static constexpr int nColor = 3;
+    using reduce_t = vector_type<double2, nSpin * nSpin>;
+
+    qudaError_t launch_error;
+    F x;
+    F y;
+    int X[4];         // local lattice dimensions
+    int offset[3];    // global coordinates of the local origin
+    int L[3];         // global spatial dimensions
+    int space_volume; // sites per local timeslice
+    int n_mom;
+    int mom[contraction_ft_max_mom][3];
+    int n_gamma;
+    int gamma[nSpin * nSpin];
+    double2 *result; // [t][mom][gamma] for the local timeslices
+
+    ContractionFTArg(const ColorSpinorField &x, const ColorSpinorField &y, const int *mom_, int n_mom,
+                     const int *gamma_, int n_gamma, double2 *result) :
+      launch_error(QUDA_ERROR_UNINITIALIZED),
+      x(x),
+      y(y),
+      n_mom(n_mom),
+      n_gamma(n_gamma),
+      result(result)
+    {
+      if (n_mom > contraction_ft_max_mom)
+        errorQuda("n_mom = %d exceeds the maximum %d", n_mom, contraction_ft_max_mom);
+      for (int dir = 0; dir < 4; dir++) X[dir] = x.X()[dir];
+      for (int dir = 0; dir < 3; dir++) {
+        offset[dir] = comm_coord(dir) * X[dir];
+        L[dir] = comm_dim(dir) * X[dir];
+      }
+      space_volume = X[0] * X[1] * X[2];
+      for (int i = 0; i < n_mom; i++)
+        for (int dir = 0; dir < 3; dir++) mom[i][dir] = mom_[3 * i + dir];
+      for (int i = 0; i < n_gamma; i++) gamma[i] = gamma_[i];
+    }
+  };
+
+  /**
+     @brief Compute the 16 contractions of x and y at a site of a
+     timeslice
+     @param[out] A The open spin elementals or DeGrand-Rossi projections
+     @param[out] coord The local coordinates of the site
+     @param[in] arg Kernel arguments
+     @param[in] idx The lexicographical index of the site in the timeslice
+     @param[in] t The local timeslice
+  */
+  template <typename Arg>
+  __device__ __host__ inline void contractSite(complex<typename Arg::real> A[Arg::nSpin * Arg::nSpin], int coord[4],
+                                               Arg &arg, int idx, int t)
+  {
+    using real = typename Arg::real;
+    constexpr int nSpin = Arg::nSpin;
+    typedef ColorSpinor<real, Arg::nColor, nSpin> Vector;
+
+    coord[0] = idx % arg.X[0];
+    coord[1] = (idx / arg.X[0]) % arg.X[1];
+    coord[2] = idx / (arg.X[0] * arg.X[1]);
+    coord[3] = t;
+    const int x_cb = (idx + t * arg.space_volume) >> 1;
+    const int parity = (coord[0] + coord[1] + coord[2] + coord[3]) & 1;
+
+    Vector x = arg.x(x_cb, parity);
+    Vector y = arg.y(x_cb, parity);
+
+    // Color contract: <\phi(x)_{\mu} | \phi(y)_{\nu}>
+    complex<real> spin_elem[nSpin][nSpin];
+#pragma unroll
+    for (int mu = 0; mu < nSpin; mu++) {
+#pragma unroll
+      for (int nu = 0; nu < nSpin; nu++) { spin_elem[mu][nu] = innerProduct(x, y, mu, nu); }
+    }
+
+    if (Arg::type == QUDA_CONTRACT_TYPE_DR) {
+      degrandRossiContract<real, nSpin>(A, spin_elem);
+    } else {
+#pragma unroll
+      for (int mu = 0; mu < nSpin; mu++) {
+#pragma unroll
+        for (int nu = 0; nu < nSpin; nu++) A[nSpin * mu + nu] = spin_elem[mu][nu];
+      }
+    }
+  }
+
+  /**
+     @brief The Fourier phase exp(-i p.x) of a momentum at a site.
+     Each p_i x_i is reduced modulo L_i in integer arithmetic, so the
+     phase is exact to rounding irrespective of the lattice size.
+     @param[in] arg Kernel arguments
+     @param[in] coord The local coordinates of the site
+     @param[in] mom The momentum index
+  */
+  template <typename Arg> __device__ __host__ inline double2 momentumPhase(const Arg &arg, const int coord[4], int mom)
+  {
+    double theta = 0.0;
+#pragma unroll
+    for (int dir = 0; dir < 3; dir++) {
+      int px = (arg.mom[mom][dir] * (coord[dir] + arg.offset[dir])) % arg.L[dir];
+      theta += static_cast<double>(px) / arg.L[dir];
+    }
+    double2 phase;
+    sincos(-2.0 * M_PI * theta, &phase.y, &phase.x);
+    return phase;
+  }
+
+  /**
+     @brief Device kernel: the x dimension of the grid runs over the
+     sites of a timeslice and the y dimension over local timeslices.
+     Each thread contracts its site once, and for each momentum the
+     thread block reduces the phased contractions before adding them
+     to the result, so the spinors are only read once.
+  */
+  template <int block_size, typename Arg> __global__ void computeContractionFT(Arg arg)
+  {
+    using real = typename Arg::real;
+    using reduce_t = typename Arg::reduce_t;
+    constexpr int n = Arg::nSpin * Arg::nSpin;
+    const int idx = threadIdx.x + blockIdx.x * blockDim.x;
+    const int t = blockIdx.y;
+    const bool active = idx < arg.space_volume;
+
+    complex<real> A[n];
+    int coord[4];
+    if (active) contractSite(A, coord, arg, idx, t);
+
+    using BlockReduce = cub::BlockReduce<reduce_t, block_size>;
+    __shared__ typename BlockReduce::TempStorage cub_tmp;
+
+    for (int mom = 0; mom < arg.n_mom; mom++) {
+      reduce_t value;
+      if (active) {
+        double2 phase = momentumPhase(arg, coord, mom);
+#pragma unroll
+        for (int i = 0; i < n; i++) {
+          value[i].x = phase.x * A[i].real() - phase.y * A[i].imag();
+          value[i].y = phase.x * A[i].imag() + phase.y * A[i].real();
+        }
+      }
+      reduce_t aggregate = BlockReduce(cub_tmp).Sum(value);
+
+      if (threadIdx.x == 0) {
+        for (int g = 0; g < arg.n_gamma; g++)
+          atomicAdd(arg.result + (t * arg.n_mom + mom) * arg.n_gamma + g, aggregate[arg.gamma[g]]);
+      }
+      __syncthreads(); // cub_tmp is reused by the next momentum
+    }
+  }
+
+  /**
+     @brief Host functor, run with launchHostReduceArray over the sites
+     and local timeslices: the contractions of each site are computed
+     once and accumulated into the correlators of every momentum.
+  */
+  template <typename Arg> struct ContractionFTHost {
+    Arg &arg;
+    ContractionFTHost(Arg &arg) : arg(arg) { }
+
+    __host__ inline void operator()(int idx, int t, int, double2 *sum) const
+    {
+      using real = typename Arg::real;
+      constexpr int n = Arg::nSpin * Arg::nSpin;
+      complex<real> A[n];
+      int coord[4];
+      contractSite(A, coord, arg, idx, t);
+
+      for (int mom = 0; mom < arg.n_mom; mom++) {
+        double2 phase = momentumPhase(arg, coord, mom);
+        double2 *s = sum + (t * arg.n_mom + mom) * arg.n_gamma;
+        for (int g = 0; g < arg.n_gamma; g++) {
+          const complex<real> &a = A[arg.gamma[g]];
+          s[g].x += phase.x * a.real() - phase.y * a.imag();
+          s[g].y += phase.x * a.imag() + phase.y * a.real();
+        }
+      }
+    }
+  };
+
+  /**
+     @brief The 16 Dirac structures of degrandRossiContract in sparse
+     form: row mu of Gamma_g has its only non-zero element in column
+     gamma_dr_col[g][mu], with value i^gamma_dr_phase[g][mu]
+  */
+  constexpr int gamma_dr_col[16][4] = {{0, 1, 2, 3}, {3, 2, 1, 0}, {3, 2, 1, 0}, {2, 3, 0, 1},
+                                       {2, 3, 0, 1}, {0, 1, 2, 3}, {3, 2, 1, 0}, {3, 2, 1, 0},
+                                       {2, 3, 0, 1}, {2, 3, 0, 1}, {0, 1, 2, 3}, {2, 3, 0, 1},
+                                       {1, 0, 3, 2}, {1, 0, 3, 2}, {1, 0, 3, 2}, {0, 1, 2, 3}};
+  constexpr int gamma_dr_phase[16][4] = {{0, 0, 0, 0}, {1, 1, 3, 3}, {2, 0, 0, 2}, {1, 3, 3, 1},
+                                         {0, 0, 0, 0}, {0, 0, 2, 2}, {1, 1, 1, 1}, {2, 0, 2, 0},
+                                         {1, 3, 1, 3}, {0, 0, 2, 2}, {0, 2, 0, 2}, {3, 3, 1, 1},
+                                         {2, 2, 0, 0}, {0, 0, 0, 0}, {3, 1, 1, 3}, {2, 2, 0, 0}};
+
+  /**
+     The diquark structure C gamma_5 = gamma_2 gamma_4 gamma_5 of the
+     nucleon interpolator, in the same sparse form
+  */
+  constexpr int cg5_col[4] = {1, 0, 3, 2};
+  constexpr int cg5_phase[4] = {2, 0, 2, 0};
+
+  /**
+     @brief Multiply (re, im) by i^phase
+  */
+  template <typename real> __device__ __host__ inline void timesIPower(real &re, real &im, int phase)
+  {
+    real r = re;
+    switch (phase & 3) {
+    case 1: re = -im; im = r; break;
+    case 2: re = -re; im = -im; break;
+    case 3: re = im; im = -r; break;
+    }
+  }
+
+  /**
+     Number of correlator channels computed per site by the propagator
+     contraction: the 16 meson gamma structures followed by the 4 x 4
+     spin matrix of the nucleon
+  */
+  constexpr int propagator_n_meson = 16;
+  constexpr int propagator_n_baryon = 16;
+  constexpr int propagator_n_channel = propagator_n_meson + propagator_n_baryon;
+
+  /**
+     @brief Parameter structure for the propagator contraction.  The
+     two propagators S1 and S2 are each given as 12 fields, where field
+     3 * s + c is the solution for a source of spin s and color c, so
+     that at each site the fields form the 12 x 12 spin-color matrix
+     S(x)[3 * s + c][3 * s' + c'].
+   */
+  template <typename real_, typename F_> struct PropagatorContractionArg {
+    using real = real_;
+    using F = F_;
+    static constexpr int nSpin = 4;
+    static constexpr int nColor = 3;
+    static constexpr int nSC = nSpin * nColor;
+
+    std::vector<F> S1;
+    std::vector<F> S2;
+    int X[4];              // local lattice dimensions
+    int offset[3];         // global coordinates of the local origin
+    int L[3];              // global spatial dimensions
+    int space_volume;      // sites per local timeslice
+    int n_mom;
+    const int (*mom)[3];   // the momenta, in units of 2 pi / L
+
+    PropagatorContractionArg(const std::vector<ColorSpinorField *> &prop1,
+                             const std::vector<ColorSpinorField *> &prop2, const int *mom, int n_mom) :
+      n_mom(n_mom),
+      mom(reinterpret_cast<const int(*)[3]>(mom))
+    {
+      for (int i = 0; i < nSC; i++) {
+        S1.emplace_back(*prop1[i]);
+        S2.emplace_back(*prop2[i]);
+      }
+      for (int dir = 0; dir < 4; dir++) X[dir] = prop1[0]->X()[dir];
+      for (int dir = 0; dir < 3; dir++) {
+        offset[dir] = comm_coord(dir) * X[dir];
+        L[dir] = comm_dim(dir) * X[dir];
+      }
+      space_volume = X[0] * X[1] * X[2];
+    }
+  };
+
+  /**
+     @brief Host functor, run with launchHostReduceArray over the sites
+     and local timeslices, that evaluates all meson and nucleon
+     channels of a site from a single load of the two propagators:
+
+     meson:   C_g(x) = Tr[Gamma_g S1(x) Gamma_g gamma_5 S2(x)^dagger gamma_5]
+     nucleon: C_{al al'}(x) = eps_abc eps_a'b'c' (C g5)_{be ga} (C g5)_{ga' be'} S2(x)^{cc'}_{ga ga'}
+                              (S1(x)^{aa'}_{al al'} S1(x)^{bb'}_{be be'} - S1(x)^{ab'}_{al be'} S1(x)^{ba'}_{be al'})
+
+     with the DeGrand-Rossi Gamma_g of degrandRossiContract, and the
+     phase conventions of the source operators left to the caller.
+     The mesons are projected from the 256 color-contracted spin
+     elements Q[j][k][i][l] = sum_ab S1[j a][k b] conj(S2'[i a][l b])
+     of S1 and S2' = gamma_5 S2 gamma_5, so every channel reuses the
+     same loaded data.  The spin matrices are held as separate real and
+     imaginary arrays whose inner loops are contiguous, so that the
+     compiler vectorizes them.
+  */
+  template <typename Arg> struct PropagatorContractionHost {
+    using real = typename Arg::real;
+    static constexpr int nSpin = Arg::nSpin;
+    static constexpr int nColor = Arg::nColor;
+    static constexpr int nSC = Arg::nSC;
+    Arg &arg;
+    PropagatorContractionHost(Arg &arg) : arg(arg) { }
+
+    /**
+       @brief Load the propagator at a site as 3 x 3 color blocks of
+       4 x 4 spin matrices, S[a * 3 + a'][s * 4 + s'] = S[3 s + a][3 s' + a']
+    */
+    __host__ inline void load(real re[nColor * nColor][nSpin * nSpin], real im[nColor * nColor][nSpin * nSpin],
+                              const std::vector<typename Arg::F> &S, int x_cb, int parity) const
+    {
+      using Vector = ColorSpinor<real, nColor, nSpin>;
+      for (int sp = 0; sp < nSpin; sp++) {
+        for (int cp = 0; cp < nColor; cp++) {
+          Vector v = S[nColor * sp + cp](x_cb, parity);
+          for (int s = 0; s < nSpin; s++) {
+            for (int c = 0; c < nColor; c++) {
+              re[c * nColor + cp][s * nSpin + sp] = v(s, c).real();
+              im[c * nColor + cp][s * nSpin + sp] = v(s, c).imag();
+            }
+          }
+        }
+      }
+    }
+
+    /**
+       @brief The 16 meson channels of the site
+    */
+    __host__ inline void meson(complex<real> C[propagator_n_meson], const real s1_re[][nSpin * nSpin],
+                               const real s1_im[][nSpin * nSpin], const real s2_re[][nSpin * nSpin],
+                               const real s2_im[][nSpin * nSpin]) const
+    {
+      constexpr int n = nSpin * nSpin;
+      constexpr real g5[nSpin] = {1, 1, -1, -1};
+      real q_re[n * n] = {};
+      real q_im[n * n] = {};
+
+      for (int ab = 0; ab < nColor * nColor; ab++) {
+        // conj(S2') for this color block, with gamma_5 S2 gamma_5 = g5_i g5_l S2[i][l]
+        real b_re[n], b_im[n];
+#pragma omp simd
+        for (int il = 0; il < n; il++) {
+          real sign = g5[il / nSpin] * g5[il % nSpin];
+          b_re[il] = sign * s2_re[ab][il];
+          b_im[il] = -sign * s2_im[ab][il];
+        }
+        for (int jk = 0; jk < n; jk++) {
+          const real a_re = s1_re[ab][jk];
+          const real a_im = s1_im[ab][jk];
+          real *qr = q_re + n * jk;
+          real *qi = q_im + n * jk;
+#pragma omp simd
+          for (int il = 0; il < n; il++) {
+            qr[il] += a_re * b_re[il] - a_im * b_im[il];
+            qi[il] += a_re * b_im[il] + a_im * b_re[il];
+          }
+        }
+      }
+
+      // C_g = sum_ik Gamma_{i p(i)} Gamma_{k p(k)} Q[p(i)][k][i][p(k)]
+      for (int g = 0; g < propagator_n_meson; g++) {
+        real c_re = 0.0, c_im = 0.0;
+        for (int i = 0; i < nSpin; i++) {
+          for (int k = 0; k < nSpin; k++) {
+            const int idx = ((gamma_dr_col[g][i] * nSpin + k) * nSpin + i) * nSpin + gamma_dr_col[g][k];
+            real re = q_re[idx], im = q_im[idx];
+            timesIPower(re, im, gamma_dr_phase[g][i] + gamma_dr_phase[g][k]);
+            c_re += re;
+            c_im += im;
+          }
+        }
+        C[g] = complex<real>(c_re, c_im);
+      }
+    }
+
+    /**
+       @brief The 4 x 4 spin matrix of the nucleon at the site, with S1
+       the doubly represented quark
+    */
+    __host__ inline void baryon(complex<real> C[propagator_n_baryon], const real u_re[][nSpin * nSpin],
+                                const real u_im[][nSpin * nSpin], const real d_re[][nSpin * nSpin],
+                                const real d_im[][nSpin * nSpin]) const
+    {
+      constexpr int n = nSpin * nSpin;
+      constexpr int eps[6][4] = {{0, 1, 2, 1}, {1, 2, 0, 1}, {2, 0, 1, 1}, {0, 2, 1, -1}, {2, 1, 0, -1}, {1, 0, 2, -1}};
+
+      // Q^{cc'} = (C g5) D^{cc'} (C g5), using that C g5 is its own inverse permutation
+      real q_re[nColor * nColor][n], q_im[nColor * nColor][n];
+      for (int cc = 0; cc < nColor * nColor; cc++) {
+        for (int be = 0; be < nSpin; be++) {
+          for (int bep = 0; bep < nSpin; bep++) {
+            const int idx = cg5_col[be] * nSpin + cg5_col[bep];
+            real re = d_re[cc][idx], im = d_im[cc][idx];
+            timesIPower(re, im, cg5_phase[be] + cg5_phase[cg5_col[bep]]);
+            q_re[cc][be * nSpin + bep] = re;
+            q_im[cc][be * nSpin + bep] = im;
+          }
+        }
+      }
+
+      real c_re[n] = {};
+      real c_im[n] = {};
+      for (int e = 0; e < 6; e++) {
+        const int a = eps[e][0], b = eps[e][1], c = eps[e][2];
+        for (int ep = 0; ep < 6; ep++) {
+          const int ap = eps[ep][0], bp = eps[ep][1], cp = eps[ep][2];
+          const real sign = eps[e][3] * eps[ep][3];
+          const real *qr = q_re[c * nColor + cp];
+          const real *qi = q_im[c * nColor + cp];
+
+          // direct term: S1^{aa'} sum_{be be'} S1^{bb'}_{be be'} Q^{cc'}_{be be'}
+          const real *ur = u_re[b * nColor + bp];
+          const real *ui = u_im[b * nColor + bp];
+          real s_re = 0.0, s_im = 0.0;
+#pragma omp simd reduction(+ : s_re, s_im)
+          for (int i = 0; i < n; i++) {
+            s_re += ur[i] * qr[i] - ui[i] * qi[i];
+            s_im += ur[i] * qi[i] + ui[i] * qr[i];
+          }
+          s_re *= sign;
+          s_im *= sign;
+          const real *vr = u_re[a * nColor + ap];
+          const real *vi = u_im[a * nColor + ap];
+#pragma omp simd
+          for (int i = 0; i < n; i++) {
+            c_re[i] += s_re * vr[i] - s_im * vi[i];
+            c_im[i] += s_re * vi[i] + s_im * vr[i];
+          }
+
+          // exchange term: -(S1^{ab'} Q^{cc' T} S1^{ba'})_{al al'}
+          const real *xr = u_re[a * nColor + bp];
+          const real *xi = u_im[a * nColor + bp];
+          real t_re[n], t_im[n]; // T_{al be} = sum_{be'} S1^{ab'}_{al be'} Q^{cc'}_{be be'}
+#pragma omp simd
+          for (int i = 0; i < n; i++) {
+            const int al = i / nSpin, be = i % nSpin;
+            real re = 0.0, im = 0.0;
+            for (int bep = 0; bep < nSpin; bep++) {
+              re += xr[al * nSpin + bep] * qr[be * nSpin + bep] - xi[al * nSpin + bep] * qi[be * nSpin + bep];
+              im += xr[al * nSpin + bep] * qi[be * nSpin + bep] + xi[al * nSpin + bep] * qr[be * nSpin + bep];
+            }
+            t_re[i] = sign * re;
+            t_im[i] = sign * im;
+          }
+          const real *yr = u_re[b * nColor + ap];
+          const real *yi = u_im[b * nColor + ap];
+#pragma omp simd
+          for (int i = 0; i < n; i++) {
+            const int al = i / nSpin, alp = i % nSpin;
+            real re = 0.0, im = 0.0;
+            for (int be = 0; be < nSpin; be++) {
+              re += t_re[al * nSpin + be] * yr[be * nSpin + alp] - t_im[al * nSpin + be] * yi[be * nSpin + alp];
+              im += t_re[al * nSpin + be] * yi[be * nSpin + alp] + t_im[al * nSpin + be] * yr[be * nSpin + alp];
+            }
+            c_re[i] -= re;
+            c_im[i] -= im;
+          }
+        }
+      }
+
+      for (int i = 0; i < n; i++) C[i] = complex<real>(c_re[i], c_im[i]);
+    }
+
+    __host__ inline void operator()(int idx, int t, int, double2 *sum) const
+    {
+      constexpr int nCC = nColor * nColor;
+      constexpr int n = nSpin * nSpin;
+      int coord[4] = {idx % arg.X[0], (idx / arg.X[0]) % arg.X[1], idx / (arg.X[0] * arg.X[1]), t};
+      const int x_cb = (idx + t * arg.space_volume) >> 1;
+      const int parity = (coord[0] + coord[1] + coord[2] + coord[3]) & 1;
+
+      real s1_re[nCC][n], s1_im[nCC][n], s2_re[nCC][n], s2_im[nCC][n];
+      load(s1_re, s1_im, arg.S1, x_cb, parity);
+      load(s2_re, s2_im, arg.S2, x_cb, parity);
+
+      complex<real> C[propagator_n_channel];
+      meson(C, s1_re, s1_im, s2_re, s2_im);
+      baryon(C + propagator_n_meson, s1_re, s1_im, s2_re, s2_im);
+
+      for (int mom = 0; mom < arg.n_mom; mom++) {
+        double2 phase = momentumPhase(arg, coord, mom);
+        double2 *s = sum + (t * arg.n_mom + mom) * propagator_n_channel;
+        for (int ch = 0; ch < propagator_n_channel; ch++) {
+          s[ch].x += phase.x * C[ch].real() - phase.y * C[ch].imag();
+          s[ch].y += phase.x * C[ch].imag() + phase.y * C[ch].real();
+        }
+      }
+    }
+  };
+
 } // namespace quda
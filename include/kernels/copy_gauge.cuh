@@ -26,7 +26,11 @@ namespace quda {
   };
 
   /**
-     Generic CPU gauge reordering and packing
+     Generic CPU gauge reordering and packing.  If a checksum stream
+     is open (see checksumStreamBegin) the checksum of the source (or
+     destination) field is accumulated on the fly, saving a separate
+     pass over memory.  Only full-precision fields are summed, since
+     these are the only ones Checksum supports.
   */
   template <typename FloatOut, typename FloatIn, int length, typename Arg>
   void copyGauge(Arg &arg) {
@@ -34,9 +38,14 @@ namespace quda {
     typedef typename mapper<FloatOut>::type RegTypeOut;
     constexpr int nColor = Ncolor(length);
 
+    const bool sum_in = std::is_same<FloatIn, RegTypeIn>::value && checksumStreamActive(false);
+    const bool sum_out = std::is_same<FloatOut, RegTypeOut>::value && checksumStreamActive(true);
+    uint64_t checksum = 0;
+
     for (int parity=0; parity<2; parity++) {
 
       for (int d=0; d<arg.geometry; d++) {
+#pragma omp parallel for schedule(static) reduction(^ : checksum)
 	for (int x=0; x<arg.volume/2; x++) {
 #ifdef FINE_GRAINED_ACCESS
 	  for (int i=0; i<nColor; i++)
@@ -49,11 +58,17 @@ namespace quda {
           in = arg.in(d, x, parity);
           out = in;
 	  arg.out(d, x, parity) = out;
+          if (sum_in) checksum ^= in.checksum();
+          if (sum_out) checksum ^= out.checksum();
 #endif
 	}
       }
 
     }
+
+#ifndef FINE_GRAINED_ACCESS
+    if (sum_in || sum_out) checksumStreamAccumulate(checksum);
+#endif
   }
 
   /**
@@ -0,0 +1,462 @@
+#pragma once
+
+#include <kernels/dslash_wilson_clover.cuh>
+#include <cub_helper.cuh>
+#include <atomic.cuh>
+
+/**
+   Kernels for applying the Wilson and Wilson-clover operators to a
+   multi-RHS field: a five-dimensional field with 4-d preconditioning
+   whose fifth dimension indexes the right-hand sides.  Each thread
+   applies the links (and clover matrices) it loads to a tile of
+   right-hand sides, so that these are read once per tile rather than
+   once per right-hand side, and the halos of all right-hand sides are
+   exchanged together.
+*/
+
+namespace quda
+{
+
+  /**
+     @brief Parameter structure for driving the multi-RHS Wilson operator
+   */
+  template <typename Float, int nColor, QudaReconstructType reconstruct_>
+  struct WilsonMultiRHSArg : WilsonArg<Float, nColor, 4, reconstruct_> {
+    static constexpr bool clover = false;
+    static constexpr int rhs_tile = 4; /** number of right-hand sides each thread applies a link to */
+    const int n_rhs;                   /** number of right-hand sides */
+
+    WilsonMultiRHSArg(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                      const ColorSpinorField &x, int parity, bool dagger, const int *comm_override) :
+      WilsonArg<Float, nColor, 4, reconstruct_>(out, in, U, a, x, parity, dagger, comm_override),
+      n_rhs(in.X(4))
+    {
+    }
+  };
+
+  /**
+     @brief Parameter structure for driving the multi-RHS Wilson-clover operator
+   */
+  template <typename Float, int nColor, QudaReconstructType reconstruct_>
+  struct WilsonCloverMultiRHSArg : WilsonCloverArg<Float, nColor, 4, reconstruct_> {
+    static constexpr bool clover = true;
+    static constexpr int rhs_tile = 4; /** number of right-hand sides each thread applies a link to */
+    const int n_rhs;                   /** number of right-hand sides */
+
+    WilsonCloverMultiRHSArg(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                            const CloverField &A, double a, const ColorSpinorField &x, int parity, bool dagger,
+                            const int *comm_override) :
+      WilsonCloverArg<Float, nColor, 4, reconstruct_>(out, in, U, A, a, 0.0, x, parity, dagger, comm_override),
+      n_rhs(in.X(4))
+    {
+    }
+  };
+
+  /**
+     @brief Applies the off-diagonal part of the Wilson operator to a
+     tile of right-hand sides, starting at coord.s.  Each link is
+     loaded once and applied to every right-hand side of the tile.
+
+     @param[out] out The out result fields, one per right-hand side of the tile
+     @param[in,out] arg Parameter struct
+     @param[in] coord Site coordinate struct
+     @param[in] parity Site parity
+     @param[in] idx Thread index (equal to face index for exterior kernels)
+     @param[in] thread_dim Which dimension this thread corresponds to (fused exterior only)
+  */
+  template <int nParity, bool dagger, KernelType kernel_type, typename Coord, typename Arg, typename Vector>
+  __device__ __host__ inline void applyWilsonMultiRHS(Vector out[], Arg &arg, Coord &coord, int parity, int idx,
+                                                      int thread_dim, bool &active)
+  {
+    typedef typename mapper<typename Arg::Float>::type real;
+    typedef ColorSpinor<real, Arg::nColor, 2> HalfVector;
+    typedef Matrix<complex<real>, Arg::nColor> Link;
+    const int their_spinor_parity = nParity == 2 ? 1 - parity : 0;
+    const int n = arg.n_rhs - coord.s; // right-hand sides remaining from the start of this tile
+
+#pragma unroll
+    for (int d = 0; d < 4; d++) {
+      { // Forward gather - compute fwd offset for vector fetch
+        const int fwd_idx = getNeighborIndexCB(coord, d, +1, arg.dc);
+        constexpr int proj_dir = dagger ? +1 : -1;
+
+        const bool ghost
+          = (coord[d] + arg.nFace >= arg.dim[d]) && isActive<kernel_type>(active, thread_dim, d, coord, arg);
+
+        if (doHalo<kernel_type>(d) && ghost) {
+          const int ghost_idx = (kernel_type == EXTERIOR_KERNEL_ALL && d != thread_dim) ?
+            ghostFaceIndex<1, Arg::nDim>(coord, arg.dim, d, arg.nFace) :
+            idx;
+
+          Link U = arg.U(d, coord.x_cb, parity);
+#pragma unroll
+          for (int r = 0; r < Arg::rhs_tile; r++) {
+            if (r < n) {
+              HalfVector in
+                = arg.in.Ghost(d, 1, ghost_idx + (coord.s + r) * arg.dc.ghostFaceCB[d], their_spinor_parity);
+              if (d == 3) in *= arg.t_proj_scale;
+              out[r] += (U * in).reconstruct(d, proj_dir);
+            }
+          }
+        } else if (doBulk<kernel_type>() && !ghost) {
+
+          Link U = arg.U(d, coord.x_cb, parity);
+#pragma unroll
+          for (int r = 0; r < Arg::rhs_tile; r++) {
+            if (r < n) {
+              Vector in = arg.in(fwd_idx + (coord.s + r) * arg.dc.volume_4d_cb, their_spinor_parity);
+              out[r] += (U * in.project(d, proj_dir)).reconstruct(d, proj_dir);
+            }
+          }
+        }
+      }
+
+      { // Backward gather - compute back offset for spinor and gauge fetch
+        const int back_idx = getNeighborIndexCB(coord, d, -1, arg.dc);
+        constexpr int proj_dir = dagger ? -1 : +1;
+
+        const bool ghost = (coord[d] - arg.nFace < 0) && isActive<kernel_type>(active, thread_dim, d, coord, arg);
+
+        if (doHalo<kernel_type>(d) && ghost) {
+          const int ghost_idx = (kernel_type == EXTERIOR_KERNEL_ALL && d != thread_dim) ?
+            ghostFaceIndex<0, Arg::nDim>(coord, arg.dim, d, arg.nFace) :
+            idx;
+
+          Link U = arg.U.Ghost(d, ghost_idx, 1 - parity);
+#pragma unroll
+          for (int r = 0; r < Arg::rhs_tile; r++) {
+            if (r < n) {
+              HalfVector in
+                = arg.in.Ghost(d, 0, ghost_idx + (coord.s + r) * arg.dc.ghostFaceCB[d], their_spinor_parity);
+              if (d == 3) in *= arg.t_proj_scale;
+              out[r] += (conj(U) * in).reconstruct(d, proj_dir);
+            }
+          }
+        } else if (doBulk<kernel_type>() && !ghost) {
+
+          Link U = arg.U(d, back_idx, 1 - parity);
+#pragma unroll
+          for (int r = 0; r < Arg::rhs_tile; r++) {
+            if (r < n) {
+              Vector in = arg.in(back_idx + (coord.s + r) * arg.dc.volume_4d_cb, their_spinor_parity);
+              out[r] += (conj(U) * in.project(d, proj_dir)).reconstruct(d, proj_dir);
+            }
+          }
+        }
+      }
+    } // nDim
+  }
+
+  /**
+     @brief Applies the clover term to a tile of right-hand sides,
+     loading the clover matrix of each chirality once
+     @param[out] out The result fields, one per right-hand side of the tile
+     @param[in] arg Parameter struct
+     @param[in] x_cb The 4-d checkerboard site index
+     @param[in] s The first right-hand side of the tile
+     @param[in] parity The site parity
+     @param[in] spinor_parity The parity index of the field
+  */
+  template <typename Arg, typename Vector>
+  __device__ __host__ inline void applyCloverMultiRHS(Vector out[], const Arg &arg, int x_cb, int s, int parity,
+                                                      int spinor_parity)
+  {
+    typedef typename mapper<typename Arg::Float>::type real;
+    typedef ColorSpinor<real, Arg::nColor, 2> HalfVector;
+    constexpr int n = Arg::nColor * Arg::nSpin / 2;
+
+    Vector x[Arg::rhs_tile];
+#pragma unroll
+    for (int r = 0; r < Arg::rhs_tile; r++) {
+      if (s + r < arg.n_rhs) {
+        x[r] = arg.x(x_cb + (s + r) * arg.dc.volume_4d_cb, spinor_parity);
+        x[r].toRel(); // switch to chiral basis
+      }
+    }
+
+#pragma unroll
+    for (int chirality = 0; chirality < 2; chirality++) {
+      HMatrix<real, n> A = arg.A(x_cb, parity, chirality);
+#pragma unroll
+      for (int r = 0; r < Arg::rhs_tile; r++) {
+        if (s + r < arg.n_rhs) {
+          HalfVector Ax_chi = A * x[r].chiral_project(chirality);
+          out[r] += Ax_chi.chiral_reconstruct(chirality);
+        }
+      }
+    }
+
+#pragma unroll
+    for (int r = 0; r < Arg::rhs_tile; r++) out[r].toNonRel(); // switch back to non-chiral basis
+  }
+
+  template <int nParity, bool dagger, bool xpay, KernelType kernel_type, typename Arg>
+  struct wilsonMultiRHS : dslash_default {
+
+    Arg &arg;
+    constexpr wilsonMultiRHS(Arg &arg) : arg(arg) {}
+    static constexpr const char *filename() { return KERNEL_FILE; } // this file name - used for run-time compilation
+
+    /**
+       @brief Apply the Wilson (or Wilson-clover) dslash to a tile of right-hand sides
+       out(x) = M*in = (-D + m) * in(x-mu), or A(x)*x(x) + D * in(x-mu) for clover
+    */
+    __device__ __host__ inline void operator()(int idx, int tile, int parity)
+    {
+      typedef typename mapper<typename Arg::Float>::type real;
+      typedef ColorSpinor<real, Arg::nColor, 4> Vector;
+
+      bool active
+        = kernel_type == EXTERIOR_KERNEL_ALL ? false : true; // is thread active (non-trival for fused kernel only)
+      int thread_dim;                                        // which dimension is thread working on (fused kernel only)
+      const int s = tile * Arg::rhs_tile;
+      auto coord = getCoords<QUDA_4D_PC, kernel_type>(arg, idx, s, parity, thread_dim);
+
+      const int my_spinor_parity = nParity == 2 ? parity : 0;
+      Vector out[Arg::rhs_tile];
+      applyWilsonMultiRHS<nParity, dagger, kernel_type>(out, arg, coord, parity, idx, thread_dim, active);
+
+      if (Arg::clover && kernel_type == INTERIOR_KERNEL) {
+        Vector Ax[Arg::rhs_tile];
+        applyCloverMultiRHS(Ax, arg, coord.x_cb, s, parity, my_spinor_parity);
+#pragma unroll
+        for (int r = 0; r < Arg::rhs_tile; r++) out[r] = Ax[r] + arg.a * out[r];
+      }
+
+#pragma unroll
+      for (int r = 0; r < Arg::rhs_tile; r++) {
+        if (s + r >= arg.n_rhs) break;
+        const int xs = coord.x_cb + (s + r) * arg.dc.volume_4d_cb;
+
+        if (!Arg::clover && xpay && kernel_type == INTERIOR_KERNEL) {
+          Vector x = arg.x(xs, my_spinor_parity);
+          out[r] = x + arg.a * out[r];
+        } else if (kernel_type != INTERIOR_KERNEL && active) {
+          Vector x = arg.out(xs, my_spinor_parity);
+          out[r] = x + (xpay ? arg.a * out[r] : out[r]);
+        }
+
+        if (kernel_type != EXTERIOR_KERNEL_ALL || active) arg.out(xs, my_spinor_parity) = out[r];
+      }
+    }
+  };
+
+  /**
+     @brief Parameter structure for the host multi-RHS Wilson
+     operator, acting on host fields in space-spin-color order with a
+     QDP-ordered gauge field.  Compressed (12 or 8) gauge fields are
+     reconstructed in registers as each link is loaded.  No dimension
+     may be partitioned: the host operator applies periodic boundaries
+     locally and has no halo exchange.
+   */
+  template <typename Float_, int nColor_, QudaReconstructType reconstruct_ = QUDA_RECONSTRUCT_NO>
+  struct WilsonMultiRHSHostArg : DslashArg<Float_, 4> {
+    using Float = Float_;
+    static constexpr int nColor = nColor_;
+    static constexpr int nSpin = 4;
+    static constexpr int rhs_tile = 4;
+    static constexpr QudaReconstructType reconstruct = reconstruct_;
+    typedef colorspinor::SpaceSpinorColorOrder<Float, nSpin, nColor> F;
+    typedef gauge_accessor_t<Float, reconstruct, QUDA_QDP_GAUGE_ORDER> G;
+    typedef typename mapper<Float>::type real;
+
+    F out;        /** output vector field */
+    const F in;   /** input vector field */
+    const F x;    /** input vector when doing xpay */
+    const G U;    /** the gauge field */
+    const real a; /** xpay scale factor */
+    const int n_rhs;
+
+    WilsonMultiRHSHostArg(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                          const ColorSpinorField &x, int parity, bool dagger, const int *comm_override) :
+      DslashArg<Float, 4>(in, U, parity, dagger, a != 0.0 ? true : false, 1, false, comm_override),
+      out(out),
+      in(in),
+      x(x),
+      U(U),
+      a(a),
+      n_rhs(in.X(4))
+    {
+      if (in.V() == out.V()) errorQuda("Aliasing pointers");
+      checkPrecision(out, in, x, U);
+      checkLocation(out, in, x, U);
+      if (in.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER || U.FieldOrder() != QUDA_QDP_GAUGE_ORDER)
+        errorQuda("Unsupported field order colorspinor=%d gauge=%d combination\n", in.FieldOrder(), U.FieldOrder());
+      for (int d = 0; d < 4; d++)
+        if (this->commDim[d]) errorQuda("Host multi-RHS dslash does not support partitioned dimension %d", d);
+    }
+  };
+
+  /**
+     @brief Host functor for the multi-RHS Wilson operator, run over
+     (x_cb, parity, tile) with launchHost.  Each link is loaded once
+     and applied to the right-hand sides of the tile.
+  */
+  template <bool dagger, bool xpay, typename Arg> struct WilsonMultiRHSHost {
+    Arg &arg;
+    WilsonMultiRHSHost(Arg &arg) : arg(arg) {}
+
+    __device__ __host__ inline void operator()(int x_cb, int parity, int tile) const
+    {
+      typedef typename mapper<typename Arg::Float>::type real;
+      typedef ColorSpinor<real, Arg::nColor, 4> Vector;
+      typedef Matrix<complex<real>, Arg::nColor> Link;
+
+      const int s = tile * Arg::rhs_tile;
+      const int n = arg.n_rhs - s < Arg::rhs_tile ? arg.n_rhs - s : Arg::rhs_tile;
+      const int my_spinor_parity = arg.nParity == 2 ? parity : 0;
+      const int their_spinor_parity = arg.nParity == 2 ? 1 - parity : 0;
+      if (arg.nParity == 1) parity = arg.parity;
+
+      Coord<4> coord;
+      coord.X = getCoordsCB(coord, x_cb, arg.dim, arg.X0h, parity);
+      coord.x_cb = x_cb;
+      coord.s = s;
+
+      Vector out[Arg::rhs_tile];
+      for (int d = 0; d < 4; d++) {
+        const int fwd_idx = getNeighborIndexCB(coord, d, +1, arg.dc);
+        const int back_idx = getNeighborIndexCB(coord, d, -1, arg.dc);
+        const Link U_fwd = arg.U(d, x_cb, parity);
+        const Link U_back = arg.U(d, back_idx, 1 - parity);
+
+        for (int r = 0; r < n; r++) {
+          const Vector in_fwd = arg.in(fwd_idx + (s + r) * arg.dc.volume_4d_cb, their_spinor_parity);
+          const Vector in_back = arg.in(back_idx + (s + r) * arg.dc.volume_4d_cb, their_spinor_parity);
+          out[r] += (U_fwd * in_fwd.project(d, dagger ? +1 : -1)).reconstruct(d, dagger ? +1 : -1);
+          out[r] += (conj(U_back) * in_back.project(d, dagger ? -1 : +1)).reconstruct(d, dagger ? -1 : +1);
+        }
+      }
+
+      for (int r = 0; r < n; r++) {
+        const int xs = x_cb + (s + r) * arg.dc.volume_4d_cb;
+        if (xpay) {
+          const Vector x = arg.x(xs, my_spinor_parity);
+          out[r] = x + arg.a * out[r];
+        }
+        arg.out(xs, my_spinor_parity) = out[r];
+      }
+    }
+  };
+
+  /**
+     @brief Parameter structure for copying a right-hand side into, or
+     out of, a multi-RHS field
+  */
+  template <typename Float, int nColor_, bool native = true> struct CopyMultiRHSArg {
+    static constexpr int nColor = nColor_;
+    typedef typename std::conditional<native, typename colorspinor_mapper<Float, 4, nColor>::type,
+                                      colorspinor::SpaceSpinorColorOrder<Float, 4, nColor>>::type F;
+    typedef typename mapper<Float>::type real;
+
+    F dst;
+    const F src;
+    const int dst_offset; /** offset of the right-hand side in dst (zero unless dst is the multi-RHS field) */
+    const int src_offset; /** offset of the right-hand side in src (zero unless src is the multi-RHS field) */
+    const int nParity;
+    const int threads; /** 4-d checkerboard volume */
+
+    CopyMultiRHSArg(ColorSpinorField &dst, const ColorSpinorField &src, int s) :
+      dst(dst),
+      src(src),
+      dst_offset(dst.Ndim() == 5 ? s * dst.getDslashConstant().volume_4d_cb : 0),
+      src_offset(src.Ndim() == 5 ? s * src.getDslashConstant().volume_4d_cb : 0),
+      nParity(src.SiteSubset()),
+      threads(src.Ndim() == 5 ? src.getDslashConstant().volume_4d_cb : src.VolumeCB())
+    {
+    }
+  };
+
+  template <typename Arg> struct CopyMultiRHS {
+    Arg &arg;
+    __device__ __host__ CopyMultiRHS(Arg &arg) : arg(arg) {}
+
+    __device__ __host__ inline void operator()(int x_cb, int parity, int = 0) const
+    {
+      ColorSpinor<typename Arg::real, Arg::nColor, 4> v = arg.src(x_cb + arg.src_offset, parity);
+      arg.dst(x_cb + arg.dst_offset, parity) = v;
+    }
+  };
+
+  template <typename Arg> __global__ void copyMultiRHSKernel(Arg arg)
+  {
+    int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
+    int parity = threadIdx.y + blockIdx.y * blockDim.y;
+    if (x_cb >= arg.threads) return;
+    if (parity >= arg.nParity) return;
+
+    CopyMultiRHS<Arg> copy(arg);
+    copy(x_cb, parity);
+  }
+
+  /**
+     @brief Parameter structure for the norm of each right-hand side of a multi-RHS field
+   */
+  template <typename Float, int nColor_, bool native = true> struct MultiRHSNorm2Arg {
+    static constexpr int nColor = nColor_;
+    typedef typename std::conditional<native, typename colorspinor_mapper<Float, 4, nColor>::type,
+                                      colorspinor::SpaceSpinorColorOrder<Float, 4, nColor>>::type F;
+    typedef typename mapper<Float>::type real;
+
+    const F in;
+    const int volume_4d_cb; /** offset between consecutive right-hand sides */
+    const int nParity;
+    const int threads; /** 4-d sites of a right-hand side */
+    double *result;    /** norm of each right-hand side */
+    qudaError_t launch_error;
+
+    MultiRHSNorm2Arg(const ColorSpinorField &in, double *result) :
+      in(in),
+      volume_4d_cb(in.getDslashConstant().volume_4d_cb),
+      nParity(in.SiteSubset()),
+      threads(volume_4d_cb * nParity),
+      result(result),
+      launch_error(QUDA_ERROR_UNINITIALIZED)
+    {
+    }
+  };
+
+  template <typename Arg>
+  __device__ __host__ inline double multiRHSSiteNorm2(const Arg &arg, int x_cb, int parity, int s)
+  {
+    ColorSpinor<typename Arg::real, Arg::nColor, 4> v = arg.in(x_cb + s * arg.volume_4d_cb, parity);
+    return innerProduct(v, v).real();
+  }
+
+  /**
+     @brief Host functor, run with launchHostReduceArray over the 4-d
+     sites with the right-hand side as the z index
+  */
+  template <typename Arg> struct MultiRHSNorm2 {
+    const Arg &arg;
+    MultiRHSNorm2(const Arg &arg) : arg(arg) {}
+
+    __host__ inline void operator()(int x_cb, int parity, int s, double *sum) const
+    {
+      sum[s] += multiRHSSiteNorm2(arg, x_cb, parity, s);
+    }
+  };
+
+  /**
+     @brief Kernel for the norm of each right-hand side of a multi-RHS
+     field: blockIdx.y indexes the right-hand side, and each thread
+     block reduces its sites before adding them to the result.
+  */
+  template <int block_size, typename Arg> __global__ void multiRHSNorm2Kernel(Arg arg)
+  {
+    const int idx = threadIdx.x + blockIdx.x * blockDim.x;
+    const int s = blockIdx.y;
+
+    double value = 0.0;
+    if (idx < arg.threads) {
+      const int parity = idx / arg.volume_4d_cb;
+      value = multiRHSSiteNorm2(arg, idx - parity * arg.volume_4d_cb, parity, s);
+    }
+
+    using BlockReduce = cub::BlockReduce<double, block_size>;
+    __shared__ typename BlockReduce::TempStorage cub_tmp;
+    double aggregate = BlockReduce(cub_tmp).Sum(value);
+    if (threadIdx.x == 0) atomicAdd(arg.result + s, aggregate);
+  }
+
+} // namespace quda
@@ -33,65 +33,70 @@ namespace quda
     }
   };
 
-  template <int mu, int nu, typename Arg>
-  __device__ __host__ __forceinline__ void computeFmunuCore(Arg &arg, int idx, int parity)
+  /**
+     @brief Compute the clover-leaf field strength F_{mu nu}(x) = (Q -
+     Q^dagger) / 8, where Q is the sum of the four plaquettes in the
+     mu-nu plane that have x as a corner.
+     @param[in] u Gauge field accessor
+     @param[in] x Extended site coordinates
+     @param[in] X Extended lattice dimensions
+     @param[in] parity Site parity
+     @param[out] plaq Real trace of the plaquette U(x,mu) U(x+mu,nu) U^dagger(x+nu,mu) U^dagger(x,nu)
+     @return F_{mu nu}(x)
+  */
+  template <int mu, int nu, typename real, typename Gauge>
+  __device__ __host__ __forceinline__ Matrix<complex<real>, 3> computeFmunuClover(const Gauge &u, const int x[4],
+                                                                                  const int X[4], int parity,
+                                                                                  double &plaq)
   {
-    typedef Matrix<complex<typename Arg::Float>, 3> Link;
-
-    int x[4];
-    auto &X = arg.X;
-
-    getCoords(x, idx, X, parity);
-    for (int dir = 0; dir < 4; ++dir) {
-      x[dir] += arg.border[dir];
-      X[dir] += 2 * arg.border[dir];
-    }
+    typedef Matrix<complex<real>, 3> Link;
 
     Link F;
     { // U(x,mu) U(x+mu,nu) U[dagger](x+nu,mu) U[dagger](x,nu)
 
       // load U(x)_(+mu)
       int dx[4] = {0, 0, 0, 0};
-      Link U1 = arg.u(mu, linkIndexShift(x, dx, X), parity);
+      Link U1 = u(mu, linkIndexShift(x, dx, X), parity);
 
       // load U(x+mu)_(+nu)
       dx[mu]++;
-      Link U2 = arg.u(nu, linkIndexShift(x, dx, X), 1 - parity);
+      Link U2 = u(nu, linkIndexShift(x, dx, X), 1 - parity);
       dx[mu]--;
 
       // load U(x+nu)_(+mu)
       dx[nu]++;
-      Link U3 = arg.u(mu, linkIndexShift(x, dx, X), 1 - parity);
+      Link U3 = u(mu, linkIndexShift(x, dx, X), 1 - parity);
       dx[nu]--;
 
       // load U(x)_(+nu)
-      Link U4 = arg.u(nu, linkIndexShift(x, dx, X), parity);
+      Link U4 = u(nu, linkIndexShift(x, dx, X), parity);
 
       // compute plaquette
       F = U1 * U2 * conj(U3) * conj(U4);
+      plaq = getTrace(F).real();
     }
 
     { // U(x,nu) U[dagger](x+nu-mu,mu) U[dagger](x-mu,nu) U(x-mu, mu)
 
       // load U(x)_(+nu)
       int dx[4] = {0, 0, 0, 0};
-      Link U1 = arg.u(nu, linkIndexShift(x, dx, X), parity);
+      Link U1 = u(nu, linkIndexShift(x, dx, X), parity);
 
       // load U(x+nu)_(-mu) = U(x+nu-mu)_(+mu)
       dx[nu]++;
       dx[mu]--;
-      Link U2 = arg.u(mu, linkIndexShift(x, dx, X), parity);
+      Link U2 = u(mu, linkIndexShift(x, dx, X), parity);
       dx[mu]++;
       dx[nu]--;
 
       // load U(x-mu)_nu
       dx[mu]--;
-      Link U3 = arg.u(nu, linkIndexShift(x, dx, X), 1 - parity);
+      Link U3 = u(nu, linkIndexShift(x, dx, X), 1 - parity);
       dx[mu]++;
 
       // load U(x)_(-mu) = U(x-mu)_(+mu)
       dx[mu]--;
-      Link U4 = arg.u(mu, linkIndexShift(x, dx, X), 1 - parity);
+      Link U4 = u(mu, linkIndexShift(x, dx, X), 1 - parity);
       dx[mu]++;
 
       // sum this contribution to Fmunu
@@ -103,23 +108,23 @@ namespace quda
       // load U(x)_(-nu)
       int dx[4] = {0, 0, 0, 0};
       dx[nu]--;
-      Link U1 = arg.u(nu, linkIndexShift(x, dx, X), 1 - parity);
+      Link U1 = u(nu, linkIndexShift(x, dx, X), 1 - parity);
       dx[nu]++;
 
       // load U(x-nu)_(+mu)
       dx[nu]--;
-      Link U2 = arg.u(mu, linkIndexShift(x, dx, X), 1 - parity);
+      Link U2 = u(mu, linkIndexShift(x, dx, X), 1 - parity);
       dx[nu]++;
 
       // load U(x+mu-nu)_(+nu)
       dx[mu]++;
       dx[nu]--;
-      Link U3 = arg.u(nu, linkIndexShift(x, dx, X), parity);
+      Link U3 = u(nu, linkIndexShift(x, dx, X), parity);
       dx[nu]++;
       dx[mu]--;
 
       // load U(x)_(+mu)
-      Link U4 = arg.u(mu, linkIndexShift(x, dx, X), parity);
+      Link U4 = u(mu, linkIndexShift(x, dx, X), parity);
 
       // sum this contribution to Fmunu
       F += conj(U1) * U2 * U3 * conj(U4);
@@ -130,26 +135,26 @@ namespace quda
       // load U(x)_(-mu)
       int dx[4] = {0, 0, 0, 0};
       dx[mu]--;
-      Link U1 = arg.u(mu, linkIndexShift(x, dx, X), 1 - parity);
+      Link U1 = u(mu, linkIndexShift(x, dx, X), 1 - parity);
       dx[mu]++;
 
       // load U(x-mu)_(-nu) = U(x-mu-nu)_(+nu)
       dx[mu]--;
       dx[nu]--;
-      Link U2 = arg.u(nu, linkIndexShift(x, dx, X), parity);
+      Link U2 = u(nu, linkIndexShift(x, dx, X), parity);
       dx[nu]++;
       dx[mu]++;
 
       // load U(x-nu)_mu
       dx[mu]--;
       dx[nu]--;
-      Link U3 = arg.u(mu, linkIndexShift(x, dx, X), parity);
+      Link U3 = u(mu, linkIndexShift(x, dx, X), parity);
       dx[nu]++;
       dx[mu]++;
 
       // load U(x)_(-nu) = U(x-nu)_(+nu)
       dx[nu]--;
-      Link U4 = arg.u(nu, linkIndexShift(x, dx, X), 1 - parity);
+      Link U4 = u(nu, linkIndexShift(x, dx, X), 1 - parity);
       dx[nu]++;
 
       // sum this contribution to Fmunu
@@ -164,10 +169,30 @@ namespace quda
     // 3*18 + 12*198 =  54 + 2376 = 2430
     {
       F -= conj(F);                   // 18 real subtractions + one matrix conjugation
-      F *= static_cast<typename Arg::Float>(0.125); // 18 real multiplications
+      F *= static_cast<real>(0.125); // 18 real multiplications
       // 36 floating point operations here
     }
-    
+
+    return F;
+  }
+
+  template <int mu, int nu, typename Arg>
+  __device__ __host__ __forceinline__ void computeFmunuCore(Arg &arg, int idx, int parity)
+  {
+    typedef Matrix<complex<typename Arg::Float>, 3> Link;
+
+    int x[4];
+    int X[4];
+
+    getCoords(x, idx, arg.X, parity);
+    for (int dir = 0; dir < 4; ++dir) {
+      x[dir] += arg.border[dir];
+      X[dir] = arg.X[dir] + 2 * arg.border[dir];
+    }
+
+    double plaq;
+    Link F = computeFmunuClover<mu, nu, typename Arg::Float>(arg.u, x, X, parity, plaq);
+
     constexpr int munu_idx = (mu * (mu - 1)) / 2 + nu; // lower-triangular indexing
     arg.f(munu_idx, idx, parity) = F;
   }
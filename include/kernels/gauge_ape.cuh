@@ -10,13 +10,15 @@ namespace quda
 #define  DOUBLE_TOL	1e-15
 #define  SINGLE_TOL	2e-6
 
-  template <typename Float_, int nColor_, QudaReconstructType recon_, int apeDim_> struct GaugeAPEArg {
+  template <typename Float_, int nColor_, QudaReconstructType recon_, int apeDim_,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
+  struct GaugeAPEArg {
     using Float = Float_;
     static constexpr int nColor = nColor_;
     static_assert(nColor == 3, "Only nColor=3 enabled at this time");
     static constexpr QudaReconstructType recon = recon_;
     static constexpr int apeDim = apeDim_;
-    typedef typename gauge_mapper<Float,recon>::type Gauge;
+    typedef gauge_accessor_t<Float, recon, order> Gauge;
 
     Gauge out;
     const Gauge in;
@@ -43,6 +45,47 @@ namespace quda
     }
   };
   
+  /**
+     @brief Functor applying an APE step to the link in direction dir at a site
+  */
+  template <typename Arg> struct APE {
+    Arg &arg;
+    __device__ __host__ APE(Arg &arg) : arg(arg) {}
+
+    __device__ __host__ inline void operator()(int x_cb, int parity, int dir) const
+    {
+      using real = typename Arg::Float;
+      typedef Matrix<complex<real>, Arg::nColor> Link;
+
+      // compute spacetime and local coords
+      int X[4];
+      for (int dr = 0; dr < 4; ++dr) X[dr] = arg.X[dr];
+      int x[4];
+      getCoords(x, x_cb, X, parity);
+      for (int dr = 0; dr < 4; ++dr) {
+        x[dr] += arg.border[dr];
+        X[dr] += 2 * arg.border[dr];
+      }
+
+      int dx[4] = {0, 0, 0, 0};
+      Link U, Stap, TestU, I;
+      // This function gets stap = S_{mu,nu} i.e., the staple of length 3,
+      computeStaple(arg, x, X, parity, dir, Stap, Arg::apeDim);
+
+      // Get link U
+      U = arg.in(dir, linkIndexShift(x, dx, X), parity);
+
+      Stap = Stap * (arg.alpha / ((real)(2. * (3. - 1.))));
+      setIdentity(&I);
+
+      TestU = I * (1. - arg.alpha) + Stap * conj(U);
+      polarSu3<real>(TestU, arg.tolerance);
+      U = TestU * U;
+
+      arg.out(dir, linkIndexShift(x, dx, X), parity) = U;
+    }
+  };
+
   template <typename Arg> __global__ void computeAPEStep(Arg arg)
   {
     int idx = threadIdx.x + blockIdx.x * blockDim.x;
@@ -50,35 +93,8 @@ namespace quda
     int dir = threadIdx.z + blockIdx.z * blockDim.z;
     if (idx >= arg.threads) return;
     if (dir >= Arg::apeDim) return;
-    using real = typename Arg::Float;
-    typedef complex<real> Complex;
-    typedef Matrix<complex<real>, Arg::nColor> Link;
-
-    // compute spacetime and local coords
-    int X[4];
-    for (int dr = 0; dr < 4; ++dr) X[dr] = arg.X[dr];
-    int x[4];
-    getCoords(x, idx, X, parity);
-    for (int dr = 0; dr < 4; ++dr) {
-      x[dr] += arg.border[dr];
-      X[dr] += 2 * arg.border[dr];
-    }
-
-    int dx[4] = {0, 0, 0, 0};
-    Link U, Stap, TestU, I;
-    // This function gets stap = S_{mu,nu} i.e., the staple of length 3,
-    computeStaple(arg, x, X, parity, dir, Stap, Arg::apeDim);
-
-    // Get link U
-    U = arg.in(dir, linkIndexShift(x, dx, X), parity);
-    
-    Stap = Stap * (arg.alpha / ((real)(2. * (3. - 1.))));
-    setIdentity(&I);
 
-    TestU = I * (1. - arg.alpha) + Stap * conj(U);
-    polarSu3<real>(TestU, arg.tolerance);
-    U = TestU * U;
-    
-    arg.out(dir, linkIndexShift(x, dx, X), parity) = U;
+    APE<Arg> ape(arg);
+    ape(idx, parity, dir);
   }
 } // namespace quda
@@ -0,0 +1,122 @@
+#include <gauge_field_order.h>
+#include <index_helper.cuh>
+#include <reduce_helper.h>
+#include <kernels/field_strength_tensor.cuh>
+
+namespace quda
+{
+
+  /**
+     @brief Per-site observables accumulated by the fused observables
+     kernel: spatial and temporal plaquette, spatial and temporal
+     clover-leaf field energy and topological charge
+  */
+  using observables_t = vector_type<double, 5>;
+
+  template <typename Float_, int nColor_, QudaReconstructType recon_, bool density_ = false,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
+  struct GaugeObservablesArg : public ReduceArg<observables_t> {
+    using Float = Float_;
+    static constexpr int nColor = nColor_;
+    static_assert(nColor == 3, "Only nColor=3 enabled at this time");
+    static constexpr QudaReconstructType recon = recon_;
+    static constexpr bool density = density_;
+    typedef gauge_accessor_t<Float, recon, order> Gauge;
+
+    int threads; // number of active threads required
+    int E[4];    // extended grid dimensions
+    int X[4];    // true grid dimensions
+    int border[4];
+    Gauge U;
+    Float *qDensity;
+
+    GaugeObservablesArg(const GaugeField &U_, Float *qDensity = nullptr) :
+      ReduceArg<observables_t>(),
+      U(U_),
+      qDensity(qDensity)
+    {
+      for (int dir = 0; dir < 4; ++dir) {
+        border[dir] = U_.R()[dir];
+        E[dir] = U_.X()[dir];
+        X[dir] = U_.X()[dir] - border[dir] * 2;
+      }
+      threads = X[0] * X[1] * X[2] * X[3] / 2;
+    }
+  };
+
+  /**
+     @brief Functor computing the plaquette, field energy and
+     topological charge density at a site from the clover-leaf field
+     strength, which is formed in registers rather than stored.  The
+     charge density is optionally written out.
+  */
+  template <typename Arg> struct GaugeObservables {
+    using reduce_t = observables_t;
+    Arg &arg;
+    __device__ __host__ GaugeObservables(Arg &arg) : arg(arg) {}
+
+    __device__ __host__ inline reduce_t operator()(int x_cb, int parity, int = 0) const
+    {
+      using real = typename Arg::Float;
+      using Link = Matrix<complex<real>, Arg::nColor>;
+      constexpr real q_norm = static_cast<real>(-1.0 / (4 * M_PI * M_PI));
+      constexpr real n_inv = static_cast<real>(1.0 / Arg::nColor);
+
+      int x[4];
+      getCoords(x, x_cb, arg.X, parity);
+#pragma unroll
+      for (int dr = 0; dr < 4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+
+      // F0 = F[Y,X], F1 = F[Z,X], F2 = F[Z,Y],
+      // F3 = F[T,X], F4 = F[T,Y], F5 = F[T,Z]
+      double plaq[6];
+      Link F[] = {computeFmunuClover<1, 0, real>(arg.U, x, arg.E, parity, plaq[0]),
+                  computeFmunuClover<2, 0, real>(arg.U, x, arg.E, parity, plaq[1]),
+                  computeFmunuClover<2, 1, real>(arg.U, x, arg.E, parity, plaq[2]),
+                  computeFmunuClover<3, 0, real>(arg.U, x, arg.E, parity, plaq[3]),
+                  computeFmunuClover<3, 1, real>(arg.U, x, arg.E, parity, plaq[4]),
+                  computeFmunuClover<3, 2, real>(arg.U, x, arg.E, parity, plaq[5])};
+
+      reduce_t obs;
+      Link iden;
+      setIdentity(&iden);
+#pragma unroll
+      for (int i = 0; i < 6; i++) {
+        obs[i < 3 ? 0 : 1] += plaq[i];
+
+        // field energy from the traceless field strength
+        auto tmp = F[i] - n_inv * getTrace(F[i]) * iden;
+        obs[i < 3 ? 2 : 3] -= getTrace(tmp * tmp).real();
+      }
+
+      // topological charge with the levi-civita symbol applied
+      double Q_idx = 0.0;
+#pragma unroll
+      for (int i = 0; i < 3; i++) {
+        double Qi = getTrace(F[i] * F[5 - i]).real();
+        Q_idx += (i % 2 == 0) ? Qi : -Qi;
+      }
+      obs[4] = Q_idx * q_norm;
+      if (Arg::density) arg.qDensity[x_cb + parity * arg.threads] = Q_idx * q_norm;
+
+      return obs;
+    }
+  };
+
+  template <int blockSize, typename Arg> __global__ void gaugeObservablesKernel(Arg arg)
+  {
+    int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
+    int parity = threadIdx.y;
+
+    observables_t obs;
+    GaugeObservables<Arg> f(arg);
+
+    while (x_cb < arg.threads) {
+      obs += f(x_cb, parity);
+      x_cb += blockDim.x * gridDim.x;
+    }
+
+    arg.template reduce2d<blockSize, 2>(obs);
+  }
+
+} // namespace quda
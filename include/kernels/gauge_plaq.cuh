@@ -6,13 +6,13 @@
 
 namespace quda {
 
-  template <typename Float_, int nColor_, QudaReconstructType recon_>
+  template <typename Float_, int nColor_, QudaReconstructType recon_, QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
   struct GaugePlaqArg : public ReduceArg<double2> {
     using Float = Float_;
     static constexpr int nColor = nColor_;
     static_assert(nColor == 3, "Only nColor=3 enabled at this time");
     static constexpr QudaReconstructType recon = recon_;
-    typedef typename gauge_mapper<Float,recon>::type Gauge;
+    typedef gauge_accessor_t<Float, recon, order> Gauge;
 
     int threads; // number of active threads required
     int E[4]; // extended grid dimensions
@@ -36,7 +36,7 @@ namespace quda {
   };
 
   template<typename Arg>
-  __device__ inline double plaquette(Arg &arg, int x[], int parity, int mu, int nu)
+  __device__ __host__ inline double plaquette(Arg &arg, int x[], int parity, int mu, int nu)
   {
     using Link = Matrix<complex<typename Arg::Float>,3>;
 
@@ -53,17 +53,20 @@ namespace quda {
     return getTrace( U1 * U2 * conj(U3) * conj(U4) ).real();
   }
 
-  template<int blockSize, typename Arg>
-  __global__ void computePlaq(Arg arg)
-  {
-    int idx = threadIdx.x + blockIdx.x * blockDim.x;
-    int parity = threadIdx.y;
+  /**
+     @brief Functor returning the spatial and temporal plaquette sums at a site
+  */
+  template <typename Arg> struct Plaquette {
+    using reduce_t = double2;
+    Arg &arg;
+    __device__ __host__ Plaquette(Arg &arg) : arg(arg) {}
 
-    double2 plaq = make_double2(0.0,0.0);
+    __device__ __host__ inline reduce_t operator()(int x_cb, int parity, int = 0) const
+    {
+      double2 plaq = make_double2(0.0, 0.0);
 
-    while (idx < arg.threads) {
       int x[4];
-      getCoords(x, idx, arg.X, parity);
+      getCoords(x, x_cb, arg.X, parity);
 #pragma unroll
       for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
 
@@ -76,7 +79,21 @@ namespace quda {
 
 	plaq.y += plaquette(arg, x, parity, mu, 3);
       }
+      return plaq;
+    }
+  };
 
+  template<int blockSize, typename Arg>
+  __global__ void computePlaq(Arg arg)
+  {
+    int idx = threadIdx.x + blockIdx.x * blockDim.x;
+    int parity = threadIdx.y;
+
+    double2 plaq = make_double2(0.0,0.0);
+    Plaquette<Arg> f(arg);
+
+    while (idx < arg.threads) {
+      plaq += f(idx, parity);
       idx += blockDim.x*gridDim.x;
     }
 
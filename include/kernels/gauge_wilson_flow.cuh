@@ -3,6 +3,8 @@
 #include <quda_matrix.h>
 #include <kernels/gauge_utils.cuh>
 #include <su3_project.cuh>
+#include <reduce_helper.h>
+#include <kernels/gauge_observables.cuh>
 
 namespace quda
 {
@@ -13,47 +15,66 @@ namespace quda
     WFLOW_STEP_VT,
   };
 
-  template <typename Float_, int nColor_, QudaReconstructType recon_, int wflow_dim_>
+  /**
+     @brief Argument struct for a Wilson flow substep.  The substep is
+     applied to the interior of the extended field and to the first
+     depth[d] layers of its halo in each dimension, so that a
+     subsequent substep can also be applied there without a ghost
+     exchange in between.  The temporary fields are extended like the
+     gauge fields and are indexed the same way.
+  */
+  template <typename Float_, int nColor_, QudaReconstructType recon_, int wflow_dim_,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
   struct GaugeWFlowArg {
     using Float = Float_;
     static constexpr int nColor = nColor_;
     static_assert(nColor == 3, "Only nColor=3 enabled at this time");
     static constexpr QudaReconstructType recon = recon_;
     static constexpr int wflow_dim = wflow_dim_;
-    typedef typename gauge_mapper<Float,recon>::type Gauge;
-    typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type Matrix; // temp field not on the manifold
+    typedef gauge_accessor_t<Float, recon, order> Gauge;
+    typedef gauge_accessor_t<Float, QUDA_RECONSTRUCT_NO, order> Matrix; // temp field not on the manifold
 
     Gauge out;
     Matrix temp;
+    Matrix z0; // copy of Z0 kept by the W2 step for the error estimate
     const Gauge in;
 
     int threads; // number of active threads required
-    int_fastdiv X[4];    // grid dimensions
-    int border[4];
+    int_fastdiv X[4];    // dimensions of the region the substep is applied to
+    int border[4];       // offset of that region in the extended grid
+    int offset_parity;   // parity of the offset
     int_fastdiv E[4];
     const Float epsilon;
     const Float coeff1x1;
     const Float coeff2x1;
     const QudaWFlowType wflow_type;
     const WFlowStepType step_type;
+    const bool adaptive; // keep Z0 in the W2 step and estimate the error in the Vt step
 
-    GaugeWFlowArg(GaugeField &out, GaugeField &temp, const GaugeField &in, const Float epsilon, const QudaWFlowType wflow_type, const WFlowStepType step_type) :
+    GaugeWFlowArg(GaugeField &out, GaugeField &temp, const GaugeField &in, const Float epsilon,
+                  const QudaWFlowType wflow_type, const WFlowStepType step_type, const int *depth, GaugeField &z0,
+                  bool adaptive) :
       out(out),
-      in(in),
       temp(temp),
+      z0(z0),
+      in(in),
       threads(1),
+      offset_parity(0),
+      epsilon(epsilon),
       coeff1x1(5.0/3.0),
       coeff2x1(-1.0/12.0),
-      epsilon(epsilon),
       wflow_type(wflow_type),
-      step_type(step_type)
+      step_type(step_type),
+      adaptive(adaptive)
     {
       for (int dir = 0; dir < 4; ++dir) {
-        border[dir] = in.R()[dir];
+        border[dir] = in.R()[dir] - depth[dir];
         X[dir] = in.X()[dir] - border[dir] * 2;
         threads *= X[dir];
         E[dir] = in.X()[dir];
+        offset_parity += border[dir];
       }
+      offset_parity &= 1;
       threads /= 2;
     }
   };
@@ -83,79 +104,229 @@ namespace quda
   }
 
   template <QudaWFlowType wflow_type, typename Link, typename Arg>
-  __host__ __device__ inline auto computeW1Step(Arg &arg, Link &U, const int *x, const int parity, const int x_cb, const int dir)
+  __host__ __device__ inline auto computeW1Step(Arg &arg, Link &U, const int *x, const int parity, const int e_cb, const int dir)
   {
     // Compute staples and Z0
     Link Z0 = computeStaple<wflow_type>(arg, x, parity, dir);
-    U = arg.in(dir, linkIndex(x, arg.E), parity);
+    U = arg.in(dir, e_cb, parity);
     Z0 *= conj(U);
-    arg.temp(dir, x_cb, parity) = Z0;
+    arg.temp(dir, e_cb, parity) = Z0;
     Z0 *= (1.0 / 4.0) * arg.epsilon;
     return Z0;
   }
 
   template <QudaWFlowType wflow_type, typename Link, typename Arg>
-  __host__ __device__ inline auto computeW2Step(Arg &arg, Link &U, const int *x, const int parity, const int x_cb, const int dir)
+  __host__ __device__ inline auto computeW2Step(Arg &arg, Link &U, const int *x, const int parity, const int e_cb, const int dir)
   {
     // Compute staples and Z1
     Link Z1 = (8.0/9.0) * computeStaple<wflow_type>(arg, x, parity, dir);
-    U = arg.in(dir, linkIndex(x, arg.E), parity);
+    U = arg.in(dir, e_cb, parity);
     Z1 *= conj(U);
 
     // Retrieve Z0, (8/9 Z1 - 17/36 Z0) stored in temp
-    Link Z0 = arg.temp(dir, x_cb, parity);
+    Link Z0 = arg.temp(dir, e_cb, parity);
+    if (arg.adaptive) arg.z0(dir, e_cb, parity) = Z0;
     Z0 *= (17.0 / 36.0);
     Z1 = Z1 - Z0;
-    arg.temp(dir, x_cb, parity) = Z1;
+    arg.temp(dir, e_cb, parity) = Z1;
     Z1 *= arg.epsilon;
     return Z1;
   }
 
   template <QudaWFlowType wflow_type, typename Link, typename Arg>
-  __host__ __device__ inline auto computeVtStep(Arg &arg, Link &U, const int *x, const int parity, const int x_cb, const int dir)
+  __host__ __device__ inline auto computeVtStep(Arg &arg, Link &U, const int *x, const int parity, const int e_cb, const int dir)
   {
     // Compute staples and Z2
     Link Z2 = (3.0/4.0) * computeStaple<wflow_type>(arg, x, parity, dir);
-    U = arg.in(dir, linkIndex(x, arg.E), parity);
+    U = arg.in(dir, e_cb, parity);
     Z2 *= conj(U);
 
     // Use (8/9 Z1 - 17/36 Z0) computed from W2 step
-    Link Z1 = arg.temp(dir, x_cb, parity);
+    Link Z1 = arg.temp(dir, e_cb, parity);
     Z2 = Z2 - Z1;
     Z2 *= arg.epsilon;
     return Z2;
   }
 
+  /**
+     @brief Compute the exponent of the embedded second-order update
+     from W2.  With Z0 and Z1 evaluated at t and t + eps/4, the
+     second-order Runge-Kutta update of V_t is exp(eps(2 Z1 - Z0)),
+     which relative to W2 is exp(eps(5/4 T - 3/16 Z0)) up to O(eps^3),
+     where T = 8/9 Z1 - 17/36 Z0 is the content of temp after W2.
+  */
+  template <typename Link, typename Arg>
+  __host__ __device__ inline auto computeVtEmbeddedStep(Arg &arg, const int parity, const int e_cb, const int dir)
+  {
+    Link T = arg.temp(dir, e_cb, parity);
+    Link Z0 = arg.z0(dir, e_cb, parity);
+    Link Z = (5.0 / 4.0) * T - (3.0 / 16.0) * Z0;
+    Z *= arg.epsilon;
+    return Z;
+  }
+
+  /**
+     @brief Apply exp(Z) to U, where Z is projected onto the Lie algebra
+  */
+  template <typename real, int n>
+  __host__ __device__ inline Matrix<complex<real>, n> expUpdate(Matrix<complex<real>, n> Z, const Matrix<complex<real>, n> &U)
+  {
+    const complex<real> im(0.0, -1.0);
+    makeAntiHerm(Z);
+    Z = im * Z;
+    return exponentiate_iQ(Z) * U;
+  }
+
   // Wilson Flow as defined in https://arxiv.org/abs/1006.4518v3
+  template <QudaWFlowType wflow_type, WFlowStepType step_type, typename Arg> struct WFlow {
+    Arg &arg;
+    __device__ __host__ WFlow(Arg &arg) : arg(arg) {}
+
+    /**
+       @brief Apply the substep to one link.  For the Vt step of an
+       adaptive integration, also form the embedded second-order
+       update and return its squared distance from the third-order one.
+    */
+    __device__ __host__ inline double update(int x_cb, int parity, int dir) const
+    {
+      using real = typename Arg::Float;
+      using Link = Matrix<complex<real>, Arg::nColor>;
+
+      //Get stacetime and local coords
+      int x[4];
+      getCoords(x, x_cb, arg.X, parity);
+      for (int dr = 0; dr < 4; ++dr) x[dr] += arg.border[dr];
+      parity = (parity + arg.offset_parity) & 1; // parity on the extended grid
+      const int e_cb = linkIndex(x, arg.E);
+
+      Link U, Z;
+      switch (step_type) {
+      case WFLOW_STEP_W1: Z = computeW1Step<wflow_type>(arg, U, x, parity, e_cb, dir); break;
+      case WFLOW_STEP_W2: Z = computeW2Step<wflow_type>(arg, U, x, parity, e_cb, dir); break;
+      case WFLOW_STEP_VT: Z = computeVtStep<wflow_type>(arg, U, x, parity, e_cb, dir); break;
+      }
+
+      // Compute anti-hermitian projection of Z, exponentiate, update U
+      Link V = expUpdate(Z, U);
+      arg.out(dir, e_cb, parity) = V;
+
+      double err2 = 0.0;
+      if (step_type == WFLOW_STEP_VT && arg.adaptive) {
+        Link D = V - expUpdate(computeVtEmbeddedStep<Link>(arg, parity, e_cb, dir), U);
+#pragma unroll
+        for (int i = 0; i < Arg::nColor; i++)
+#pragma unroll
+          for (int j = 0; j < Arg::nColor; j++) err2 += norm(D(i, j));
+      }
+      return err2;
+    }
+
+    __device__ __host__ inline void operator()(int x_cb, int parity, int dir) const { update(x_cb, parity, dir); }
+  };
+
   template <QudaWFlowType wflow_type, WFlowStepType step_type, typename Arg> __global__ void computeWFlowStep(Arg arg)
   {
-    using real = typename Arg::Float;
-    using Link = Matrix<complex<real>, Arg::nColor>;
-    complex<real> im(0.0,-1.0);
-
     int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
     int parity = threadIdx.y + blockIdx.y * blockDim.y;
     int dir = threadIdx.z + blockIdx.z * blockDim.z;
     if (x_cb >= arg.threads) return;
     if (dir >= Arg::wflow_dim) return;
 
-    //Get stacetime and local coords
-    int x[4];
-    getCoords(x, x_cb, arg.X, parity);
-    for (int dr = 0; dr < 4; ++dr) x[dr] += arg.border[dr];
+    WFlow<wflow_type, step_type, Arg> f(arg);
+    f(x_cb, parity, dir);
+  }
+
+  constexpr int wflow_interior[4] = {0, 0, 0, 0}; // the fused reductions are applied to the interior only
 
-    Link U, Z;
-    switch (step_type) {
-    case WFLOW_STEP_W1: Z = computeW1Step<wflow_type>(arg, U, x, parity, x_cb, dir); break;
-    case WFLOW_STEP_W2: Z = computeW2Step<wflow_type>(arg, U, x, parity, x_cb, dir); break;
-    case WFLOW_STEP_VT: Z = computeVtStep<wflow_type>(arg, U, x, parity, x_cb, dir); break;
+  /**
+     @brief Argument struct for the W1 step fused with the measurement
+     of the observables of its input field
+  */
+  template <typename Float, int nColor, QudaReconstructType recon, int wflow_dim,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
+  struct GaugeWFlowMeasureArg : public GaugeObservablesArg<Float, nColor, recon, false, order> {
+    using WFlowArg = GaugeWFlowArg<Float, nColor, recon, wflow_dim, order>;
+    WFlowArg wflow;
+
+    GaugeWFlowMeasureArg(GaugeField &out, GaugeField &temp, const GaugeField &in, const Float epsilon,
+                         const QudaWFlowType wflow_type, GaugeField &z0) :
+      GaugeObservablesArg<Float, nColor, recon, false, order>(in),
+      wflow(out, temp, in, epsilon, wflow_type, WFLOW_STEP_W1, wflow_interior, z0, false)
+    {
     }
+  };
 
-    // Compute anti-hermitian projection of Z, exponentiate, update U
-    makeAntiHerm(Z);
-    Z = im * Z;
-    U = exponentiate_iQ(Z) * U;
-    arg.out(dir, linkIndex(x, arg.E), parity) = U;
+  /**
+     @brief Argument struct for the Vt step fused with the error estimate
+  */
+  template <typename Float, int nColor, QudaReconstructType recon, int wflow_dim,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
+  struct GaugeWFlowErrorArg : public ReduceArg<double> {
+    using WFlowArg = GaugeWFlowArg<Float, nColor, recon, wflow_dim, order>;
+    WFlowArg wflow;
+    int threads;
+
+    GaugeWFlowErrorArg(GaugeField &out, GaugeField &temp, const GaugeField &in, const Float epsilon,
+                       const QudaWFlowType wflow_type, GaugeField &z0) :
+      ReduceArg<double>(),
+      wflow(out, temp, in, epsilon, wflow_type, WFLOW_STEP_VT, wflow_interior, z0, true),
+      threads(wflow.threads)
+    {
+    }
+  };
+
+  /**
+     @brief Apply the W1 step to all links of a site and return the
+     observables of the input field at the site, so that the flow and
+     the measurement share one pass over the field
+  */
+  template <QudaWFlowType wflow_type, typename Arg> struct WFlowMeasure {
+    using reduce_t = observables_t;
+    Arg &arg;
+    __device__ __host__ WFlowMeasure(Arg &arg) : arg(arg) {}
+
+    __device__ __host__ inline reduce_t operator()(int x_cb, int parity, int = 0) const
+    {
+      WFlow<wflow_type, WFLOW_STEP_W1, typename Arg::WFlowArg> step(arg.wflow);
+#pragma unroll
+      for (int dir = 0; dir < Arg::WFlowArg::wflow_dim; dir++) step(x_cb, parity, dir);
+      return GaugeObservables<Arg>(arg)(x_cb, parity);
+    }
+  };
+
+  /**
+     @brief Apply the Vt step to all links of a site and return the
+     summed squared distance to the embedded second-order update
+  */
+  template <QudaWFlowType wflow_type, typename Arg> struct WFlowError {
+    using reduce_t = double;
+    Arg &arg;
+    __device__ __host__ WFlowError(Arg &arg) : arg(arg) {}
+
+    __device__ __host__ inline reduce_t operator()(int x_cb, int parity, int = 0) const
+    {
+      WFlow<wflow_type, WFLOW_STEP_VT, typename Arg::WFlowArg> step(arg.wflow);
+      reduce_t err2 = 0.0;
+#pragma unroll
+      for (int dir = 0; dir < Arg::WFlowArg::wflow_dim; dir++) err2 += step.update(x_cb, parity, dir);
+      return err2;
+    }
+  };
+
+  template <int blockSize, typename Functor, typename Arg> __global__ void computeWFlowReduce(Arg arg)
+  {
+    int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
+    int parity = threadIdx.y;
+
+    typename Functor::reduce_t value = typename Functor::reduce_t();
+    Functor f(arg);
+
+    while (x_cb < arg.threads) {
+      value = value + f(x_cb, parity);
+      x_cb += blockDim.x * gridDim.x;
+    }
+
+    arg.template reduce2d<blockSize, 2>(value);
   }
 
 } // namespace quda
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+   @file launch_host.h
+
+   Host execution of site-local kernel functors.  A kernel whose body
+   is written as a __device__ __host__ functor over (x_cb, parity, z)
+   can be run on CPU-location fields with the launchers below, with
+   the thread index and the y and z block indices of the device
+   launch mapped to x_cb, parity and z, respectively.  The loops are
+   parallelized with OpenMP when enabled.
+*/
+
+namespace quda
+{
+
+  /**
+     @brief Return the number of host threads the launchers will use
+  */
+  inline int hostThreads()
+  {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+
+  /**
+     @brief Apply a kernel functor to every site on the host,
+     calling f(x_cb, parity, z) for all x_cb < threads, parity <
+     n_parity and z < n_z.
+     @param[in] f The functor to apply
+     @param[in] threads The number of checkerboard sites
+     @param[in] n_parity The number of parities
+     @param[in] n_z The extent of the z dimension (e.g., the number of directions)
+  */
+  template <typename Functor> void launchHost(const Functor &f, int threads, int n_parity = 2, int n_z = 1)
+  {
+#pragma omp parallel for collapse(3) schedule(static)
+    for (int z = 0; z < n_z; z++)
+      for (int parity = 0; parity < n_parity; parity++)
+        for (int x_cb = 0; x_cb < threads; x_cb++) f(x_cb, parity, z);
+  }
+
+  /**
+     @brief Apply a reducing kernel functor to every site on the host,
+     summing the values of f(x_cb, parity, z) of type
+     Functor::reduce_t.  Each thread accumulates into its own buffer,
+     and the buffers are summed in thread order, so the result is
+     reproducible for a given number of threads.
+     @param[in] f The functor to apply
+     @param[in] threads The number of checkerboard sites
+     @param[in] n_parity The number of parities
+     @param[in] n_z The extent of the z dimension
+     @return The sum over all sites
+  */
+  template <typename Functor>
+  typename Functor::reduce_t launchHostReduce(const Functor &f, int threads, int n_parity = 2, int n_z = 1)
+  {
+    using reduce_t = typename Functor::reduce_t;
+    std::vector<reduce_t> partial(hostThreads(), reduce_t());
+
+#pragma omp parallel
+    {
+      reduce_t sum = reduce_t();
+#pragma omp for collapse(3) schedule(static)
+      for (int z = 0; z < n_z; z++)
+        for (int parity = 0; parity < n_parity; parity++)
+          for (int x_cb = 0; x_cb < threads; x_cb++) sum = sum + f(x_cb, parity, z);
+#ifdef _OPENMP
+      partial[omp_get_thread_num()] = sum;
+#else
+      partial[0] = sum;
+#endif
+    }
+
+    reduce_t sum = reduce_t();
+    for (auto &p : partial) sum = sum + p;
+    return sum;
+  }
+
+  /**
+     @brief Apply a kernel functor that accumulates into an array on
+     the host: f(x_cb, parity, z, sum) adds its contributions to the
+     elements of the array sum, which has the length of result.  As
+     with launchHostReduce, each thread accumulates into its own array
+     and the arrays are summed in thread order.
+     @param[out] result The sum over all sites
+     @param[in] f The functor to apply
+     @param[in] threads The number of checkerboard sites
+     @param[in] n_parity The number of parities
+     @param[in] n_z The extent of the z dimension
+  */
+  template <typename T, typename Functor>
+  void launchHostReduceArray(std::vector<T> &result, const Functor &f, int threads, int n_parity = 2, int n_z = 1)
+  {
+    std::vector<std::vector<T>> partial(hostThreads(), std::vector<T>(result.size(), T()));
+
+#pragma omp parallel
+    {
+#ifdef _OPENMP
+      T *sum = partial[omp_get_thread_num()].data();
+#else
+      T *sum = partial[0].data();
+#endif
+#pragma omp for collapse(3) schedule(static)
+      for (int z = 0; z < n_z; z++)
+        for (int parity = 0; parity < n_parity; parity++)
+          for (int x_cb = 0; x_cb < threads; x_cb++) f(x_cb, parity, z, sum);
+    }
+
+    for (auto &r : result) r = T();
+    for (auto &p : partial)
+      for (auto i = 0u; i < result.size(); i++) result[i] = result[i] + p[i];
+  }
+
+} // namespace quda
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+namespace quda
+{
+
+  class ColorSpinorField;
+  class GaugeField;
+
+  /**
+     @brief A checkpoint of one level of a multigrid hierarchy.  Each
+     rank writes its own file, <prefix>_level_<level>.rank<rank>,
+     holding a sequence of named records (null-space vectors,
+     block-orthogonalized prolongator, coarse link fields, coarse
+     deflation space) that are read back in the order they were
+     written.  Every record is the raw storage of a field, so
+     restoring is bitwise exact but requires the same process grid,
+     lattice and multigrid parameters as the run that wrote it; the
+     record names and sizes are checked on restore.
+   */
+  class MGCheckpoint
+  {
+    std::string filename;
+    FILE *file;
+    const bool writing;
+    size_t bytes; /** Total payload bytes transferred */
+
+    /**
+       @brief Write a record
+       @param[in] name The record name
+       @param[in] data The payload, in host or device memory
+       @param[in] size The payload bytes
+       @param[in] norm The norm payload of fixed-point fields (or nullptr)
+       @param[in] norm_size The norm payload bytes
+       @param[in] scale The scale factor of the field
+       @param[in] device Whether the payloads reside in device memory
+    */
+    void write(const char *name, const void *data, size_t size, const void *norm, size_t norm_size, double scale,
+               bool device);
+
+    /**
+       @brief Read a record, checking its name and size
+       @param[in] name The expected record name
+       @param[out] data The payload, in host or device memory
+       @param[in] size The expected payload bytes
+       @param[out] norm The norm payload of fixed-point fields (or nullptr)
+       @param[in] norm_size The expected norm payload bytes
+       @param[in] device Whether the payloads reside in device memory
+       @return The scale factor of the field
+    */
+    double read(const char *name, void *data, size_t size, void *norm, size_t norm_size, bool device);
+
+  public:
+    /**
+       @brief Open the checkpoint file of this rank for a given level
+       @param[in] prefix The checkpoint filename prefix
+       @param[in] level The multigrid level
+       @param[in] write Whether we are writing (else restoring)
+    */
+    MGCheckpoint(const std::string &prefix, int level, bool write);
+
+    ~MGCheckpoint();
+
+    /**
+       @return Whether this checkpoint is being written
+    */
+    bool Writing() const { return writing; }
+
+    /**
+       @brief Write a spinor field record
+       @param[in] name The record name
+       @param[in] v The field to write
+    */
+    void save(const char *name, const ColorSpinorField &v);
+
+    /**
+       @brief Read a spinor field record into a preallocated field
+       @param[in] name The record name
+       @param[out] v The field to read into
+    */
+    void load(const char *name, ColorSpinorField &v);
+
+    /**
+       @brief Write a device gauge field record
+       @param[in] name The record name
+       @param[in] u The field to write
+    */
+    void save(const char *name, const GaugeField &u);
+
+    /**
+       @brief Read a device gauge field record into a preallocated field
+       @param[in] name The record name
+       @param[out] u The field to read into
+    */
+    void load(const char *name, GaugeField &u);
+
+    /**
+       @brief Write an integer record (e.g., the size of a set of vectors)
+       @param[in] name The record name
+       @param[in] n The value to write
+    */
+    void save(const char *name, int n);
+
+    /**
+       @brief Read an integer record
+       @param[in] name The record name
+       @return The value read
+    */
+    int load(const char *name);
+  };
+
+} // namespace quda
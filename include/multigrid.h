@@ -15,6 +15,7 @@ namespace quda {
   // forward declarations
   class MG;
   class DiracCoarse;
+  class MGCheckpoint;
 
   /**
      This struct contains all the metadata required to define the
@@ -104,6 +105,9 @@ namespace quda {
     /** Whether to use tensor cores (if available) */
     bool use_mma;
 
+    /** If set, the checkpoint prefix from which the hierarchy is restored rather than set up */
+    std::string checkpoint;
+
     /**
        This is top level instantiation done when we start creating the multigrid operator.
      */
@@ -131,7 +135,8 @@ namespace quda {
       location(param.location[level]),
       setup_location(param.setup_location[level]),
       transfer_type(param.transfer_type[level]),
-      use_mma(param.use_mma == QUDA_BOOLEAN_TRUE)
+      use_mma(param.use_mma == QUDA_BOOLEAN_TRUE),
+      checkpoint("")
     {
       // set the block size
       for (int i = 0; i < QUDA_MAX_DIM; i++) geoBlockSize[i] = param.geo_block_size[level][i];
@@ -166,7 +171,8 @@ namespace quda {
       location(param.mg_global.location[level]),
       setup_location(param.mg_global.setup_location[level]),
       transfer_type(param.mg_global.transfer_type[level]),
-      use_mma(param.use_mma)
+      use_mma(param.use_mma),
+      checkpoint(param.checkpoint)
     {
       // set the block size
       for (int i = 0; i < QUDA_MAX_DIM; i++) geoBlockSize[i] = param.mg_global.geo_block_size[level][i];
@@ -176,6 +182,19 @@ namespace quda {
     }
   };
 
+  /**
+     @brief Select the null-space vectors to refresh following an
+     operator update
+     @param[in] residual Near-null residuals under the updated operator
+     @param[in] baseline Near-null residuals the vectors are judged against
+     @param[in] tol Relative growth of the residual beyond which a vector is refreshed
+     @param[in] all Whether to refresh every vector, e.g., since the
+     coarse-grid iteration count has grown
+     @return Indices of the vectors to refresh
+  */
+  std::vector<int> staleNullVectors(const std::vector<double> &residual, const std::vector<double> &baseline,
+                                    double tol, bool all);
+
   /**
      Adaptive Multigrid solver
    */
@@ -278,6 +297,21 @@ namespace quda {
     /** Parallel hyper-cubic random number generator for generating null-space vectors */
     RNG *rng;
 
+    /** Near-null residuals |D v_k| / |v_k| measured when the null-space vectors were last generated or refreshed */
+    std::vector<double> null_residual;
+
+    /** Number of coarse-grid solves since the last (re)setup */
+    int coarse_solve_count;
+
+    /** Accumulated coarse-grid solver iterations since the last (re)setup */
+    long coarse_solve_iter;
+
+    /** Mean coarse-grid solver iteration count following the last null-space generation (negative if unset) */
+    double coarse_iter_baseline;
+
+    /** The checkpoint this level is being restored from (only set during the initial setup) */
+    MGCheckpoint *restore;
+
     /**
        @brief Helper function called on entry to each MG function
        @param[in] level The level we working on
@@ -320,6 +354,14 @@ public:
     */
     void dumpNullVectors() const;
 
+    /**
+       @brief Checkpoint this level of the hierarchy to disk: the
+       null-space vectors, prolongator, coarse operator and coarse
+       deflation space.  Will recurse checkpointing all levels.
+       @param[in] prefix The checkpoint filename prefix
+    */
+    void saveCheckpoint(const std::string &prefix) const;
+
     /**
        @brief Create the smoothers
     */
@@ -384,6 +426,26 @@ public:
     */
     void generateNullVectors(std::vector<ColorSpinorField*> &B, bool refresh=false);
 
+    /**
+       @brief Adaptively refresh the null-space vectors following an
+       operator update.  The near-null residual of each vector and the
+       coarse-grid solver iteration count are compared against their
+       values at the last setup, and only the vectors found to have
+       degraded are refreshed, repeating for at most
+       setup_refresh_max_pass passes.  Following a refresh, the
+       residuals of the refreshed null space become the new baseline.
+       @return Whether any null-space vectors were refreshed
+    */
+    bool refreshNullVectors();
+
+    /**
+       @brief Compute the near-null residual |D v_k| / |v_k| for each
+       null-space vector on this level.  If the residual operator has
+       a batched multi-RHS kernel the vectors are applied in batches.
+       @return Vector of near-null residuals
+    */
+    std::vector<double> nullResidual();
+
     /**
        @brief Generate lowest eigenvectors
     */
@@ -516,7 +578,12 @@ public:
     MG *mg;
     TimeProfile &profile;
 
-    multigrid_solver(QudaMultigridParam &mg_param, TimeProfile &profile);
+    /**
+       @param[in] mg_param The multigrid parameters
+       @param[in] profile The profile to record the setup against
+       @param[in] checkpoint If set, the checkpoint prefix to restore the hierarchy from
+    */
+    multigrid_solver(QudaMultigridParam &mg_param, TimeProfile &profile, const char *checkpoint = nullptr);
 
     virtual ~multigrid_solver()
     {
@@ -7,9 +7,11 @@ namespace quda {
 
   /**
    * @brief Perform heatbath and overrelaxation. Performs nhb heatbath steps followed by nover overrelaxation steps.
+   * Host fields in QDP order are updated with host threads; since the random numbers depend only on
+   * the site, sweep and direction, the result does not depend on the number of threads.
    *
    * @param[in,out] data Gauge field
-   * @param[in,out] rngstate state of the CURAND random number generator
+   * @param[in,out] rngstate random number generator
    * @param[in] Beta inverse of the gauge coupling, beta = 2 Nc / g_0^2
    * @param[in] nhb number of heatbath steps
    * @param[in] nover number of overrelaxation steps
@@ -31,7 +33,7 @@ namespace quda {
    * in multi-GPU case.
    *
    * @param[in,out] data Gauge field
-   * @param[in,out] rngstate state of the CURAND random number generator
+   * @param[in,out] rngstate random number generator
    */
   void InitGaugeField(GaugeField &data, RNG &rngstate);
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #ifdef HAVE_QIO
 void read_gauge_field(const char *filename, void *gauge[], QudaPrecision prec, const int *X,
 		      int argc, char *argv[]);
@@ -8,6 +10,35 @@ void read_spinor_field(const char *filename, void *V[], QudaPrecision precision,
                        QudaParity parity, int nColor, int nSpin, int Nvec, int argc, char *argv[]);
 void write_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X, QudaSiteSubset subset,
                         QudaParity parity, int nColor, int nSpin, int Nvec, int argc, char *argv[]);
+
+/**
+   @brief Read Nvec vector fields from file, handing them over in
+   batches of at most batch_size fields.  Files that store the fields
+   across several records are supported, and records larger than the
+   batch size are read over multiple passes.
+   @param[in] acquire Called with (start, count) before each batch is
+   read, returning the host pointers the fields [start, start+count)
+   are to be read into
+   @param[in] release Called with (start, count) once the batch has
+   been read
+ */
+void read_spinor_field_batched(const char *filename, QudaPrecision precision, const int *X, QudaSiteSubset subset,
+                               QudaParity parity, int nColor, int nSpin, int Nvec, int batch_size,
+                               const std::function<void **(int, int)> &acquire,
+                               const std::function<void(int, int)> &release);
+
+/**
+   @brief Write Nvec vector fields to file, with each batch of at most
+   batch_size fields stored as a separate record.
+   @param[in] acquire Called with (start, count) before each batch is
+   written, returning the host pointers of the fields [start, start+count)
+   @param[in] release Called with (start, count) once the batch has
+   been written
+ */
+void write_spinor_field_batched(const char *filename, QudaPrecision precision, const int *X, QudaSiteSubset subset,
+                                QudaParity parity, int nColor, int nSpin, int Nvec, int batch_size,
+                                const std::function<void **(int, int)> &acquire,
+                                const std::function<void(int, int)> &release);
 #else
 inline void read_gauge_field(const char *filename, void *gauge[], QudaPrecision prec, const int *X, int argc,
                              char *argv[])
@@ -35,5 +66,21 @@ inline void write_spinor_field(const char *filename, void *V[], QudaPrecision pr
   printf("QIO support has not been enabled\n");
   exit(-1);
 }
+inline void read_spinor_field_batched(const char *filename, QudaPrecision precision, const int *X,
+                                      QudaSiteSubset subset, QudaParity parity, int nColor, int nSpin, int Nvec,
+                                      int batch_size, const std::function<void **(int, int)> &acquire,
+                                      const std::function<void(int, int)> &release)
+{
+  printf("QIO support has not been enabled\n");
+  exit(-1);
+}
+inline void write_spinor_field_batched(const char *filename, QudaPrecision precision, const int *X,
+                                       QudaSiteSubset subset, QudaParity parity, int nColor, int nSpin, int Nvec,
+                                       int batch_size, const std::function<void **(int, int)> &acquire,
+                                       const std::function<void(int, int)> &release)
+{
+  printf("QIO support has not been enabled\n");
+  exit(-1);
+}
 
 #endif
@@ -430,6 +430,23 @@ extern "C" {
         false, but preserve_deflation would be true */
     QudaBoolean preserve_evals;
 
+    /** Whether to store the deflation space in compressed form: a
+        small set of block-orthogonalized basis vectors together with
+        low-precision coarse-grid coefficients for each eigenvector,
+        with eigenvectors reconstructed on the fly by prolongation */
+    QudaBoolean compress_deflation;
+
+    /** Number of basis vectors used for the compressed deflation
+        space (this sets the coarse color count so must be supported
+        by the multigrid build, e.g., 24 or 32) */
+    int compress_n_basis;
+
+    /** Geometric block size used for the compressed deflation space */
+    int compress_block_size[4];
+
+    /** Precision of the compressed basis and coefficients */
+    QudaPrecision compress_precision;
+
     /** What type of Dirac operator we are using **/
     /** If !(use_norm_op) && !(use_dagger) use M. **/
     /** If use_dagger, use Mdag **/
@@ -571,6 +588,24 @@ extern "C" {
     /** Maximum number of iterations for refreshing the null-space vectors */
     int setup_maxiter_refresh[QUDA_MAX_MG_LEVEL];
 
+    /** Whether to adaptively refresh the null-space vectors, only
+        regenerating those vectors that have degraded under the
+        updated operator */
+    QudaBoolean setup_refresh_adaptive[QUDA_MAX_MG_LEVEL];
+
+    /** Adaptive refresh: a null-space vector v is refreshed when its
+        near-null residual |D v| / |v| has grown by more than this
+        factor relative to its value at the last setup */
+    double setup_refresh_tol[QUDA_MAX_MG_LEVEL];
+
+    /** Adaptive refresh: all null-space vectors are refreshed when the
+        mean coarse-grid solver iteration count has grown by more than
+        this factor relative to that following the last setup */
+    double setup_refresh_iter_growth[QUDA_MAX_MG_LEVEL];
+
+    /** Adaptive refresh: maximum number of refresh passes */
+    int setup_refresh_max_pass[QUDA_MAX_MG_LEVEL];
+
     /** Basis to use for CA-CGN(E/R) setup */
     QudaCABasis setup_ca_basis[QUDA_MAX_MG_LEVEL];
 
@@ -691,6 +726,10 @@ extern "C" {
     /** Filename prefix for where to save the null-space vectors */
     char vec_outfile[QUDA_MAX_MG_LEVEL][256];
 
+    /** Whether to save half or quarter precision null-space vectors
+        to a native block-scaled vector archive rather than through QIO */
+    QudaBoolean vec_archive[QUDA_MAX_MG_LEVEL];
+
     /** Whether to use and initial guess during coarse grid deflation */
     QudaBoolean coarse_guess;
 
@@ -1034,6 +1073,51 @@ extern "C" {
    */
   void invertQuda(void *h_x, void *h_b, QudaInvertParam *param);
 
+  /**
+   * Create a solve context for repeated solves with @invertQuda
+   * semantics.  The Dirac operators, the solver with its workspace
+   * and the device source and solution fields are constructed on the
+   * first solve and kept alive between solves.  It is assumed that
+   * the gauge field has already been loaded via loadGaugeQuda().
+   * @param param  Contains all metadata regarding host and device
+   *               storage and solver parameters
+   * @return Pointer to the solve context
+   */
+  void *newSolveContextQuda(QudaInvertParam *param);
+
+  /**
+   * Perform a solve with a solve context.  The result is identical
+   * to that of @invertQuda with the same arguments.  The per-solve
+   * parameters (tol, tol_hq, maxiter, compute_true_res,
+   * compute_action, use_init_guess, solver_normalization, verbosity
+   * and tune) and the host field layout (cpu_prec, dirac_order,
+   * gamma_basis, input_location and output_location) may change
+   * freely between solves; a change to any other parameter, or a
+   * reload or release of the resident gauge or clover fields, makes
+   * the context rebuild its state.  The chrono and resident solution
+   * options are not supported.
+   * @param context  Solve context created by @newSolveContextQuda
+   * @param h_x      Solution spinor field
+   * @param h_b      Source spinor field
+   * @param param    Contains all metadata regarding host and device
+   *                 storage and solver parameters
+   */
+  void solveWithContextQuda(void *context, void *h_x, void *h_b, QudaInvertParam *param);
+
+  /**
+   * Query how often a solve context has built its state, i.e., one
+   * for its first solve plus one for every rebuild
+   * @param context  Solve context created by @newSolveContextQuda
+   * @return The number of times the state has been built
+   */
+  int getSolveContextBuildsQuda(void *context);
+
+  /**
+   * Free the resources held by a solve context
+   * @param context  Solve context created by @newSolveContextQuda
+   */
+  void destroySolveContextQuda(void *context);
+
   /**
    * Perform the solve like @invertQuda but for multiples right hand sides.
    *
@@ -1089,6 +1173,33 @@ extern "C" {
    */
   void dumpMultigridQuda(void *mg_instance, QudaMultigridParam *param);
 
+  /**
+   * @brief Checkpoint the complete multigrid hierarchy to disk: on
+   * each level the null-space vectors, the block-orthogonalized
+   * prolongator and the coarse link and clover fields, together with
+   * the coarse-grid deflation space if present.  Each rank writes its
+   * own file per level, <prefix>_level_<level>.rank<rank>.
+   * @param[in] mg_instance Pointer to the instance of multigrid_solver
+   * @param[in] param Contains all metadata regarding host and device
+   * storage and solver parameters
+   * @param[in] prefix The checkpoint filename prefix
+   */
+  void checkpointMultigridQuda(void *mg_instance, QudaMultigridParam *param, const char *prefix);
+
+  /**
+   * @brief Create a multigrid solver from a checkpoint written by
+   * checkpointMultigridQuda, skipping the null-space generation,
+   * block orthogonalization, coarse-operator construction and
+   * coarse-grid eigensolve.  The gauge field, process grid and
+   * multigrid parameters must match those of the checkpointed
+   * instance.
+   * @param[in] param Contains all metadata regarding host and device
+   * storage and solver parameters
+   * @param[in] prefix The checkpoint filename prefix
+   * @return Pointer to instance of multigrid_solver
+   */
+  void *restoreMultigridQuda(QudaMultigridParam *param, const char *prefix);
+
   /**
    * Apply the Dslash operator (D_{eo} or D_{oe}).
    * @param h_out  Result spinor field
@@ -1382,6 +1493,18 @@ extern "C" {
    */
   void performWFlownStep(unsigned int n_steps, double step_size, int meas_interval, QudaWFlowType wflow_type);
 
+  /**
+   * Performs Wilson Flow on gaugePrecise up to a given flow time with
+   * an adaptive step size, and stores it in gaugeSmeared
+   * @param t_max Flow time to integrate to
+   * @param step_size Initial size of Wilson Flow step
+   * @param tol Tolerance on the RMS link distance between each step
+   * and its embedded second-order estimate
+   * @param meas_interval Measure the Q charge and field energy every Nth step
+   * @param wflow_type 1x1 Wilson or 2x1 Symanzik flow type
+   */
+  void performWFlowAdaptive(double t_max, double step_size, double tol, int meas_interval, QudaWFlowType wflow_type);
+
   /**
    * @brief Calculates a variety of gauge-field observables.  If a
    * smeared gauge field is presently loaded (in gaugeSmeared) the
@@ -1404,6 +1527,47 @@ extern "C" {
   void contractQuda(const void *x, const void *y, void *result, const QudaContractType cType, QudaInvertParam *param,
                     const int *X);
 
+  /**
+   * Public function to perform color contractions of the host spinors x and y,
+   * projected onto a set of spatial momenta and summed over timeslices in the
+   * contraction kernel, so only the correlators are returned.
+   * @param[in] x pointer to host data
+   * @param[in] y pointer to host data
+   * @param[out] result pointer to Nt * n_mom * n_gamma complex correlators
+   * C(t, p, g) = sum_x exp(-i p.x) C_g(x, t), with t the slowest and g the
+   * fastest index, where Nt is the global temporal extent
+   * @param[in] cType Which type of contraction (open, degrand-rossi)
+   * @param[in] mom pointer to 3 * n_mom integer momentum components, in units of 2 pi / L
+   * @param[in] n_mom number of momenta
+   * @param[in] gamma pointer to the n_gamma contractions to project, each in [0, 16)
+   * @param[in] n_gamma number of contractions
+   * @param[in] param meta data for construction of ColorSpinorFields.
+   * @param[in] X spacetime data for construction of ColorSpinorFields.
+   */
+  void contractFTQuda(const void *x, const void *y, double *result, const QudaContractType cType, const int *mom,
+                      int n_mom, const int *gamma, int n_gamma, QudaInvertParam *param, const int *X);
+
+  /**
+   * Public function to evaluate meson and nucleon correlators of two host
+   * propagators in a single sweep over the lattice, projected onto a set of
+   * spatial momenta and summed over timeslices.
+   * @param[in] prop1 array of 12 pointers to the host data of the propagator S1,
+   * where element 3 * s + c is the solution for a source of spin s and color c
+   * @param[in] prop2 array of 12 pointers to the host data of the propagator S2
+   * @param[out] meson pointer to Nt * n_mom * 16 complex correlators
+   * Tr[Gamma_g S1 Gamma_g gamma_5 S2^dagger gamma_5], ordered [t][mom][g],
+   * with the gamma structures g of the degrand-rossi contraction
+   * @param[out] baryon pointer to Nt * n_mom * 16 complex elements of the 4 x 4
+   * spin matrix of the nucleon correlator with diquark C gamma_5 and S1 the
+   * doubly represented quark, ordered [t][mom][alpha][alpha']
+   * @param[in] mom pointer to 3 * n_mom integer momentum components, in units of 2 pi / L
+   * @param[in] n_mom number of momenta
+   * @param[in] param meta data for construction of ColorSpinorFields.
+   * @param[in] X spacetime data for construction of ColorSpinorFields.
+   */
+  void contractPropagatorsQuda(void **prop1, void **prop2, double *meson, double *baryon, const int *mom, int n_mom,
+                               QudaInvertParam *param, const int *X);
+
   /**
    * @brief Gauge fixing with overrelaxation with support for single and multi GPU.
    * @param[in,out] gauge, gauge field to be fixed
@@ -5,147 +5,242 @@
 #ifdef __CUDACC_RTC__
 #define RNG int
 #else
-#include <curand_kernel.h>
 
 namespace quda {
 
-#if defined(XORWOW)
-typedef struct curandStateXORWOW cuRNGState;
-#elif defined(MRG32k3a)
-typedef struct curandStateMRG32k3a cuRNGState;
-#else
-typedef struct curandStateMRG32k3a cuRNGState;
-#endif
+  /**
+     @brief Counter-based random number generator.  Random numbers
+     are generated with the Philox4x32-10 bijection, keyed on the
+     seed, applied to a counter composed of the global lattice site
+     index, a stream index and a per-site draw counter.  There is no
+     per-site state to allocate, store or back up: each kernel
+     launch obtains its own streams with next(), and each thread
+     constructs an RNGState for the site it is generating at.  Since
+     the counter depends only on the global site coordinates, the
+     random fields are independent of the process grid, the thread
+     count and whether they are generated on the host or the device.
+  */
+  class RNG {
+
+    unsigned long long seed; /** initial rng seed */
+    unsigned int stream;     /** first stream not yet handed out by next() */
+    int X[4];                /** local (interior) lattice dimensions */
+    int G[4];                /** global lattice dimensions */
+    int offset[4];           /** global coordinates of the local origin */
+
+    /**
+       @brief Set the lattice geometry from the field dimensions
+       @param[in] x The field dimensions (checkerboarded in x[0] for single-parity fields)
+       @param[in] r The extended field radius
+       @param[in] site_subset The site subset of the field
+    */
+    void init(const int *x, const int *r, QudaSiteSubset site_subset);
 
-/**
-   @brief Class declaration to initialize and hold CURAND RNG states
-*/
-class RNG {
+  public:
+    /**
+       @brief Constructor that takes its metadata from a field
+       @param[in] meta The field whose data we use
+       @param[in] seed Seed to initialize the RNG
+    */
+    RNG(const LatticeField &meta, unsigned long long seedin);
+
+    /**
+       @brief Constructor that takes its metadata from a param
+       @param[in] param The param whose data we use
+       @param[in] seed Seed to initialize the RNG
+     */
+    RNG(const LatticeFieldParam &param, unsigned long long seedin);
+
+    __host__ __device__ unsigned long long Seed() const { return seed; };
+
+    __host__ __device__ unsigned int Stream() const { return stream; };
+
+    /**
+       @brief Return a copy of this generator for use by one kernel
+       launch, reserving n_stream streams for it, and advance this
+       generator past them so that subsequent launches draw fresh
+       random numbers.  Since the copy is immutable, relaunching the
+       kernel (e.g., when autotuning) reproduces the same numbers.
+       @param[in] n_stream Number of streams the launch will use
+       @return Generator for the launch
+    */
+    RNG next(unsigned int n_stream = 1)
+    {
+      RNG rng = *this;
+      stream += n_stream;
+      return rng;
+    }
 
-  private:
-  cuRNGState *state;        /*! array with current curand rng state */
-  cuRNGState *backup_state; /*! array for backup of current curand rng state */
-  unsigned long long seed;  /*! initial rng seed */
-  int size;                 /*! @brief number of curand states */
-  int size_cb;        /*! @brief number of curand states checkerboarded (equal to size if we have a single parity) */
-  int X[4];           /*! @brief local lattice dimensions */
-  void AllocateRNG(); /*! @brief allocate curand rng states array in device memory */
+    /**
+       @brief Return the global lexicographic index of a site
+       @param[in] x Local (interior) site coordinates
+       @param[in] s Local fifth-dimension coordinate
+       @return The global site index
+    */
+    __host__ __device__ inline unsigned long long globalIndex(const int x[4], int s = 0) const
+    {
+      unsigned long long idx = s;
+      for (int d = 3; d >= 0; d--) idx = idx * G[d] + (x[d] + offset[d]);
+      return idx;
+    }
 
-  public:
-  /**
-     @brief Constructor that takes its metadata from a field
-     @param[in] meta The field whose data we use
-     @param[in] seed Seed to initialize the RNG
-  */
-  RNG(const LatticeField &meta, unsigned long long seedin);
+    /**
+       @brief Return the global lexicographic index of a site
+       @param[in] x_cb Checkerboarded site index (including any fifth dimension)
+       @param[in] parity Site parity
+       @return The global site index
+    */
+    __host__ __device__ inline unsigned long long globalIndex(int x_cb, int parity) const
+    {
+      const int volume_4d_cb = (X[0] * X[1] * X[2] * X[3]) / 2;
+      const int s = x_cb / volume_4d_cb;
+      x_cb -= s * volume_4d_cb;
+
+      int x[4];
+      int za = x_cb / (X[0] / 2);
+      int zb = za / X[1];
+      x[1] = za - zb * X[1];
+      x[3] = zb / X[2];
+      x[2] = zb - x[3] * X[2];
+      int x1odd = (x[1] + x[2] + x[3] + parity) & 1;
+      x[0] = 2 * x_cb + x1odd - za * X[0];
+      return globalIndex(x, s);
+    }
+  };
 
   /**
-     @brief Constructor that takes its metadata from a param
-     @param[in] param The param whose data we use
-     @param[in] seed Seed to initialize the RNG
-   */
-  RNG(const LatticeFieldParam &param, unsigned long long seedin);
-
-  /*! free array */
-  void Release();
-
-  /*! initialize curand rng states with seed */
-  void Init();
-
-  unsigned long long Seed() { return seed; };
-
-  __host__ __device__ __inline__ cuRNGState *State() { return state; };
-
-  /*! @brief Restore CURAND array states initialization */
-  void restore();
-
-  /*! @brief Backup CURAND array states initialization */
-  void backup();
-};
-
-
-/**
-   @brief Return a random number between a and b
-   @param state curand rng state
-   @param a lower range
-   @param b upper range
-   @return  random number in range a,b
-*/
-template<class Real>
-inline  __device__ Real Random(cuRNGState &state, Real a, Real b){
-    Real res;
-    return res;
-}
-
-template<>
-inline  __device__ float Random<float>(cuRNGState &state, float a, float b){
-    return a + (b - a) * curand_uniform(&state);
-}
-
-template<>
-inline  __device__ double Random<double>(cuRNGState &state, double a, double b){
-    return a + (b - a) * curand_uniform_double(&state);
-}
-
-/**
-   @brief Return a random number between 0 and 1
-   @param state curand rng state
-   @return  random number in range 0,1
-*/
-template<class Real>
-inline  __device__ Real Random(cuRNGState &state){
-    Real res;
-    return res;
-}
-
-template<>
-inline  __device__ float Random<float>(cuRNGState &state){
-    return curand_uniform(&state);
-}
-
-template<>
-inline  __device__ double Random<double>(cuRNGState &state){
-    return curand_uniform_double(&state);
-}
-
-
-template<class Real>
-struct uniform { };
-template<>
-struct uniform<float> {
-    __device__
-        static inline float rand(cuRNGState &state) {
-        return curand_uniform(&state);
-    }
-};
-template<>
-struct uniform<double> {
-    __device__
-        static inline double rand(cuRNGState &state) {
-        return curand_uniform_double(&state);
+     @brief Random number stream of one lattice site.  This is a
+     Philox4x32-10 generator whose 128-bit counter is (draw, stream,
+     site low word, site high word) and whose key is the seed; each
+     evaluation yields four 32-bit random numbers.  It is cheap to
+     construct, so kernels create it in registers where needed.
+  */
+  class RNGState {
+
+    unsigned int counter[4];
+    unsigned int key[2];
+    unsigned int output[4];
+    int remaining;
+
+    __host__ __device__ static inline unsigned int mulhilo(unsigned int a, unsigned int b, unsigned int &hi)
+    {
+      unsigned long long product = static_cast<unsigned long long>(a) * b;
+      hi = static_cast<unsigned int>(product >> 32);
+      return static_cast<unsigned int>(product);
     }
-};
 
+    /**
+       @brief Advance to the next block of four random numbers
+    */
+    __host__ __device__ inline void generate()
+    {
+#pragma unroll
+      for (int i = 0; i < 4; i++) output[i] = counter[i];
+      philox(output, key);
+      counter[0]++;
+      remaining = 4;
+    }
 
+  public:
+    /**
+       @brief Constructor for the stream of a given site
+       @param[in] rng The generator of this kernel launch
+       @param[in] site Global site index (see RNG::globalIndex)
+       @param[in] sub Stream offset within the streams reserved for the launch
+    */
+    __host__ __device__ RNGState(const RNG &rng, unsigned long long site, unsigned int sub = 0) : remaining(0)
+    {
+      counter[0] = 0;
+      counter[1] = rng.Stream() + sub;
+      counter[2] = static_cast<unsigned int>(site);
+      counter[3] = static_cast<unsigned int>(site >> 32);
+      key[0] = static_cast<unsigned int>(rng.Seed());
+      key[1] = static_cast<unsigned int>(rng.Seed() >> 32);
+    }
 
-template<class Real>
-struct normal { };
-template<>
-struct normal<float> {
-    __device__
-        static inline float rand(cuRNGState &state) {
-        return curand_normal(&state);
+    /**
+       @brief Apply the Philox4x32-10 bijection
+       @param[in,out] c The 128-bit counter, replaced by the random output
+       @param[in] key The 64-bit key
+    */
+    __host__ __device__ static inline void philox(unsigned int c[4], const unsigned int key[2])
+    {
+      unsigned int k[2] = {key[0], key[1]};
+#pragma unroll
+      for (int round = 0; round < 10; round++) {
+        unsigned int hi0, hi1;
+        unsigned int lo0 = mulhilo(0xD2511F53u, c[0], hi0);
+        unsigned int lo1 = mulhilo(0xCD9E8D57u, c[2], hi1);
+        c[0] = hi1 ^ c[1] ^ k[0];
+        c[1] = lo1;
+        c[2] = hi0 ^ c[3] ^ k[1];
+        c[3] = lo0;
+        k[0] += 0x9E3779B9u;
+        k[1] += 0xBB67AE85u;
+      }
     }
-};
-template<>
-struct normal<double> {
-    __device__
-        static inline double rand(cuRNGState &state) {
-        return curand_normal_double(&state);
+
+    /**
+       @brief Return the next 32-bit random number
+    */
+    __host__ __device__ inline unsigned int operator()()
+    {
+      if (remaining == 0) generate();
+      // rotate the outputs rather than indexing to keep them in registers
+      unsigned int r = output[0];
+      output[0] = output[1];
+      output[1] = output[2];
+      output[2] = output[3];
+      remaining--;
+      return r;
     }
-};
+  };
+
+  /**
+     @brief Return a random number between 0 and 1 (excluding both end points)
+     @param state rng state
+     @return  random number in range 0,1
+  */
+  template <class Real> __host__ __device__ inline Real Random(RNGState &state);
+
+  template <> __host__ __device__ inline float Random<float>(RNGState &state)
+  {
+    return ((state() >> 9) + 0.5f) * 1.1920928955078125e-7f; // 2^-23
+  }
+
+  template <> __host__ __device__ inline double Random<double>(RNGState &state)
+  {
+    unsigned long long hi = state();
+    unsigned long long lo = state();
+    return ((((hi << 32) | lo) >> 12) + 0.5) * 2.220446049250313e-16; // 2^-52
+  }
 
+  /**
+     @brief Return a random number between a and b
+     @param state rng state
+     @param a lower range
+     @param b upper range
+     @return  random number in range a,b
+  */
+  template <class Real> __host__ __device__ inline Real Random(RNGState &state, Real a, Real b)
+  {
+    return a + (b - a) * Random<Real>(state);
+  }
+
+  template <class Real> struct uniform {
+    __host__ __device__ static inline Real rand(RNGState &state) { return Random<Real>(state); }
+  };
+
+  template <class Real> struct normal {
+    __host__ __device__ static inline Real rand(RNGState &state)
+    {
+      // Box-Muller, discarding the second variate
+      Real radius = sqrt(static_cast<Real>(-2.0) * log(Random<Real>(state)));
+      Real phi = static_cast<Real>(2.0 * M_PI) * Random<Real>(state);
+      return radius * cos(phi);
+    }
+  };
 
-}
+} // namespace quda
 
 #endif
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <cub_helper.cuh>
+#include <comm_quda.h>
+#include <compensated.h>
 
-#ifdef QUAD_SUM
+#if defined(QUAD_SUM)
 using device_reduce_t = doubledouble;
+#elif defined(QUDA_REDUCE_COMPENSATED)
+using device_reduce_t = quda::compensated;
 #else
 using device_reduce_t = double;
 #endif
@@ -46,15 +50,44 @@ namespace quda
   /**
      @brief The atomic word size we use for a given reduction type.
      This type should be lock-free to guarantee correct behaviour on
-     platforms that are not coherent with respect to the host
+     platforms that are not coherent with respect to the host, so
+     extended-precision reduction types are transferred as multiple
+     double words.
    */
   template <typename T> struct atomic_type {
-    using type = device_reduce_t;
+    using type = double;
   };
   template <> struct atomic_type<float> {
     using type = float;
   };
 
+  /**
+     @brief Sum a locally computed reduction result over all processes
+     and convert it to the type returned to the caller.
+     @param[out] result The global result
+     @param[in] partial The local result, in the reduction type
+  */
+  template <typename host_t, typename reduce_t>
+  typename std::enable_if<!is_compensated<reduce_t>::value>::type reduce_global(host_t &result, reduce_t &partial)
+  {
+    reduce_convert(result, partial);
+    reduceDoubleArray(reinterpret_cast<double *>(&result), sizeof(host_t) / sizeof(double));
+  }
+
+  /**
+     @brief Compensated variant of reduce_global: the compensation
+     terms are carried through the sum over processes, and the result
+     is only rounded to double once the global sum is complete.
+     @param[out] result The global result
+     @param[in] partial The local result, in the reduction type
+  */
+  template <typename host_t, typename reduce_t>
+  typename std::enable_if<is_compensated<reduce_t>::value>::type reduce_global(host_t &result, reduce_t &partial)
+  {
+    reduceCompensatedArray(reinterpret_cast<double *>(&partial), sizeof(reduce_t) / sizeof(compensated));
+    reduce_convert(result, partial);
+  }
+
   template <typename T> struct ReduceArg {
 
     qudaError_t launch_error; // only do complete if no launch error to avoid hang
@@ -142,7 +175,7 @@ namespace quda
       const int n_element = n_reduce * sizeof(T) / sizeof(device_t);
       if (result.size() != (unsigned)n_element)
         errorQuda("result vector length %lu does not match n_reduce %d", result.size(), n_reduce);
-      for (int i = 0; i < n_element; i++) result[i] = reinterpret_cast<device_t *>(result_h)[i];
+      for (int i = 0; i < n_element; i++) reduce_convert(result[i], reinterpret_cast<device_t *>(result_h)[i]);
 
 #ifdef HETEROGENEOUS_ATOMIC
       if (!reset) {
@@ -169,7 +202,7 @@ namespace quda
     void complete(host_t &result, const qudaStream_t stream = 0, bool reset = false)
     {
       std::vector<host_t> result_(1);
-      complete(result_, stream, reset);
+      complete<host_t, device_t>(result_, stream, reset);
       result = result_[0];
     }
 
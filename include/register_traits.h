@@ -12,6 +12,7 @@
 #include <generics/ldg.h>
 #include <complex_quda.h>
 #include <inline_ptx.h>
+#include <compensated.h>
 
 namespace quda {
 
@@ -324,6 +325,19 @@ namespace quda {
   };
 #endif
 
+  template <> struct scalar<compensated> {
+    typedef compensated type;
+  };
+  template <> struct scalar<compensated2> {
+    typedef compensated type;
+  };
+  template <> struct scalar<compensated3> {
+    typedef compensated type;
+  };
+  template <> struct scalar<compensated4> {
+    typedef compensated type;
+  };
+
   /* Traits used to determine if a variable is half precision or not */
   template< typename T > struct isHalf{ static const bool value = false; };
   template<> struct isHalf<short>{ static const bool value = true; };
@@ -452,6 +466,20 @@ namespace quda {
     typedef double8 type;
   };
 
+  // compensated double precision, used for reductions
+  template <> struct VectorType<compensated, 1> {
+    typedef compensated type;
+  };
+  template <> struct VectorType<compensated, 2> {
+    typedef compensated2 type;
+  };
+  template <> struct VectorType<compensated, 3> {
+    typedef compensated3 type;
+  };
+  template <> struct VectorType<compensated, 4> {
+    typedef compensated4 type;
+  };
+
   // single precision
   template <> struct VectorType<float, 1>{typedef float type; };
   template <> struct VectorType<float, 2>{typedef float2 type; };
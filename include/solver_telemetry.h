@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <quda.h>
+#include <timer.h>
+
+namespace quda
+{
+
+  /**
+     @brief Structured per-solve telemetry.
+
+     If the environment variable QUDA_TELEMETRY_FILE is set, every
+     top-level solve (invertQuda, invertMultiShiftQuda) emits a
+     single JSON record, one record per line, to the named file (or
+     to stdout if the value is "stdout").  Records are only written
+     by rank 0.  Each record contains the iterated residual history
+     of the outer solver, the number of reliable updates and
+     restarts, the time spent in each QUDA_PROFILE_* category, the
+     flops broken down by operator type, the bytes moved by blas and
+     the per-level multigrid breakdown.
+
+     When the variable is not set, every hook reduces to a test of
+     active(), so the instrumentation is free in production runs.
+   */
+  namespace telemetry
+  {
+
+    /** Whether a record is currently being collected */
+    extern bool recording;
+
+    /**
+       @return Whether telemetry is being collected for the current solve
+    */
+    inline bool active() { return recording; }
+
+    /**
+       @brief Open a record for a top-level solve.  Nested calls are
+       folded into the outermost record.
+       @param[in] name The name of the interface function
+       @param[in] profile The profile of the interface function
+    */
+    void begin(const char *name, TimeProfile &profile);
+
+    /**
+       @brief Close the record opened by begin() and write it to the sink
+       @param[in] param The invert parameters after the solve
+       @param[in] profile The profile passed to begin()
+    */
+    void end(const QudaInvertParam &param, TimeProfile &profile);
+
+    /**
+       @brief Append an entry to the residual history
+       @param[in] k The iteration count
+       @param[in] r2 The iterated residual norm squared
+       @param[in] b2 The source norm squared
+       @param[in] hq2 The heavy-quark residual norm squared
+    */
+    void residual(int k, double r2, double b2, double hq2);
+
+    /**
+       @brief Record the completion of an outer solver
+       @param[in] name The solver name
+       @param[in] k The iterations taken
+       @param[in] blas_flops The blas flops accumulated by the solver
+    */
+    void solve(const char *name, int k, unsigned long long blas_flops);
+
+    /**
+       @brief Accumulate an event counter (e.g., "reliable_updates")
+       @param[in] key The counter name
+       @param[in] n The amount to add
+    */
+    void counter(const char *key, long n);
+
+    /**
+       @brief Accumulate the flops of a Dirac operator
+       @param[in] type The operator type, recorded under a readable name (e.g., "wilson-pc")
+       @param[in] flops The flops to add
+    */
+    void operatorFlops(QudaDiracType type, unsigned long long flops);
+
+    /**
+       @brief Accumulate a per-level multigrid quantity
+       @param[in] level The multigrid level
+       @param[in] key The quantity name (e.g., "cycles")
+       @param[in] value The amount to add
+    */
+    void mgLevel(int level, const char *key, double value);
+
+  } // namespace telemetry
+
+} // namespace quda
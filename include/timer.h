@@ -15,6 +15,8 @@ namespace quda {
     void Stop_(const char *func, const char *file, int line, QudaProfileType idx);
     void Reset_(const char *func, const char *file, int line);
     double Last(QudaProfileType idx);
+    double Time(QudaProfileType idx);
+    static const std::string &Name(QudaProfileType idx);
     void PrintGlobal();
     bool isRunning(QudaProfileType idx);
   };
@@ -255,6 +257,12 @@ namespace quda {
       return profile[idx].last;
     }
 
+    /**< The cumulative time recorded for a given profile type */
+    double Time(QudaProfileType idx) { return profile[idx].time; }
+
+    /**< The printable name of a given profile type */
+    static const std::string &Name(QudaProfileType idx) { return pname[idx]; }
+
     static void PrintGlobal();
 
     bool isRunning(QudaProfileType idx) { return profile[idx].running; }
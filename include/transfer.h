@@ -15,6 +15,8 @@
 
 namespace quda {
 
+  class MGCheckpoint;
+
   /**
      The transfer class defines the inter-grid operators that connect
      fine and coarse grids.  This implements both restriction and
@@ -167,9 +169,11 @@ namespace quda {
        * @param parity For single-parity fields are these QUDA_EVEN_PARITY or QUDA_ODD_PARITY
        * @param null_precision The precision to store the null-space basis vectors in
        * @param enable_gpu Whether to enable this to run on GPU (as well as CPU)
+       * @param checkpoint If set, restore the prolongator from this checkpoint instead of block orthogonalizing
        */
     Transfer(const std::vector<ColorSpinorField *> &B, int Nvec, int NblockOrtho, int *geo_bs, int spin_bs,
-             QudaPrecision null_precision, const QudaTransferType transfer_type, TimeProfile &profile);
+             QudaPrecision null_precision, const QudaTransferType transfer_type, TimeProfile &profile,
+             MGCheckpoint *checkpoint = nullptr);
 
     /** The destructor for Transfer */
     virtual ~Transfer();
@@ -179,6 +183,19 @@ namespace quda {
      */
     void reset();
 
+    /**
+       @brief Write the block-orthogonalized prolongator to a checkpoint
+       @param[in] checkpoint The checkpoint being written
+     */
+    void save(MGCheckpoint &checkpoint) const;
+
+    /**
+       @brief Restore the block-orthogonalized prolongator from a
+       checkpoint, in place of reset()
+       @param[in] checkpoint The checkpoint being restored
+     */
+    void restore(MGCheckpoint &checkpoint);
+
     /**
      * Apply the prolongator
      * @param out The resulting field on the fine lattice
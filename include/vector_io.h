@@ -8,12 +8,62 @@ namespace quda
   /**
      @brief VectorIO is a simple wrapper class for loading and saving
      sets of vector fields using QIO.
+
+     If the environment variable QUDA_IO_BUFFER_SIZE is set (in MiB),
+     vectors are streamed through a two-slot host staging ring whose
+     size is bounded by this budget, rather than staging the entire
+     set in host memory.  The host-device transfer of one batch is
+     overlapped with the file I/O of the next; all conversions are
+     issued from the calling thread.  Files saved
+     in this mode store each batch as a separate record.
+
+     Vectors stored in half or quarter precision are by default
+     written through QIO in single precision.  If requested, either
+     through the constructor or by setting QUDA_VECTOR_ARCHIVE=1,
+     they are instead written to a native vector archive of 16-bit or
+     8-bit fixed-point components with one scale factor per block of
+     sites, mirroring the norm layout of QUDA's half and quarter
+     precision fields.  The number of sites per scale factor is set
+     with QUDA_VECTOR_ARCHIVE_BLOCK (default 1, i.e., per site).  The
+     archive format is detected on load and does not require QIO.
    */
   class VectorIO
   {
     const std::string filename;
+    bool archive;
+
+    /**
+       @return Whether filename is a native vector archive
+    */
+    bool isArchive() const;
+
+    /**
+       @brief Load vectors from a native vector archive
+       @param[in] vecs The set of vectors to load
+       @param[in] first The index of the first vector to read
+    */
+    void loadArchive(std::vector<ColorSpinorField *> &vecs, int first);
+
+    /**
+       @brief Save vectors to a native vector archive
+       @param[in] vecs The set of vectors to save
+    */
+    void saveArchive(const std::vector<ColorSpinorField *> &vecs);
 #ifdef HAVE_QIO
     bool parity_inflate;
+    size_t buffer_bytes;
+
+    /**
+       @brief Load vectors from filename in batches bounded by buffer_bytes
+       @param[in] vecs The set of vectors to load
+    */
+    void loadBatched(std::vector<ColorSpinorField *> &vecs);
+
+    /**
+       @brief Save vectors to filename in batches bounded by buffer_bytes
+       @param[in] vecs The set of vectors to save
+    */
+    void saveBatched(const std::vector<ColorSpinorField *> &vecs);
 #endif
   public:
 
@@ -22,14 +72,19 @@ namespace quda
        @param[in] filename The filename associated with this IO object
        @param[in] parity_inflate Whether to inflate single_parity
        field to dual parity fields for I/O
+       @param[in] archive Whether to save half and quarter precision
+       vectors to a native vector archive rather than through QIO
     */
-    VectorIO(const std::string &filename, bool parity_inflate = false);
+    VectorIO(const std::string &filename, bool parity_inflate = false, bool archive = false);
 
     /**
        @brief Load vectors from filename
        @param[in] vecs The set of vectors to load
+       @param[in] first The index of the first vector in the file to
+       load, allowing a file to be read in slices (native vector
+       archives only)
     */
-    void load(std::vector<ColorSpinorField *> &vecs);
+    void load(std::vector<ColorSpinorField *> &vecs, int first = 0);
 
     /**
        @brief Save vectors to filename
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <color_spinor_field.h>
+
+namespace quda
+{
+
+  /**
+     @brief Arena of temporary ColorSpinorFields shared by the
+     solvers and multigrid levels.  Rather than allocating private
+     temporaries for their whole lifetime, solvers check out the
+     fields they need for the duration of a solve and return them on
+     exit, so nested solvers (e.g., the smoothers and coarse-grid
+     solvers of a multigrid preconditioner) and solvers that are
+     never active at the same time reuse the same storage.  Returned
+     fields are kept idle in the arena and handed out again to any
+     request with the same shape, precision and location.  At the end
+     of each solve the idle fields are trimmed to retain_bytes(), so by
+     default nothing is held between solves, other than the fields
+     pinned by an owner such as a solve context.  The arena tracks the
+     number of bytes that are checked out, and its high-water mark, so
+     that the peak live footprint of a solve can be reported.
+  */
+  namespace workspace
+  {
+
+    /**
+       @brief Check out a field from the arena.  An idle field
+       matching the parameters is reused if available, otherwise a
+       new field is created.  The contents are undefined unless
+       param.create is QUDA_ZERO_FIELD_CREATE.
+       @param[in] param Parameters of the requested field
+       @return Field owned by the arena until it is checked back in
+    */
+    ColorSpinorField *checkout(const ColorSpinorParam &param);
+
+    /**
+       @brief Return a field to the arena, making it available to
+       subsequent checkouts
+       @param[in] field Field obtained from checkout (may be nullptr)
+    */
+    void checkin(ColorSpinorField *field);
+
+    /**
+       @brief Release all idle fields held by the arena, including
+       pinned ones.  Fields that are checked out are unaffected.
+    */
+    void flush();
+
+    /**
+       @brief Release idle fields that are not pinned, largest first,
+       until the arena holds at most max_bytes.  Fields that are
+       checked out or pinned are unaffected, so the arena may still
+       hold more than max_bytes.
+       @param[in] max_bytes Number of bytes the arena may retain
+    */
+    void trim(size_t max_bytes);
+
+    /**
+       @brief Set the owner that fields checked out from now on are
+       pinned to.  A pinned field is still handed out to any matching
+       request once checked in, but is not released by trim() until
+       its owner releases it.
+       @param[in] owner The owner, or nullptr to stop pinning
+    */
+    void set_owner(const void *owner);
+
+    /**
+       @brief Unpin the fields pinned to an owner
+       @param[in] owner The owner
+    */
+    void release(const void *owner);
+
+    /**
+       @return The number of bytes of idle fields retained between
+       solves, set in MiB with the QUDA_WORKSPACE_RETAIN environment
+       variable (default 0)
+    */
+    size_t retain_bytes();
+
+    /**
+       @return The number of bytes currently checked out
+    */
+    size_t live_bytes();
+
+    /**
+       @return The maximum number of bytes checked out at any time
+       since the last reset_peak().  This only counts fields checked
+       out of the arena: see device_allocated_peak() for all device
+       allocations.
+    */
+    size_t peak_bytes();
+
+    /**
+       @return The total number of bytes held by the arena (checked out and idle)
+    */
+    size_t pool_bytes();
+
+    /**
+       @return The number of fields the arena has created
+    */
+    size_t created();
+
+    /**
+       @brief Reset the high-water mark to the current live footprint
+    */
+    void reset_peak();
+
+  } // namespace workspace
+
+  /**
+     @brief Scoped checkout of a workspace field: the field is checked
+     out of the arena on construction and returned on destruction.
+  */
+  class WorkspaceField
+  {
+    ColorSpinorField *field;
+
+  public:
+    WorkspaceField(const ColorSpinorParam &param) : field(workspace::checkout(param)) {}
+    WorkspaceField(const WorkspaceField &) = delete;
+    WorkspaceField &operator=(const WorkspaceField &) = delete;
+    ~WorkspaceField() { workspace::checkin(field); }
+
+    ColorSpinorField &operator*() const { return *field; }
+    ColorSpinorField *operator->() const { return field; }
+    ColorSpinorField *get() const { return field; }
+  };
+
+} // namespace quda
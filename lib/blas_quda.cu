@@ -9,6 +9,7 @@
 
 #include <jitify_helper.cuh>
 #include <kernels/blas_core.cuh>
+#include <blas_expr.cuh>
 
 namespace quda {
 
@@ -232,7 +233,13 @@ namespace quda {
 
     void cxpaypbz(ColorSpinorField &x, const Complex &a, ColorSpinorField &y, const Complex &b, ColorSpinorField &z)
     {
-      instantiate<caxpbypczw_, Blas, false>(Complex(1.0), a, b, x, y, z, z, y);
+      using expr::_0;
+      using expr::_1;
+      using expr::_2;
+      if (expr::fusable({&x, &y, &z}))
+        expr::eval({&x, &y, &z}, _2 = _0 + a * _1 + b * _2);
+      else
+        instantiate<caxpbypczw_, Blas, false>(Complex(1.0), a, b, x, y, z, z, y);
     }
 
     void axpyBzpcx(double a, ColorSpinorField& x, ColorSpinorField& y, double b, ColorSpinorField& z, double c)
@@ -242,7 +249,13 @@ namespace quda {
 
     void axpyZpbx(double a, ColorSpinorField& x, ColorSpinorField& y, ColorSpinorField& z, double b)
     {
-      instantiate<axpyZpbx_, Blas, true>(a, b, 0.0, x, y, z, x, y);
+      using expr::_0;
+      using expr::_1;
+      using expr::_2;
+      if (expr::fusable({&x, &y, &z}))
+        expr::eval({&x, &y, &z}, _1 = _1 + a * _0, _0 = _2 + b * _0);
+      else
+        instantiate<axpyZpbx_, Blas, true>(a, b, 0.0, x, y, z, x, y);
     }
 
     void caxpyBzpx(const Complex &a, ColorSpinorField &x, ColorSpinorField &y, const Complex &b, ColorSpinorField &z)
@@ -257,7 +270,14 @@ namespace quda {
 
     void caxpbypzYmbw(const Complex &a, ColorSpinorField &x, const Complex &b, ColorSpinorField &y, ColorSpinorField &z, ColorSpinorField &w)
     {
-      instantiate<caxpbypzYmbw_, Blas, false>(a, b, Complex(0.0), x, y, z, w, y);
+      using expr::_0;
+      using expr::_1;
+      using expr::_2;
+      using expr::_3;
+      if (expr::fusable({&x, &y, &z, &w}))
+        expr::eval({&x, &y, &z, &w}, _2 = _2 + a * _0 + b * _1, _1 = _1 - b * _3);
+      else
+        instantiate<caxpbypzYmbw_, Blas, false>(a, b, Complex(0.0), x, y, z, w, y);
     }
 
     void cabxpyAx(double a, const Complex &b, ColorSpinorField &x, ColorSpinorField &y)
@@ -281,7 +301,14 @@ namespace quda {
 
     void tripleCGUpdate(double a, double b, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z, ColorSpinorField &w)
     {
-      instantiate<tripleCGUpdate_, Blas, true>(a, b, 0.0, x, y, z, w, y);
+      using expr::_0;
+      using expr::_1;
+      using expr::_2;
+      using expr::_3;
+      if (expr::fusable({&x, &y, &z, &w}))
+        expr::eval({&x, &y, &z, &w}, _1 = _1 + a * _3, _2 = _2 - a * _0, _3 = _2 + b * _3);
+      else
+        instantiate<tripleCGUpdate_, Blas, true>(a, b, 0.0, x, y, z, w, y);
     }
 
   } // namespace blas
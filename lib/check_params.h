@@ -161,6 +161,10 @@ void printQudaEigParam(QudaEigParam *param) {
   P(preserve_deflation, QUDA_BOOLEAN_FALSE);
   P(preserve_deflation_space, 0);
   P(preserve_evals, QUDA_BOOLEAN_TRUE);
+  P(compress_deflation, QUDA_BOOLEAN_FALSE);
+  P(compress_n_basis, 24);
+  for (int i = 0; i < 4; i++) P(compress_block_size[i], 4);
+  P(compress_precision, QUDA_HALF_PRECISION);
   P(use_dagger, QUDA_BOOLEAN_FALSE);
   P(use_norm_op, QUDA_BOOLEAN_FALSE);
   P(compute_svd, QUDA_BOOLEAN_FALSE);
@@ -189,6 +193,10 @@ void printQudaEigParam(QudaEigParam *param) {
   P(a_max, INVALID_DOUBLE);
   P(preserve_deflation, QUDA_BOOLEAN_INVALID);
   P(preserve_evals, QUDA_BOOLEAN_INVALID);
+  P(compress_deflation, QUDA_BOOLEAN_INVALID);
+  P(compress_n_basis, INVALID_INT);
+  for (int i = 0; i < 4; i++) P(compress_block_size[i], INVALID_INT);
+  P(compress_precision, QUDA_INVALID_PRECISION);
   P(use_dagger, QUDA_BOOLEAN_INVALID);
   P(use_norm_op, QUDA_BOOLEAN_INVALID);
   P(compute_svd, QUDA_BOOLEAN_INVALID);
@@ -716,6 +724,18 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
     P(setup_maxiter_refresh[i], INVALID_INT);
 #endif
 
+#ifdef INIT_PARAM
+    P(setup_refresh_adaptive[i], QUDA_BOOLEAN_FALSE);
+    P(setup_refresh_tol[i], 2.0);
+    P(setup_refresh_iter_growth[i], 1.5);
+    P(setup_refresh_max_pass[i], 4);
+#else
+    P(setup_refresh_adaptive[i], QUDA_BOOLEAN_INVALID);
+    P(setup_refresh_tol[i], INVALID_DOUBLE);
+    P(setup_refresh_iter_growth[i], INVALID_DOUBLE);
+    P(setup_refresh_max_pass[i], INVALID_INT);
+#endif
+
 #ifdef INIT_PARAM
     P(setup_ca_basis[i], QUDA_POWER_BASIS);
     P(setup_ca_basis_size[i], 4);
@@ -851,9 +871,11 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
 #ifdef INIT_PARAM
     P(vec_load[i], QUDA_BOOLEAN_FALSE);
     P(vec_store[i], QUDA_BOOLEAN_FALSE);
+    P(vec_archive[i], QUDA_BOOLEAN_FALSE);
 #else
     P(vec_load[i], QUDA_BOOLEAN_INVALID);
     P(vec_store[i], QUDA_BOOLEAN_INVALID);
+    P(vec_archive[i], QUDA_BOOLEAN_INVALID);
 #endif
   }
 
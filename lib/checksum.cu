@@ -18,14 +18,21 @@ namespace quda {
     return u.checksum(); 
   }
 
+  /**
+     Sites are split statically over threads; since XOR is associative
+     and commutative the combined result is independent of the thread
+     count and schedule.
+  */
   template <typename Arg>
   uint64_t ChecksumCPU(const Arg &arg)
   {
     uint64_t checksum_ = 0;
-    for (int parity=0; parity<2; parity++)
-      for (int x_cb=0; x_cb<arg.volumeCB; x_cb++)
-	for (int d=0; d<arg.U.geometry; d++)
-	  checksum_ ^= siteChecksum(arg, d, parity, x_cb);
+#pragma omp parallel for schedule(static) reduction(^ : checksum_)
+    for (int i = 0; i < 2 * arg.volumeCB; i++) {
+      const int parity = i / arg.volumeCB;
+      const int x_cb = i - parity * arg.volumeCB;
+      for (int d = 0; d < arg.U.geometry; d++) checksum_ ^= siteChecksum(arg, d, parity, x_cb);
+    }
     return checksum_;
   }
 
@@ -83,4 +90,43 @@ namespace quda {
     return checksum;
   }
 
+  static bool stream_open = false;
+  static bool stream_output = false;
+  static bool stream_suspended = false;
+  static bool stream_touched = false;
+  static uint64_t stream_checksum = 0;
+
+  void checksumStreamBegin(bool output)
+  {
+    if (stream_open) errorQuda("Checksum stream already open");
+    stream_open = true;
+    stream_output = output;
+    stream_suspended = false;
+    stream_touched = false;
+    stream_checksum = 0;
+  }
+
+  bool checksumStreamEnd(uint64_t &checksum)
+  {
+    if (!stream_open) errorQuda("No checksum stream open");
+    stream_open = false;
+
+    // a rank that owns no sites still takes part in the reduction
+    double touched = stream_touched ? 1.0 : 0.0;
+    comm_allreduce_max(&touched);
+    checksum = stream_checksum;
+    comm_allreduce_xor(&checksum);
+    return touched > 0.0;
+  }
+
+  void checksumStreamSuspend(bool suspend) { stream_suspended = suspend; }
+
+  bool checksumStreamActive(bool output) { return stream_open && !stream_suspended && stream_output == output; }
+
+  void checksumStreamAccumulate(uint64_t checksum)
+  {
+    stream_checksum ^= checksum;
+    stream_touched = true;
+  }
+
 }
@@ -205,7 +205,9 @@ namespace quda {
     if (location == QUDA_CPU_FIELD_LOCATION) {
       //First make a cpu gauge field from the cuda gauge field
       int pad = 0;
-      GaugeFieldParam gf_param(gauge.X(), precision, QUDA_RECONSTRUCT_NO, pad, gauge.Geometry());
+      // the fine links are not stored in fixed point on the host, even if the coarse links are
+      GaugeFieldParam gf_param(gauge.X(), std::max(precision, QUDA_SINGLE_PRECISION), QUDA_RECONSTRUCT_NO, pad,
+                               gauge.Geometry());
       gf_param.order = QUDA_QDP_GAUGE_ORDER;
       gf_param.fixed = gauge.GaugeFixed();
       gf_param.link_type = gauge.LinkType();
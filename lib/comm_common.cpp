@@ -4,6 +4,7 @@
 
 #include <quda_internal.h>
 #include <comm_quda.h>
+#include <compensated.h>
 #include <csignal>
 
 #ifdef QUDA_BACKWARDSCPP
@@ -697,6 +698,7 @@ bool comm_gdr_blacklist() {
 }
 
 static bool deterministic_reduce = false;
+static bool reduce_check = false;
 
 void comm_init_common(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *map_data)
 {
@@ -732,6 +734,15 @@ void comm_init_common(int ndim, const int *dims, QudaCommsMap rank_from_coords,
   char *enable_reduce_env = getenv("QUDA_DETERMINISTIC_REDUCE");
   if (enable_reduce_env && strcmp(enable_reduce_env, "1") == 0) { deterministic_reduce = true; }
 
+  char *reduce_check_env = getenv("QUDA_REDUCE_CHECK");
+  if (reduce_check_env && strcmp(reduce_check_env, "1") == 0) {
+#ifdef QUDA_REDUCE_COMPENSATED
+    reduce_check = true;
+#else
+    warningQuda("QUDA_REDUCE_CHECK requires QUDA_REDUCE_MODE=compensated, ignoring");
+#endif
+  }
+
   snprintf(partition_string, 16, ",comm=%d%d%d%d", comm_dim_partitioned(0), comm_dim_partitioned(1),
            comm_dim_partitioned(2), comm_dim_partitioned(3));
 
@@ -808,6 +819,20 @@ static bool asyncReduce = false;
 
 void reduceMaxDouble(double &max) { comm_allreduce_max(&max); }
 
+void reduceCompensatedArray(double *sum, const int len)
+{
+  if (globalReduce) comm_allreduce_compensated_array(sum, len);
+
+  if (reduce_check) {
+    auto *c = reinterpret_cast<quda::compensated *>(sum);
+    for (int i = 0; i < len; i++) {
+      if (!quda::is_exact(c[i]))
+        warningQuda("Reduction result %.16e (component %d of %d) may depend on the order of summation", c[i].value(),
+                    i, len);
+    }
+  }
+}
+
 void reduceDouble(double &sum) { if (globalReduce) comm_allreduce(&sum); }
 
 void reduceDoubleArray(double *sum, const int len)
@@ -6,6 +6,7 @@
 #include <mpi.h>
 #include <quda_internal.h>
 #include <comm_quda.h>
+#include <compensated.h>
 #include <mpi_comm_handle.h>
 
 #define MPI_CHECK(mpi_call) do {                    \
@@ -291,6 +292,47 @@ void comm_allreduce_array(double* data, size_t size)
   }
 }
 
+/**
+   Elementwise compensated sum of (sum, compensation) pairs, used as
+   a non-commutative MPI reduction operation so that the partial sums
+   are combined in rank order.
+*/
+static void compensated_sum(void *in, void *inout, int *len, MPI_Datatype *)
+{
+  auto *a = static_cast<const quda::compensated *>(in);
+  auto *b = static_cast<quda::compensated *>(inout);
+  for (int i = 0; i < *len; i++) b[i] = a[i] + b[i];
+}
+
+void comm_allreduce_compensated_array(double *data, size_t size)
+{
+  if (!comm_deterministic_reduce()) {
+    static MPI_Datatype compensated_type = MPI_DATATYPE_NULL;
+    static MPI_Op compensated_op = MPI_OP_NULL;
+    if (compensated_op == MPI_OP_NULL) {
+      MPI_CHECK(MPI_Type_contiguous(2, MPI_DOUBLE, &compensated_type));
+      MPI_CHECK(MPI_Type_commit(&compensated_type));
+      MPI_CHECK(MPI_Op_create(compensated_sum, 0, &compensated_op));
+    }
+    MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, data, size, compensated_type, compensated_op, MPI_COMM_HANDLE));
+  } else {
+    size_t n = comm_size();
+    double *recv_buf = new double[2 * size * n];
+    MPI_CHECK(MPI_Allgather(data, 2 * size, MPI_DOUBLE, recv_buf, 2 * size, MPI_DOUBLE, MPI_COMM_HANDLE));
+
+    // accumulate in rank order
+    auto *sum = reinterpret_cast<quda::compensated *>(data);
+    auto *recv = reinterpret_cast<quda::compensated *>(recv_buf);
+    for (size_t j = 0; j < size; j++) {
+      quda::compensated s;
+      for (size_t i = 0; i < n; i++) s += recv[i * size + j];
+      sum[j] = s;
+    }
+
+    delete[] recv_buf;
+  }
+}
+
 void comm_allreduce_max_array(double* data, size_t size)
 {
   double *recvbuf = new double[size];
@@ -53,6 +53,8 @@ void comm_allreduce_min(double* data) {}
 
 void comm_allreduce_array(double* data, size_t size) {}
 
+void comm_allreduce_compensated_array(double *data, size_t size) {}
+
 void comm_allreduce_max_array(double* data, size_t size) {}
 
 void comm_allreduce_int(int* data) {}
@@ -5,6 +5,8 @@
 
 #include <contract_quda.h>
 #include <jitify_helper.cuh>
+#include <launch_kernel.cuh>
+#include <launch_host.h>
 #include <kernels/contraction.cuh>
 
 namespace quda {
@@ -99,6 +101,135 @@ public:
     qudaDeviceSynchronize();
   }
 
+  template <typename Arg> class ContractionFT : Tunable
+  {
+    Arg &arg;
+    const ColorSpinorField &x;
+    const ColorSpinorField &y;
+
+    unsigned int sharedBytesPerThread() const { return 0; }
+    unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
+    bool tuneGridDim() const { return false; } // one thread per site of the timeslice
+    unsigned int minThreads() const { return arg.space_volume; }
+    unsigned int maxBlockSize(const TuneParam &param) const { return deviceProp.maxThreadsPerBlock / 2; }
+
+  public:
+    ContractionFT(Arg &arg, const ColorSpinorField &x, const ColorSpinorField &y) : arg(arg), x(x), y(y)
+    {
+      strcat(aux, Arg::type == QUDA_CONTRACT_TYPE_DR ? "degrand-rossi," : "open,");
+      strcat(aux, x.AuxString());
+      char mom_str[16];
+      snprintf(mom_str, sizeof(mom_str), ",n_mom=%d", arg.n_mom);
+      strcat(aux, mom_str);
+#ifdef JITIFY
+      create_jitify_program("kernels/contraction.cuh");
+#endif
+      apply(0);
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      if (x.Location() == QUDA_CUDA_FIELD_LOCATION) {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+        // the result is accumulated with atomics, so is reset on every launch, including when tuning
+        qudaMemsetAsync(arg.result, 0, arg.X[3] * arg.n_mom * arg.n_gamma * sizeof(double2), stream);
+#ifdef JITIFY
+        using namespace jitify::reflection;
+        jitify_error = program->kernel("quda::computeContractionFT")
+                         .instantiate((int)tp.block.x, Type<Arg>())
+                         .configure(tp.grid, tp.block, tp.shared_bytes, stream)
+                         .launch(arg);
+        arg.launch_error = jitify_error == CUDA_SUCCESS ? QUDA_SUCCESS : QUDA_ERROR;
+#else
+        LAUNCH_KERNEL_LOCAL_PARITY(computeContractionFT, (*this), tp, stream, arg, Arg);
+#endif
+      } else {
+        std::vector<double2> result(arg.X[3] * arg.n_mom * arg.n_gamma);
+        launchHostReduceArray(result, ContractionFTHost<Arg>(arg), arg.space_volume, arg.X[3]);
+        memcpy(arg.result, result.data(), result.size() * sizeof(double2));
+      }
+    }
+
+    void initTuneParam(TuneParam &param) const
+    {
+      Tunable::initTuneParam(param);
+      param.grid.y = arg.X[3];
+    }
+
+    void defaultTuneParam(TuneParam &param) const
+    {
+      Tunable::defaultTuneParam(param);
+      param.grid.y = arg.X[3];
+    }
+
+    bool advanceTuneParam(TuneParam &param) const
+    {
+      bool rtn = Tunable::advanceTuneParam(param);
+      param.grid.y = arg.X[3];
+      return rtn;
+    }
+
+    TuneKey tuneKey() const { return TuneKey(x.VolString(), typeid(*this).name(), aux); }
+
+    long long flops() const
+    {
+      long long contract = 16 * 3 * 6ll + (Arg::type == QUDA_CONTRACT_TYPE_DR ? 16 * (4 + 12) : 0);
+      return (contract + arg.n_mom * arg.n_gamma * 8ll) * x.Volume();
+    }
+
+    long long bytes() const { return x.Bytes() + y.Bytes(); }
+  };
+
+  template <typename real, typename F, QudaContractType type>
+  void contract_ft(const ColorSpinorField &x, const ColorSpinorField &y, double2 *result, const int *mom, int n_mom,
+                   const int *gamma, int n_gamma)
+  {
+    ContractionFTArg<real, F, type> arg(x, y, mom, n_mom, gamma, n_gamma, result);
+    ContractionFT<decltype(arg)> contraction(arg, x, y);
+    if (x.Location() == QUDA_CUDA_FIELD_LOCATION) qudaDeviceSynchronize();
+  }
+
+  template <typename real, typename F>
+  void contract_ft(const ColorSpinorField &x, const ColorSpinorField &y, double2 *result, const int *mom, int n_mom,
+                   const int *gamma, int n_gamma, QudaContractType cType)
+  {
+    switch (cType) {
+    case QUDA_CONTRACT_TYPE_OPEN:
+      contract_ft<real, F, QUDA_CONTRACT_TYPE_OPEN>(x, y, result, mom, n_mom, gamma, n_gamma);
+      break;
+    case QUDA_CONTRACT_TYPE_DR:
+      contract_ft<real, F, QUDA_CONTRACT_TYPE_DR>(x, y, result, mom, n_mom, gamma, n_gamma);
+      break;
+    default: errorQuda("Unexpected contraction type %d", cType);
+    }
+  }
+
+  template <typename real>
+  void contract_ft(const ColorSpinorField &x, const ColorSpinorField &y, double2 *result, const int *mom, int n_mom,
+                   const int *gamma, int n_gamma, QudaContractType cType)
+  {
+    if (x.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      using F = typename ContractionArg<real>::F;
+      contract_ft<real, F>(x, y, result, mom, n_mom, gamma, n_gamma, cType);
+    } else {
+      if (x.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER || y.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+        errorQuda("Unsupported host field order x=%d y=%d", x.FieldOrder(), y.FieldOrder());
+      using F = colorspinor::SpaceSpinorColorOrder<real, 4, 3>;
+      contract_ft<real, F>(x, y, result, mom, n_mom, gamma, n_gamma, cType);
+    }
+  }
+
+  template <typename real>
+  void contract_propagators(const std::vector<ColorSpinorField *> &prop1, const std::vector<ColorSpinorField *> &prop2,
+                            double2 *result, const int *mom, int n_mom)
+  {
+    using F = colorspinor::SpaceSpinorColorOrder<real, 4, 3>;
+    PropagatorContractionArg<real, F> arg(prop1, prop2, mom, n_mom);
+    std::vector<double2> local(arg.X[3] * n_mom * propagator_n_channel);
+    launchHostReduceArray(local, PropagatorContractionHost<decltype(arg)>(arg), arg.space_volume, arg.X[3]);
+    memcpy(result, local.data(), local.size() * sizeof(double2));
+  }
+
 #endif
 
   void contractQuda(const ColorSpinorField &x, const ColorSpinorField &y, void *result, const QudaContractType cType)
@@ -119,6 +250,145 @@ public:
       errorQuda("Precision %d not supported", x.Precision());
     }
 
+#else
+    errorQuda("Contraction code has not been built");
+#endif
+  }
+
+  void contractFTQuda(const ColorSpinorField &x, const ColorSpinorField &y, std::vector<Complex> &result,
+                      QudaContractType cType, const std::vector<int> &mom, const std::vector<int> &gamma)
+  {
+#ifdef GPU_CONTRACT
+    checkPrecision(x, y);
+    checkLocation(x, y);
+
+    if (x.GammaBasis() != QUDA_DEGRAND_ROSSI_GAMMA_BASIS || y.GammaBasis() != QUDA_DEGRAND_ROSSI_GAMMA_BASIS)
+      errorQuda("Unexpected gamma basis x=%d y=%d", x.GammaBasis(), y.GammaBasis());
+    if (x.Ncolor() != 3 || y.Ncolor() != 3) errorQuda("Unexpected number of colors x=%d y=%d", x.Ncolor(), y.Ncolor());
+    if (x.Nspin() != 4 || y.Nspin() != 4) errorQuda("Unexpected number of spins x=%d y=%d", x.Nspin(), y.Nspin());
+    if (x.SiteSubset() != QUDA_FULL_SITE_SUBSET) errorQuda("Unexpected site subset %d", x.SiteSubset());
+    if (mom.size() % 3 != 0) errorQuda("Momentum list length %lu is not a multiple of 3", mom.size());
+    for (auto g : gamma)
+      if (g < 0 || g >= 16) errorQuda("Invalid gamma index %d", g);
+    result.clear();
+    if (mom.empty() || gamma.empty()) return;
+
+    const int n_mom = mom.size() / 3;
+    const int n_gamma = gamma.size();
+    const int nt = x.X()[3];
+    const int t_offset = comm_coord(3) * nt;
+    const int Nt = comm_dim(3) * nt;
+    constexpr int max_n_mom = contraction_ft_max_mom;
+
+    // the local timeslices are written to their place in the global
+    // correlator, which is then summed over all processes
+    std::vector<double> global(2 * Nt * n_mom * n_gamma, 0.0);
+    const size_t max_bytes = nt * max_n_mom * n_gamma * sizeof(double2);
+    auto buffer = static_cast<double2 *>(x.Location() == QUDA_CUDA_FIELD_LOCATION ? pool_device_malloc(max_bytes) :
+                                                                                    safe_malloc(max_bytes));
+    std::vector<double2> local(nt * max_n_mom * n_gamma);
+
+    for (int m0 = 0; m0 < n_mom; m0 += max_n_mom) {
+      const int m = std::min(max_n_mom, n_mom - m0);
+      if (x.Precision() == QUDA_SINGLE_PRECISION) {
+        contract_ft<float>(x, y, buffer, mom.data() + 3 * m0, m, gamma.data(), n_gamma, cType);
+      } else if (x.Precision() == QUDA_DOUBLE_PRECISION) {
+        contract_ft<double>(x, y, buffer, mom.data() + 3 * m0, m, gamma.data(), n_gamma, cType);
+      } else {
+        errorQuda("Precision %d not supported", x.Precision());
+      }
+
+      if (x.Location() == QUDA_CUDA_FIELD_LOCATION)
+        qudaMemcpy(local.data(), buffer, nt * m * n_gamma * sizeof(double2), cudaMemcpyDeviceToHost);
+      else
+        memcpy(local.data(), buffer, nt * m * n_gamma * sizeof(double2));
+
+      for (int t = 0; t < nt; t++)
+        for (int i = 0; i < m; i++)
+          for (int g = 0; g < n_gamma; g++) {
+            const double2 &c = local[(t * m + i) * n_gamma + g];
+            const size_t idx = ((t_offset + t) * n_mom + m0 + i) * n_gamma + g;
+            global[2 * idx + 0] = c.x;
+            global[2 * idx + 1] = c.y;
+          }
+    }
+
+    if (x.Location() == QUDA_CUDA_FIELD_LOCATION)
+      pool_device_free(buffer);
+    else
+      host_free(buffer);
+
+    comm_allreduce_array(global.data(), global.size());
+
+    result.resize(Nt * n_mom * n_gamma);
+    for (auto i = 0u; i < result.size(); i++) result[i] = Complex(global[2 * i], global[2 * i + 1]);
+#else
+    errorQuda("Contraction code has not been built");
+#endif
+  }
+
+  void contractPropagatorsQuda(const std::vector<ColorSpinorField *> &prop1,
+                               const std::vector<ColorSpinorField *> &prop2, std::vector<Complex> &meson,
+                               std::vector<Complex> &baryon, const std::vector<int> &mom)
+  {
+#ifdef GPU_CONTRACT
+    constexpr int nSC = 12;
+    if (prop1.size() != nSC || prop2.size() != nSC)
+      errorQuda("Expected %d propagator columns, got %lu and %lu", nSC, prop1.size(), prop2.size());
+    for (int i = 0; i < nSC; i++) {
+      for (auto p : {prop1[i], prop2[i]}) {
+        checkPrecision(*prop1[0], *p);
+        if (p->Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Unsupported field location %d", p->Location());
+        if (p->FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+          errorQuda("Unsupported field order %d", p->FieldOrder());
+        if (p->GammaBasis() != QUDA_DEGRAND_ROSSI_GAMMA_BASIS) errorQuda("Unexpected gamma basis %d", p->GammaBasis());
+        if (p->Ncolor() != 3 || p->Nspin() != 4) errorQuda("Unexpected Nc=%d Ns=%d", p->Ncolor(), p->Nspin());
+        if (p->SiteSubset() != QUDA_FULL_SITE_SUBSET) errorQuda("Unexpected site subset %d", p->SiteSubset());
+        if (p->VolumeCB() != prop1[0]->VolumeCB()) errorQuda("Volume mismatch");
+      }
+    }
+    if (mom.size() % 3 != 0) errorQuda("Momentum list length %lu is not a multiple of 3", mom.size());
+    meson.clear();
+    baryon.clear();
+    if (mom.empty()) return;
+
+    const int n_mom = mom.size() / 3;
+    const int nt = prop1[0]->X()[3];
+    const int t_offset = comm_coord(3) * nt;
+    const int Nt = comm_dim(3) * nt;
+
+    std::vector<double2> local(nt * n_mom * propagator_n_channel);
+    if (prop1[0]->Precision() == QUDA_SINGLE_PRECISION) {
+      contract_propagators<float>(prop1, prop2, local.data(), mom.data(), n_mom);
+    } else if (prop1[0]->Precision() == QUDA_DOUBLE_PRECISION) {
+      contract_propagators<double>(prop1, prop2, local.data(), mom.data(), n_mom);
+    } else {
+      errorQuda("Precision %d not supported", prop1[0]->Precision());
+    }
+
+    // the local timeslices are written to their place in the global
+    // correlators, which are then summed over all processes
+    std::vector<double> global(2 * Nt * n_mom * propagator_n_channel, 0.0);
+    for (int t = 0; t < nt; t++) {
+      for (int i = 0; i < n_mom * propagator_n_channel; i++) {
+        const double2 &c = local[t * n_mom * propagator_n_channel + i];
+        const size_t idx = (t_offset + t) * n_mom * propagator_n_channel + i;
+        global[2 * idx + 0] = c.x;
+        global[2 * idx + 1] = c.y;
+      }
+    }
+    comm_allreduce_array(global.data(), global.size());
+
+    meson.resize(Nt * n_mom * propagator_n_meson);
+    baryon.resize(Nt * n_mom * propagator_n_baryon);
+    for (int tp = 0; tp < Nt * n_mom; tp++) {
+      const double *c = global.data() + 2 * tp * propagator_n_channel;
+      for (int g = 0; g < propagator_n_meson; g++)
+        meson[tp * propagator_n_meson + g] = Complex(c[2 * g], c[2 * g + 1]);
+      c += 2 * propagator_n_meson;
+      for (int s = 0; s < propagator_n_baryon; s++)
+        baryon[tp * propagator_n_baryon + s] = Complex(c[2 * s], c[2 * s + 1]);
+    }
 #else
     errorQuda("Contraction code has not been built");
 #endif
@@ -66,8 +66,26 @@ namespace quda {
     } else if (out.Order() == QUDA_QDP_GAUGE_ORDER) {
 
 #ifdef BUILD_QDP_INTERFACE
-      copyGauge<FloatOut,FloatIn,length>
-	(QDPOrder<FloatOut,length>(out, Out, outGhost), inOrder, out, in, location, type);
+      if (out.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+        typedef QDPOrder<FloatOut, length> G;
+        copyGauge<FloatOut, FloatIn, length>(G(out, Out, outGhost), inOrder, out, in, location, type);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_12) {
+#if QUDA_RECONSTRUCT & 2
+        typedef QDPOrder<FloatOut, length, 12> G;
+        copyGauge<FloatOut, FloatIn, length>(G(out, Out, outGhost), inOrder, out, in, location, type);
+#else
+        errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-12", QUDA_RECONSTRUCT);
+#endif
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_8) {
+#if QUDA_RECONSTRUCT & 1
+        typedef QDPOrder<FloatOut, length, 8> G;
+        copyGauge<FloatOut, FloatIn, length>(G(out, Out, outGhost), inOrder, out, in, location, type);
+#else
+        errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-8", QUDA_RECONSTRUCT);
+#endif
+      } else {
+        errorQuda("Reconstruction %d and order %d not supported", out.Reconstruct(), out.Order());
+      }
 #else
       errorQuda("QDP interface has not been built\n");
 #endif
@@ -93,8 +111,26 @@ namespace quda {
     } else if (out.Order() == QUDA_MILC_GAUGE_ORDER) {
 
 #ifdef BUILD_MILC_INTERFACE
-      copyGauge<FloatOut,FloatIn,length>
-	(MILCOrder<FloatOut,length>(out, Out, outGhost), inOrder, out, in, location, type);
+      if (out.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+        typedef MILCOrder<FloatOut, length> G;
+        copyGauge<FloatOut, FloatIn, length>(G(out, Out, outGhost), inOrder, out, in, location, type);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_12) {
+#if QUDA_RECONSTRUCT & 2
+        typedef MILCOrder<FloatOut, length, 12> G;
+        copyGauge<FloatOut, FloatIn, length>(G(out, Out, outGhost), inOrder, out, in, location, type);
+#else
+        errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-12", QUDA_RECONSTRUCT);
+#endif
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_8) {
+#if QUDA_RECONSTRUCT & 1
+        typedef MILCOrder<FloatOut, length, 8> G;
+        copyGauge<FloatOut, FloatIn, length>(G(out, Out, outGhost), inOrder, out, in, location, type);
+#else
+        errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-8", QUDA_RECONSTRUCT);
+#endif
+      } else {
+        errorQuda("Reconstruction %d and order %d not supported", out.Reconstruct(), out.Order());
+      }
 #else
       errorQuda("MILC interface has not been built\n");
 #endif
@@ -199,8 +235,26 @@ namespace quda {
     } else if (in.Order() == QUDA_QDP_GAUGE_ORDER) {
 
 #ifdef BUILD_QDP_INTERFACE
-      copyGauge<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length>(in, In, inGhost),
-					 out, in, location, Out, outGhost, type);
+      if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+        typedef QDPOrder<FloatIn, length> G;
+        copyGauge<FloatOut, FloatIn, length>(G(in, In, inGhost), out, in, location, Out, outGhost, type);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_12) {
+#if QUDA_RECONSTRUCT & 2
+        typedef QDPOrder<FloatIn, length, 12> G;
+        copyGauge<FloatOut, FloatIn, length>(G(in, In, inGhost), out, in, location, Out, outGhost, type);
+#else
+        errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-12", QUDA_RECONSTRUCT);
+#endif
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_8) {
+#if QUDA_RECONSTRUCT & 1
+        typedef QDPOrder<FloatIn, length, 8> G;
+        copyGauge<FloatOut, FloatIn, length>(G(in, In, inGhost), out, in, location, Out, outGhost, type);
+#else
+        errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-8", QUDA_RECONSTRUCT);
+#endif
+      } else {
+        errorQuda("Reconstruction %d and order %d not supported", in.Reconstruct(), in.Order());
+      }
 #else
       errorQuda("QDP interface has not been built\n");
 #endif
@@ -226,8 +280,26 @@ namespace quda {
     } else if (in.Order() == QUDA_MILC_GAUGE_ORDER) {
 
 #ifdef BUILD_MILC_INTERFACE
-      copyGauge<FloatOut,FloatIn,length>(MILCOrder<FloatIn,length>(in, In, inGhost),
-					 out, in, location, Out, outGhost, type);
+      if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+        typedef MILCOrder<FloatIn, length> G;
+        copyGauge<FloatOut, FloatIn, length>(G(in, In, inGhost), out, in, location, Out, outGhost, type);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_12) {
+#if QUDA_RECONSTRUCT & 2
+        typedef MILCOrder<FloatIn, length, 12> G;
+        copyGauge<FloatOut, FloatIn, length>(G(in, In, inGhost), out, in, location, Out, outGhost, type);
+#else
+        errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-12", QUDA_RECONSTRUCT);
+#endif
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_8) {
+#if QUDA_RECONSTRUCT & 1
+        typedef MILCOrder<FloatIn, length, 8> G;
+        copyGauge<FloatOut, FloatIn, length>(G(in, In, inGhost), out, in, location, Out, outGhost, type);
+#else
+        errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-8", QUDA_RECONSTRUCT);
+#endif
+      } else {
+        errorQuda("Reconstruction %d and order %d not supported", in.Reconstruct(), in.Order());
+      }
 #else
       errorQuda("MILC interface has not been built\n");
 #endif
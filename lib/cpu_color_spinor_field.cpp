@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <iostream>
+#include <algorithm>
 #include <typeinfo>
 #include <color_spinor_field.h>
 #include <comm_quda.h> // for comm_drand()
@@ -22,6 +23,7 @@ namespace quda {
     // need to set this before create
     if (param.create == QUDA_REFERENCE_FIELD_CREATE) {
       v = param.v;
+      norm = param.norm;
       reference = true;
     }
 
@@ -40,6 +42,7 @@ namespace quda {
     ColorSpinorField(src), init(false), reference(false) {
     create(QUDA_COPY_FIELD_CREATE);
     memcpy(v,src.v,bytes);
+    if (norm_bytes) memcpy(norm, src.norm, norm_bytes);
   }
 
   cpuColorSpinorField::cpuColorSpinorField(const ColorSpinorField &src) : 
@@ -47,6 +50,7 @@ namespace quda {
     create(QUDA_COPY_FIELD_CREATE);
     if (typeid(src) == typeid(cpuColorSpinorField)) {
       memcpy(v, dynamic_cast<const cpuColorSpinorField&>(src).v, bytes);
+      if (norm_bytes) memcpy(norm, dynamic_cast<const cpuColorSpinorField &>(src).norm, norm_bytes);
     } else if (typeid(src) == typeid(cudaColorSpinorField)) {
       dynamic_cast<const cudaColorSpinorField&>(src).saveSpinorField(*this);
     } else {
@@ -131,7 +135,13 @@ namespace quda {
     if (isNative()) bytes = (siteSubset == QUDA_FULL_SITE_SUBSET && fieldOrder != QUDA_QDPJIT_FIELD_ORDER) ? 2*ALIGNMENT_ADJUST(bytes/2) : ALIGNMENT_ADJUST(bytes);
 
     if (pad != 0) errorQuda("Non-zero pad not supported");
-    if (precision < QUDA_SINGLE_PRECISION) errorQuda("Fixed-point precision not supported");
+    if (precision == QUDA_QUARTER_PRECISION) errorQuda("Quarter precision not supported");
+    // half-precision fields use the same per-site norm as the native format
+    if (precision == QUDA_HALF_PRECISION && fieldOrder != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+      errorQuda("Half precision only supported with field order %d (requested %d)", QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,
+                fieldOrder);
+    // and exchange their halos in single precision
+    if (precision == QUDA_HALF_PRECISION) ghost_precision = QUDA_SINGLE_PRECISION;
 
     if (fieldOrder != QUDA_SPACE_COLOR_SPIN_FIELD_ORDER && 
 	fieldOrder != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER &&
@@ -150,6 +160,7 @@ namespace quda {
       } else {
         v = safe_malloc(bytes);
       }
+      if (norm_bytes) norm = safe_malloc(norm_bytes);
       init = true;
     }
  
@@ -187,6 +198,7 @@ namespace quda {
       if (fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) 
 	for (int i=0; i<x[nDim-1]; i++) host_free(((void**)v)[i]);
       host_free(v);
+      if (norm_bytes) host_free(norm);
       init = false;
     }
 
@@ -204,6 +216,7 @@ namespace quda {
         for (int i=0; i<x[nDim-1]; i++) memcpy(((void**)v)[i], ((void**)src.v)[i], bytes/x[nDim-1]);
       else 
         memcpy(v, src.v, bytes);
+      if (norm_bytes) memcpy(norm, src.norm, norm_bytes);
     } else {
       copyGenericColorSpinor(*this, src, QUDA_CPU_FIELD_LOCATION);
     }
@@ -240,6 +253,7 @@ namespace quda {
   void cpuColorSpinorField::zero() {
     if (fieldOrder != QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) memset(v, '\0', bytes);
     else for (int i=0; i<x[nDim-1]; i++) memset(((void**)v)[i], '\0', bytes/x[nDim-1]);
+    if (norm_bytes) memset(norm, '\0', norm_bytes);
   }
 
   void cpuColorSpinorField::Source(QudaSourceType source_type, int x, int s, int c) {
@@ -257,7 +271,7 @@ namespace quda {
 
   void cpuColorSpinorField::allocateGhostBuffer(int nFace) const
   {
-    int spinor_size = 2*nSpin*nColor*precision;
+    int spinor_size = 2 * nSpin * nColor * std::max(precision, ghost_precision);
     bool resize = false;
 
     // resize face only if requested size is larger than previously allocated one
@@ -296,6 +310,17 @@ namespace quda {
 
   void cpuColorSpinorField::packGhost(void **ghost, const QudaParity parity, const int nFace, const int dagger) const
   {
+    if (precision == QUDA_HALF_PRECISION) {
+      // the generic packer assumes a global scale, so decode the per-site norm into a single-precision copy
+      ColorSpinorParam param(*this);
+      param.create = QUDA_NULL_FIELD_CREATE;
+      param.setPrecision(QUDA_SINGLE_PRECISION);
+      param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+      cpuColorSpinorField tmp(param);
+      tmp.copy(*this);
+      genericPackGhost(ghost, tmp, parity, nFace, dagger);
+      return;
+    }
     genericPackGhost(ghost, *this, parity, nFace, dagger);
     return;
   }
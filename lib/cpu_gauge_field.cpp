@@ -9,8 +9,12 @@ namespace quda {
   cpuGaugeField::cpuGaugeField(const GaugeFieldParam &param) :
     GaugeField(param)
   {
-    if (precision == QUDA_HALF_PRECISION) {
-      errorQuda("CPU fields do not support half precision");
+    // half-precision coarse links use a global scale, as with their device counterparts
+    if (precision == QUDA_HALF_PRECISION && link_type != QUDA_COARSE_LINKS) {
+      errorQuda("CPU fields only support half precision for coarse links");
+    }
+    if (precision == QUDA_HALF_PRECISION && order != QUDA_QDP_GAUGE_ORDER && order != QUDA_MILC_GAUGE_ORDER) {
+      errorQuda("Half precision not supported for order %d", order);
     }
     if (precision == QUDA_QUARTER_PRECISION) {
       errorQuda("CPU fields do not support quarter precision");
@@ -18,9 +22,15 @@ namespace quda {
     if (pad != 0) {
       errorQuda("CPU fields do not support non-zero padding");
     }
-    if (reconstruct != QUDA_RECONSTRUCT_NO && reconstruct != QUDA_RECONSTRUCT_10) {
+    if (reconstruct != QUDA_RECONSTRUCT_NO && reconstruct != QUDA_RECONSTRUCT_10 && reconstruct != QUDA_RECONSTRUCT_12
+        && reconstruct != QUDA_RECONSTRUCT_8) {
       errorQuda("Reconstruction type %d not supported", reconstruct);
     }
+    // compressed links are reconstructed on load by the QDP and MILC accessors
+    if ((reconstruct == QUDA_RECONSTRUCT_12 || reconstruct == QUDA_RECONSTRUCT_8)
+        && ((order != QUDA_QDP_GAUGE_ORDER && order != QUDA_MILC_GAUGE_ORDER) || precision < QUDA_SINGLE_PRECISION)) {
+      errorQuda("Reconstruction type %d not supported for order %d and precision %d", reconstruct, order, precision);
+    }
     if (reconstruct == QUDA_RECONSTRUCT_10 && link_type != QUDA_ASQTAD_MOM_LINKS) {
       errorQuda("10-reconstruction only supported with momentum links");
     }
@@ -410,4 +410,203 @@ namespace quda
     profile.TPSTART(QUDA_PROFILE_INIT);
   }
 
+  // number of coarse coefficient vectors we convert to the working precision at once
+  constexpr int compressed_batch_size = 16;
+
+  CompressedDeflationSpace::CompressedDeflationSpace(const QudaEigParam &eig_param,
+                                                     const std::vector<ColorSpinorField *> &evecs, QudaParity parity) :
+    profile("CompressedDeflationSpace", false),
+    n_ev_deflate(eig_param.n_ev_deflate == -1 ? (int)evecs.size() : eig_param.n_ev_deflate),
+    parity(parity),
+    transfer(nullptr),
+    fine_tmp(nullptr),
+    coarse_src(nullptr),
+    coarse_sol(nullptr)
+  {
+    profile.TPSTART(QUDA_PROFILE_INIT);
+
+    const int n_ev = evecs.size();
+    const int n_basis = eig_param.compress_n_basis;
+    if (n_ev == 0) errorQuda("Cannot compress an empty deflation space");
+    if (n_basis <= 0 || n_basis > n_ev)
+      errorQuda("Invalid number of basis vectors %d for deflation space of size %d", n_basis, n_ev);
+    if (n_ev_deflate > n_ev) errorQuda("deflation vecs = %d is greater than space size = %d", n_ev_deflate, n_ev);
+
+    const ColorSpinorField &meta = *evecs[0];
+    const bool single_parity = meta.SiteSubset() == QUDA_PARITY_SITE_SUBSET;
+    if (single_parity && parity != QUDA_EVEN_PARITY && parity != QUDA_ODD_PARITY)
+      errorQuda("Undefined parity %d for single-parity deflation space", parity);
+
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Compressing deflation space of %d vectors onto %d basis vectors\n", n_ev, n_basis);
+
+    // the basis vectors are full fields, with single-parity eigenvectors embedded into the matching parity
+    ColorSpinorParam csParam(meta);
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    csParam.setPrecision(QUDA_SINGLE_PRECISION, QUDA_SINGLE_PRECISION, true);
+    if (single_parity) {
+      csParam.x[0] *= 2;
+      csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+    }
+
+    basis.reserve(n_basis);
+    for (int i = 0; i < n_basis; i++) {
+      basis.push_back(ColorSpinorField::Create(csParam));
+      if (!single_parity)
+        blas::copy(*basis[i], *evecs[i]);
+      else if (parity == QUDA_EVEN_PARITY)
+        blas::copy(basis[i]->Even(), *evecs[i]);
+      else
+        blas::copy(basis[i]->Odd(), *evecs[i]);
+    }
+
+    int geo_bs[QUDA_MAX_DIM] = {};
+    for (int d = 0; d < 4; d++) geo_bs[d] = eig_param.compress_block_size[d];
+    const int spin_bs = meta.Nspin() == 1 ? 0 : 2;
+    transfer = new Transfer(basis, n_basis, 1, geo_bs, spin_bs, eig_param.compress_precision, QUDA_TRANSFER_AGGREGATE,
+                            profile);
+    if (single_parity) transfer->setSiteSubset(QUDA_PARITY_SITE_SUBSET, parity);
+
+    // The block-orthogonalized basis now lives in the transfer
+    // operator, which only needs the first vector for its metadata
+    for (int i = 1; i < n_basis; i++) delete basis[i];
+    basis.resize(1);
+
+    csParam = ColorSpinorParam(meta);
+    csParam.create = QUDA_NULL_FIELD_CREATE;
+    csParam.setPrecision(QUDA_SINGLE_PRECISION, QUDA_SINGLE_PRECISION, true);
+    fine_tmp = ColorSpinorField::Create(csParam);
+
+    const int *coarse_bs = transfer->Geo_bs();
+    coarse_src = basis[0]->CreateCoarse(coarse_bs, spin_bs, n_basis, QUDA_SINGLE_PRECISION);
+    coarse_sol = basis[0]->CreateCoarse(coarse_bs, spin_bs, n_basis, QUDA_SINGLE_PRECISION);
+    if (eig_param.compress_precision != QUDA_SINGLE_PRECISION) {
+      for (int i = 0; i < std::min(compressed_batch_size, n_ev); i++)
+        coarse_tmp.push_back(basis[0]->CreateCoarse(coarse_bs, spin_bs, n_basis, QUDA_SINGLE_PRECISION));
+    }
+
+    // Since P R is an orthogonal projector, |v - P R v|^2 = |v|^2 - |R v|^2
+    double max_error = 0.0;
+    coeff.reserve(n_ev);
+    for (int i = 0; i < n_ev; i++) {
+      blas::copy(*fine_tmp, *evecs[i]);
+      transfer->R(*coarse_src, *fine_tmp);
+      coeff.push_back(basis[0]->CreateCoarse(coarse_bs, spin_bs, n_basis, eig_param.compress_precision));
+      blas::copy(*coeff[i], *coarse_src);
+
+      double v2 = blas::norm2(*fine_tmp);
+      double error = sqrt(std::max(0.0, 1.0 - blas::norm2(*coarse_src) / v2));
+      max_error = std::max(max_error, error);
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printfQuda("Compressed eigenvector %d relative error = %e\n", i, error);
+    }
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      size_t full_bytes = n_ev * meta.Bytes();
+      printfQuda("Compressed deflation space uses %.2f MiB (uncompressed %.2f MiB), maximum relative error %e\n",
+                 Bytes() / (double)(1 << 20), full_bytes / (double)(1 << 20), max_error);
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_INIT);
+  }
+
+  CompressedDeflationSpace::~CompressedDeflationSpace()
+  {
+    for (auto &c : coeff) delete c;
+    for (auto &c : coarse_tmp) delete c;
+    if (coarse_sol) delete coarse_sol;
+    if (coarse_src) delete coarse_src;
+    if (fine_tmp) delete fine_tmp;
+    if (transfer) delete transfer;
+    for (auto &b : basis) delete b;
+
+    if (getVerbosity() >= QUDA_DEBUG_VERBOSE) profile.Print();
+  }
+
+  void CompressedDeflationSpace::deflate(ColorSpinorField &sol, const ColorSpinorField &src,
+                                         const std::vector<Complex> &evals, bool accumulate) const
+  {
+    if (n_ev_deflate == 0) {
+      warningQuda("deflate called with n_ev_deflate = 0");
+      return;
+    }
+
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Deflating %d compressed vectors\n", n_ev_deflate);
+
+    // 1. Restrict the source: with a block-orthonormal basis we
+    //    have (V_i)^dag * vec = (C_i)^dag * R * vec
+    blas::copy(*fine_tmp, src);
+    transfer->R(*coarse_src, *fine_tmp);
+
+    // 2. Accumulate Sum_i C_i * (L_i)^{-1} * (C_i)^dag * R * vec on
+    //    the coarse grid, converting the coefficients to the working
+    //    precision in batches if needed
+    blas::zero(*coarse_sol);
+    std::vector<ColorSpinorField *> src_ {coarse_src};
+    std::vector<ColorSpinorField *> sol_ {coarse_sol};
+    const int batch = coarse_tmp.size() > 0 ? coarse_tmp.size() : n_ev_deflate;
+    for (int i = 0; i < n_ev_deflate; i += batch) {
+      const int n = std::min(batch, n_ev_deflate - i);
+      std::vector<ColorSpinorField *> c;
+      c.reserve(n);
+      for (int j = 0; j < n; j++) {
+        if (coarse_tmp.size() > 0) {
+          blas::copy(*coarse_tmp[j], *coeff[i + j]);
+          c.push_back(coarse_tmp[j]);
+        } else {
+          c.push_back(coeff[i + j]);
+        }
+      }
+
+      std::vector<Complex> s(n);
+      blas::cDotProduct(s.data(), c, src_);
+      for (int j = 0; j < n; j++) s[j] /= evals[i + j].real();
+      blas::caxpy(s.data(), c, sol_);
+    }
+
+    // 3. Prolongate the deflated solution back to the fine grid
+    transfer->P(*fine_tmp, *coarse_sol);
+    if (accumulate)
+      blas::xpy(*fine_tmp, sol);
+    else
+      blas::copy(sol, *fine_tmp);
+
+    // Save Deflation tuning
+    saveTuneCache();
+  }
+
+  void CompressedDeflationSpace::reconstruct(ColorSpinorField &v, int i) const
+  {
+    if (i < 0 || i >= size()) errorQuda("Invalid eigenvector index %d for compressed space of size %d", i, size());
+    blas::copy(*coarse_sol, *coeff[i]);
+    transfer->P(*fine_tmp, *coarse_sol);
+    blas::copy(v, *fine_tmp);
+  }
+
+  void CompressedDeflationSpace::computeEvals(const DiracMatrix &mat, QudaPrecision precision,
+                                              std::vector<Complex> &evals) const
+  {
+    ColorSpinorParam csParam(*fine_tmp);
+    csParam.create = QUDA_NULL_FIELD_CREATE;
+    csParam.setPrecision(precision, QUDA_INVALID_PRECISION, true);
+    std::unique_ptr<ColorSpinorField> v(ColorSpinorField::Create(csParam));
+    std::unique_ptr<ColorSpinorField> mv(ColorSpinorField::Create(csParam));
+
+    evals.resize(size());
+    for (int i = 0; i < size(); i++) {
+      reconstruct(*v, i);
+      mat(*mv, *v);
+      // the reconstruction is not exactly normalized, so use the Rayleigh quotient
+      evals[i] = blas::cDotProduct(*v, *mv) / blas::norm2(*v);
+      if (getVerbosity() >= QUDA_VERBOSE)
+        printfQuda("Compressed eval[%04d] = (%+.16e,%+.16e)\n", i, evals[i].real(), evals[i].imag());
+    }
+  }
+
+  size_t CompressedDeflationSpace::Bytes() const
+  {
+    size_t bytes = transfer->Vectors(QUDA_CUDA_FIELD_LOCATION).Bytes();
+    for (auto &c : coeff) bytes += c->Bytes();
+    return bytes;
+  }
+
 } // namespace quda
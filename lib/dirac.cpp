@@ -1,6 +1,7 @@
 #include <dirac_quda.h>
 #include <dslash_quda.h>
 #include <blas_quda.h>
+#include <workspace.h>
 
 #include <iostream>
 
@@ -105,6 +106,24 @@ namespace quda {
 
 #undef flip
 
+  void Dirac::MMultiRHS(ColorSpinorField &out, const ColorSpinorField &in) const
+  {
+    if (in.Ndim() != 5 || out.Ndim() != 5 || in.X(4) != out.X(4))
+      errorQuda("Fields are not multi-RHS fields with matching right-hand sides (nDim = %d %d)", out.Ndim(), in.Ndim());
+
+    ColorSpinorParam param(in);
+    param.nDim = 4;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    WorkspaceField x(param);
+    WorkspaceField y(param);
+
+    for (int s = 0; s < in.X(4); s++) {
+      copyMultiRHS(*x, in, s);
+      M(*y, *x);
+      copyMultiRHS(out, *y, s);
+    }
+  }
+
   void Dirac::checkParitySpinor(const ColorSpinorField &out, const ColorSpinorField &in) const
   {
     if ( (in.GammaBasis() != QUDA_UKQCD_GAMMA_BASIS || out.GammaBasis() != QUDA_UKQCD_GAMMA_BASIS) && 
@@ -55,6 +55,18 @@ namespace quda {
     flops += 1872ll * in.Volume();
   }
 
+  void DiracClover::MMultiRHS(ColorSpinorField &out, const ColorSpinorField &in) const
+  {
+    if (!hasMultiRHS()) {
+      Dirac::MMultiRHS(out, in);
+      return;
+    }
+    checkFullSpinor(out, in);
+
+    ApplyWilsonCloverMultiRHS(out, in, *gauge, *clover, -kappa, in, QUDA_INVALID_PARITY, dagger, commDim, profile);
+    flops += 1872ll * in.Volume();
+  }
+
   void DiracClover::MdagM(ColorSpinorField &out, const ColorSpinorField &in) const
   {
     checkFullSpinor(out, in);
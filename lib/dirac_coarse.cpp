@@ -1,10 +1,11 @@
 #include <string.h>
 #include <multigrid.h>
+#include <mg_checkpoint.h>
 #include <algorithm>
 
 namespace quda {
 
-  DiracCoarse::DiracCoarse(const DiracParam &param, bool gpu_setup, bool mapped) :
+  DiracCoarse::DiracCoarse(const DiracParam &param, bool gpu_setup, bool mapped, MGCheckpoint *checkpoint) :
     Dirac(param),
     mass(param.mass),
     mu(param.mu),
@@ -28,7 +29,10 @@ namespace quda {
     init_cpu(!gpu_setup),
     mapped(mapped)
   {
-    initializeCoarse();
+    if (checkpoint)
+      restore(*checkpoint);
+    else
+      initializeCoarse();
   }
 
   DiracCoarse::DiracCoarse(const DiracParam &param, cpuGaugeField *Y_h, cpuGaugeField *X_h, cpuGaugeField *Xinv_h,
@@ -123,8 +127,9 @@ namespace quda {
     gParam.link_type = QUDA_COARSE_LINKS;
     gParam.t_boundary = QUDA_PERIODIC_T;
     gParam.create = QUDA_ZERO_FIELD_CREATE;
-    // use null-space precision for coarse links on gpu
-    gParam.setPrecision( transfer->NullPrecision(gpu ? QUDA_CUDA_FIELD_LOCATION : QUDA_CPU_FIELD_LOCATION) );
+    // use null-space precision for coarse links on gpu, and keep the gpu precision when copying to the host
+    gParam.setPrecision(gpu ? transfer->NullPrecision(QUDA_CUDA_FIELD_LOCATION) :
+                          Y_d ? Y_d->Precision() : transfer->NullPrecision(QUDA_CPU_FIELD_LOCATION));
     gParam.nDim = ndim;
     gParam.siteSubset = QUDA_FULL_SITE_SUBSET;
     gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
@@ -165,8 +170,9 @@ namespace quda {
     gParam.link_type = QUDA_COARSE_LINKS;
     gParam.t_boundary = QUDA_PERIODIC_T;
     gParam.create = QUDA_ZERO_FIELD_CREATE;
-    // use null-space precision for preconditioned links on gpu
-    gParam.setPrecision( transfer->NullPrecision(gpu ? QUDA_CUDA_FIELD_LOCATION : QUDA_CPU_FIELD_LOCATION) );
+    // use null-space precision for preconditioned links on gpu, and keep the gpu precision when copying to the host
+    gParam.setPrecision(gpu ? transfer->NullPrecision(QUDA_CUDA_FIELD_LOCATION) :
+                          Yhat_d ? Yhat_d->Precision() : transfer->NullPrecision(QUDA_CPU_FIELD_LOCATION));
     gParam.nDim = ndim;
     gParam.siteSubset = QUDA_FULL_SITE_SUBSET;
     gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
@@ -283,6 +289,34 @@ namespace quda {
     }
   }
 
+  void DiracCoarse::restore(MGCheckpoint &checkpoint)
+  {
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Restoring the coarse op\n");
+
+    createY(true, mapped);
+    createYhat(true);
+    checkpoint.load("Y", *Y_d);
+    checkpoint.load("X", *X_d);
+    checkpoint.load("Yhat", *Yhat_d);
+    checkpoint.load("Xinv", *Xinv_d);
+
+    // rebuild the bi-directional halos as calculateYhat does
+    Y_d->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+    Yhat_d->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+
+    enable_gpu = true;
+    init_gpu = true;
+  }
+
+  void DiracCoarse::save(MGCheckpoint &checkpoint) const
+  {
+    initializeLazy(QUDA_CUDA_FIELD_LOCATION);
+    checkpoint.save("Y", *Y_d);
+    checkpoint.save("X", *X_d);
+    checkpoint.save("Yhat", *Yhat_d);
+    checkpoint.save("Xinv", *Xinv_d);
+  }
+
   // we only copy to host or device lazily on demand
   void DiracCoarse::initializeLazy(QudaFieldLocation location) const
   {
@@ -1,5 +1,6 @@
 #include <dirac_quda.h>
 #include <blas_quda.h>
+#include <workspace.h>
 #include <iostream>
 #include <multigrid.h>
 
@@ -51,6 +52,18 @@ namespace quda {
     flops += 1368ll * in.Volume();
   }
 
+  void DiracWilson::MMultiRHS(ColorSpinorField &out, const ColorSpinorField &in) const
+  {
+    if (!hasMultiRHS()) {
+      Dirac::MMultiRHS(out, in);
+      return;
+    }
+    checkFullSpinor(out, in);
+
+    ApplyWilsonMultiRHS(out, in, *gauge, -kappa, in, QUDA_INVALID_PARITY, dagger, commDim, profile);
+    flops += 1368ll * in.Volume();
+  }
+
   void DiracWilson::MdagM(ColorSpinorField &out, const ColorSpinorField &in) const
   {
     checkFullSpinor(out, in);
@@ -136,6 +149,36 @@ namespace quda {
     deleteTmp(&tmp1, reset);
   }
 
+  void DiracWilsonPC::MMultiRHS(ColorSpinorField &out, const ColorSpinorField &in) const
+  {
+    if (!hasMultiRHS()) {
+      Dirac::MMultiRHS(out, in);
+      return;
+    }
+    checkParitySpinor(out, in);
+    checkSpinorAlias(out, in);
+
+    double kappa2 = -kappa*kappa;
+    ColorSpinorParam param(in);
+    param.create = QUDA_NULL_FIELD_CREATE;
+    WorkspaceField tmp(param);
+
+    QudaParity parity[2];
+    if (matpcType == QUDA_MATPC_EVEN_EVEN) {
+      parity[0] = QUDA_ODD_PARITY;
+      parity[1] = QUDA_EVEN_PARITY;
+    } else if (matpcType == QUDA_MATPC_ODD_ODD) {
+      parity[0] = QUDA_EVEN_PARITY;
+      parity[1] = QUDA_ODD_PARITY;
+    } else {
+      errorQuda("MatPCType %d not valid for DiracWilsonPC", matpcType);
+    }
+
+    ApplyWilsonMultiRHS(*tmp, in, *gauge, 0.0, in, parity[0], dagger, commDim, profile);
+    ApplyWilsonMultiRHS(out, *tmp, *gauge, kappa2, in, parity[1], dagger, commDim, profile);
+    flops += (1320ll + 1368ll) * in.Volume();
+  }
+
   void DiracWilsonPC::MdagM(ColorSpinorField &out, const ColorSpinorField &in) const
   {
     bool reset = newTmp(&tmp2, in);
@@ -483,6 +483,25 @@ namespace quda {
 	   policy == DslashCoarsePolicy::DSLASH_COARSE_ZERO_COPY_PACK_GDR_RECV ||
 	   policy == DslashCoarsePolicy::DSLASH_COARSE_GDR_SEND_ZERO_COPY_READ) comm_enable_peer2peer(false);
 
+      if (precision == QUDA_HALF_PRECISION && out.Location() == QUDA_CPU_FIELD_LOCATION) {
+        // the host stencil reads and writes through a global scale, so it is applied to single-precision
+        // copies of half-precision host fields, whose per-site norms are decoded and re-encoded by the copies
+        auto single = [](const ColorSpinorField &a) {
+          ColorSpinorParam param(a);
+          param.create = QUDA_NULL_FIELD_CREATE;
+          param.setPrecision(QUDA_SINGLE_PRECISION);
+          param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+          return param;
+        };
+        cpuColorSpinorField out_s(single(out)), inA_s(single(inA)), inB_s(single(inB));
+        inA_s.copy(static_cast<const cpuColorSpinorField &>(inA));
+        if (clover) inB_s.copy(static_cast<const cpuColorSpinorField &>(inB));
+        DslashCoarseLaunch<dagger>(out_s, inA_s, inB_s, Y, X, kappa, parity, dslash, clover, commDim,
+                                   halo_precision)(policy);
+        static_cast<cpuColorSpinorField &>(out).copy(out_s);
+        return;
+      }
+
       if (dslash && comm_partitioned() && comms) {
 	const int nFace = 1;
         inA.exchangeGhost((QudaParity)(inA.SiteSubset() == QUDA_PARITY_SITE_SUBSET ? (1 - parity) : 0), nFace, dagger,
@@ -512,7 +531,11 @@ namespace quda {
           }
         } else if (Y.Precision() == QUDA_HALF_PRECISION) {
 #if QUDA_PRECISION & 2
-          if (halo_precision == QUDA_HALF_PRECISION) {
+          if (out.Location() == QUDA_CPU_FIELD_LOCATION) {
+            // host halos are always exchanged in the precision of the field
+            ApplyCoarse<float, short, float, dagger>(out, inA, inB, Y, X, kappa, parity, dslash, clover,
+                                                     comms ? DSLASH_FULL : DSLASH_INTERIOR, halo_location);
+          } else if (halo_precision == QUDA_HALF_PRECISION) {
             ApplyCoarse<float,short,short,dagger>(out, inA, inB, Y, X, kappa, parity, dslash, clover,
                                                   comms ? DSLASH_FULL : DSLASH_INTERIOR, halo_location);
           } else if (halo_precision == QUDA_QUARTER_PRECISION) {
@@ -532,7 +555,7 @@ namespace quda {
           errorQuda("Unsupported precision %d\n", Y.Precision());
         }
       } else {
-	errorQuda("Unsupported precision %d\n", Y.Precision());
+        errorQuda("Unsupported field precision %d\n", precision);
       }
 
       if (dslash && comm_partitioned() && comms) inA.bufferIndex = (1 - inA.bufferIndex);
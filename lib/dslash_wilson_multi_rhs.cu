@@ -0,0 +1,323 @@
+#include <gauge_field.h>
+#include <color_spinor_field.h>
+#include <clover_field.h>
+#include <dslash.h>
+#include <worker.h>
+
+#include <dslash_policy.cuh>
+#include <launch_kernel.cuh>
+#include <kernels/dslash_wilson_multi_rhs.cuh>
+#include <launch_host.h>
+
+/**
+   This is the Wilson and Wilson-clover operator applied to a set of
+   right-hand sides stored as a multi-RHS field.  As with the 4-d
+   preconditioned domain-wall operator, the fifth dimension is
+   batched over, with each thread applying its links to a tile of
+   right-hand sides.
+*/
+
+namespace quda
+{
+
+  template <typename Arg> class WilsonMultiRHS : public Dslash<wilsonMultiRHS, Arg>
+  {
+    using Dslash = Dslash<wilsonMultiRHS, Arg>;
+    using Dslash::arg;
+    using Dslash::in;
+
+    /**
+       @brief Number of right-hand side tiles
+    */
+    int tiles() const { return (arg.n_rhs + Arg::rhs_tile - 1) / Arg::rhs_tile; }
+
+  public:
+    WilsonMultiRHS(Arg &arg, const ColorSpinorField &out, const ColorSpinorField &in) : Dslash(arg, out, in)
+    {
+      TunableVectorYZ::resizeVector(tiles(), arg.nParity);
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      Dslash::setParam(tp);
+      if (Arg::clover && !arg.xpay) errorQuda("Wilson-clover operator only defined for xpay=true");
+      Dslash::template instantiate<packShmem>(tp, stream);
+    }
+
+    long long flops() const
+    {
+      int clover_flops = Arg::clover ? 504 : 0;
+      long long flops = Dslash::flops();
+
+      switch (arg.kernel_type) {
+      case INTERIOR_KERNEL:
+      case KERNEL_POLICY: flops += clover_flops * in.Volume(); break;
+      default: break; // all clover flops are in the interior kernel
+      }
+      return flops;
+    }
+
+    long long bytes() const
+    {
+      int gauge_bytes = arg.reconstruct * in.Precision();
+      int clover_bytes = 72 * in.Precision() + (isFixed<typename Arg::Float>::value ? 2 * sizeof(float) : 0);
+      long long bytes = Dslash::bytes();
+
+      switch (arg.kernel_type) {
+      case INTERIOR_KERNEL:
+      case KERNEL_POLICY: {
+        // links and clover matrices are loaded once per tile, not once per right-hand side
+        long long sites_4d = in.Volume() / arg.n_rhs;
+        if (Arg::clover) bytes += clover_bytes * sites_4d * tiles();
+        bytes -= 2 * 4 * gauge_bytes * sites_4d * (arg.n_rhs - tiles());
+        break;
+      }
+      default: break;
+      }
+
+      return bytes;
+    }
+  };
+
+  template <typename Float, int nColor, QudaReconstructType recon> struct WilsonMultiRHSApply {
+
+    inline WilsonMultiRHSApply(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                               const ColorSpinorField &x, int parity, bool dagger, const int *comm_override,
+                               TimeProfile &profile)
+    {
+      WilsonMultiRHSArg<Float, nColor, recon> arg(out, in, U, a, x, parity, dagger, comm_override);
+      WilsonMultiRHS<decltype(arg)> wilson(arg, out, in);
+
+      dslash::DslashPolicyTune<decltype(wilson)> policy(
+        wilson, const_cast<cudaColorSpinorField *>(static_cast<const cudaColorSpinorField *>(&in)),
+        in.getDslashConstant().volume_4d_cb, in.getDslashConstant().ghostFaceCB, profile);
+      policy.apply(0);
+    }
+  };
+
+  template <typename Float, int nColor, QudaReconstructType recon> struct WilsonCloverMultiRHSApply {
+
+    inline WilsonCloverMultiRHSApply(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                                     const CloverField &A, double a, const ColorSpinorField &x, int parity,
+                                     bool dagger, const int *comm_override, TimeProfile &profile)
+    {
+      WilsonCloverMultiRHSArg<Float, nColor, recon> arg(out, in, U, A, a, x, parity, dagger, comm_override);
+      WilsonMultiRHS<decltype(arg)> wilson(arg, out, in);
+
+      dslash::DslashPolicyTune<decltype(wilson)> policy(
+        wilson, const_cast<cudaColorSpinorField *>(static_cast<const cudaColorSpinorField *>(&in)),
+        in.getDslashConstant().volume_4d_cb, in.getDslashConstant().ghostFaceCB, profile);
+      policy.apply(0);
+    }
+  };
+
+  template <typename Float, int nColor, QudaReconstructType recon> struct WilsonMultiRHSHostApply {
+
+    inline WilsonMultiRHSHostApply(const GaugeField &U, ColorSpinorField &out, const ColorSpinorField &in, double a,
+                                   const ColorSpinorField &x, int parity, bool dagger, const int *comm_override)
+    {
+      WilsonMultiRHSHostArg<Float, nColor, recon> arg(out, in, U, a, x, parity, dagger, comm_override);
+      const int tiles = (arg.n_rhs + arg.rhs_tile - 1) / arg.rhs_tile;
+      const int threads = in.getDslashConstant().volume_4d_cb;
+
+      if (dagger) {
+        if (arg.xpay)
+          launchHost(WilsonMultiRHSHost<true, true, decltype(arg)>(arg), threads, arg.nParity, tiles);
+        else
+          launchHost(WilsonMultiRHSHost<true, false, decltype(arg)>(arg), threads, arg.nParity, tiles);
+      } else {
+        if (arg.xpay)
+          launchHost(WilsonMultiRHSHost<false, true, decltype(arg)>(arg), threads, arg.nParity, tiles);
+        else
+          launchHost(WilsonMultiRHSHost<false, false, decltype(arg)>(arg), threads, arg.nParity, tiles);
+      }
+    }
+  };
+
+  /**
+     @brief Check that a pair of fields are multi-RHS fields with the same number of right-hand sides
+  */
+  static void checkMultiRHS(const ColorSpinorField &out, const ColorSpinorField &in)
+  {
+    if (in.Ndim() != 5 || out.Ndim() != 5 || in.PCType() != QUDA_4D_PC || out.PCType() != QUDA_4D_PC)
+      errorQuda("Fields are not multi-RHS fields (nDim = %d %d, pc_type = %d %d)", out.Ndim(), in.Ndim(),
+                out.PCType(), in.PCType());
+    if (in.X(4) != out.X(4)) errorQuda("Mismatched number of right-hand sides %d != %d", out.X(4), in.X(4));
+  }
+
+  // Apply the Wilson operator to each right-hand side of a multi-RHS field
+  // out(x,s) = M*in = x(x,s) + a*\sum_mu U_{-\mu}(x)in(x+mu,s) + U^\dagger_mu(x-mu)in(x-mu,s)
+  void ApplyWilsonMultiRHS(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                           const ColorSpinorField &x, int parity, bool dagger, const int *comm_override,
+                           TimeProfile &profile)
+  {
+#ifdef GPU_WILSON_DIRAC
+    checkMultiRHS(out, in);
+    if (in.Location() == QUDA_CPU_FIELD_LOCATION) {
+      // compressed host links are reconstructed on the fly, so dispatch on the gauge field
+      instantiate<WilsonMultiRHSHostApply, WilsonReconstruct>(U, out, in, a, x, parity, dagger, comm_override);
+    } else {
+      instantiate<WilsonMultiRHSApply, WilsonReconstruct>(out, in, U, a, x, parity, dagger, comm_override, profile);
+    }
+#else
+    errorQuda("Wilson dslash has not been built");
+#endif // GPU_WILSON_DIRAC
+  }
+
+  // Apply the Wilson-clover operator to each right-hand side of a multi-RHS field
+  // out(x,s) = M*in = A(x)*x(x,s) + a*\sum_mu U_{-\mu}(x)in(x+mu,s) + U^\dagger_mu(x-mu)in(x-mu,s)
+  void ApplyWilsonCloverMultiRHS(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                                 const CloverField &A, double a, const ColorSpinorField &x, int parity, bool dagger,
+                                 const int *comm_override, TimeProfile &profile)
+  {
+#ifdef GPU_CLOVER_DIRAC
+    checkMultiRHS(out, in);
+    if (in.Location() == QUDA_CPU_FIELD_LOCATION) errorQuda("Host multi-RHS Wilson-clover dslash not supported");
+    instantiate<WilsonCloverMultiRHSApply>(out, in, U, A, a, x, parity, dagger, comm_override, profile);
+#else
+    errorQuda("Clover dslash has not been built");
+#endif
+  }
+
+  template <typename Float, int nColor> class CopyMultiRHSField : TunableVectorY
+  {
+    ColorSpinorField &dst;
+    const ColorSpinorField &src;
+    const int s;
+    const ColorSpinorField &meta; // the 4-d field
+
+    bool tuneGridDim() const { return false; }
+    unsigned int minThreads() const { return meta.VolumeCB(); }
+
+  public:
+    CopyMultiRHSField(ColorSpinorField &dst, const ColorSpinorField &src, int s) :
+      TunableVectorY(src.SiteSubset()),
+      dst(dst),
+      src(src),
+      s(s),
+      meta(dst.Ndim() == 5 ? src : dst)
+    {
+      strcpy(aux, meta.AuxString());
+      strcat(aux, dst.Ndim() == 5 ? ",insert" : ",extract");
+      apply(0);
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
+        CopyMultiRHSArg<Float, nColor, false> arg(dst, src, s);
+        launchHost(CopyMultiRHS<decltype(arg)>(arg), arg.threads, arg.nParity);
+      } else {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+        CopyMultiRHSArg<Float, nColor> arg(dst, src, s);
+        qudaLaunchKernel(copyMultiRHSKernel<decltype(arg)>, tp, stream, arg);
+      }
+    }
+
+    TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
+
+    void preTune() { dst.backup(); }
+    void postTune() { dst.restore(); }
+
+    long long flops() const { return 0; }
+    long long bytes() const { return 2 * meta.Bytes() + 2 * meta.NormBytes(); }
+  };
+
+  void copyMultiRHS(ColorSpinorField &dst, const ColorSpinorField &src, int s)
+  {
+    const ColorSpinorField &batch = dst.Ndim() == 5 ? dst : src;
+    const ColorSpinorField &field = dst.Ndim() == 5 ? src : dst;
+
+    if (batch.Ndim() != 5 || batch.PCType() != QUDA_4D_PC || field.Ndim() != 4)
+      errorQuda("Expected a 4-d field and a multi-RHS field (nDim = %d %d)", dst.Ndim(), src.Ndim());
+    if (s < 0 || s >= batch.X(4)) errorQuda("Right-hand side %d out of range for %d right-hand sides", s, batch.X(4));
+    if (field.Nspin() != 4) errorQuda("Unsupported nSpin = %d", field.Nspin());
+    if (field.SiteSubset() != batch.SiteSubset()) errorQuda("Mismatched site subsets");
+    if (field.VolumeCB() != batch.getDslashConstant().volume_4d_cb)
+      errorQuda("Mismatched 4-d volumes %d %d", field.VolumeCB(), batch.getDslashConstant().volume_4d_cb);
+    checkPrecision(dst, src);
+    checkLocation(dst, src);
+    checkOrder(dst, src);
+
+    instantiate<CopyMultiRHSField>(dst, src, s);
+  }
+
+  template <typename Float, int nColor> class MultiRHSNorm2Field : Tunable
+  {
+    const ColorSpinorField &in;
+    std::vector<double> &norm;
+    const int n_rhs;
+    const int threads;
+
+    unsigned int sharedBytesPerThread() const { return 0; }
+    unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
+    bool tuneGridDim() const { return false; } // one thread per 4-d site of a right-hand side
+    unsigned int minThreads() const { return threads; }
+    unsigned int maxBlockSize(const TuneParam &param) const { return deviceProp.maxThreadsPerBlock / 2; }
+
+  public:
+    MultiRHSNorm2Field(const ColorSpinorField &in, std::vector<double> &norm) :
+      in(in),
+      norm(norm),
+      n_rhs(in.X(4)),
+      threads(in.getDslashConstant().volume_4d_cb * in.SiteSubset())
+    {
+      strcpy(aux, in.AuxString());
+      apply(0);
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      if (in.Location() == QUDA_CPU_FIELD_LOCATION) {
+        MultiRHSNorm2Arg<Float, nColor, false> arg(in, nullptr);
+        launchHostReduceArray(norm, MultiRHSNorm2<decltype(arg)>(arg), arg.volume_4d_cb, arg.nParity, n_rhs);
+      } else {
+        auto result = static_cast<double *>(pool_device_malloc(n_rhs * sizeof(double)));
+        MultiRHSNorm2Arg<Float, nColor> arg(in, result);
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+        // the result is accumulated with atomics, so is reset on every launch, including when tuning
+        qudaMemsetAsync(result, 0, n_rhs * sizeof(double), stream);
+        LAUNCH_KERNEL_LOCAL_PARITY(multiRHSNorm2Kernel, (*this), tp, stream, arg, decltype(arg));
+        qudaMemcpy(norm.data(), result, n_rhs * sizeof(double), cudaMemcpyDeviceToHost);
+        pool_device_free(result);
+      }
+    }
+
+    void initTuneParam(TuneParam &param) const
+    {
+      Tunable::initTuneParam(param);
+      param.grid.y = n_rhs;
+    }
+
+    void defaultTuneParam(TuneParam &param) const
+    {
+      Tunable::defaultTuneParam(param);
+      param.grid.y = n_rhs;
+    }
+
+    bool advanceTuneParam(TuneParam &param) const
+    {
+      bool rtn = Tunable::advanceTuneParam(param);
+      param.grid.y = n_rhs;
+      return rtn;
+    }
+
+    TuneKey tuneKey() const { return TuneKey(in.VolString(), typeid(*this).name(), aux); }
+
+    long long flops() const { return 2ll * in.Ncolor() * in.Nspin() * in.Volume(); }
+    long long bytes() const { return in.Bytes() + in.NormBytes(); }
+  };
+
+  void multiRHSNorm2(std::vector<double> &norm, const ColorSpinorField &in)
+  {
+    if (in.Ndim() != 5 || in.PCType() != QUDA_4D_PC)
+      errorQuda("Field is not a multi-RHS field (nDim = %d, pc_type = %d)", in.Ndim(), in.PCType());
+    if (in.Nspin() != 4) errorQuda("Unsupported nSpin = %d", in.Nspin());
+
+    norm.resize(in.X(4));
+    instantiate<MultiRHSNorm2Field>(in, norm);
+    comm_allreduce_array(norm.data(), norm.size());
+  }
+
+} // namespace quda
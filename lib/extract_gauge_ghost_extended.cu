@@ -371,8 +371,26 @@ namespace quda {
       } else if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
 
 #ifdef BUILD_QDP_INTERFACE
-        extractGhostEx<Float,length>(QDPOrder<Float,length>(u, 0, Ghost),
-                                     dim, u.SurfaceCB(), u.X(), R, extract, u, location);
+        if (u.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+          typedef QDPOrder<Float, length> G;
+          extractGhostEx<Float, length>(G(u, 0, Ghost), dim, u.SurfaceCB(), u.X(), R, extract, u, location);
+        } else if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+#if QUDA_RECONSTRUCT & 2
+          typedef QDPOrder<Float, length, 12> G;
+          extractGhostEx<Float, length>(G(u, 0, Ghost), dim, u.SurfaceCB(), u.X(), R, extract, u, location);
+#else
+          errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-12", QUDA_RECONSTRUCT);
+#endif
+        } else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+#if QUDA_RECONSTRUCT & 1
+          typedef QDPOrder<Float, length, 8> G;
+          extractGhostEx<Float, length>(G(u, 0, Ghost), dim, u.SurfaceCB(), u.X(), R, extract, u, location);
+#else
+          errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-8", QUDA_RECONSTRUCT);
+#endif
+        } else {
+          errorQuda("Reconstruction %d and order %d not supported", u.Reconstruct(), u.Order());
+        }
 #else
         errorQuda("QDP interface has not been built\n");
 #endif
@@ -398,8 +416,26 @@ namespace quda {
       } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
 
 #ifdef BUILD_MILC_INTERFACE
-        extractGhostEx<Float,length>(MILCOrder<Float,length>(u, 0, Ghost),
-                                     dim, u.SurfaceCB(), u.X(), R, extract, u, location);
+        if (u.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+          typedef MILCOrder<Float, length> G;
+          extractGhostEx<Float, length>(G(u, 0, Ghost), dim, u.SurfaceCB(), u.X(), R, extract, u, location);
+        } else if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+#if QUDA_RECONSTRUCT & 2
+          typedef MILCOrder<Float, length, 12> G;
+          extractGhostEx<Float, length>(G(u, 0, Ghost), dim, u.SurfaceCB(), u.X(), R, extract, u, location);
+#else
+          errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-12", QUDA_RECONSTRUCT);
+#endif
+        } else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+#if QUDA_RECONSTRUCT & 1
+          typedef MILCOrder<Float, length, 8> G;
+          extractGhostEx<Float, length>(G(u, 0, Ghost), dim, u.SurfaceCB(), u.X(), R, extract, u, location);
+#else
+          errorQuda("QUDA_RECONSTRUCT=%d does not enable reconstruct-8", QUDA_RECONSTRUCT);
+#endif
+        } else {
+          errorQuda("Reconstruction %d and order %d not supported", u.Reconstruct(), u.Order());
+        }
 #else
         errorQuda("MILC interface has not been built\n");
 #endif
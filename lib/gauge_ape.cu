@@ -4,6 +4,7 @@
 
 #include <jitify_helper.cuh>
 #include <kernels/gauge_ape.cuh>
+#include <launch_host.h>
 #include <instantiate.h>
 
 namespace quda {
@@ -12,7 +13,9 @@ namespace quda {
   {
     static constexpr int apeDim = 3; // apply APE in space only
     GaugeAPEArg<Float,nColor,recon, apeDim> arg;
+    GaugeField &out;
     const GaugeField &meta;
+    const double alpha;
 
     bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
     unsigned int minThreads() const { return arg.threads; }
@@ -22,7 +25,9 @@ public:
     GaugeAPE(GaugeField &out, const GaugeField &in, double alpha) :
       TunableVectorYZ(2, apeDim),
       arg(out, in, alpha),
-      meta(in)
+      out(out),
+      meta(in),
+      alpha(alpha)
     {
       strcpy(aux, meta.AuxString());
       strcat(aux, comm_dim_partitioned_string());
@@ -35,14 +40,19 @@ public:
 
     void apply(const qudaStream_t &stream)
     {
-      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 #ifdef JITIFY
-      using namespace jitify::reflection;
-      jitify_error = program->kernel("quda::computeAPEStep").instantiate(Type<decltype(arg)>())
-        .configure(tp.grid, tp.block, tp.shared_bytes, stream).launch(arg);
+        using namespace jitify::reflection;
+        jitify_error = program->kernel("quda::computeAPEStep").instantiate(Type<decltype(arg)>())
+          .configure(tp.grid, tp.block, tp.shared_bytes, stream).launch(arg);
 #else
-      qudaLaunchKernel(computeAPEStep<decltype(arg)>, tp, stream, arg);
+        qudaLaunchKernel(computeAPEStep<decltype(arg)>, tp, stream, arg);
 #endif
+      } else {
+        GaugeAPEArg<Float, nColor, recon, apeDim, QUDA_QDP_GAUGE_ORDER> arg(out, meta, alpha);
+        launchHost(APE<decltype(arg)>(arg), arg.threads, 2, apeDim);
+      }
     }
 
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
@@ -58,11 +68,11 @@ public:
 #ifdef GPU_GAUGE_TOOLS
     checkPrecision(out, in);
     checkReconstruct(out, in);
+    auto location = checkLocation(out, in);
+    checkKernelOrder(out);
+    checkKernelOrder(in);
 
-    if (!out.isNative()) errorQuda("Order %d with %d reconstruct not supported", in.Order(), in.Reconstruct());
-    if (!in.isNative()) errorQuda("Order %d with %d reconstruct not supported", out.Order(), out.Reconstruct());
-    
-    copyExtendedGauge(in, out, QUDA_CUDA_FIELD_LOCATION);
+    copyExtendedGauge(in, out, location);
     in.exchangeExtendedGhost(in.R(), false);
     instantiate<GaugeAPE>(out, in, alpha);
     out.exchangeExtendedGhost(out.R(), false);
@@ -0,0 +1,886 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <ctime>
+#include <complex>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <gauge_tools.h>
+#include <comm_quda.h>
+#include <timer.h>
+
+/**
+   Native parallel reader and writer for binary gauge configurations
+   in the NERSC, ILDG (SciDAC/LIME) and MILC formats.  All three
+   formats store the links site-major in lexicographic order (x
+   fastest), four row-major SU(3) matrices per site, so they share a
+   single decode/encode kernel that differs only in word size, byte
+   order, the number of stored rows and the checksum applied.
+
+   Each rank memory-maps the file and touches only the rows of its
+   own sub-volume.  Byte swapping, precision conversion, row
+   reconstruction and the format checksums are done in one threaded
+   pass that writes directly into (or reads directly from) a MILC
+   ordered host field; any other field order, precision or location
+   is reached through the regular GaugeField::copy.
+*/
+
+namespace quda
+{
+
+  namespace
+  {
+
+    enum class GaugeFileFormat { NERSC, ILDG, MILC };
+
+    const char *formatName(GaugeFileFormat format)
+    {
+      switch (format) {
+      case GaugeFileFormat::NERSC: return "NERSC";
+      case GaugeFileFormat::ILDG: return "ILDG";
+      case GaugeFileFormat::MILC: return "MILC";
+      }
+      return "unknown";
+    }
+
+    constexpr uint32_t lime_magic = 0x456789ab;
+    constexpr size_t lime_header_bytes = 144;
+    constexpr int32_t milc_magic = 20103;
+    constexpr size_t milc_header_bytes = 96; // magic, dims[4], time_stamp[64], order, sum29, sum31
+
+    /** Description of the link payload shared by all formats */
+    struct GaugeFileLayout {
+      GaugeFileFormat format;
+      size_t offset = 0;       // byte offset of the link data
+      int X[4] = {0, 0, 0, 0}; // global lattice dimensions
+      int word = 0;            // bytes per real number
+      int rows = 3;            // rows stored per link
+      bool big_endian = true;  // byte order of the payload
+
+      // checksums recorded in the file
+      bool has_nersc = false;
+      uint32_t nersc = 0;
+      bool has_trace = false;
+      double trace = 0.0;
+      bool has_plaquette = false;
+      double plaquette = 0.0;
+      bool has_scidac = false;
+      uint32_t suma = 0, sumb = 0;
+      bool has_milc = false;
+      uint32_t sum29 = 0, sum31 = 0;
+
+      size_t siteBytes() const { return 4 * rows * 3 * 2 * word; }
+      size_t volume() const { return (size_t)X[0] * X[1] * X[2] * X[3]; }
+      size_t dataBytes() const { return volume() * siteBytes(); }
+    };
+
+    /** Checksums accumulated over the payload */
+    struct GaugeChecksum {
+      uint32_t nersc = 0;   // sum of the stored 32-bit words
+      uint32_t nersc33 = 0; // sum of the 32-bit words of the full 3x3 matrices
+      uint32_t suma = 0, sumb = 0;
+      uint32_t sum29 = 0, sum31 = 0;
+      double trace = 0.0;
+      uint64_t field = 0; // rank-local Checksum() of the decoded field, for the checksum stream
+
+      GaugeChecksum &operator+=(const GaugeChecksum &a)
+      {
+        nersc += a.nersc;
+        nersc33 += a.nersc33;
+        suma ^= a.suma;
+        sumb ^= a.sumb;
+        sum29 ^= a.sum29;
+        sum31 ^= a.sum31;
+        trace += a.trace;
+        field ^= a.field;
+        return *this;
+      }
+
+      /**
+         @brief Reduce the partial checksums over all ranks
+       */
+      void reduce()
+      {
+        double n[2] = {static_cast<double>(nersc), static_cast<double>(nersc33)};
+        comm_allreduce_array(n, 2);
+        nersc = static_cast<uint32_t>(static_cast<uint64_t>(n[0]) & 0xffffffff);
+        nersc33 = static_cast<uint32_t>(static_cast<uint64_t>(n[1]) & 0xffffffff);
+
+        uint64_t scidac = (static_cast<uint64_t>(suma) << 32) | sumb;
+        uint64_t milc = (static_cast<uint64_t>(sum29) << 32) | sum31;
+        comm_allreduce_xor(&scidac);
+        comm_allreduce_xor(&milc);
+        suma = scidac >> 32;
+        sumb = scidac & 0xffffffff;
+        sum29 = milc >> 32;
+        sum31 = milc & 0xffffffff;
+
+        comm_allreduce(&trace);
+      }
+    };
+
+    bool hostBigEndian()
+    {
+      const uint32_t one = 1;
+      unsigned char c;
+      memcpy(&c, &one, 1);
+      return c == 0;
+    }
+
+    inline uint32_t rotl(uint32_t x, int r) { return r == 0 ? x : (x << r) | (x >> (32 - r)); }
+
+    /** Standard (zlib) CRC-32, as used by the SciDAC checksum */
+    uint32_t crc32(const unsigned char *buf, size_t len)
+    {
+      static const std::vector<uint32_t> table = [] {
+        std::vector<uint32_t> t(256);
+        for (uint32_t n = 0; n < 256; n++) {
+          uint32_t c = n;
+          for (int k = 0; k < 8; k++) c = c & 1 ? 0xedb88320 ^ (c >> 1) : c >> 1;
+          t[n] = c;
+        }
+        return t;
+      }();
+
+      uint32_t c = 0xffffffff;
+      for (size_t i = 0; i < len; i++) c = table[(c ^ buf[i]) & 0xff] ^ (c >> 8);
+      return c ^ 0xffffffff;
+    }
+
+    inline double loadReal(const unsigned char *p, int word, bool swap)
+    {
+      if (word == 4) {
+        uint32_t u;
+        memcpy(&u, p, 4);
+        if (swap) u = __builtin_bswap32(u);
+        float f;
+        memcpy(&f, &u, 4);
+        return f;
+      } else {
+        uint64_t u;
+        memcpy(&u, p, 8);
+        if (swap) u = __builtin_bswap64(u);
+        double d;
+        memcpy(&d, &u, 8);
+        return d;
+      }
+    }
+
+    inline void storeReal(unsigned char *p, double v, int word, bool swap)
+    {
+      if (word == 4) {
+        float f = static_cast<float>(v);
+        uint32_t u;
+        memcpy(&u, &f, 4);
+        if (swap) u = __builtin_bswap32(u);
+        memcpy(p, &u, 4);
+      } else {
+        uint64_t u;
+        memcpy(&u, &v, 8);
+        if (swap) u = __builtin_bswap64(u);
+        memcpy(p, &u, 8);
+      }
+    }
+
+    /** Sum of the 32-bit words of a real number in the file precision */
+    inline uint32_t wordSum(double v, int word)
+    {
+      if (word == 4) {
+        float f = static_cast<float>(v);
+        uint32_t u;
+        memcpy(&u, &f, 4);
+        return u;
+      } else {
+        uint32_t u[2];
+        memcpy(u, &v, 8);
+        return u[0] + u[1];
+      }
+    }
+
+    /** Third row of an SU(3) matrix from the first two: conj(row0 x row1) */
+    inline void reconstructRow(double *U)
+    {
+      using complex = std::complex<double>;
+      auto e = [&](int r, int c) { return complex(U[(r * 3 + c) * 2], U[(r * 3 + c) * 2 + 1]); };
+      for (int c = 0; c < 3; c++) {
+        int c1 = (c + 1) % 3, c2 = (c + 2) % 3;
+        complex v = std::conj(e(0, c1) * e(1, c2) - e(0, c2) * e(1, c1));
+        U[(2 * 3 + c) * 2] = v.real();
+        U[(2 * 3 + c) * 2 + 1] = v.imag();
+      }
+    }
+
+    /**
+       @brief Apply the format checksums to one site of 4 x 18 reals
+       @param[in,out] sum The checksum we are accumulating
+       @param[in] U The site's links in the file precision
+       @param[in] raw The site as stored in the file
+       @param[in] layout The file layout
+       @param[in] glex Global lexicographic site index
+     */
+    inline void checksumSite(GaugeChecksum &sum, const double *U, const unsigned char *raw,
+                             const GaugeFileLayout &layout, size_t glex)
+    {
+      const int n = layout.rows * 6;
+      for (int mu = 0; mu < 4; mu++) {
+        for (int i = 0; i < 18; i++) {
+          uint32_t w = wordSum(U[mu * 18 + i], layout.word);
+          sum.nersc33 += w;
+          if (i < n) sum.nersc += w;
+        }
+        sum.trace += U[mu * 18 + 0] + U[mu * 18 + 8] + U[mu * 18 + 16];
+      }
+
+      if (layout.format == GaugeFileFormat::ILDG) {
+        uint32_t crc = crc32(raw, layout.siteBytes());
+        sum.suma ^= rotl(crc, glex % 29);
+        sum.sumb ^= rotl(crc, glex % 31);
+      } else if (layout.format == GaugeFileFormat::MILC) {
+        // MILC wraps the rotation at 32 rather than at the prime
+        int r29 = (72 * glex) % 29;
+        int r31 = (72 * glex) % 31;
+        for (int i = 0; i < 72; i++) {
+          uint32_t w = wordSum(U[i], 4);
+          sum.sum29 ^= rotl(w, r29);
+          sum.sum31 ^= rotl(w, r31);
+          if (++r29 >= 32) r29 = 0;
+          if (++r31 >= 32) r31 = 0;
+        }
+      }
+    }
+
+    /**
+       @brief Decode the local sub-volume from a mapped file into a
+       MILC-ordered host buffer
+       @param[out] gauge MILC-ordered destination
+       @param[in] data Pointer to the start of the link payload
+       @param[in] layout The file layout
+       @param[in] X Local lattice dimensions
+       @return The local checksums
+     */
+    template <typename Float>
+    GaugeChecksum decode(Float *gauge, const unsigned char *data, const GaugeFileLayout &layout, const int *X)
+    {
+      const bool swap = layout.big_endian != hostBigEndian();
+      const size_t site_bytes = layout.siteBytes();
+      const size_t volumeCB = (size_t)X[0] * X[1] * X[2] * X[3] / 2;
+      const int *G = layout.X;
+      int o[4];
+      for (int d = 0; d < 4; d++) o[d] = comm_coord(d) * X[d];
+      const int n_rows = X[1] * X[2] * X[3];
+      const bool stream = checksumStreamActive(false);
+
+      GaugeChecksum sum;
+#pragma omp parallel
+      {
+        GaugeChecksum local;
+        double U[72];
+
+#pragma omp for schedule(static)
+        for (int row = 0; row < n_rows; row++) {
+          const int y = row % X[1];
+          const int z = (row / X[1]) % X[2];
+          const int t = row / (X[1] * X[2]);
+          const size_t grow = ((size_t)(t + o[3]) * G[2] + (z + o[2])) * G[1] + (y + o[1]);
+
+          for (int x = 0; x < X[0]; x++) {
+            const size_t glex = grow * G[0] + (x + o[0]);
+            const unsigned char *raw = data + glex * site_bytes;
+
+            const unsigned char *p = raw;
+            for (int mu = 0; mu < 4; mu++) {
+              for (int i = 0; i < layout.rows * 6; i++, p += layout.word) U[mu * 18 + i] = loadReal(p, layout.word, swap);
+              if (layout.rows == 2) reconstructRow(U + mu * 18);
+            }
+
+            checksumSite(local, U, raw, layout, glex);
+
+            const size_t lex = ((size_t)row) * X[0] + x;
+            const int parity = (x + y + z + t) & 1;
+            Float *dst = gauge + (parity * volumeCB + lex / 2) * 72;
+            for (int i = 0; i < 72; i++) dst[i] = static_cast<Float>(U[i]);
+
+            // the XOR of the site's 64-bit words is the XOR of its link checksums
+            if (stream) {
+              uint64_t w[72 * sizeof(Float) / sizeof(uint64_t)];
+              memcpy(w, dst, sizeof(w));
+              for (auto wi : w) local.field ^= wi;
+            }
+          }
+        }
+
+#pragma omp critical
+        sum += local;
+      }
+
+      return sum;
+    }
+
+    /**
+       @brief Encode the local sub-volume of a MILC-ordered host
+       buffer and write it to the file, one x-row at a time
+       @param[in] fd File descriptor open for writing
+       @param[in] gauge MILC-ordered source
+       @param[in] layout The file layout
+       @param[in] X Local lattice dimensions
+       @return The local checksums
+     */
+    template <typename Float>
+    GaugeChecksum encode(int fd, const Float *gauge, const GaugeFileLayout &layout, const int *X)
+    {
+      const bool swap = layout.big_endian != hostBigEndian();
+      const size_t site_bytes = layout.siteBytes();
+      const size_t volumeCB = (size_t)X[0] * X[1] * X[2] * X[3] / 2;
+      const int *G = layout.X;
+      int o[4];
+      for (int d = 0; d < 4; d++) o[d] = comm_coord(d) * X[d];
+      const int n_rows = X[1] * X[2] * X[3];
+
+      GaugeChecksum sum;
+      bool failed = false;
+#pragma omp parallel reduction(|| : failed)
+      {
+        GaugeChecksum local;
+        double U[72];
+        std::vector<unsigned char> buffer(X[0] * site_bytes);
+
+#pragma omp for schedule(static)
+        for (int row = 0; row < n_rows; row++) {
+          const int y = row % X[1];
+          const int z = (row / X[1]) % X[2];
+          const int t = row / (X[1] * X[2]);
+          const size_t grow = ((size_t)(t + o[3]) * G[2] + (z + o[2])) * G[1] + (y + o[1]);
+
+          for (int x = 0; x < X[0]; x++) {
+            const size_t lex = ((size_t)row) * X[0] + x;
+            const int parity = (x + y + z + t) & 1;
+            const Float *src = gauge + (parity * volumeCB + lex / 2) * 72;
+            for (int i = 0; i < 72; i++) U[i] = src[i];
+
+            unsigned char *raw = buffer.data() + x * site_bytes;
+            for (int i = 0; i < 72; i++) storeReal(raw + i * layout.word, U[i], layout.word, swap);
+
+            // checksum the values as stored
+            if (layout.word == 4)
+              for (int i = 0; i < 72; i++) U[i] = static_cast<float>(U[i]);
+            checksumSite(local, U, raw, layout, grow * G[0] + (x + o[0]));
+          }
+
+          const off_t offset = layout.offset + (grow * G[0] + o[0]) * site_bytes;
+          if (pwrite(fd, buffer.data(), buffer.size(), offset) != static_cast<ssize_t>(buffer.size())) failed = true;
+        }
+
+#pragma omp critical
+        sum += local;
+      }
+
+      if (failed) errorQuda("Failed to write gauge field data");
+      return sum;
+    }
+
+    std::string xmlValue(const std::string &xml, const std::string &tag)
+    {
+      auto begin = xml.find("<" + tag + ">");
+      if (begin == std::string::npos) return "";
+      begin += tag.size() + 2;
+      auto end = xml.find("</" + tag + ">", begin);
+      if (end == std::string::npos) return "";
+      return xml.substr(begin, end - begin);
+    }
+
+    uint64_t readBE(const unsigned char *p, int bytes)
+    {
+      uint64_t v = 0;
+      for (int i = 0; i < bytes; i++) v = (v << 8) | p[i];
+      return v;
+    }
+
+    void writeBE(unsigned char *p, uint64_t v, int bytes)
+    {
+      for (int i = bytes - 1; i >= 0; i--, v >>= 8) p[i] = v & 0xff;
+    }
+
+    void parseNERSC(GaugeFileLayout &layout, const unsigned char *map, size_t size)
+    {
+      const std::string end_tag = "END_HEADER";
+      std::string header(reinterpret_cast<const char *>(map), std::min<size_t>(size, 65536));
+      auto end = header.find(end_tag);
+      if (end == std::string::npos) errorQuda("Cannot find end of NERSC header");
+      end = header.find('\n', end);
+      if (end == std::string::npos) errorQuda("Truncated NERSC header");
+      layout.offset = end + 1;
+      header.resize(end);
+
+      std::string datatype, fp;
+      size_t pos = 0;
+      while (pos < header.size()) {
+        auto eol = header.find('\n', pos);
+        std::string line = header.substr(pos, eol == std::string::npos ? std::string::npos : eol - pos);
+        pos = eol == std::string::npos ? header.size() : eol + 1;
+
+        auto eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        auto trim = [](std::string s) {
+          s.erase(0, s.find_first_not_of(" \t\r"));
+          s.erase(s.find_last_not_of(" \t\r") + 1);
+          return s;
+        };
+        std::string key = trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+
+        if (key == "DATATYPE") datatype = value;
+        else if (key == "FLOATING_POINT")
+          fp = value;
+        else if (key.compare(0, 10, "DIMENSION_") == 0 && key.size() == 11 && key[10] >= '1' && key[10] <= '4')
+          layout.X[key[10] - '1'] = std::stoi(value);
+        else if (key == "CHECKSUM") {
+          layout.nersc = std::stoul(value, nullptr, 16);
+          layout.has_nersc = true;
+        } else if (key == "LINK_TRACE") {
+          layout.trace = std::stod(value);
+          layout.has_trace = true;
+        } else if (key == "PLAQUETTE") {
+          layout.plaquette = std::stod(value);
+          layout.has_plaquette = true;
+        }
+      }
+
+      if (datatype == "4D_SU3_GAUGE_3x3") layout.rows = 3;
+      else if (datatype == "4D_SU3_GAUGE")
+        layout.rows = 2;
+      else
+        errorQuda("Unsupported NERSC datatype %s", datatype.c_str());
+
+      if (fp == "IEEE32" || fp == "IEEE32BIG") {
+        layout.word = 4;
+        layout.big_endian = true;
+      } else if (fp == "IEEE32LITTLE") {
+        layout.word = 4;
+        layout.big_endian = false;
+      } else if (fp == "IEEE64" || fp == "IEEE64BIG") {
+        layout.word = 8;
+        layout.big_endian = true;
+      } else if (fp == "IEEE64LITTLE") {
+        layout.word = 8;
+        layout.big_endian = false;
+      } else {
+        errorQuda("Unsupported NERSC floating point format %s", fp.c_str());
+      }
+    }
+
+    void parseILDG(GaugeFileLayout &layout, const unsigned char *map, size_t size)
+    {
+      size_t binary_bytes = 0;
+      int precision = 0;
+
+      for (size_t pos = 0; pos + lime_header_bytes <= size;) {
+        const unsigned char *h = map + pos;
+        if (readBE(h, 4) != lime_magic) errorQuda("Invalid LIME record header at offset %lu", pos);
+        const size_t bytes = readBE(h + 8, 8);
+        std::string type(reinterpret_cast<const char *>(h + 16), strnlen(reinterpret_cast<const char *>(h + 16), 128));
+        const size_t payload = pos + lime_header_bytes;
+        if (payload + bytes > size) errorQuda("Truncated LIME record %s", type.c_str());
+
+        if (type == "ildg-binary-data") {
+          layout.offset = payload;
+          binary_bytes = bytes;
+        } else if (type == "ildg-format") {
+          std::string xml(reinterpret_cast<const char *>(map + payload), bytes);
+          const char *dims[] = {"lx", "ly", "lz", "lt"};
+          for (int d = 0; d < 4; d++) {
+            auto v = xmlValue(xml, dims[d]);
+            if (!v.empty()) layout.X[d] = std::stoi(v);
+          }
+          auto p = xmlValue(xml, "precision");
+          if (!p.empty()) precision = std::stoi(p);
+        } else if (type == "scidac-checksum") {
+          std::string xml(reinterpret_cast<const char *>(map + payload), bytes);
+          auto a = xmlValue(xml, "suma"), b = xmlValue(xml, "sumb");
+          if (!a.empty() && !b.empty()) {
+            layout.suma = std::stoul(a, nullptr, 16);
+            layout.sumb = std::stoul(b, nullptr, 16);
+            layout.has_scidac = true;
+          }
+        }
+
+        pos = payload + ((bytes + 7) / 8) * 8;
+      }
+
+      if (!binary_bytes) errorQuda("No ildg-binary-data record found");
+      layout.rows = 3;
+      layout.big_endian = true;
+      if (precision == 32 || precision == 64) {
+        layout.word = precision / 8;
+      } else if (layout.volume() > 0) { // infer the precision from the record length
+        layout.word = binary_bytes / (layout.volume() * 4 * 18);
+      }
+      if (layout.word != 4 && layout.word != 8) errorQuda("Cannot determine ILDG precision");
+      if (binary_bytes != layout.dataBytes())
+        errorQuda("ILDG binary record length %lu does not match lattice volume", binary_bytes);
+    }
+
+    void parseMILC(GaugeFileLayout &layout, const unsigned char *map, size_t size)
+    {
+      if (size < milc_header_bytes) errorQuda("Truncated MILC header");
+      int32_t magic;
+      memcpy(&magic, map, 4);
+      const bool swap = magic != milc_magic;
+      if (swap && static_cast<int32_t>(__builtin_bswap32(magic)) != milc_magic) errorQuda("Invalid MILC magic number");
+
+      auto word = [&](size_t offset) {
+        uint32_t u;
+        memcpy(&u, map + offset, 4);
+        return swap ? __builtin_bswap32(u) : u;
+      };
+
+      for (int d = 0; d < 4; d++) layout.X[d] = word(4 + 4 * d);
+      if (word(84) != 0) errorQuda("Only natural site order MILC files are supported");
+      layout.sum29 = word(88);
+      layout.sum31 = word(92);
+      layout.has_milc = true;
+      layout.offset = milc_header_bytes;
+      layout.word = 4;
+      layout.rows = 3;
+      layout.big_endian = hostBigEndian() != swap;
+    }
+
+    GaugeFileLayout parseLayout(const unsigned char *map, size_t size)
+    {
+      GaugeFileLayout layout;
+      int32_t magic = 0;
+      if (size >= 4) memcpy(&magic, map, 4);
+
+      if (size >= 12 && strncmp(reinterpret_cast<const char *>(map), "BEGIN_HEADER", 12) == 0) {
+        layout.format = GaugeFileFormat::NERSC;
+        parseNERSC(layout, map, size);
+      } else if (size >= 4 && readBE(map, 4) == lime_magic) {
+        layout.format = GaugeFileFormat::ILDG;
+        parseILDG(layout, map, size);
+      } else if (magic == milc_magic || static_cast<int32_t>(__builtin_bswap32(magic)) == milc_magic) {
+        layout.format = GaugeFileFormat::MILC;
+        parseMILC(layout, map, size);
+      } else {
+        errorQuda("Unrecognized gauge file format");
+      }
+
+      if (layout.offset + layout.dataBytes() > size) errorQuda("Gauge file is truncated");
+      return layout;
+    }
+
+    std::string nerscHeader(const GaugeFileLayout &layout, double trace, double plaquette, uint32_t checksum)
+    {
+      char buf[2048];
+      snprintf(buf, sizeof(buf),
+               "BEGIN_HEADER\n"
+               "HDR_VERSION = 1.0\n"
+               "DATATYPE = 4D_SU3_GAUGE_3x3\n"
+               "STORAGE_FORMAT = 1.0\n"
+               "DIMENSION_1 = %d\nDIMENSION_2 = %d\nDIMENSION_3 = %d\nDIMENSION_4 = %d\n"
+               "LINK_TRACE = % .10e\n"
+               "PLAQUETTE = % .10e\n"
+               "BOUNDARY_1 = PERIODIC\nBOUNDARY_2 = PERIODIC\nBOUNDARY_3 = PERIODIC\nBOUNDARY_4 = PERIODIC\n"
+               "CHECKSUM = %08x\n"
+               "ENSEMBLE_ID = quda\n"
+               "ENSEMBLE_LABEL = quda\n"
+               "SEQUENCE_NUMBER = 0\n"
+               "CREATOR = QUDA\n"
+               "FLOATING_POINT = %s\n"
+               "END_HEADER\n",
+               layout.X[0], layout.X[1], layout.X[2], layout.X[3], trace, plaquette, checksum,
+               layout.word == 8 ? "IEEE64BIG" : "IEEE32BIG");
+      return buf;
+    }
+
+    std::string ildgFormat(const GaugeFileLayout &layout)
+    {
+      char buf[1024];
+      snprintf(buf, sizeof(buf),
+               "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+               "<ildgFormat xmlns=\"http://www.lqcd.org/ildg\" xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" "
+               "xsi:schemaLocation=\"http://www.lqcd.org/ildg http://www.lqcd.org/ildg/filefmt.xsd\">"
+               "<version>1.0</version><field>su3gauge</field><precision>%d</precision>"
+               "<lx>%d</lx><ly>%d</ly><lz>%d</lz><lt>%d</lt></ildgFormat>",
+               layout.word * 8, layout.X[0], layout.X[1], layout.X[2], layout.X[3]);
+      return buf;
+    }
+
+    std::string scidacChecksum(uint32_t suma, uint32_t sumb)
+    {
+      char buf[256];
+      snprintf(buf, sizeof(buf),
+               "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+               "<scidacChecksum><version>1.0</version><suma>%08x</suma><sumb>%08x</sumb></scidacChecksum>",
+               suma, sumb);
+      return buf;
+    }
+
+    /** Append a LIME record (header, payload and padding) to a byte buffer; a null payload appends only the header */
+    void limeRecord(std::vector<unsigned char> &out, const char *type, const void *data, size_t bytes, bool begin,
+                    bool end)
+    {
+      unsigned char h[lime_header_bytes] = {};
+      writeBE(h, lime_magic, 4);
+      writeBE(h + 4, 1, 2);
+      h[6] = (begin ? 0x80 : 0) | (end ? 0x40 : 0);
+      writeBE(h + 8, bytes, 8);
+      strncpy(reinterpret_cast<char *>(h + 16), type, 127);
+      out.insert(out.end(), h, h + lime_header_bytes);
+      if (!data) return; // the payload is written separately
+      auto d = static_cast<const unsigned char *>(data);
+      out.insert(out.end(), d, d + bytes);
+      out.resize(out.size() + ((bytes + 7) / 8) * 8 - bytes, 0);
+    }
+
+    /**
+       @brief Compute the plaquette of a host field on the device
+       @param[in] u Host gauge field
+       @return Average plaquette normalized to one
+    */
+    double computePlaquette(const GaugeField &u)
+    {
+      GaugeFieldParam param(u);
+      param.location = QUDA_CUDA_FIELD_LOCATION;
+      param.create = QUDA_NULL_FIELD_CREATE;
+      param.reconstruct = QUDA_RECONSTRUCT_NO;
+      param.setPrecision(u.Precision(), true);
+      cudaGaugeField device(param);
+      device.copy(u);
+
+      int R[4];
+      for (int d = 0; d < 4; d++) R[d] = 2 * comm_dim_partitioned(d);
+      TimeProfile profile("computePlaquette", false);
+      cudaGaugeField *extended = createExtendedGauge(device, R, profile);
+      double3 plaq = plaquette(*extended);
+      delete extended;
+      return plaq.x;
+    }
+
+    /**
+       @brief Return a MILC-ordered, no-reconstruct host view of a gauge field
+       @param[in] u The field we need a host view of
+       @return Either u itself, or a newly allocated copy that the caller must delete
+    */
+    GaugeField *hostView(GaugeField &u)
+    {
+      if (u.Location() == QUDA_CPU_FIELD_LOCATION && u.Order() == QUDA_MILC_GAUGE_ORDER
+          && u.Reconstruct() == QUDA_RECONSTRUCT_NO)
+        return &u;
+
+      GaugeFieldParam param(u);
+      param.location = QUDA_CPU_FIELD_LOCATION;
+      param.create = QUDA_NULL_FIELD_CREATE;
+      param.order = QUDA_MILC_GAUGE_ORDER;
+      param.reconstruct = QUDA_RECONSTRUCT_NO;
+      param.pad = 0;
+      param.setPrecision(u.Precision() == QUDA_DOUBLE_PRECISION ? QUDA_DOUBLE_PRECISION : QUDA_SINGLE_PRECISION);
+      return new cpuGaugeField(param);
+    }
+
+    /** A read-only memory mapping of a file */
+    struct MappedFile {
+      int fd = -1;
+      size_t size = 0;
+      unsigned char *map = nullptr;
+
+      MappedFile(const char *filename)
+      {
+        fd = open(filename, O_RDONLY);
+        if (fd < 0) errorQuda("Cannot open gauge file %s", filename);
+        struct stat st;
+        if (fstat(fd, &st) != 0) errorQuda("Cannot stat gauge file %s", filename);
+        size = st.st_size;
+        void *ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr == MAP_FAILED) errorQuda("Cannot map gauge file %s", filename);
+        map = static_cast<unsigned char *>(ptr);
+      }
+
+      ~MappedFile()
+      {
+        munmap(map, size);
+        close(fd);
+      }
+    };
+
+  } // namespace
+
+  void GaugeField::read(char *filename)
+  {
+    if (nColor != 3) errorQuda("Unsupported number of colors %d", nColor);
+    if (geometry != QUDA_VECTOR_GEOMETRY) errorQuda("Unsupported geometry %d", geometry);
+    if (ghostExchange == QUDA_GHOST_EXCHANGE_EXTENDED) errorQuda("Reading into extended fields is not supported");
+
+    TimeProfile profile("GaugeField::read", false);
+    profile.TPSTART(QUDA_PROFILE_IO);
+
+    GaugeFileLayout layout;
+    GaugeChecksum sum;
+    GaugeField *host = hostView(*this);
+    {
+      MappedFile file(filename);
+      layout = parseLayout(file.map, file.size);
+      for (int d = 0; d < 4; d++) {
+        if (layout.X[d] != x[d] * comm_dim(d))
+          errorQuda("File lattice dimension %d = %d does not match %d", d, layout.X[d], x[d] * comm_dim(d));
+      }
+
+      const unsigned char *data = file.map + layout.offset;
+      sum = host->Precision() == QUDA_DOUBLE_PRECISION ? decode(static_cast<double *>(host->Gauge_p()), data, layout, x) :
+                                                         decode(static_cast<float *>(host->Gauge_p()), data, layout, x);
+    }
+    comm_barrier();
+    profile.TPSTOP(QUDA_PROFILE_IO);
+
+    // the decode pass already summed the field; don't sum it again when copying out of the staging field
+    const bool stream = checksumStreamActive(false);
+    if (stream) checksumStreamAccumulate(sum.field);
+
+    sum.reduce();
+    sum.trace /= 4 * 3 * layout.volume();
+
+    if (layout.has_nersc && sum.nersc != layout.nersc && sum.nersc33 != layout.nersc)
+      errorQuda("NERSC checksum mismatch: computed %08x, expected %08x", sum.nersc, layout.nersc);
+    if (layout.has_trace && std::fabs(sum.trace - layout.trace) > 1e-5)
+      errorQuda("NERSC link trace mismatch: computed %.10e, expected %.10e", sum.trace, layout.trace);
+    if (layout.has_scidac && (sum.suma != layout.suma || sum.sumb != layout.sumb))
+      errorQuda("SciDAC checksum mismatch: computed %08x %08x, expected %08x %08x", sum.suma, sum.sumb, layout.suma,
+                layout.sumb);
+    if (layout.has_milc && (sum.sum29 != layout.sum29 || sum.sum31 != layout.sum31))
+      errorQuda("MILC checksum mismatch: computed %08x %08x, expected %08x %08x", sum.sum29, sum.sum31, layout.sum29,
+                layout.sum31);
+
+    if (host->GhostExchange() == QUDA_GHOST_EXCHANGE_PAD) host->exchangeGhost();
+
+    if (layout.has_plaquette) {
+      double plaq = computePlaquette(*host);
+      if (std::fabs(plaq - layout.plaquette) > 1e-5)
+        errorQuda("NERSC plaquette mismatch: computed %.10e, expected %.10e", plaq, layout.plaquette);
+    }
+
+    if (host != this) {
+      if (stream) checksumStreamSuspend(true);
+      copy(*host);
+      if (stream) checksumStreamSuspend(false);
+      delete host;
+    }
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      double secs = profile.Last(QUDA_PROFILE_IO);
+      printfQuda("Read %s gauge field from %s (%d-bit): %.3f GB in %.3f secs (%.3f GB/s), link trace = %.10e\n",
+                 formatName(layout.format), filename, layout.word * 8, layout.dataBytes() / 1e9, secs,
+                 layout.dataBytes() / (1e9 * secs), sum.trace);
+    }
+  }
+
+  void GaugeField::write(char *filename)
+  {
+    if (nColor != 3) errorQuda("Unsupported number of colors %d", nColor);
+    if (geometry != QUDA_VECTOR_GEOMETRY) errorQuda("Unsupported geometry %d", geometry);
+    if (ghostExchange == QUDA_GHOST_EXCHANGE_EXTENDED) errorQuda("Writing extended fields is not supported");
+
+    // the format is chosen from the file extension, defaulting to NERSC
+    std::string name(filename);
+    auto ends_with = [&](const std::string &ext) {
+      return name.size() >= ext.size() && name.compare(name.size() - ext.size(), ext.size(), ext) == 0;
+    };
+
+    GaugeFileLayout layout;
+    layout.format = (ends_with(".lime") || ends_with(".ildg")) ? GaugeFileFormat::ILDG :
+      ends_with(".milc")                                       ? GaugeFileFormat::MILC :
+                                                                 GaugeFileFormat::NERSC;
+    for (int d = 0; d < 4; d++) layout.X[d] = x[d] * comm_dim(d);
+    layout.rows = 3;
+    layout.word = (layout.format != GaugeFileFormat::MILC && precision == QUDA_DOUBLE_PRECISION) ? 8 : 4;
+    layout.big_endian = layout.format == GaugeFileFormat::MILC ? hostBigEndian() : true;
+
+    // everything preceding the payload has a fixed size, so we can lay out the file before writing it
+    std::vector<unsigned char> head, tail;
+    switch (layout.format) {
+    case GaugeFileFormat::NERSC: layout.offset = nerscHeader(layout, 0.0, 0.0, 0).size(); break;
+    case GaugeFileFormat::ILDG: {
+      auto format = ildgFormat(layout);
+      limeRecord(head, "ildg-format", format.data(), format.size(), true, false);
+      limeRecord(head, "ildg-binary-data", nullptr, layout.dataBytes(), false, false);
+      layout.offset = head.size();
+      break;
+    }
+    case GaugeFileFormat::MILC: layout.offset = milc_header_bytes; break;
+    }
+
+    GaugeField *host = hostView(*this);
+    if (host != this) host->copy(*this);
+
+    TimeProfile profile("GaugeField::write", false);
+    profile.TPSTART(QUDA_PROFILE_IO);
+
+    const size_t padded = ((layout.dataBytes() + 7) / 8) * 8;
+    if (comm_rank() == 0) {
+      int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd < 0 || ftruncate(fd, layout.offset + padded) != 0) errorQuda("Cannot create gauge file %s", filename);
+      close(fd);
+    }
+    comm_barrier();
+
+    int fd = open(filename, O_WRONLY);
+    if (fd < 0) errorQuda("Cannot open gauge file %s", filename);
+    GaugeChecksum sum = host->Precision() == QUDA_DOUBLE_PRECISION ?
+      encode(fd, static_cast<const double *>(host->Gauge_p()), layout, x) :
+      encode(fd, static_cast<const float *>(host->Gauge_p()), layout, x);
+
+    sum.reduce();
+    sum.trace /= 4 * 3 * layout.volume();
+    double plaq = layout.format == GaugeFileFormat::NERSC ? computePlaquette(*host) : 0.0;
+
+    if (comm_rank() == 0) {
+      switch (layout.format) {
+      case GaugeFileFormat::NERSC: {
+        auto header = nerscHeader(layout, sum.trace, plaq, sum.nersc);
+        if (header.size() != layout.offset) errorQuda("Unexpected NERSC header size %lu", header.size());
+        head.assign(header.begin(), header.end());
+        break;
+      }
+      case GaugeFileFormat::ILDG: {
+        auto checksum = scidacChecksum(sum.suma, sum.sumb);
+        limeRecord(tail, "scidac-checksum", checksum.data(), checksum.size(), false, true);
+        break;
+      }
+      case GaugeFileFormat::MILC: {
+        head.resize(milc_header_bytes, 0);
+        int32_t header[5] = {milc_magic, layout.X[0], layout.X[1], layout.X[2], layout.X[3]};
+        memcpy(head.data(), header, sizeof(header));
+        time_t now = time(nullptr);
+        strftime(reinterpret_cast<char *>(head.data() + 20), 64, "%a %b %d %H:%M:%S %Y", localtime(&now));
+        uint32_t trailer[3] = {0, sum.sum29, sum.sum31}; // order, sum29, sum31
+        memcpy(head.data() + 84, trailer, sizeof(trailer));
+        break;
+      }
+      }
+
+      bool ok = pwrite(fd, head.data(), head.size(), 0) == static_cast<ssize_t>(head.size());
+      if (tail.size()) ok = ok && pwrite(fd, tail.data(), tail.size(), layout.offset + padded) == static_cast<ssize_t>(tail.size());
+      if (!ok) errorQuda("Failed to write gauge file header to %s", filename);
+    }
+    close(fd);
+    comm_barrier();
+    profile.TPSTOP(QUDA_PROFILE_IO);
+
+    if (host != this) delete host;
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      double secs = profile.Last(QUDA_PROFILE_IO);
+      printfQuda("Wrote %s gauge field to %s (%d-bit): %.3f GB in %.3f secs (%.3f GB/s), link trace = %.10e\n",
+                 formatName(layout.format), filename, layout.word * 8, layout.dataBytes() / 1e9, secs,
+                 layout.dataBytes() / (1e9 * secs), sum.trace);
+    }
+  }
+
+} // namespace quda
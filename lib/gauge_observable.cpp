@@ -17,61 +17,45 @@ namespace quda
       pool_pinned_free(num_failures_h);
     }
 
-    if (param.compute_plaquette) {
-      double3 plaq = plaquette(u);
-      param.plaquette[0] = plaq.x;
-      param.plaquette[1] = plaq.y;
-      param.plaquette[2] = plaq.z;
+    // the plaquette alone does not need the clover-leaf field strength
+    if (!param.compute_qcharge && !param.compute_qcharge_density) {
+      if (param.compute_plaquette) {
+        double3 plaq = plaquette(u);
+        param.plaquette[0] = plaq.x;
+        param.plaquette[1] = plaq.y;
+        param.plaquette[2] = plaq.z;
+      }
+      profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+      return;
     }
     profile.TPSTOP(QUDA_PROFILE_COMPUTE);
 
-    // no point constructing Fmunu unless we are going to use it
-    if (!param.compute_qcharge && !param.compute_qcharge_density) return;
-
-    // create the Fmunu field
+    // otherwise measure everything in a single fused sweep without constructing Fmunu
     profile.TPSTART(QUDA_PROFILE_INIT);
-    // u is an extended field we need to shrink for the Fmunu field
-    int x[4];
-    for (int i = 0; i < 4; i++) x[i] = u.X()[i] - 2 * u.R()[i];
-    GaugeFieldParam tensorParam(x, u.Precision(), QUDA_RECONSTRUCT_NO, 0, QUDA_TENSOR_GEOMETRY);
-    tensorParam.siteSubset = QUDA_FULL_SITE_SUBSET;
-    tensorParam.order = QUDA_FLOAT2_GAUGE_ORDER;
-    tensorParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
-    cudaGaugeField gaugeFmunu(tensorParam);
+    if (param.compute_qcharge_density && !param.qcharge_density)
+      errorQuda("Charge density requested, but destination field not defined");
+    size_t size = u.Precision();
+    for (int i = 0; i < 4; i++) size *= u.X()[i] - 2 * u.R()[i];
+    void *qdensity = nullptr;
+    if (param.compute_qcharge_density)
+      qdensity = u.Location() == QUDA_CUDA_FIELD_LOCATION ? pool_device_malloc(size) : param.qcharge_density;
     profile.TPSTOP(QUDA_PROFILE_INIT);
 
     profile.TPSTART(QUDA_PROFILE_COMPUTE);
-    computeFmunu(gaugeFmunu, u);
+    double plaq[3];
+    computeGaugeObservables(u, plaq, param.energy, param.qcharge, qdensity);
+    if (param.compute_plaquette)
+      for (int i = 0; i < 3; i++) param.plaquette[i] = plaq[i];
     profile.TPSTOP(QUDA_PROFILE_COMPUTE);
-    profile.TPSTOP(QUDA_PROFILE_TOTAL);
-
-    if (param.compute_qcharge || param.compute_qcharge_density) {
-      profile.TPSTART(QUDA_PROFILE_TOTAL);
-      profile.TPSTART(QUDA_PROFILE_INIT);
-      if (param.compute_qcharge_density && !param.qcharge_density)
-        errorQuda("Charge density requested, but destination field not defined");
-      size_t size = gaugeFmunu.Volume() * gaugeFmunu.Precision();
-      void *d_qDensity = param.compute_qcharge_density ? pool_device_malloc(size) : nullptr;
-      profile.TPSTOP(QUDA_PROFILE_INIT);
-
-      profile.TPSTART(QUDA_PROFILE_COMPUTE);
 
-      if (param.compute_qcharge_density)
-        computeQChargeDensity(param.energy, param.qcharge, d_qDensity, gaugeFmunu);
-      else
-        computeQCharge(param.energy, param.qcharge, gaugeFmunu);
+    if (qdensity && qdensity != param.qcharge_density) {
+      profile.TPSTART(QUDA_PROFILE_D2H);
+      qudaMemcpy(param.qcharge_density, qdensity, size, cudaMemcpyDeviceToHost);
+      profile.TPSTOP(QUDA_PROFILE_D2H);
 
-      profile.TPSTOP(QUDA_PROFILE_COMPUTE);
-
-      if (param.compute_qcharge_density) {
-        profile.TPSTART(QUDA_PROFILE_D2H);
-        qudaMemcpy(param.qcharge_density, d_qDensity, size, cudaMemcpyDeviceToHost);
-        profile.TPSTOP(QUDA_PROFILE_D2H);
-
-        profile.TPSTART(QUDA_PROFILE_FREE);
-        pool_device_free(d_qDensity);
-        profile.TPSTOP(QUDA_PROFILE_FREE);
-      }
+      profile.TPSTART(QUDA_PROFILE_FREE);
+      pool_device_free(qdensity);
+      profile.TPSTOP(QUDA_PROFILE_FREE);
     }
   }
 
@@ -0,0 +1,110 @@
+#include <quda_internal.h>
+#include <tune_quda.h>
+#include <gauge_field.h>
+#include <gauge_tools.h>
+#include <launch_kernel.cuh>
+#include <jitify_helper.cuh>
+#include <kernels/gauge_observables.cuh>
+#include <launch_host.h>
+#include <instantiate.h>
+
+namespace quda
+{
+
+  template <typename Float, int nColor, QudaReconstructType recon> class GaugeObservablesCompute :
+    TunableLocalParityReduction
+  {
+    const GaugeField &u;
+    observables_t &obs;
+    void *qdensity;
+
+    template <bool density> void launch(const qudaStream_t &stream)
+    {
+      if (u.Location() == QUDA_CUDA_FIELD_LOCATION) {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+        GaugeObservablesArg<Float, nColor, recon, density> arg(u, static_cast<Float *>(qdensity));
+#ifdef JITIFY
+        using namespace jitify::reflection;
+        jitify_error = program->kernel("quda::gaugeObservablesKernel")
+                         .instantiate((int)tp.block.x, Type<decltype(arg)>())
+                         .configure(tp.grid, tp.block, tp.shared_bytes, stream)
+                         .launch(arg);
+        arg.launch_error = jitify_error == CUDA_SUCCESS ? QUDA_SUCCESS : QUDA_ERROR;
+#else
+        LAUNCH_KERNEL_LOCAL_PARITY(gaugeObservablesKernel, (*this), tp, stream, arg, decltype(arg));
+#endif
+        arg.complete(obs);
+      } else {
+        GaugeObservablesArg<Float, nColor, recon, density, QUDA_QDP_GAUGE_ORDER> arg(u, static_cast<Float *>(qdensity));
+        obs = launchHostReduce(GaugeObservables<decltype(arg)>(arg), arg.threads);
+      }
+    }
+
+  public:
+    GaugeObservablesCompute(const GaugeField &u, observables_t &obs, void *qdensity) :
+      u(u),
+      obs(obs),
+      qdensity(qdensity)
+    {
+#ifdef JITIFY
+      create_jitify_program("kernels/gauge_observables.cuh");
+#endif
+      strcpy(aux, compile_type_str(u));
+      if (qdensity) strcat(aux, ",density");
+      apply(0);
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      if (qdensity)
+        launch<true>(stream);
+      else
+        launch<false>(stream);
+    }
+
+    TuneKey tuneKey() const { return TuneKey(u.VolString(), typeid(*this).name(), aux); }
+
+    long long flops() const
+    {
+      auto mm_flops = 8 * nColor * nColor * (nColor - 2);
+      auto traceless_flops = (nColor * nColor + nColor + 1);
+      auto fmunu_flops = 2466; // 12 matrix-matrix products, 3 additions and the anti-hermitian projection
+      auto energy_flops = 6 * (mm_flops + traceless_flops + nColor);
+      auto q_flops = 3 * mm_flops + 2 * nColor + 2;
+      return u.Volume() * (6 * fmunu_flops + energy_flops + q_flops);
+    }
+
+    long long bytes() const { return u.Bytes() + (qdensity ? u.Volume() * sizeof(Float) : 0); }
+  };
+
+  void computeGaugeObservables(const GaugeField &u, double plaq[3], double energy[3], double &qcharge, void *qdensity)
+  {
+#ifdef GPU_GAUGE_TOOLS
+    checkKernelOrder(u);
+
+    observables_t obs;
+    instantiate<GaugeObservablesCompute>(u, obs, qdensity);
+    completeGaugeObservables(u, obs.data, plaq, energy, qcharge);
+#else
+    errorQuda("Gauge tools are not built");
+#endif // GPU_GAUGE_TOOLS
+  }
+
+  void completeGaugeObservables(const GaugeField &u, double obs[5], double plaq[3], double energy[3], double &qcharge)
+  {
+    comm_allreduce_array(obs, 5);
+
+    size_t volume = 1;
+    for (int d = 0; d < 4; d++) volume *= u.X()[d] - 2 * u.R()[d];
+    double global_volume = static_cast<double>(volume) * comm_size();
+
+    plaq[1] = obs[0] / (9.0 * global_volume);
+    plaq[2] = obs[1] / (9.0 * global_volume);
+    plaq[0] = 0.5 * (plaq[1] + plaq[2]);
+    energy[1] = obs[2] / global_volume;
+    energy[2] = obs[3] / global_volume;
+    energy[0] = energy[1] + energy[2];
+    qcharge = obs[4];
+  }
+
+} // namespace quda
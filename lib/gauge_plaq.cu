@@ -2,6 +2,7 @@
 #include <gauge_field.h>
 #include <jitify_helper.cuh>
 #include <kernels/gauge_plaq.cuh>
+#include <launch_host.h>
 #include <instantiate.h>
 
 namespace quda {
@@ -42,7 +43,11 @@ namespace quda {
           for (int i = 0; i < 2; i++) ((double*)&plq)[i] /= 9.*2*arg.threads*comm_size();
         }
       } else {
-	errorQuda("CPU not supported yet\n");
+        if (u.Order() != QUDA_QDP_GAUGE_ORDER) errorQuda("Host order %d not supported", u.Order());
+        GaugePlaqArg<Float, nColor, recon, QUDA_QDP_GAUGE_ORDER> arg(u);
+        plq = launchHostReduce(Plaquette<decltype(arg)>(arg), arg.threads);
+        comm_allreduce_array((double*)&plq, 2);
+        for (int i = 0; i < 2; i++) ((double*)&plq)[i] /= 9.*2*arg.threads*comm_size();
       }
     }
 
@@ -7,18 +7,21 @@
 #include <atomic.cuh>
 #include <index_helper.cuh>
 #include <random_quda.h>
+#include <launch_host.h>
 #include <instantiate.h>
 
 namespace quda {
 
-  template <typename Float_, int nColor_, QudaReconstructType recon_, bool group_> struct GaugeGaussArg {
+  template <typename Float_, int nColor_, QudaReconstructType recon_, bool group_,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
+  struct GaugeGaussArg {
     using Float = Float_;
     using real = typename mapper<Float>::type;
     static constexpr int nColor = nColor_;
     static constexpr QudaReconstructType recon = recon_;
     static constexpr bool group = group_;
 
-    using Gauge = typename gauge_mapper<Float, recon>::type;
+    using Gauge = gauge_accessor_t<Float, recon, order>;
 
     int threads; // number of active threads required
     int E[4]; // extended grid dimensions
@@ -28,7 +31,7 @@ namespace quda {
     RNG rngstate;
     real sigma; // where U = exp(sigma * H)
 
-    GaugeGaussArg(const GaugeField &U, RNG &rngstate, double sigma) : U(U), rngstate(rngstate), sigma(sigma)
+    GaugeGaussArg(const GaugeField &U, RNG &rngstate, double sigma) : U(U), rngstate(rngstate.next()), sigma(sigma)
     {
       int R = 0;
       for (int dir = 0; dir < 4; ++dir) {
@@ -41,7 +44,7 @@ namespace quda {
     }
   };
 
-  template <typename real, typename Link> __device__ __host__ Link gauss_su3(cuRNGState &localState)
+  template <typename real, typename Link> __device__ __host__ Link gauss_su3(RNGState &localState)
   {
     Link ret;
     real rand1[4], rand2[4], phi[4], radius[4], temp1[4], temp2[4];
@@ -73,38 +76,50 @@ namespace quda {
     return ret;
   }
 
+  /**
+     @brief Functor generating the links of one site.  The random
+     numbers depend only on the global site index, so the host and
+     device fields are identical for a given seed.
+  */
+  template <typename Arg> struct GaugeGaussSite {
+    Arg &arg;
+    __device__ __host__ GaugeGaussSite(Arg &arg) : arg(arg) {}
+
+    __device__ __host__ inline void operator()(int x_cb, int parity, int = 0) const
+    {
+      using real = typename mapper<typename Arg::Float>::type;
+      using Link = Matrix<complex<real>, Arg::nColor>;
+
+      int x[4];
+      getCoords(x, x_cb, arg.X, parity);
+      RNGState localState(arg.rngstate, arg.rngstate.globalIndex(x));
+      for (int dr = 0; dr < 4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+
+      if (arg.group && arg.sigma == 0.0) {
+        // if sigma = 0 then we just set the output matrix to the identity and finish
+        Link I;
+        setIdentity(&I);
+        for (int mu = 0; mu < 4; mu++) arg.U(mu, linkIndex(x, arg.E), parity) = I;
+      } else {
+        for (int mu = 0; mu < 4; mu++) {
+          // generate Gaussian distributed su(n) fiueld
+          Link u = gauss_su3<real, Link>(localState);
+          if (arg.group) {
+            u = arg.sigma * u;
+            expsu3<real>(u);
+          }
+          arg.U(mu, linkIndex(x, arg.E), parity) = u;
+        }
+      }
+    }
+  };
+
   template <typename Arg> __global__ void computeGenGauss(Arg arg)
   {
-    using real = typename mapper<typename Arg::Float>::type;
-    using Link = Matrix<complex<real>, Arg::nColor>;
     int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
     int parity = threadIdx.y + blockIdx.y * blockDim.y;
     if (x_cb >= arg.threads) return;
-
-    int x[4];
-    getCoords(x, x_cb, arg.X, parity);
-    for (int dr = 0; dr < 4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
-
-    if (arg.group && arg.sigma == 0.0) {
-      // if sigma = 0 then we just set the output matrix to the identity and finish
-      Link I;
-      setIdentity(&I);
-      for (int mu = 0; mu < 4; mu++) arg.U(mu, linkIndex(x, arg.E), parity) = I;
-    } else {
-      for (int mu = 0; mu < 4; mu++) {
-        cuRNGState localState = arg.rngstate.State()[parity * arg.threads + x_cb];
-
-        // generate Gaussian distributed su(n) fiueld
-        Link u = gauss_su3<real, Link>(localState);
-        if (arg.group) {
-          u = arg.sigma * u;
-          expsu3<real>(u);
-        }
-        arg.U(mu, linkIndex(x, arg.E), parity) = u;
-
-        arg.rngstate.State()[parity * arg.threads + x_cb] = localState;
-      }
-    }
+    GaugeGaussSite<Arg>(arg)(x_cb, parity);
   }
 
   template <typename Arg> class GaugeGauss : TunableVectorY
@@ -131,19 +146,26 @@ namespace quda {
 
     long long flops() const { return 0; }
     long long bytes() const { return meta.Bytes(); }
-
-    void preTune() { arg.rngstate.backup(); }
-    void postTune() { arg.rngstate.restore(); }
   };
 
+  template <typename Float, int nColor, QudaReconstructType recon, bool group>
+  void genGauss(GaugeField &U, RNG &rngstate, double sigma)
+  {
+    if (U.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      GaugeGaussArg<Float, nColor, recon, group> arg(U, rngstate, sigma);
+      GaugeGauss<decltype(arg)> gaugeGauss(arg, U);
+      gaugeGauss.apply(0);
+    } else {
+      GaugeGaussArg<Float, nColor, recon, group, QUDA_QDP_GAUGE_ORDER> arg(U, rngstate, sigma);
+      launchHost(GaugeGaussSite<decltype(arg)>(arg), arg.threads);
+    }
+  }
+
   template <typename Float, int nColor, QudaReconstructType recon>
   struct GenGaussGroup {
     GenGaussGroup(GaugeField &U, RNG &rngstate, double sigma)
     {
-      constexpr bool group = true;
-      GaugeGaussArg<Float, nColor, recon, group> arg(U, rngstate, sigma);
-      GaugeGauss<decltype(arg)> gaugeGauss(arg, U);
-      gaugeGauss.apply(0);
+      genGauss<Float, nColor, recon, true>(U, rngstate, sigma);
     }
   };
 
@@ -151,16 +173,13 @@ namespace quda {
   struct GenGaussAlgebra {
     GenGaussAlgebra(GaugeField &U, RNG &rngstate, double sigma)
     {
-      constexpr bool group = false;
-      GaugeGaussArg<Float, nColor, recon, group> arg(U, rngstate, sigma);
-      GaugeGauss<decltype(arg)> gaugeGauss(arg, U);
-      gaugeGauss.apply(0);
+      genGauss<Float, nColor, recon, false>(U, rngstate, sigma);
     }
   };
 
   void gaugeGauss(GaugeField &U, RNG &rng, double sigma)
   {
-    if (!U.isNative()) errorQuda("Order %d with %d reconstruct not supported", U.Order(), U.Reconstruct());
+    checkKernelOrder(U);
 
     if (U.LinkType() == QUDA_SU3_LINKS) {
 
@@ -188,10 +207,7 @@ namespace quda {
 
   void gaugeGauss(GaugeField &U, unsigned long long seed, double sigma)
   {
-    RNG *randstates = new RNG(U, seed);
-    randstates->Init();
-    quda::gaugeGauss(U, *randstates, sigma);
-    randstates->Release();
-    delete randstates;
+    RNG randstates(U, seed);
+    quda::gaugeGauss(U, randstates, sigma);
   }
 }
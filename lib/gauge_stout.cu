@@ -4,6 +4,7 @@
 
 #include <jitify_helper.cuh>
 #include <kernels/gauge_stout.cuh>
+#include <launch_host.h>
 #include <instantiate.h>
 
 namespace quda {
@@ -12,7 +13,9 @@ namespace quda {
   {
     static constexpr int stoutDim = 3; // apply stouting in space only
     GaugeSTOUTArg<Float, nColor, recon, stoutDim> arg;
+    GaugeField &out;
     const GaugeField &meta;
+    const double rho;
 
     bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
     unsigned int minThreads() const { return arg.threads; }
@@ -22,7 +25,9 @@ public:
     GaugeSTOUT(GaugeField &out, const GaugeField &in, double rho) :
       TunableVectorYZ(2, stoutDim),
       arg(out, in, rho),
-      meta(in)
+      out(out),
+      meta(in),
+      rho(rho)
     {
       strcpy(aux, meta.AuxString());
       strcat(aux, comm_dim_partitioned_string());
@@ -35,14 +40,19 @@ public:
 
     void apply(const qudaStream_t &stream)
     {
-      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 #ifdef JITIFY
-      using namespace jitify::reflection;
-      jitify_error = program->kernel("quda::computeSTOUTStep").instantiate(Type<decltype(arg)>())
-        .configure(tp.grid, tp.block, tp.shared_bytes, stream).launch(arg);
+        using namespace jitify::reflection;
+        jitify_error = program->kernel("quda::computeSTOUTStep").instantiate(Type<decltype(arg)>())
+          .configure(tp.grid, tp.block, tp.shared_bytes, stream).launch(arg);
 #else
-      qudaLaunchKernel(computeSTOUTStep<decltype(arg)>, tp, stream, arg);
+        qudaLaunchKernel(computeSTOUTStep<decltype(arg)>, tp, stream, arg);
 #endif
+      } else {
+        GaugeSTOUTArg<Float, nColor, recon, stoutDim, QUDA_QDP_GAUGE_ORDER> arg(out, meta, rho);
+        launchHost(STOUT<decltype(arg)>(arg), arg.threads, 2, stoutDim);
+      }
     }
 
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
@@ -59,11 +69,11 @@ public:
 #ifdef GPU_GAUGE_TOOLS
     checkPrecision(out, in);
     checkReconstruct(out, in);
+    auto location = checkLocation(out, in);
+    checkKernelOrder(out);
+    checkKernelOrder(in);
 
-    if (!out.isNative()) errorQuda("Order %d with %d reconstruct not supported", in.Order(), in.Reconstruct());
-    if (!in.isNative()) errorQuda("Order %d with %d reconstruct not supported", out.Order(), out.Reconstruct());
-
-    copyExtendedGauge(in, out, QUDA_CUDA_FIELD_LOCATION);
+    copyExtendedGauge(in, out, location);
     in.exchangeExtendedGhost(in.R(), false);
     instantiate<GaugeSTOUT>(out, in, rho);
     out.exchangeExtendedGhost(out.R(), false);    
@@ -76,7 +86,10 @@ public:
   {
     static constexpr int stoutDim = 4; // apply stouting in all dims
     GaugeSTOUTArg<Float, nColor, recon, stoutDim> arg;
+    GaugeField &out;
     const GaugeField &meta;
+    const double rho;
+    const double epsilon;
 
     bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
     unsigned int minThreads() const { return arg.threads; }
@@ -85,7 +98,10 @@ public:
     GaugeOvrImpSTOUT(GaugeField &out, const GaugeField &in, double rho, double epsilon) :
       TunableVectorYZ(2, stoutDim),
       arg(out, in, rho, epsilon),
-      meta(in)
+      out(out),
+      meta(in),
+      rho(rho),
+      epsilon(epsilon)
     {
       strcpy(aux, meta.AuxString());
       strcat(aux, comm_dim_partitioned_string());
@@ -98,14 +114,19 @@ public:
 
     void apply(const qudaStream_t &stream)
     {
-      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 #ifdef JITIFY
-      using namespace jitify::reflection;
-      jitify_error = program->kernel("quda::computeOvrImpSTOUTStep").instantiate(Type<decltype(arg)>())
-        .configure(tp.grid, tp.block, tp.shared_bytes, stream).launch(arg);
+        using namespace jitify::reflection;
+        jitify_error = program->kernel("quda::computeOvrImpSTOUTStep").instantiate(Type<decltype(arg)>())
+          .configure(tp.grid, tp.block, tp.shared_bytes, stream).launch(arg);
 #else
-      qudaLaunchKernel(computeOvrImpSTOUTStep<decltype(arg)>, tp, stream, arg);
+        qudaLaunchKernel(computeOvrImpSTOUTStep<decltype(arg)>, tp, stream, arg);
 #endif
+      } else {
+        GaugeSTOUTArg<Float, nColor, recon, stoutDim, QUDA_QDP_GAUGE_ORDER> arg(out, meta, rho, epsilon);
+        launchHost(OvrImpSTOUT<decltype(arg)>(arg), arg.threads, 2, stoutDim);
+      }
     }
 
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
@@ -122,11 +143,11 @@ public:
 #ifdef GPU_GAUGE_TOOLS
     checkPrecision(out, in);
     checkReconstruct(out, in);
+    auto location = checkLocation(out, in);
+    checkKernelOrder(out);
+    checkKernelOrder(in);
 
-    if (!out.isNative()) errorQuda("Order %d with %d reconstruct not supported", in.Order(), in.Reconstruct());
-    if (!in.isNative()) errorQuda("Order %d with %d reconstruct not supported", out.Order(), out.Reconstruct());
-
-    copyExtendedGauge(in, out, QUDA_CUDA_FIELD_LOCATION);
+    copyExtendedGauge(in, out, location);
     in.exchangeExtendedGhost(in.R(), false);
     instantiate<GaugeOvrImpSTOUT>(out, in, rho, epsilon);
     out.exchangeExtendedGhost(out.R(), false);
@@ -1,10 +1,14 @@
 #include <quda_internal.h>
 #include <tune_quda.h>
 #include <gauge_field.h>
+#include <gauge_tools.h>
 
+#include <launch_kernel.cuh>
 #include <jitify_helper.cuh>
 #include <kernels/gauge_wilson_flow.cuh>
+#include <launch_host.h>
 #include <instantiate.h>
+#include <uint_to_char.h>
 
 namespace quda {
 
@@ -13,7 +17,11 @@ namespace quda {
   {
     static constexpr int wflow_dim = 4; // apply flow in all dims
     GaugeWFlowArg<Float, nColor, recon, wflow_dim> arg;
+    GaugeField &out;
+    GaugeField &temp;
     const GaugeField &meta;
+    const int *depth;
+    GaugeField &z0;
 
     bool tuneSharedBytes() const { return false; }
     bool tuneGridDim() const { return false; }
@@ -23,13 +31,22 @@ namespace quda {
     int blockMin() const { return 8; }
 
   public:
-    GaugeWFlowStep(GaugeField &out, GaugeField &temp, const GaugeField &in, const double epsilon, const QudaWFlowType wflow_type, const WFlowStepType step_type) :
+    GaugeWFlowStep(GaugeField &out, GaugeField &temp, const GaugeField &in, const double epsilon,
+                   const QudaWFlowType wflow_type, const WFlowStepType step_type, const int *depth, GaugeField &z0,
+                   bool adaptive) :
       TunableVectorYZ(2, wflow_dim),
-      arg(out, temp, in, epsilon, wflow_type, step_type),
-      meta(in)
+      arg(out, temp, in, epsilon, wflow_type, step_type, depth, z0, adaptive),
+      out(out),
+      temp(temp),
+      meta(in),
+      depth(depth),
+      z0(z0)
     {
       strcpy(aux, meta.AuxString());
       strcat(aux, comm_dim_partitioned_string());
+      strcat(aux, ",depth=");
+      for (int d = 0; d < 4; d++) u32toa(aux + strlen(aux), depth[d]);
+      if (adaptive) strcat(aux, ",adaptive");
       switch (wflow_type) {
       case QUDA_WFLOW_TYPE_WILSON: strcat(aux,",computeWFlowStepWilson"); break;
       case QUDA_WFLOW_TYPE_SYMANZIK: strcat(aux,",computeWFlowStepSymanzik"); break;
@@ -49,8 +66,40 @@ namespace quda {
       qudaDeviceSynchronize();
     }
 
+    /**
+       @brief Run the step on host fields
+    */
+    void applyHost()
+    {
+      GaugeWFlowArg<Float, nColor, recon, wflow_dim, QUDA_QDP_GAUGE_ORDER> arg(
+        out, temp, meta, this->arg.epsilon, this->arg.wflow_type, this->arg.step_type, depth, z0, this->arg.adaptive);
+      using Arg = decltype(arg);
+      switch (arg.wflow_type) {
+      case QUDA_WFLOW_TYPE_WILSON:
+        switch (arg.step_type) {
+        case WFLOW_STEP_W1: launchHost(WFlow<QUDA_WFLOW_TYPE_WILSON, WFLOW_STEP_W1, Arg>(arg), arg.threads, 2, wflow_dim); break;
+        case WFLOW_STEP_W2: launchHost(WFlow<QUDA_WFLOW_TYPE_WILSON, WFLOW_STEP_W2, Arg>(arg), arg.threads, 2, wflow_dim); break;
+        case WFLOW_STEP_VT: launchHost(WFlow<QUDA_WFLOW_TYPE_WILSON, WFLOW_STEP_VT, Arg>(arg), arg.threads, 2, wflow_dim); break;
+        }
+        break;
+      case QUDA_WFLOW_TYPE_SYMANZIK:
+        switch (arg.step_type) {
+        case WFLOW_STEP_W1: launchHost(WFlow<QUDA_WFLOW_TYPE_SYMANZIK, WFLOW_STEP_W1, Arg>(arg), arg.threads, 2, wflow_dim); break;
+        case WFLOW_STEP_W2: launchHost(WFlow<QUDA_WFLOW_TYPE_SYMANZIK, WFLOW_STEP_W2, Arg>(arg), arg.threads, 2, wflow_dim); break;
+        case WFLOW_STEP_VT: launchHost(WFlow<QUDA_WFLOW_TYPE_SYMANZIK, WFLOW_STEP_VT, Arg>(arg), arg.threads, 2, wflow_dim); break;
+        }
+        break;
+      default: errorQuda("Unknown Wilson Flow type %d", arg.wflow_type);
+      }
+    }
+
     void apply(const qudaStream_t &stream)
     {
+      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
+        applyHost();
+        return;
+      }
+
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 #ifdef JITIFY
       using namespace jitify::reflection;
@@ -110,34 +159,362 @@ namespace quda {
       case QUDA_WFLOW_TYPE_SYMANZIK: links = 24; break;
       default : errorQuda("Unknown Wilson Flow type");
       }
-      auto temp_io = arg.step_type == WFLOW_STEP_W2 ? 2 : arg.step_type == WFLOW_STEP_VT ? 1 : 0;
+      auto temp_io = arg.step_type == WFLOW_STEP_W2 ? (arg.adaptive ? 3 : 2) : arg.step_type == WFLOW_STEP_VT ? 1 : 0;
       return ((1 + (wflow_dim-1) * links) * arg.in.Bytes() + arg.out.Bytes() + temp_io*arg.temp.Bytes()) * 2ll * arg.threads * wflow_dim;
     }
   }; // GaugeWFlowStep
 
-  void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in, const double epsilon, const QudaWFlowType wflow_type)
+  template <typename Float, int nColor, QudaReconstructType recon>
+  class GaugeWFlowReduce : TunableLocalParityReduction
+  {
+    static constexpr int wflow_dim = 4; // apply flow in all dims
+    GaugeField &out;
+    GaugeField &temp;
+    const GaugeField &in;
+    GaugeField &z0;
+    const double epsilon;
+    const QudaWFlowType wflow_type;
+    const WFlowStepType step_type;
+    observables_t &obs;
+    double &err2;
+
+    template <typename Functor, typename Arg> void launchKernel(Arg &arg, const TuneParam &tp, const qudaStream_t &stream)
+    {
+#ifdef JITIFY
+      using namespace jitify::reflection;
+      jitify_error = program->kernel("quda::computeWFlowReduce")
+                       .instantiate((int)tp.block.x, Type<Functor>(), Type<Arg>())
+                       .configure(tp.grid, tp.block, tp.shared_bytes, stream)
+                       .launch(arg);
+      arg.launch_error = jitify_error == CUDA_SUCCESS ? QUDA_SUCCESS : QUDA_ERROR;
+#else
+      LAUNCH_KERNEL_LOCAL_PARITY(computeWFlowReduce, (*this), tp, stream, arg, Functor, Arg);
+#endif
+    }
+
+    template <QudaWFlowType type> void launch(const qudaStream_t &stream)
+    {
+      if (in.Location() == QUDA_CUDA_FIELD_LOCATION) {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+        if (step_type == WFLOW_STEP_W1) {
+          GaugeWFlowMeasureArg<Float, nColor, recon, wflow_dim> arg(out, temp, in, epsilon, type, z0);
+          launchKernel<WFlowMeasure<type, decltype(arg)>>(arg, tp, stream);
+          arg.complete(obs);
+        } else {
+          GaugeWFlowErrorArg<Float, nColor, recon, wflow_dim> arg(out, temp, in, epsilon, type, z0);
+          launchKernel<WFlowError<type, decltype(arg)>>(arg, tp, stream);
+          arg.complete(err2);
+        }
+      } else {
+        if (step_type == WFLOW_STEP_W1) {
+          GaugeWFlowMeasureArg<Float, nColor, recon, wflow_dim, QUDA_QDP_GAUGE_ORDER> arg(out, temp, in, epsilon, type, z0);
+          obs = launchHostReduce(WFlowMeasure<type, decltype(arg)>(arg), arg.threads);
+        } else {
+          GaugeWFlowErrorArg<Float, nColor, recon, wflow_dim, QUDA_QDP_GAUGE_ORDER> arg(out, temp, in, epsilon, type, z0);
+          err2 = launchHostReduce(WFlowError<type, decltype(arg)>(arg), arg.threads);
+        }
+      }
+    }
+
+  public:
+    GaugeWFlowReduce(GaugeField &out, GaugeField &temp, const GaugeField &in, GaugeField &z0, const double epsilon,
+                     const QudaWFlowType wflow_type, const WFlowStepType step_type, observables_t &obs, double &err2) :
+      out(out),
+      temp(temp),
+      in(in),
+      z0(z0),
+      epsilon(epsilon),
+      wflow_type(wflow_type),
+      step_type(step_type),
+      obs(obs),
+      err2(err2)
+    {
+      strcpy(aux, in.AuxString());
+      strcat(aux, comm_dim_partitioned_string());
+      switch (wflow_type) {
+      case QUDA_WFLOW_TYPE_WILSON: strcat(aux, ",computeWFlowStepWilson"); break;
+      case QUDA_WFLOW_TYPE_SYMANZIK: strcat(aux, ",computeWFlowStepSymanzik"); break;
+      default: errorQuda("Unknown Wilson Flow type %d", wflow_type);
+      }
+      switch (step_type) {
+      case WFLOW_STEP_W1: strcat(aux, "_W1,measure"); break;
+      case WFLOW_STEP_VT: strcat(aux, "_VT,error"); break;
+      default: errorQuda("Wilson Flow step type %d cannot be fused with a reduction", step_type);
+      }
+
+#ifdef JITIFY
+      create_jitify_program("kernels/gauge_wilson_flow.cuh");
+#endif
+      apply(0);
+    }
+
+    void apply(const qudaStream_t &stream)
+    {
+      switch (wflow_type) {
+      case QUDA_WFLOW_TYPE_WILSON: launch<QUDA_WFLOW_TYPE_WILSON>(stream); break;
+      case QUDA_WFLOW_TYPE_SYMANZIK: launch<QUDA_WFLOW_TYPE_SYMANZIK>(stream); break;
+      default: errorQuda("Unknown Wilson Flow type %d", wflow_type);
+      }
+    }
+
+    TuneKey tuneKey() const { return TuneKey(in.VolString(), typeid(*this).name(), aux); }
+
+    long long flops() const
+    {
+      long long mat_flops = nColor * nColor * (8 * nColor - 2);
+      long long mat_muls = 1 + (wflow_type == QUDA_WFLOW_TYPE_WILSON ? 4 : 28) * (wflow_dim - 1);
+      long long extra = step_type == WFLOW_STEP_W1 ? 6 * 2466 : 0; // clover field strength of the measurement
+      return (mat_muls * mat_flops * wflow_dim + extra) * in.Volume();
+    }
+
+    long long bytes() const
+    {
+      long long links = 1 + (wflow_dim - 1) * (wflow_type == QUDA_WFLOW_TYPE_WILSON ? 6 : 24);
+      long long temp_io = step_type == WFLOW_STEP_W1 ? 1 : 2;
+      return links * in.Bytes() + out.Bytes() + temp_io * temp.Bytes();
+    }
+  }; // GaugeWFlowReduce
+
+  /**
+     @brief Driver for the substeps of the flow.  It tracks how many
+     layers of the halo of the most recently written field hold valid
+     links: all of them after a ghost exchange, and reach fewer after
+     each substep, where reach is the depth the staples of a substep
+     read.  Each substep is applied over as much of the halo as is
+     still valid, so the next one needs an exchange only once the
+     halo has been used up.  W2 and Vt also read the accumulated
+     temporary field (and z0) at the sites they update, and these are
+     never exchanged, so their depth is further capped at the depth to
+     which the previous substep wrote them.  With the usual extended
+     radius of two, the Wilson action flow thus exchanges twice per
+     step rather than three times.  The substeps fused with a
+     reduction are only applied to the interior.
+  */
+  class WFlowIntegrator
+  {
+    GaugeField &temp;
+    GaugeField &z0;
+    const QudaWFlowType wflow_type;
+    const int reach;
+    int R_min;
+    bool halo;
+    int valid;      // valid halo layers of the most recently written field
+    int temp_valid; // halo layers of temp and z0 written by the previous substep
+
+    void exchange(GaugeField &in)
+    {
+      if (halo && valid < reach) {
+        in.exchangeExtendedGhost(in.R(), false);
+        valid = R_min;
+      }
+    }
+
+  public:
+    WFlowIntegrator(const GaugeField &u, GaugeField &temp, GaugeField &z0, QudaWFlowType wflow_type) :
+      temp(temp),
+      z0(z0),
+      wflow_type(wflow_type),
+      reach(wflow_type == QUDA_WFLOW_TYPE_SYMANZIK ? 2 : 1),
+      R_min(0),
+      halo(false)
+    {
+      for (int d = 0; d < 4; d++) {
+        if (temp.R()[d] != u.R()[d] || z0.R()[d] != u.R()[d])
+          errorQuda("Temporary fields must be extended as the gauge field");
+        if (u.R()[d] > 0) {
+          R_min = halo ? std::min(R_min, u.R()[d]) : u.R()[d];
+          halo = true;
+        }
+      }
+      if (halo && R_min < reach) errorQuda("Extended radius %d is too small for flow type %d", R_min, wflow_type);
+      valid = R_min; // the input field has been exchanged
+      temp_valid = 0;
+    }
+
+    /**
+       @return Number of valid halo layers of the most recently written field
+    */
+    int Valid() const { return valid; }
+
+    /**
+       @brief Reset the number of valid halo layers, e.g., when a step is rejected
+    */
+    void Valid(int valid) { this->valid = valid; }
+
+    void substep(GaugeField &out, GaugeField &in, double epsilon, WFlowStepType step_type, bool adaptive)
+    {
+      exchange(in);
+      // W1 only writes temp, while W2 and Vt read it where they write out
+      int depth_ = valid - reach;
+      if (step_type != WFLOW_STEP_W1) depth_ = std::min(depth_, temp_valid);
+      int depth[4];
+      for (int d = 0; d < 4; d++) depth[d] = in.R()[d] > 0 ? depth_ : 0;
+      instantiate<GaugeWFlowStep, WilsonReconstruct>(out, temp, in, epsilon, wflow_type, step_type, depth, z0, adaptive);
+      valid = depth_;
+      temp_valid = depth_;
+    }
+
+    void substep(GaugeField &out, GaugeField &in, double epsilon, WFlowStepType step_type, observables_t &obs,
+                 double &err2)
+    {
+      exchange(in);
+      instantiate<GaugeWFlowReduce, WilsonReconstruct>(out, temp, in, z0, epsilon, wflow_type, step_type, obs, err2);
+      valid = 0;
+      temp_valid = 0;
+    }
+
+    /**
+       @brief Apply steps W1, W2, Vt
+       @param[out] out Output field, also holding W1
+       @param[out] w2 Field holding W2, which may alias in when not adaptive
+       @param[in] in Input field
+       @param[in] epsilon Step size
+       @param[in] adaptive Whether to estimate the error; w2 must not alias in
+       @param[out] obs If not nullptr, the local sums of the observables of the input field
+       @return The local sum of the squared distance between the
+       updated links and the embedded second-order update if adaptive
+    */
+    double step(GaugeField &out, GaugeField &w2, GaugeField &in, double epsilon, bool adaptive, observables_t *obs)
+    {
+      double err2 = 0.0;
+      observables_t obs_;
+      if (obs)
+        substep(out, in, epsilon, WFLOW_STEP_W1, *obs, err2);
+      else
+        substep(out, in, epsilon, WFLOW_STEP_W1, false);
+
+      substep(w2, out, epsilon, WFLOW_STEP_W2, adaptive);
+
+      if (adaptive)
+        substep(out, w2, epsilon, WFLOW_STEP_VT, obs_, err2);
+      else
+        substep(out, w2, epsilon, WFLOW_STEP_VT, false);
+      return err2;
+    }
+
+    /**
+       @brief Exchange the most recently written field if its halo is not wholly valid
+    */
+    void finish(GaugeField &u)
+    {
+      if (halo && valid < R_min) {
+        u.exchangeExtendedGhost(u.R(), false);
+        valid = R_min;
+      }
+    }
+  };
+
+  static void checkWFlowFields(GaugeField &out, GaugeField &temp, GaugeField &in)
   {
-#ifdef GPU_GAUGE_TOOLS
     checkPrecision(out, temp, in);
     checkReconstruct(out, in);
+    checkLocation(out, temp, in);
     if (temp.Reconstruct() != QUDA_RECONSTRUCT_NO) errorQuda("Temporary vector must not use reconstruct");
-    if (!out.isNative()) errorQuda("Order %d with %d reconstruct not supported", in.Order(), in.Reconstruct());
-    if (!in.isNative()) errorQuda("Order %d with %d reconstruct not supported", out.Order(), out.Reconstruct());
+    checkKernelOrder(out);
+    checkKernelOrder(temp);
+    checkKernelOrder(in);
+  }
+
+  void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in, const double epsilon, const QudaWFlowType wflow_type)
+  {
+#ifdef GPU_GAUGE_TOOLS
+    checkWFlowFields(out, temp, in);
 
-    // Set each step type as an arg parameter, update halos if needed
-    // Step W1
-    instantiate<GaugeWFlowStep,WilsonReconstruct>(out, temp, in, epsilon, wflow_type, WFLOW_STEP_W1);
-    out.exchangeExtendedGhost(out.R(), false);
+    WFlowIntegrator flow(in, temp, temp, wflow_type);
+    flow.step(out, in, in, epsilon, false, nullptr);
+    flow.finish(out);
+#else
+    errorQuda("Gauge tools are not built");
+#endif
+  }
+
+  std::vector<WFlowObservables> WFlowIntegrate(GaugeField &u, double epsilon, double t_max, QudaWFlowType wflow_type,
+                                               double tol, int meas_interval)
+  {
+    std::vector<WFlowObservables> meas;
+#ifdef GPU_GAUGE_TOOLS
+    if (epsilon <= 0.0) errorQuda("Invalid step size %e", epsilon);
+    const bool adaptive = tol > 0.0;
+
+    GaugeFieldParam param(u);
+    param.create = QUDA_NULL_FIELD_CREATE;
+    GaugeField *aux = GaugeField::Create(param);
+    GaugeField *w2 = adaptive ? GaugeField::Create(param) : nullptr;
+    param.reconstruct = QUDA_RECONSTRUCT_NO; // temporary fields are not on manifold so cannot use reconstruct
+    if (u.Location() == QUDA_CUDA_FIELD_LOCATION) param.setPrecision(param.Precision(), true);
+    GaugeField *temp = GaugeField::Create(param);
+    GaugeField *z0 = adaptive ? GaugeField::Create(param) : nullptr;
+    checkWFlowFields(*aux, *temp, u);
+
+    WFlowIntegrator flow(u, *temp, adaptive ? *z0 : *temp, wflow_type);
+    GaugeField *in = &u;
+    GaugeField *out = aux;
+
+    auto record = [&](double t, observables_t &obs) {
+      WFlowObservables m;
+      m.t = t;
+      completeGaugeObservables(u, obs.data, m.plaquette, m.energy, m.qcharge);
+      meas.push_back(m);
+    };
+
+    size_t volume = 1;
+    for (int d = 0; d < 4; d++) volume *= u.X()[d] - 2 * u.R()[d];
+    const double n_links = 4.0 * volume * comm_size();
+
+    double t = 0.0;
+    int n_steps = 0;
+    int n_rejected = 0;
+    bool measured = false; // whether the current configuration has been measured
+    while (t_max - t > 1e-10 * t_max) {
+      const double eps = std::min(epsilon, t_max - t);
+      const bool measure = meas_interval > 0 && n_steps % meas_interval == 0 && !measured;
+      const int valid = flow.Valid();
+
+      observables_t obs;
+      double err2 = flow.step(*out, adaptive ? *w2 : *in, *in, eps, adaptive, measure ? &obs : nullptr);
+      if (measure) {
+        record(t, obs);
+        measured = true;
+      }
+
+      if (adaptive) {
+        // the embedded update is of second order, so the error scales as eps^3
+        comm_allreduce(&err2);
+        double err = sqrt(err2 / n_links);
+        double factor = err > 0.0 ? std::min(std::max(0.9 * cbrt(tol / err), 0.2), 2.0) : 2.0;
+        epsilon = eps * factor;
+        if (err > tol) { // reject the step: in is intact since W2 was written to w2
+          n_rejected++;
+          flow.Valid(valid);
+          continue;
+        }
+      }
+
+      t += eps;
+      n_steps++;
+      measured = false;
+      std::swap(in, out);
+    }
+
+    flow.finish(*in);
+    if (meas_interval > 0 && n_steps % meas_interval == 0) {
+      WFlowObservables m;
+      m.t = t;
+      computeGaugeObservables(*in, m.plaquette, m.energy, m.qcharge);
+      meas.push_back(m);
+    }
+    if (in != &u) copyExtendedGauge(u, *in, u.Location());
 
-    // Step W2
-    instantiate<GaugeWFlowStep,WilsonReconstruct>(in, temp, out, epsilon, wflow_type, WFLOW_STEP_W2);
-    in.exchangeExtendedGhost(in.R(), false);
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Flowed to t = %e in %d steps (%d rejected)\n", t, n_steps, n_rejected);
 
-    // Step Vt
-    instantiate<GaugeWFlowStep,WilsonReconstruct>(out, temp, in, epsilon, wflow_type, WFLOW_STEP_VT);
-    out.exchangeExtendedGhost(out.R(), false);
+    if (z0) delete z0;
+    delete temp;
+    if (w2) delete w2;
+    delete aux;
 #else
     errorQuda("Gauge tools are not built");
 #endif
+    return meas;
   }
 }
@@ -31,6 +31,8 @@
 
 #include <multigrid.h>
 #include <deflation.h>
+#include <solver_telemetry.h>
+#include <workspace.h>
 #include <ks_force_quda.h>
 
 #ifdef GPU_GAUGE_FORCE
@@ -130,6 +132,11 @@ cudaGaugeField *extendedGaugeResident = nullptr;
 
 std::vector<cudaColorSpinorField*> solutionResident;
 
+// Generation of the resident gauge and clover fields, incremented
+// whenever they are reallocated or released.  Solve contexts compare
+// it against the generation their Dirac operators were built with.
+static unsigned long long resident_generation = 0;
+
 // vector of spinors used for forecasting solutions in HMC
 #define QUDA_MAX_CHRONO 12
 // each entry is one p
@@ -162,6 +169,9 @@ static TimeProfile profileMulti("invertMultiShiftQuda");
 //!< Profiler for eigensolveQuda
 static TimeProfile profileEigensolve("eigensolveQuda");
 
+//!< Profiler for checkpointMultigridQuda / restoreMultigridQuda
+static TimeProfile profileMGCheckpoint("checkpointMultigridQuda");
+
 //!< Profiler for computeFatLinkQuda
 static TimeProfile profileFatLink("computeKSLinkQuda");
 
@@ -561,6 +571,36 @@ void initQuda(int dev)
   initQudaMemory();
 }
 
+/**
+   @return Whether QUDA_GAUGE_CHECKSUM is set, in which case the
+   checksum of every gauge field passing through loadGaugeQuda and
+   saveGaugeQuda is reported.  Where the host reorder is done on the
+   CPU this is accumulated during the copy itself.
+ */
+static bool gaugeChecksumEnabled()
+{
+  static bool init = false;
+  static bool enabled = false;
+  if (!init) {
+    char *checksum_env = getenv("QUDA_GAUGE_CHECKSUM");
+    enabled = checksum_env && strcmp(checksum_env, "0") != 0;
+    init = true;
+  }
+  return enabled;
+}
+
+/**
+   @brief Close the streaming checksum opened around a host transfer
+   and report it, falling back to a separate (threaded) pass over the
+   host field if the transfer did not contribute to the stream.
+ */
+static void reportGaugeChecksum(const GaugeField &host, const char *direction)
+{
+  uint64_t checksum;
+  if (!checksumStreamEnd(checksum)) checksum = host.checksum();
+  if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Gauge field %s checksum = %016lx\n", direction, checksum);
+}
+
 // This is a flag used to signal when we have downloaded new gauge
 // field.  Set by loadGaugeQuda and consumed by loadCloverQuda as one
 // possible flag to indicate we need to recompute the clover field
@@ -599,6 +639,8 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
     invalidate_clover = true;
   }
 
+  resident_generation++;
+
   // free any current gauge field before new allocations to reduce memory overhead
   switch (param->type) {
     case QUDA_WILSON_LINKS:
@@ -683,7 +725,10 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
   } else {
     profileGauge.TPSTOP(QUDA_PROFILE_INIT);
     profileGauge.TPSTART(QUDA_PROFILE_H2D);
+    bool stream_checksum = gaugeChecksumEnabled() && in->Location() == QUDA_CPU_FIELD_LOCATION;
+    if (stream_checksum) checksumStreamBegin();
     precise->copy(*in);
+    if (stream_checksum) reportGaugeChecksum(*in, "load");
     profileGauge.TPSTOP(QUDA_PROFILE_H2D);
   }
 
@@ -860,7 +905,9 @@ void saveGaugeQuda(void *h_gauge, QudaGaugeParam *param)
   }
 
   profileGauge.TPSTART(QUDA_PROFILE_D2H);
+  if (gaugeChecksumEnabled()) checksumStreamBegin(true);
   cudaGauge->saveCPUField(cpuGauge);
+  if (gaugeChecksumEnabled()) reportGaugeChecksum(cpuGauge, "save");
   profileGauge.TPSTOP(QUDA_PROFILE_D2H);
 
   if (param->type == QUDA_SMEARED_LINKS) { delete cudaGauge; }
@@ -878,6 +925,7 @@ void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
 
   checkCloverParam(inv_param);
   bool device_calc = false; // calculate clover and inverse on the device?
+  resident_generation++;
 
   pushVerbosity(inv_param->verbosity);
   if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printQudaInvertParam(inv_param);
@@ -1066,6 +1114,7 @@ void freeSloppyCloverQuda();
 void loadSloppyCloverQuda(const QudaPrecision *prec)
 {
   freeSloppyCloverQuda();
+  resident_generation++;
 
   if (cloverPrecise) {
     // create the mirror sloppy clover field
@@ -1132,6 +1181,7 @@ void loadSloppyCloverQuda(const QudaPrecision *prec)
 void freeSloppyGaugeQuda()
 {
   if (!initialized) errorQuda("QUDA not initialized");
+  resident_generation++;
 
   // Wilson gauges
   //---------------------------------------------------------------------------
@@ -1236,6 +1286,8 @@ void freeGaugeQuda(void)
 
 void loadSloppyGaugeQuda(const QudaPrecision *prec, const QudaReconstructType *recon)
 {
+  resident_generation++;
+
   // first do SU3 links (if they exist)
   if (gaugePrecise) {
     GaugeFieldParam gauge_param(*gaugePrecise);
@@ -1442,6 +1494,7 @@ void loadSloppyGaugeQuda(const QudaPrecision *prec, const QudaReconstructType *r
 void freeSloppyCloverQuda()
 {
   if (!initialized) errorQuda("QUDA not initialized");
+  resident_generation++;
 
   // Delete cloverRefinement if it does not alias gaugeSloppy.
   if (cloverRefinement != cloverSloppy && cloverRefinement) delete cloverRefinement;
@@ -1508,6 +1561,7 @@ void endQuda(void)
   blas_lapack::native::destroy();
   blas::destroy();
 
+  workspace::flush();
   pool::flush_pinned();
   pool::flush_device();
 
@@ -1540,6 +1594,7 @@ void endQuda(void)
     profileInvert.Print();
     profileMulti.Print();
     profileEigensolve.Print();
+    profileMGCheckpoint.Print();
     profileFatLink.Print();
     profileGaugeForce.Print();
     profileGaugeUpdate.Print();
@@ -2513,7 +2568,7 @@ void eigensolveQuda(void **host_evecs, double _Complex *host_evals, QudaEigParam
   profileEigensolve.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
-multigrid_solver::multigrid_solver(QudaMultigridParam &mg_param, TimeProfile &profile)
+multigrid_solver::multigrid_solver(QudaMultigridParam &mg_param, TimeProfile &profile, const char *checkpoint)
   : profile(profile) {
   profile.TPSTART(QUDA_PROFILE_INIT);
   QudaInvertParam *param = mg_param.invert_param;
@@ -2591,6 +2646,7 @@ multigrid_solver::multigrid_solver(QudaMultigridParam &mg_param, TimeProfile &pr
 
   // fill out the MG parameters for the fine level
   mgParam = new MGParam(mg_param, B, m, mSmooth, mSmoothSloppy);
+  if (checkpoint) mgParam->checkpoint = checkpoint;
 
   mg = new MG(*mgParam, profile);
   mgParam->updateInvertParam(*param);
@@ -2619,6 +2675,7 @@ void* newMultigridQuda(QudaMultigridParam *mg_param) {
 
 void destroyMultigridQuda(void *mg) {
   delete static_cast<multigrid_solver*>(mg);
+  workspace::trim(0); // release the idle fields of the coarse levels
 }
 
 void updateMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
@@ -2743,6 +2800,41 @@ void dumpMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
   profilerStop(__func__);
 }
 
+void checkpointMultigridQuda(void *mg_, QudaMultigridParam *mg_param, const char *prefix)
+{
+  profilerStart(__func__);
+  pushVerbosity(mg_param->invert_param->verbosity);
+  profileMGCheckpoint.TPSTART(QUDA_PROFILE_TOTAL);
+
+  auto *mg = static_cast<multigrid_solver*>(mg_);
+  checkMultigridParam(mg_param);
+  checkGauge(mg_param->invert_param);
+
+  mg->mg->saveCheckpoint(prefix);
+
+  profileMGCheckpoint.TPSTOP(QUDA_PROFILE_TOTAL);
+  popVerbosity();
+  profilerStop(__func__);
+}
+
+void *restoreMultigridQuda(QudaMultigridParam *mg_param, const char *prefix)
+{
+  profilerStart(__func__);
+
+  pushVerbosity(mg_param->invert_param->verbosity);
+
+  profileMGCheckpoint.TPSTART(QUDA_PROFILE_TOTAL);
+  auto *mg = new multigrid_solver(*mg_param, profileMGCheckpoint, prefix);
+  profileMGCheckpoint.TPSTOP(QUDA_PROFILE_TOTAL);
+
+  saveTuneCache();
+
+  popVerbosity();
+
+  profilerStop(__func__);
+  return static_cast<void*>(mg);
+}
+
 deflated_solver::deflated_solver(QudaEigParam &eig_param, TimeProfile &profile)
   : d(nullptr), m(nullptr), RV(nullptr), deflParam(nullptr), defl(nullptr),  profile(profile) {
 
@@ -2830,6 +2922,24 @@ void destroyDeflationQuda(void *df) {
   delete static_cast<deflated_solver*>(df);
 }
 
+/**
+   @brief Report the peak live workspace footprint of the solve that
+   just completed, then release the idle workspace fields that exceed
+   the retention limit
+*/
+static void finishWorkspace()
+{
+  if (getVerbosity() >= QUDA_VERBOSE)
+    printfQuda("Workspace: peak live footprint = %.3f MiB (workspace fields only, device peak = %.3f MiB), held = "
+               "%.3f MiB\n",
+               workspace::peak_bytes() / static_cast<double>(1 << 20),
+               device_allocated_peak() / static_cast<double>(1 << 20),
+               workspace::pool_bytes() / static_cast<double>(1 << 20));
+  if (telemetry::active()) telemetry::counter("workspace_peak_bytes", workspace::peak_bytes());
+
+  workspace::trim(workspace::retain_bytes());
+}
+
 void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
 {
   profilerStart(__func__);
@@ -2841,11 +2951,13 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
   profileInvert.TPSTART(QUDA_PROFILE_TOTAL);
 
   if (!initialized) errorQuda("QUDA not initialized");
+  telemetry::begin(__func__, profileInvert);
 
   pushVerbosity(param->verbosity);
   if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printQudaInvertParam(param);
 
   checkInvertParam(param, hp_x, hp_b);
+  workspace::reset_peak();
 
   // check the gauge fields have been created
   cudaGaugeField *cudaGauge = checkGauge(param);
@@ -3241,16 +3353,439 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
 
   profileInvert.TPSTOP(QUDA_PROFILE_FREE);
 
+  finishWorkspace();
+
   popVerbosity();
 
   // cache is written out even if a long benchmarking job gets interrupted
   saveTuneCache();
 
   profileInvert.TPSTOP(QUDA_PROFILE_TOTAL);
+  telemetry::end(*param, profileInvert);
 
   profilerStop(__func__);
 }
 
+/**
+   @brief State kept alive by a solve context between solves: the
+   Dirac operators and the matrices wrapping them, the solvers with
+   their workspaces and the device source, solution and temporary
+   fields.  All of it is derived from the invert parameters and the
+   resident gauge and clover fields, and it is rebuilt by update()
+   only when one of them changes in a way that invalidates it.
+*/
+struct solve_context {
+  QudaInvertParam param;              /** parameters the state was built from */
+  unsigned long long generation = 0;  /** resident field generation the state was built from */
+  bool built = false;
+  int n_build = 0;                    /** number of times the state has been built */
+
+  Dirac *d = nullptr;
+  Dirac *dSloppy = nullptr;
+  Dirac *dPre = nullptr;
+  Dirac *dEig = nullptr;
+
+  // matrices, parameters and solver of the (final) solve
+  DiracMatrix *m = nullptr;
+  DiracMatrix *mSloppy = nullptr;
+  DiracMatrix *mPre = nullptr;
+  DiracMatrix *mEig = nullptr;
+  SolverParam *solverParam = nullptr;
+  Solver *solve = nullptr;
+
+  // matrices, parameters and solver of the first pass A^dag y = b of a two-pass solve
+  DiracMatrix *mDag = nullptr;
+  DiracMatrix *mDagSloppy = nullptr;
+  DiracMatrix *mDagPre = nullptr;
+  DiracMatrix *mDagEig = nullptr;
+  SolverParam *solverParamDag = nullptr;
+  Solver *solveDag = nullptr;
+
+  cudaColorSpinorField *b = nullptr;
+  cudaColorSpinorField *x = nullptr;
+  cudaColorSpinorField *tmp = nullptr;
+
+  solve_context(const QudaInvertParam &param) : param(param) {}
+
+  ~solve_context() { free(); }
+
+  void free()
+  {
+    // the solvers reference the matrices, which reference the Dirac operators
+    delete solve;
+    delete solveDag;
+    delete solverParam;
+    delete solverParamDag;
+    for (auto mat : {m, mSloppy, mPre, mEig, mDag, mDagSloppy, mDagPre, mDagEig}) delete mat;
+    delete d;
+    delete dSloppy;
+    delete dPre;
+    delete dEig;
+    delete b;
+    delete x;
+    delete tmp;
+
+    solve = solveDag = nullptr;
+    solverParam = solverParamDag = nullptr;
+    m = mSloppy = mPre = mEig = mDag = mDagSloppy = mDagPre = mDagEig = nullptr;
+    d = dSloppy = dPre = dEig = nullptr;
+    b = x = tmp = nullptr;
+    built = false;
+  }
+
+  /**
+     @brief Whether two parameter sets only differ in the per-solve
+     and output parameters, so that state built for one is valid for
+     the other
+  */
+  static bool compatible(const QudaInvertParam &p0, const QudaInvertParam &p1)
+  {
+    QudaInvertParam c = p1;
+    c.input_location = p0.input_location;
+    c.output_location = p0.output_location;
+    c.cpu_prec = p0.cpu_prec;
+    c.dirac_order = p0.dirac_order;
+    c.gamma_basis = p0.gamma_basis;
+    c.tol = p0.tol;
+    c.tol_hq = p0.tol_hq;
+    c.maxiter = p0.maxiter;
+    c.compute_true_res = p0.compute_true_res;
+    c.compute_action = p0.compute_action;
+    c.use_init_guess = p0.use_init_guess;
+    c.solver_normalization = p0.solver_normalization;
+    c.verbosity = p0.verbosity;
+    c.tune = p0.tune;
+
+    // outputs
+    c.true_res = p0.true_res;
+    c.true_res_hq = p0.true_res_hq;
+    c.iter = p0.iter;
+    c.gflops = p0.gflops;
+    c.secs = p0.secs;
+    c.rhs_idx = p0.rhs_idx;
+    c.ca_lambda_min = p0.ca_lambda_min;
+    c.ca_lambda_max = p0.ca_lambda_max;
+    for (int i = 0; i < 2; i++) {
+      c.action[i] = p0.action[i];
+      c.trlogA[i] = p0.trlogA[i];
+    }
+    for (int i = 0; i < QUDA_MAX_MULTI_SHIFT; i++) {
+      c.true_res_offset[i] = p0.true_res_offset[i];
+      c.iter_res_offset[i] = p0.iter_res_offset[i];
+      c.true_res_hq_offset[i] = p0.true_res_hq_offset[i];
+    }
+
+    // a bitwise comparison errs on the side of rebuilding
+    return memcmp(&p0, &c, sizeof(QudaInvertParam)) == 0;
+  }
+
+  /**
+     @brief Build the Dirac operators, solvers and device fields for
+     the parameters in param, or reuse those already built if they
+     are still valid
+     @param[in] inv_param The parameters of the next solve
+     @param[in] X The local lattice dimensions
+  */
+  void update(const QudaInvertParam &inv_param, const int *X)
+  {
+    if (built && generation == resident_generation && compatible(param, inv_param)) {
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printfQuda("Reusing solve context state\n");
+      param = inv_param;
+      return;
+    }
+
+    if (built && getVerbosity() >= QUDA_VERBOSE) printfQuda("Rebuilding solve context state\n");
+    free();
+    param = inv_param;
+    generation = resident_generation;
+
+    bool pc_solution
+      = (param.solution_type == QUDA_MATPC_SOLUTION) || (param.solution_type == QUDA_MATPCDAG_MATPC_SOLUTION);
+    bool pc_solve = (param.solve_type == QUDA_DIRECT_PC_SOLVE) || (param.solve_type == QUDA_NORMOP_PC_SOLVE)
+      || (param.solve_type == QUDA_NORMERR_PC_SOLVE);
+    bool mat_solution = (param.solution_type == QUDA_MAT_SOLUTION) || (param.solution_type == QUDA_MATPC_SOLUTION);
+    bool direct_solve = (param.solve_type == QUDA_DIRECT_SOLVE) || (param.solve_type == QUDA_DIRECT_PC_SOLVE);
+    bool norm_error_solve = (param.solve_type == QUDA_NORMERR_SOLVE) || (param.solve_type == QUDA_NORMERR_PC_SOLVE);
+
+    if (pc_solution && !pc_solve) errorQuda("Preconditioned (PC) solution_type requires a PC solve_type");
+    if (!mat_solution && !pc_solution && pc_solve)
+      errorQuda("Unpreconditioned MATDAG_MAT solution_type requires an unpreconditioned solve_type");
+    if (!mat_solution && norm_error_solve) errorQuda("Normal-error solve requires Mat solution");
+    if (param.inv_type_precondition == QUDA_MG_INVERTER && (!direct_solve || !mat_solution))
+      errorQuda("Multigrid preconditioning only supported for direct solves");
+
+    createDiracWithEig(d, dSloppy, dPre, dEig, param, pc_solve);
+
+    ColorSpinorParam cpuParam(nullptr, param, X, pc_solution, param.input_location);
+    ColorSpinorParam cudaParam(cpuParam, param);
+    cudaParam.create = QUDA_NULL_FIELD_CREATE;
+    b = new cudaColorSpinorField(cudaParam);
+    x = new cudaColorSpinorField(cudaParam);
+
+    if (param.inv_type_precondition == QUDA_MG_INVERTER) {
+      d->prefetch(QUDA_CUDA_FIELD_LOCATION);
+      dSloppy->prefetch(QUDA_CUDA_FIELD_LOCATION);
+      dPre->prefetch(QUDA_CUDA_FIELD_LOCATION);
+    }
+
+    if (!mat_solution && direct_solve) {
+      mDag = new DiracMdag(*d);
+      mDagSloppy = new DiracMdag(*dSloppy);
+      mDagPre = new DiracMdag(*dPre);
+      mDagEig = new DiracMdag(*dEig);
+      solverParamDag = new SolverParam(param);
+      solveDag = Solver::create(*solverParamDag, *mDag, *mDagSloppy, *mDagPre, *mDagEig, profileInvert);
+    }
+
+    if (direct_solve) {
+      m = new DiracM(*d);
+      mSloppy = new DiracM(*dSloppy);
+      mPre = new DiracM(*dPre);
+      mEig = new DiracM(*dEig);
+    } else if (!norm_error_solve) {
+      m = new DiracMdagM(*d);
+      mSloppy = new DiracMdagM(*dSloppy);
+      // if using a Schwarz preconditioner with a normal operator then we must use the DiracMdagMLocal operator
+      if (param.inv_type_precondition != QUDA_INVALID_INVERTER && param.schwarz_type != QUDA_INVALID_SCHWARZ)
+        mPre = new DiracMdagMLocal(*dPre);
+      else
+        mPre = new DiracMdagM(*dPre);
+      mEig = new DiracMdagM(*dEig);
+    } else {
+      m = new DiracMMdag(*d);
+      mSloppy = new DiracMMdag(*dSloppy);
+      mPre = new DiracMMdag(*dPre);
+      mEig = new DiracMMdag(*dEig);
+    }
+    solverParam = new SolverParam(param);
+    solve = Solver::create(*solverParam, *m, *mSloppy, *mPre, *mEig, profileInvert);
+
+    built = true;
+    n_build++;
+  }
+
+  /**
+     @brief Reset the per-solve parameters of a solver that has been
+     kept alive from a previous solve
+     @param[in,out] solver_param The solver parameters to reset
+  */
+  void reset(SolverParam &solver_param) const
+  {
+    solver_param.tol = param.tol;
+    solver_param.tol_hq = param.tol_hq;
+    solver_param.maxiter = param.maxiter;
+    solver_param.compute_true_res = param.compute_true_res;
+    solver_param.use_init_guess = param.use_init_guess;
+    solver_param.true_res = 0.0;
+    solver_param.true_res_hq = 0.0;
+    solver_param.iter = 0;
+    solver_param.secs = 0.0;
+    solver_param.gflops = 0.0;
+  }
+};
+
+void *newSolveContextQuda(QudaInvertParam *param)
+{
+  if (!initialized) errorQuda("QUDA not initialized");
+  checkInvertParam(param);
+  // the state is built lazily by the first solve
+  return static_cast<void *>(new solve_context(*param));
+}
+
+void solveWithContextQuda(void *context, void *hp_x, void *hp_b, QudaInvertParam *param)
+{
+  profilerStart(__func__);
+
+  if (param->dslash_type == QUDA_DOMAIN_WALL_DSLASH || param->dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH
+      || param->dslash_type == QUDA_MOBIUS_DWF_DSLASH || param->dslash_type == QUDA_MOBIUS_DWF_EOFA_DSLASH)
+    setKernelPackT(true);
+
+  profileInvert.TPSTART(QUDA_PROFILE_TOTAL);
+
+  if (!initialized) errorQuda("QUDA not initialized");
+  if (!context) errorQuda("Solve context not allocated");
+  telemetry::begin(__func__, profileInvert);
+
+  pushVerbosity(param->verbosity);
+  if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printQudaInvertParam(param);
+
+  checkInvertParam(param, hp_x, hp_b);
+
+  if (param->chrono_use_resident || param->chrono_make_resident)
+    errorQuda("Chronological forecasting not supported by solve contexts");
+  if (param->use_resident_solution || param->make_resident_solution)
+    errorQuda("Resident solutions not supported by solve contexts");
+  workspace::reset_peak();
+
+  // check the gauge fields have been created
+  cudaGaugeField *cudaGauge = checkGauge(param);
+
+  param->secs = 0;
+  param->gflops = 0;
+  param->iter = 0;
+
+  auto &ctx = *static_cast<solve_context *>(context);
+
+  // the workspace the solvers check out is pinned to the context, so is reused by its later solves
+  workspace::set_owner(&ctx);
+
+  profileInvert.TPSTART(QUDA_PROFILE_INIT);
+  ctx.update(*param, cudaGauge->X());
+  profileInvert.TPSTOP(QUDA_PROFILE_INIT);
+
+  bool pc_solution = (param->solution_type == QUDA_MATPC_SOLUTION) ||
+    (param->solution_type == QUDA_MATPCDAG_MATPC_SOLUTION);
+  bool mat_solution = (param->solution_type == QUDA_MAT_SOLUTION) ||
+    (param->solution_type ==  QUDA_MATPC_SOLUTION);
+  bool direct_solve = (param->solve_type == QUDA_DIRECT_SOLVE) ||
+    (param->solve_type == QUDA_DIRECT_PC_SOLVE);
+  bool norm_error_solve = (param->solve_type == QUDA_NORMERR_SOLVE) ||
+    (param->solve_type == QUDA_NORMERR_PC_SOLVE);
+
+  Dirac &dirac = *ctx.d;
+  cudaColorSpinorField &b = *ctx.b;
+  cudaColorSpinorField &x = *ctx.x;
+  ColorSpinorField *in = nullptr;
+  ColorSpinorField *out = nullptr;
+
+  profileInvert.TPSTART(QUDA_PROFILE_H2D);
+
+  // wrap CPU host side pointers
+  ColorSpinorParam cpuParam(hp_b, *param, cudaGauge->X(), pc_solution, param->input_location);
+  ColorSpinorField *h_b = ColorSpinorField::Create(cpuParam);
+
+  cpuParam.v = hp_x;
+  cpuParam.location = param->output_location;
+  ColorSpinorField *h_x = ColorSpinorField::Create(cpuParam);
+
+  // download source into the staging field
+  b = *h_b;
+
+  if (param->use_init_guess == QUDA_USE_INIT_GUESS_YES) { // download initial guess
+    // initial guess only supported for single-pass solvers
+    if (!mat_solution && direct_solve) errorQuda("Initial guess not supported for two-pass solver");
+    x = *h_x; // solution
+  } else { // zero initial guess
+    blas::zero(x);
+  }
+
+  profileInvert.TPSTOP(QUDA_PROFILE_H2D);
+  profileInvert.TPSTART(QUDA_PROFILE_PREAMBLE);
+
+  double nb = blas::norm2(b);
+  if (nb==0.0) errorQuda("Source has zero norm");
+
+  if (getVerbosity() >= QUDA_VERBOSE) {
+    double nh_b = blas::norm2(*h_b);
+    printfQuda("Source: CPU = %g, CUDA copy = %g\n", nh_b, nb);
+  }
+
+  // rescale the source and solution vectors to help prevent the onset of underflow
+  if (param->solver_normalization == QUDA_SOURCE_NORMALIZATION) {
+    blas::ax(1.0/sqrt(nb), b);
+    blas::ax(1.0/sqrt(nb), x);
+  }
+
+  massRescale(b, *param);
+
+  dirac.prepare(in, out, x, b, param->solution_type);
+
+  if (getVerbosity() >= QUDA_VERBOSE) {
+    double nin = blas::norm2(*in);
+    double nout = blas::norm2(*out);
+    printfQuda("Prepared source = %g\n", nin);
+    printfQuda("Prepared solution = %g\n", nout);
+  }
+
+  if ((mat_solution && !direct_solve) && !ctx.tmp) ctx.tmp = new cudaColorSpinorField(*in);
+
+  profileInvert.TPSTOP(QUDA_PROFILE_PREAMBLE);
+
+  // see invertQuda for the cases handled here
+  if (mat_solution && !direct_solve && !norm_error_solve) { // prepare source: b' = A^dag b
+    blas::copy(*ctx.tmp, *in);
+    dirac.Mdag(*in, *ctx.tmp);
+  } else if (!mat_solution && direct_solve) { // perform the first of two solves: A^dag y = b
+    ctx.reset(*ctx.solverParamDag);
+    (*ctx.solveDag)(*out, *in);
+    blas::copy(*in, *out);
+    ctx.solverParamDag->updateInvertParam(*param);
+  }
+
+  ctx.reset(*ctx.solverParam);
+  if (!norm_error_solve) {
+    (*ctx.solve)(*out, *in);
+  } else {
+    blas::copy(*ctx.tmp, *out);
+    (*ctx.solve)(*ctx.tmp, *in); // y = (M M^\dag) b
+    dirac.Mdag(*out, *ctx.tmp);  // x = M^dag y
+  }
+  ctx.solverParam->updateInvertParam(*param);
+
+  if (getVerbosity() >= QUDA_VERBOSE){
+    double nx = blas::norm2(x);
+    printfQuda("Solution = %g\n",nx);
+  }
+
+  profileInvert.TPSTART(QUDA_PROFILE_EPILOGUE);
+  dirac.reconstruct(x, b, param->solution_type);
+
+  if (param->solver_normalization == QUDA_SOURCE_NORMALIZATION) {
+    // rescale the solution
+    blas::ax(sqrt(nb), x);
+  }
+  profileInvert.TPSTOP(QUDA_PROFILE_EPILOGUE);
+
+  profileInvert.TPSTART(QUDA_PROFILE_D2H);
+  *h_x = x;
+  profileInvert.TPSTOP(QUDA_PROFILE_D2H);
+
+  profileInvert.TPSTART(QUDA_PROFILE_EPILOGUE);
+
+  if (param->compute_action) {
+    Complex action = blas::cDotProduct(b, x);
+    param->action[0] = action.real();
+    param->action[1] = action.imag();
+  }
+
+  if (getVerbosity() >= QUDA_VERBOSE){
+    double nx = blas::norm2(x);
+    double nh_x = blas::norm2(*h_x);
+    printfQuda("Reconstructed: CUDA solution = %g, CPU copy = %g\n", nx, nh_x);
+  }
+  profileInvert.TPSTOP(QUDA_PROFILE_EPILOGUE);
+
+  profileInvert.TPSTART(QUDA_PROFILE_FREE);
+  delete h_b;
+  delete h_x;
+  profileInvert.TPSTOP(QUDA_PROFILE_FREE);
+
+  workspace::set_owner(nullptr);
+  finishWorkspace();
+
+  popVerbosity();
+
+  // cache is written out even if a long benchmarking job gets interrupted
+  saveTuneCache();
+
+  profileInvert.TPSTOP(QUDA_PROFILE_TOTAL);
+  telemetry::end(*param, profileInvert);
+
+  profilerStop(__func__);
+}
+
+int getSolveContextBuildsQuda(void *context)
+{
+  if (!context) errorQuda("Solve context not allocated");
+  return static_cast<solve_context *>(context)->n_build;
+}
+
+void destroySolveContextQuda(void *context)
+{
+  delete static_cast<solve_context *>(context);
+  workspace::release(context);
+  workspace::trim(workspace::retain_bytes());
+}
 
 /*!
  * Generic version of the multi-shift solver. Should work for
@@ -3613,6 +4148,7 @@ void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param)
   profileMulti.TPSTART(QUDA_PROFILE_INIT);
 
   if (!initialized) errorQuda("QUDA not initialized");
+  telemetry::begin(__func__, profileMulti);
 
   checkInvertParam(param, _hp_x[0], _hp_b);
 
@@ -3999,6 +4535,7 @@ void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param)
   saveTuneCache();
 
   profileMulti.TPSTOP(QUDA_PROFILE_TOTAL);
+  telemetry::end(*param, profileMulti);
 
   profilerStop(__func__);
 }
@@ -4196,6 +4733,7 @@ int computeGaugeForceQuda(void* mom, void* siteLink,  int*** input_path_buf, int
   if (qudaGaugeParam->make_resident_gauge) {
     if (gaugePrecise && gaugePrecise != cudaSiteLink) delete gaugePrecise;
     gaugePrecise = cudaSiteLink;
+    resident_generation++;
   } else {
     delete cudaSiteLink;
   }
@@ -5028,6 +5566,7 @@ void updateGaugeFieldQuda(void* gauge,
   if (param->make_resident_gauge) {
     if (gaugePrecise != nullptr) delete gaugePrecise;
     gaugePrecise = cudaOutGauge;
+    resident_generation++;
   } else {
     delete cudaOutGauge;
   }
@@ -5097,6 +5636,7 @@ void updateGaugeFieldQuda(void* gauge,
    if (param->make_resident_gauge) {
      if (gaugePrecise != nullptr && cudaGauge != gaugePrecise) delete gaugePrecise;
      gaugePrecise = cudaGauge;
+     resident_generation++;
    } else {
      delete cudaGauge;
    }
@@ -5151,6 +5691,7 @@ void updateGaugeFieldQuda(void* gauge,
    if (param->make_resident_gauge) {
      if (gaugePrecise != nullptr && cudaGauge != gaugePrecise) delete gaugePrecise;
      gaugePrecise = cudaGauge;
+     resident_generation++;
    } else {
      delete cudaGauge;
    }
@@ -5713,9 +6254,8 @@ void performOvrImpSTOUTnStep(unsigned int n_steps, double rho, double epsilon, i
   profileOvrImpSTOUT.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
-void performWFlownStep(unsigned int n_steps, double step_size, int meas_interval, QudaWFlowType wflow_type)
+static void performWFlow(double t_max, double step_size, double tol, int meas_interval, QudaWFlowType wflow_type)
 {
-  pushOutputPrefix("performWFlownStep: ");
   profileWFlow.TPSTART(QUDA_PROFILE_TOTAL);
 
   if (gaugePrecise == nullptr) errorQuda("Gauge field must be loaded");
@@ -5723,46 +6263,35 @@ void performWFlownStep(unsigned int n_steps, double step_size, int meas_interval
   if (gaugeSmeared != nullptr) delete gaugeSmeared;
   gaugeSmeared = createExtendedGauge(*gaugePrecise, R, profileWFlow);
 
-  GaugeFieldParam gParamEx(*gaugeSmeared);
-  auto *gaugeAux = GaugeField::Create(gParamEx);
-
-  GaugeFieldParam gParam(*gaugePrecise);
-  gParam.reconstruct = QUDA_RECONSTRUCT_NO; // temporary field is not on manifold so cannot use reconstruct
-  auto *gaugeTemp = GaugeField::Create(gParam);
-
-  GaugeField *in = gaugeSmeared;
-  GaugeField *out = gaugeAux;
-
-  QudaGaugeObservableParam param = newQudaGaugeObservableParam();
-  param.compute_plaquette = QUDA_BOOLEAN_TRUE;
-  param.compute_qcharge = QUDA_BOOLEAN_TRUE;
+  // Perform W1, W2, and Vt Wilson Flow steps as defined in
+  // https://arxiv.org/abs/1006.4518v3, measuring on the fly
+  profileWFlow.TPSTART(QUDA_PROFILE_COMPUTE);
+  auto meas = WFlowIntegrate(*gaugeSmeared, step_size, t_max, wflow_type, tol,
+                             getVerbosity() >= QUDA_SUMMARIZE ? meas_interval : 0);
+  profileWFlow.TPSTOP(QUDA_PROFILE_COMPUTE);
 
   if (getVerbosity() >= QUDA_SUMMARIZE) {
-    gaugeObservables(*in, param, profileWFlow);
     printfQuda("flow t, plaquette, E_tot, E_spatial, E_temporal, Q charge\n");
-    printfQuda("%le %.16e %+.16e %+.16e %+.16e %+.16e\n", 0.0, param.plaquette[0], param.energy[0], param.energy[1],
-               param.energy[2], param.qcharge);
-  }
-
-  for (unsigned int i = 0; i < n_steps; i++) {
-    // Perform W1, W2, and Vt Wilson Flow steps as defined in
-    // https://arxiv.org/abs/1006.4518v3
-    profileWFlow.TPSTART(QUDA_PROFILE_COMPUTE);
-    if (i > 0) std::swap(in, out); // output from prior step becomes input for next step
-
-    WFlowStep(*out, *gaugeTemp, *in, step_size, wflow_type);
-    profileWFlow.TPSTOP(QUDA_PROFILE_COMPUTE);
-
-    if ((i + 1) % meas_interval == 0 && getVerbosity() >= QUDA_SUMMARIZE) {
-      gaugeObservables(*out, param, profileWFlow);
-      printfQuda("%le %.16e %+.16e %+.16e %+.16e %+.16e\n", step_size * (i + 1), param.plaquette[0], param.energy[0],
-                 param.energy[1], param.energy[2], param.qcharge);
-    }
+    for (auto &m : meas)
+      printfQuda("%le %.16e %+.16e %+.16e %+.16e %+.16e\n", m.t, m.plaquette[0], m.energy[0], m.energy[1], m.energy[2],
+                 m.qcharge);
   }
 
-  delete gaugeTemp;
-  delete gaugeAux;
   profileWFlow.TPSTOP(QUDA_PROFILE_TOTAL);
+}
+
+void performWFlownStep(unsigned int n_steps, double step_size, int meas_interval, QudaWFlowType wflow_type)
+{
+  pushOutputPrefix("performWFlownStep: ");
+  performWFlow(n_steps * step_size, step_size, 0.0, meas_interval, wflow_type);
+  popOutputPrefix();
+}
+
+void performWFlowAdaptive(double t_max, double step_size, double tol, int meas_interval, QudaWFlowType wflow_type)
+{
+  pushOutputPrefix("performWFlowAdaptive: ");
+  if (tol <= 0.0) errorQuda("Invalid tolerance %e", tol);
+  performWFlow(t_max, step_size, tol, meas_interval, wflow_type);
   popOutputPrefix();
 }
 
@@ -5962,6 +6491,110 @@ void contractQuda(const void *hp_x, const void *hp_y, void *h_result, const Quda
   profileContract.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
+void contractFTQuda(const void *hp_x, const void *hp_y, double *h_result, const QudaContractType cType, const int *mom,
+                    int n_mom, const int *gamma, int n_gamma, QudaInvertParam *param, const int *X)
+{
+  profileContract.TPSTART(QUDA_PROFILE_TOTAL);
+  profileContract.TPSTART(QUDA_PROFILE_INIT);
+  // wrap CPU host side pointers
+  ColorSpinorParam cpuParam((void *)hp_x, *param, X, false, param->input_location);
+  ColorSpinorField *h_x = ColorSpinorField::Create(cpuParam);
+
+  cpuParam.v = (void *)hp_y;
+  ColorSpinorField *h_y = ColorSpinorField::Create(cpuParam);
+
+  // Create device parameter
+  ColorSpinorParam cudaParam(cpuParam);
+  cudaParam.location = QUDA_CUDA_FIELD_LOCATION;
+  cudaParam.create = QUDA_NULL_FIELD_CREATE;
+  // Quda uses Degrand-Rossi gamma basis for contractions and will
+  // automatically reorder data if necessary.
+  cudaParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  cudaParam.setPrecision(cpuParam.Precision(), cpuParam.Precision(), true);
+
+  ColorSpinorField *x = ColorSpinorField::Create(cudaParam);
+  ColorSpinorField *y = ColorSpinorField::Create(cudaParam);
+  profileContract.TPSTOP(QUDA_PROFILE_INIT);
+
+  profileContract.TPSTART(QUDA_PROFILE_H2D);
+  *x = *h_x;
+  *y = *h_y;
+  profileContract.TPSTOP(QUDA_PROFILE_H2D);
+
+  // only the correlators are returned, which are reduced on the device
+  profileContract.TPSTART(QUDA_PROFILE_COMPUTE);
+  std::vector<Complex> result;
+  contractFTQuda(*x, *y, result, cType, std::vector<int>(mom, mom + 3 * n_mom),
+                 std::vector<int>(gamma, gamma + n_gamma));
+  for (auto i = 0u; i < result.size(); i++) {
+    h_result[2 * i + 0] = result[i].real();
+    h_result[2 * i + 1] = result[i].imag();
+  }
+  profileContract.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+  profileContract.TPSTART(QUDA_PROFILE_FREE);
+  delete x;
+  delete y;
+  delete h_y;
+  delete h_x;
+  profileContract.TPSTOP(QUDA_PROFILE_FREE);
+
+  profileContract.TPSTOP(QUDA_PROFILE_TOTAL);
+}
+
+void contractPropagatorsQuda(void **prop1, void **prop2, double *h_meson, double *h_baryon, const int *mom,
+                             int n_mom, QudaInvertParam *param, const int *X)
+{
+  profileContract.TPSTART(QUDA_PROFILE_TOTAL);
+  profileContract.TPSTART(QUDA_PROFILE_INIT);
+  // wrap CPU host side pointers
+  ColorSpinorParam cpuParam(prop1[0], *param, X, false, param->input_location);
+  if (cpuParam.location != QUDA_CPU_FIELD_LOCATION) errorQuda("Propagators must be host fields");
+
+  // The propagator contraction is performed on the host in the
+  // Degrand-Rossi basis and space-spin-color order, so the data is
+  // reordered into copies if necessary.
+  ColorSpinorParam contractParam(cpuParam);
+  contractParam.create = QUDA_NULL_FIELD_CREATE;
+  contractParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  contractParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  const bool reorder
+    = cpuParam.gammaBasis != contractParam.gammaBasis || cpuParam.fieldOrder != contractParam.fieldOrder;
+
+  std::vector<ColorSpinorField *> h_prop[2];
+  std::vector<ColorSpinorField *> S[2];
+  for (int p = 0; p < 2; p++) {
+    for (int i = 0; i < 12; i++) {
+      cpuParam.v = (p == 0 ? prop1 : prop2)[i];
+      h_prop[p].push_back(ColorSpinorField::Create(cpuParam));
+      S[p].push_back(reorder ? ColorSpinorField::Create(contractParam) : h_prop[p].back());
+    }
+  }
+  profileContract.TPSTOP(QUDA_PROFILE_INIT);
+
+  profileContract.TPSTART(QUDA_PROFILE_COMPUTE);
+  if (reorder)
+    for (int p = 0; p < 2; p++)
+      for (int i = 0; i < 12; i++) *S[p][i] = *h_prop[p][i];
+
+  std::vector<Complex> meson, baryon;
+  contractPropagatorsQuda(S[0], S[1], meson, baryon, std::vector<int>(mom, mom + 3 * n_mom));
+  memcpy(h_meson, meson.data(), meson.size() * sizeof(Complex));
+  memcpy(h_baryon, baryon.data(), baryon.size() * sizeof(Complex));
+  profileContract.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+  profileContract.TPSTART(QUDA_PROFILE_FREE);
+  for (int p = 0; p < 2; p++) {
+    for (int i = 0; i < 12; i++) {
+      if (reorder) delete S[p][i];
+      delete h_prop[p][i];
+    }
+  }
+  profileContract.TPSTOP(QUDA_PROFILE_FREE);
+
+  profileContract.TPSTOP(QUDA_PROFILE_TOTAL);
+}
+
 void gaugeObservablesQuda(QudaGaugeObservableParam *param)
 {
   profileGaugeObs.TPSTART(QUDA_PROFILE_TOTAL);
@@ -8,6 +8,7 @@
 #include <invert_quda.h>
 #include <util_quda.h>
 #include <color_spinor_field.h>
+#include <workspace.h>
 
 namespace quda {
 
@@ -16,24 +17,11 @@ namespace quda {
 
   BiCGstab::BiCGstab(const DiracMatrix &mat, const DiracMatrix &matSloppy, const DiracMatrix &matPrecon,
                      const DiracMatrix &matEig, SolverParam &param, TimeProfile &profile) :
-    Solver(mat, matSloppy, matPrecon, matEig, param, profile), init(false)
+    Solver(mat, matSloppy, matPrecon, matEig, param, profile)
   {
   }
 
-  BiCGstab::~BiCGstab() {
-    profile.TPSTART(QUDA_PROFILE_FREE);
-
-    if(init) {
-      delete yp;
-      delete rp;
-      delete pp;
-      delete vp;
-      delete tmpp;
-      delete tp;
-    }
-
-    profile.TPSTOP(QUDA_PROFILE_FREE);
-  }
+  BiCGstab::~BiCGstab() { }
 
   int reliable(double &rNorm, double &maxrx, double &maxrr, const double &r2, const double &delta) {
     // reliable updates
@@ -53,19 +41,17 @@ namespace quda {
   {
     profile.TPSTART(QUDA_PROFILE_PREAMBLE);
 
-    if (!init) {
-      ColorSpinorParam csParam(x);
-      csParam.create = QUDA_ZERO_FIELD_CREATE;
-      yp = ColorSpinorField::Create(csParam);
-      rp = ColorSpinorField::Create(csParam);
-      csParam.setPrecision(param.precision_sloppy);
-      pp = ColorSpinorField::Create(csParam);
-      vp = ColorSpinorField::Create(csParam);
-      tmpp = ColorSpinorField::Create(csParam);
-      tp = ColorSpinorField::Create(csParam);
-
-      init = true;
-    }
+    // the temporaries are checked out of the workspace for the duration of the solve
+    ColorSpinorParam csParam(x);
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    WorkspaceField yp(csParam); // y accumulates the solution so must start zeroed
+    csParam.create = QUDA_NULL_FIELD_CREATE;
+    WorkspaceField rp(csParam);
+    csParam.setPrecision(param.precision_sloppy);
+    WorkspaceField pp(csParam);
+    WorkspaceField vp(csParam);
+    WorkspaceField tmpp(csParam);
+    WorkspaceField tp(csParam);
 
     ColorSpinorField &y = *yp;
     ColorSpinorField &r = *rp; 
@@ -117,17 +103,17 @@ namespace quda {
       else
       {
         ColorSpinorParam csParam(r);
-        csParam.create = QUDA_ZERO_FIELD_CREATE;
-        r_0 = ColorSpinorField::Create(csParam);//remember to delete this pointer.
+        csParam.create = QUDA_NULL_FIELD_CREATE;
+        r_0 = workspace::checkout(csParam); // remember to check this field back in
         *r_0 = r;
       }
     } else {
       ColorSpinorParam csParam(x);
       csParam.setPrecision(param.precision_sloppy);
       csParam.create = QUDA_NULL_FIELD_CREATE;
-      r_sloppy = ColorSpinorField::Create(csParam);
+      r_sloppy = workspace::checkout(csParam);
       *r_sloppy = r;
-      r_0 = ColorSpinorField::Create(csParam);
+      r_0 = workspace::checkout(csParam);
       *r_0 = r;
     }
 
@@ -141,7 +127,7 @@ namespace quda {
       ColorSpinorParam csParam(x);
       csParam.create = QUDA_ZERO_FIELD_CREATE;
       csParam.setPrecision(param.precision_sloppy);
-      x_sloppy = ColorSpinorField::Create(csParam);
+      x_sloppy = workspace::checkout(csParam);
     }
 
     // Syntatic sugar
@@ -310,6 +296,7 @@ namespace quda {
     if (k==param.maxiter) warningQuda("Exceeded maximum iterations %d", param.maxiter);
 
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("BiCGstab: Reliable updates = %d\n", rUpdate);
+    if (!param.is_preconditioner && telemetry::active()) telemetry::counter("reliable_updates", rUpdate);
   
     if (!param.is_preconditioner) { // do not do the below if we this is an inner solver
       // Calculate the true residual
@@ -333,15 +320,15 @@ namespace quda {
 
     profile.TPSTART(QUDA_PROFILE_FREE);
     if (param.precision_sloppy != x.Precision()) {
-      delete r_0;
-      delete r_sloppy;
+      workspace::checkin(r_0);
+      workspace::checkin(r_sloppy);
     }
     else if(param.compute_null_vector == QUDA_COMPUTE_NULL_VECTOR_YES) 
     {
-      delete r_0;
+      workspace::checkin(r_0);
     }
 
-    if (&x != &xSloppy) delete x_sloppy;
+    if (&x != &xSloppy) workspace::checkin(x_sloppy);
 
     profile.TPSTOP(QUDA_PROFILE_FREE);
     
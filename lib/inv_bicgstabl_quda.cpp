@@ -683,6 +683,7 @@ namespace quda {
 
     // Print number of reliable updates.
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("%s: Reliable updates = %d\n", solver_name.c_str(), rUpdate);
+    if (!param.is_preconditioner && telemetry::active()) telemetry::counter("reliable_updates", rUpdate);
 
     // compute the true residual
     // !param.is_preconditioner comes from bicgstab, param.compute_true_res came from gcr.
@@ -695,6 +696,7 @@ namespace quda {
     }
     
     // Reset flops counters.
+    unsigned long long blas_flops = blas::flops;
     blas::flops = 0;
     mat.flops();
     
@@ -710,7 +712,7 @@ namespace quda {
     profile.TPSTART(QUDA_PROFILE_FREE);
     
     // ...yup...
-    PrintSummary(solver_name.c_str(), k, r2, b2, stop, param.tol_hq);
+    PrintSummary(solver_name.c_str(), k, r2, b2, stop, param.tol_hq, blas_flops);
     
     // Done!
     profile.TPSTOP(QUDA_PROFILE_FREE);
@@ -503,9 +503,10 @@ namespace quda {
         deflate_compute = false;
       }
       if (recompute_evals) {
-        eig_solve->computeEvals(matEig, evecs, evals);
+        computeDeflationEvals();
         recompute_evals = false;
       }
+      compressDeflationSpace();
     }
 
     // compute intitial residual depending on whether we have an initial guess or not
@@ -526,7 +527,7 @@ namespace quda {
 
     if (param.deflate && param.maxiter > 1) {
       // Deflate and add solution to accumulator
-      eig_solve->deflate(x, r_, evecs, evals, true);
+      deflate(x, r_, true);
 
       mat(r_, x, tmp, tmp2);
       if (!fixed_iteration) {
@@ -732,7 +733,7 @@ namespace quda {
 
         if (param.deflate && sqrt(r2) < maxr_deflate * param.tol_restart) {
           // Deflate and add solution to accumulator
-          eig_solve->deflate(x, r_, evecs, evals, true);
+          deflate(x, r_, true);
 
           // Compute r_defl = RHS - A * LHS
           mat(r_, x, tmp, tmp2);
@@ -769,6 +770,7 @@ namespace quda {
 
     // Print number of reliable updates.
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("%s: Reliable updates = %d\n", "CA-CG", rUpdate);
+    if (!param.is_preconditioner && telemetry::active()) telemetry::counter("reliable_updates", rUpdate);
 
     if (param.compute_true_res) {
       // Calculate the true residual
@@ -781,6 +783,7 @@ namespace quda {
       if (param.return_residual) blas::copy(b, *Q[0]);
     }
 
+    unsigned long long blas_flops = blas::flops; // for the summary, since the counters are reset below
     if (!param.is_preconditioner) {
       qudaDeviceSynchronize(); // ensure solver is complete before ending timing
       profile.TPSTOP(QUDA_PROFILE_COMPUTE);
@@ -803,7 +806,7 @@ namespace quda {
       profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
     }
 
-    PrintSummary("CA-CG", total_iter, r2, b2, stop, param.tol_hq);
+    PrintSummary("CA-CG", total_iter, r2, b2, stop, param.tol_hq, blas_flops);
   }
 
 } // namespace quda
@@ -385,6 +385,7 @@ namespace quda {
       warningQuda("Exceeded maximum iterations %d", param.maxiter);
 
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("CA-GCR: number of restarts = %d\n", restart);
+    if (!param.is_preconditioner && telemetry::active()) telemetry::counter("restarts", restart);
 
     if (param.compute_true_res) {
       // Calculate the true residual
@@ -397,6 +398,7 @@ namespace quda {
       if (param.return_residual) blas::copy(b, r);
     }
 
+    unsigned long long blas_flops = blas::flops; // for the summary, since the counters are reset below
     if (!param.is_preconditioner) {
       qudaDeviceSynchronize(); // ensure solver is complete before ending timing
       profile.TPSTOP(QUDA_PROFILE_COMPUTE);
@@ -419,7 +421,7 @@ namespace quda {
       profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
     }
 
-    PrintSummary("CA-GCR", total_iter, r2, b2, stop, param.tol_hq);
+    PrintSummary("CA-GCR", total_iter, r2, b2, stop, param.tol_hq, blas_flops);
   }
 
 } // namespace quda
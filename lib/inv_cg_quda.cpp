@@ -13,6 +13,7 @@
 #include <util_quda.h>
 #include <eigensolve_quda.h>
 #include <eigen_helper.h>
+#include <workspace.h>
 
 namespace quda {
 
@@ -37,7 +38,6 @@ namespace quda {
   {
     if (!param.is_preconditioner) profile.TPSTART(QUDA_PROFILE_FREE);
     if ( init ) {
-      for (auto pi : p) if (pi) delete pi;
       if (rp) delete rp;
       if (pp) delete pp;
       if (yp) delete yp;
@@ -53,9 +53,8 @@ namespace quda {
       }
       if (rnewp) delete rnewp;
       init = false;
-
-      destroyDeflationSpace();
     }
+    destroyDeflationSpace();
     if (!param.is_preconditioner) profile.TPSTOP(QUDA_PROFILE_FREE);
   }
 
@@ -254,37 +253,44 @@ namespace quda {
       return;
     }
 
-    if (!init) {
+    // the temporaries are checked out of the workspace for the duration of the solve
+    std::vector<ColorSpinorField *> fields;
+    auto checkout = [&](const ColorSpinorParam &cs_param) {
+      fields.push_back(workspace::checkout(cs_param));
+      return fields.back();
+    };
+
+    ColorSpinorField *rp, *yp, *App, *tmpp, *tmp2p, *tmp3p, *rSloppyp, *xSloppyp = nullptr;
+    std::vector<ColorSpinorField *> p(Np);
+    {
       ColorSpinorParam csParam(x);
       csParam.create = QUDA_NULL_FIELD_CREATE;
-      rp = ColorSpinorField::Create(csParam);
-      yp = ColorSpinorField::Create(csParam);
+      rp = checkout(csParam);
+      yp = checkout(csParam);
 
       // sloppy fields
       csParam.setPrecision(param.precision_sloppy);
-      App = ColorSpinorField::Create(csParam);
+      App = checkout(csParam);
       if(param.precision != param.precision_sloppy) {
-	rSloppyp = ColorSpinorField::Create(csParam);
-	xSloppyp = ColorSpinorField::Create(csParam);
+	rSloppyp = checkout(csParam);
+	xSloppyp = checkout(csParam);
       } else {
 	rSloppyp = rp;
 	param.use_sloppy_partial_accumulator = false;
       }
+      for (auto &pi : p) pi = checkout(csParam);
 
       // temporary fields
-      tmpp = ColorSpinorField::Create(csParam);
+      tmpp = checkout(csParam);
       if(!mat.isStaggered()) {
 	// tmp2 only needed for multi-gpu Wilson-like kernels
-	tmp2p = ColorSpinorField::Create(csParam);
+	tmp2p = checkout(csParam);
 	// additional high-precision temporary if Wilson and mixed-precision
 	csParam.setPrecision(param.precision);
-	tmp3p = (param.precision != param.precision_sloppy) ?
-	  ColorSpinorField::Create(csParam) : tmpp;
+	tmp3p = (param.precision != param.precision_sloppy) ? checkout(csParam) : tmpp;
       } else {
 	tmp3p = tmp2p = tmpp;
       }
-
-      init = true;
     }
 
     if (param.deflate) {
@@ -298,9 +304,10 @@ namespace quda {
         deflate_compute = false;
       }
       if (recompute_evals) {
-        eig_solve->computeEvals(matEig, evecs, evals);
+        computeDeflationEvals();
         recompute_evals = false;
       }
+      compressDeflationSpace();
     }
 
     ColorSpinorField &r = *rp;
@@ -312,18 +319,6 @@ namespace quda {
     ColorSpinorField &rSloppy = *rSloppyp;
     ColorSpinorField &xSloppy = param.use_sloppy_partial_accumulator ? *xSloppyp : x;
 
-    {
-      ColorSpinorParam csParam(r);
-      csParam.create = QUDA_NULL_FIELD_CREATE;
-      csParam.setPrecision(param.precision_sloppy);
-
-      if (Np != (int)p.size()) {
-	for (auto &pi : p) delete pi;
-	p.resize(Np);
-	for (auto &pi : p) pi = ColorSpinorField::Create(csParam);
-      }
-    }
-
     // alternative reliable updates
     // alternative reliable updates - set precision - does not hurt performance here
 
@@ -370,7 +365,7 @@ namespace quda {
 
     if (param.deflate && param.maxiter > 1) {
       // Deflate and accumulate to solution vector
-      eig_solve->deflate(y, r, evecs, evals, true);
+      deflate(y, r, true);
       mat(r, y, x, tmp3);
       r2 = blas::xmyNorm(b, r);
     }
@@ -379,16 +374,7 @@ namespace quda {
     if (&x != &xSloppy) blas::zero(xSloppy);
     blas::copy(rSloppy,r);
 
-    if (Np != (int)p.size()) {
-      for (auto &pi : p) delete pi;
-      p.resize(Np);
-      ColorSpinorParam csParam(rSloppy);
-      csParam.create = QUDA_COPY_FIELD_CREATE;
-      for (auto &pi : p)
-        pi = p_init ? ColorSpinorField::Create(*p_init, csParam) : ColorSpinorField::Create(rSloppy, csParam);
-    } else {
-      for (auto &p_i : p) *p_i = p_init ? *p_init : rSloppy;
-    }
+    for (auto &p_i : p) *p_i = p_init ? *p_init : rSloppy;
 
     double r2_old=0.0;
     if (r2_old_init != 0.0 and p_init) {
@@ -607,7 +593,7 @@ namespace quda {
 
         if (param.deflate && sqrt(r2) < maxr_deflate * param.tol_restart) {
           // Deflate and accumulate to solution vector
-          eig_solve->deflate(y, r, evecs, evals, true);
+          deflate(y, r, true);
 
           // Compute r_defl = RHS - A * LHS
           mat(r, y, x, tmp3);
@@ -754,6 +740,7 @@ namespace quda {
 
     if (getVerbosity() >= QUDA_VERBOSE)
       printfQuda("CG: Reliable updates = %d\n", rUpdate);
+    if (!param.is_preconditioner && telemetry::active()) telemetry::counter("reliable_updates", rUpdate);
 
     if (param.compute_true_res) {
       // compute the true residuals
@@ -774,6 +761,8 @@ namespace quda {
       profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
     }
 
+    for (auto f : fields) workspace::checkin(f);
+
     if (param.is_preconditioner && param.global_reduction == false) commGlobalReductionSet(true);
   }
 
@@ -10,6 +10,7 @@
 #include <invert_quda.h>
 #include <util_quda.h>
 #include <color_spinor_field.h>
+#include <workspace.h>
 
 #include <sys/time.h>
 
@@ -168,7 +169,6 @@ namespace quda {
     K(0),
     Kparam(param),
     n_krylov(param.Nkrylov),
-    init(false),
     rp(nullptr),
     tmpp(nullptr),
     tmp_sloppy(nullptr),
@@ -207,7 +207,6 @@ namespace quda {
     K(&K),
     Kparam(param),
     n_krylov(param.Nkrylov),
-    init(false),
     rp(nullptr),
     tmpp(nullptr),
     tmp_sloppy(nullptr),
@@ -232,19 +231,6 @@ namespace quda {
 
     if (K && param.inv_type_precondition != QUDA_MG_INVERTER) delete K;
 
-    if (init && param.precision_sloppy != tmpp->Precision()) {
-      if (r_sloppy && r_sloppy != rp) delete r_sloppy;
-    }
-
-    for (int i = 0; i < n_krylov + 1; i++)
-      if (p[i]) delete p[i];
-    for (int i = 0; i < n_krylov; i++)
-      if (Ap[i]) delete Ap[i];
-
-    if (tmp_sloppy != tmpp) delete tmp_sloppy;
-    if (tmpp) delete tmpp;
-    if (rp) delete rp;
-
     destroyDeflationSpace();
 
     profile.TPSTOP(QUDA_PROFILE_FREE);
@@ -260,34 +246,28 @@ namespace quda {
 
     profile.TPSTART(QUDA_PROFILE_INIT);
 
-    if (!init) {
+    {
+      // the Krylov space and temporaries are checked out of the workspace for the duration of the solve
       ColorSpinorParam csParam(x);
       csParam.create = QUDA_NULL_FIELD_CREATE;
 
-      rp = (K || x.Precision() != param.precision_sloppy) ? ColorSpinorField::Create(csParam) : nullptr;
+      rp = (K || x.Precision() != param.precision_sloppy) ? workspace::checkout(csParam) : nullptr;
 
       // high precision temporary
-      tmpp = ColorSpinorField::Create(csParam);
+      tmpp = workspace::checkout(csParam);
 
       // create sloppy fields used for orthogonalization
       csParam.setPrecision(param.precision_sloppy);
-      for (int i = 0; i < n_krylov + 1; i++) p[i] = ColorSpinorField::Create(csParam);
-      for (int i = 0; i < n_krylov; i++) Ap[i] = ColorSpinorField::Create(csParam);
+      for (int i = 0; i < n_krylov + 1; i++) p[i] = workspace::checkout(csParam);
+      for (int i = 0; i < n_krylov; i++) Ap[i] = workspace::checkout(csParam);
 
-      csParam.setPrecision(param.precision_sloppy);
       if (param.precision_sloppy != x.Precision()) {
         tmp_sloppy = tmpp->CreateAlias(csParam);
+        r_sloppy = K ? workspace::checkout(csParam) : nullptr;
       } else {
         tmp_sloppy = tmpp;
-      }
-
-      if (param.precision_sloppy != x.Precision()) {
-        r_sloppy = K ? ColorSpinorField::Create(csParam) : nullptr;
-      } else {
         r_sloppy = K ? rp : nullptr;
       }
-
-      init = true;
     }
 
     if (param.deflate) {
@@ -356,6 +336,7 @@ namespace quda {
 	x = b;
 	param.true_res = 0.0;
 	param.true_res_hq = 0.0;
+	release();
 	return;
       } else {
 	b2 = r2;
@@ -513,6 +494,7 @@ namespace quda {
       warningQuda("Exceeded maximum iterations %d", param.maxiter);
 
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("GCR: number of restarts = %d\n", restart);
+    if (!param.is_preconditioner && telemetry::active()) telemetry::counter("restarts", restart);
 
     if (param.compute_true_res) {
       // Calculate the true residual
@@ -533,6 +515,7 @@ namespace quda {
     param.iter += total_iter;
 
     // reset the flops counters
+    unsigned long long blas_flops = blas::flops;
     blas::flops = 0;
     mat.flops();
     matSloppy.flops();
@@ -542,11 +525,27 @@ namespace quda {
     profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
     profile.TPSTART(QUDA_PROFILE_FREE);
 
-    PrintSummary("GCR", total_iter, r2, b2, stop, param.tol_hq);
+    PrintSummary("GCR", total_iter, r2, b2, stop, param.tol_hq, blas_flops);
+
+    release();
 
     profile.TPSTOP(QUDA_PROFILE_FREE);
 
     return;
   }
 
+  void GCR::release()
+  {
+    if (r_sloppy != rp) workspace::checkin(r_sloppy);
+    if (tmp_sloppy != tmpp) delete tmp_sloppy;
+    for (auto &pi : p) workspace::checkin(pi);
+    for (auto &Api : Ap) workspace::checkin(Api);
+    workspace::checkin(tmpp);
+    workspace::checkin(rp);
+
+    for (auto &pi : p) pi = nullptr;
+    for (auto &Api : Ap) Api = nullptr;
+    rp = tmpp = tmp_sloppy = r_sloppy = nullptr;
+  }
+
 } // namespace quda
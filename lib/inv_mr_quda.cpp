@@ -10,36 +10,19 @@
 #include <invert_quda.h>
 #include <util_quda.h>
 #include <color_spinor_field.h>
+#include <workspace.h>
 
 namespace quda {
 
   MR::MR(const DiracMatrix &mat, const DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile) :
-    Solver(mat, matSloppy, matSloppy, matSloppy, param, profile),
-    rp(nullptr),
-    r_sloppy(nullptr),
-    Arp(nullptr),
-    tmpp(nullptr),
-    tmp_sloppy(nullptr),
-    x_sloppy(nullptr),
-    init(false)
+    Solver(mat, matSloppy, matSloppy, matSloppy, param, profile)
   {
     if (param.schwarz_type == QUDA_MULTIPLICATIVE_SCHWARZ && param.Nsteps % 2 == 1) {
       errorQuda("For multiplicative Schwarz, number of solver steps %d must be even", param.Nsteps);
     }
   }
 
-  MR::~MR() {
-    if (!param.is_preconditioner) profile.TPSTART(QUDA_PROFILE_FREE);
-    if (init) {
-      if (x_sloppy) delete x_sloppy;
-      if (tmp_sloppy) delete tmp_sloppy;
-      if (tmpp) delete tmpp;
-      if (Arp) delete Arp;
-      if (r_sloppy) delete r_sloppy;
-      if (rp) delete rp;
-    }
-    if (!param.is_preconditioner) profile.TPSTOP(QUDA_PROFILE_FREE);
-  }
+  MR::~MR() { }
 
   void MR::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
@@ -50,34 +33,33 @@ namespace quda {
       return;
     }
 
-    if (!init) {
-      bool mixed = param.precision != param.precision_sloppy;
-
-      ColorSpinorParam csParam(x);
-      csParam.create = QUDA_NULL_FIELD_CREATE;
+    bool mixed = param.precision != param.precision_sloppy;
 
-      // Source needs to be preserved if we're computing the true residual
-      rp = (param.use_init_guess == QUDA_USE_INIT_GUESS_YES || param.preserve_source == QUDA_PRESERVE_SOURCE_YES
-	    || param.Nsteps > 1 || param.compute_true_res == 1) ?
-	ColorSpinorField::Create(csParam) : nullptr;
+    ColorSpinorParam csParam(x);
+    csParam.create = QUDA_NULL_FIELD_CREATE;
 
-      tmpp = (param.use_init_guess == QUDA_USE_INIT_GUESS_YES || param.Nsteps > 1 || param.compute_true_res) ?
-	ColorSpinorField::Create(csParam) : nullptr;
+    // Source needs to be preserved if we're computing the true residual
+    ColorSpinorField *rp = (param.use_init_guess == QUDA_USE_INIT_GUESS_YES
+                            || param.preserve_source == QUDA_PRESERVE_SOURCE_YES || param.Nsteps > 1
+                            || param.compute_true_res == 1) ?
+      workspace::checkout(csParam) :
+      nullptr;
 
-      // now allocate sloppy fields
-      csParam.setPrecision(param.precision_sloppy);
+    ColorSpinorField *tmpp = (param.use_init_guess == QUDA_USE_INIT_GUESS_YES || param.Nsteps > 1 || param.compute_true_res) ?
+      workspace::checkout(csParam) :
+      nullptr;
 
-      r_sloppy = mixed ? ColorSpinorField::Create(csParam) : nullptr;  // we need a separate sloppy residual vector
-      Arp = ColorSpinorField::Create(csParam);
+    // now check out sloppy fields
+    csParam.setPrecision(param.precision_sloppy);
 
-      //sloppy temporary for mat-vec
-      tmp_sloppy = (!tmpp || mixed) ? ColorSpinorField::Create(csParam) : nullptr;
+    ColorSpinorField *r_sloppy = mixed ? workspace::checkout(csParam) : nullptr; // we need a separate sloppy residual vector
+    ColorSpinorField *Arp = workspace::checkout(csParam);
 
-      //  iterated sloppy solution vector
-      x_sloppy = ColorSpinorField::Create(csParam);
+    //sloppy temporary for mat-vec
+    ColorSpinorField *tmp_sloppy = (!tmpp || mixed) ? workspace::checkout(csParam) : nullptr;
 
-      init = true;
-    } // init
+    //  iterated sloppy solution vector
+    ColorSpinorField *x_sloppy = workspace::checkout(csParam);
 
     ColorSpinorField &r = rp ? *rp : b;
     ColorSpinorField &rSloppy = r_sloppy ? *r_sloppy : r;
@@ -218,7 +200,7 @@ namespace quda {
       profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
     }
 
-    return;
+    for (auto f : {rp, tmpp, r_sloppy, Arp, tmp_sloppy, x_sloppy}) workspace::checkin(f);
   }
 
 } // namespace quda
@@ -475,6 +475,7 @@ namespace quda {
 
       if (getVerbosity() >= QUDA_VERBOSE) 
 	printfQuda("MultiShift CG: %d iterations, <r,r> = %e, |r|/|b| = %e\n", k, r2[0], sqrt(r2[0]/b2));
+      if (telemetry::active()) telemetry::residual(k, r2[0], b2, 0.0);
     }
     
     for (int i=0; i<num_offset; i++) {
@@ -488,6 +489,7 @@ namespace quda {
 
     if (getVerbosity() >= QUDA_VERBOSE)
       printfQuda("MultiShift CG: Reliable updates = %d\n", rUpdate);
+    if (!param.is_preconditioner && telemetry::active()) telemetry::counter("reliable_updates", rUpdate);
 
     if (k==param.maxiter) warningQuda("Exceeded maximum iterations %d\n", param.maxiter);
     
@@ -495,6 +497,7 @@ namespace quda {
     double gflops = (blas::flops + mat.flops() + matSloppy.flops())*1e-9;
     param.gflops = gflops;
     param.iter += k;
+    if (telemetry::active()) telemetry::solve("MultiShift CG", k, blas::flops);
 
     if (param.compute_true_res){
       // only allocate temporaries if necessary
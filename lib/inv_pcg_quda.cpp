@@ -117,9 +117,10 @@ namespace quda
         deflate_compute = false;
       }
       if (recompute_evals) {
-        eig_solve->computeEvals(matEig, evecs, evals);
+        computeDeflationEvals();
         recompute_evals = false;
       }
+      compressDeflationSpace();
     }
 
     cudaColorSpinorField *minvrPre = NULL;
@@ -171,7 +172,7 @@ namespace quda
 
     if (param.deflate && param.maxiter > 1) {
       // Deflate and accumulate to solution vector
-      eig_solve->deflate(y, r, evecs, evals, true);
+      deflate(y, r, true);
       mat(r, y, x, tmp3);
       r2 = blas::xmyNorm(b, r);
     }
@@ -311,7 +312,7 @@ namespace quda
 
         if (param.deflate && sqrt(r2) < maxr_deflate * param.tol_restart) {
           // Deflate and accumulate to solution vector
-          eig_solve->deflate(y, r, evecs, evals, true);
+          deflate(y, r, true);
 
           // Compute r_defl = RHS - A * LHS
           mat(r, y, x, tmp3);
@@ -382,6 +383,7 @@ namespace quda
     if (k == param.maxiter) warningQuda("Exceeded maximum iterations %d", param.maxiter);
 
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("PCG: Reliable updates = %d\n", rUpdate);
+    if (!param.is_preconditioner && telemetry::active()) telemetry::counter("reliable_updates", rUpdate);
 
     // compute the true residual
     mat(r, x, y, tmp3);
@@ -0,0 +1,160 @@
+#include <cstdint>
+#include <cstring>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <comm_quda.h>
+#include <malloc_quda.h>
+#include <mg_checkpoint.h>
+
+namespace quda
+{
+
+  namespace
+  {
+
+    constexpr char checkpoint_magic[8] = {'Q', 'U', 'D', 'A', 'M', 'G', 'C', '1'};
+
+    struct FileHeader {
+      char magic[8];
+      int32_t level;
+      int32_t n_rank;
+    };
+
+    struct RecordHeader {
+      char name[32];
+      uint64_t size;
+      uint64_t norm_size;
+      double scale;
+    };
+
+  } // namespace
+
+  MGCheckpoint::MGCheckpoint(const std::string &prefix, int level, bool write) :
+    filename(prefix + "_level_" + std::to_string(level) + ".rank" + std::to_string(comm_rank())),
+    file(nullptr),
+    writing(write),
+    bytes(0)
+  {
+    file = fopen(filename.c_str(), writing ? "wb" : "rb");
+    if (!file) errorQuda("Cannot open multigrid checkpoint %s", filename.c_str());
+
+    FileHeader header = {};
+    if (writing) {
+      memcpy(header.magic, checkpoint_magic, sizeof(checkpoint_magic));
+      header.level = level;
+      header.n_rank = comm_size();
+      if (fwrite(&header, sizeof(header), 1, file) != 1)
+        errorQuda("Failed to write multigrid checkpoint %s", filename.c_str());
+    } else {
+      if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, checkpoint_magic, sizeof(checkpoint_magic)))
+        errorQuda("%s is not a multigrid checkpoint", filename.c_str());
+      if (header.level != level) errorQuda("Checkpoint %s is for level %d not %d", filename.c_str(), header.level, level);
+      if (header.n_rank != comm_size())
+        errorQuda("Checkpoint %s was written with %d ranks, running with %d", filename.c_str(), header.n_rank,
+                  comm_size());
+    }
+
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("%s multigrid checkpoint %s\n", writing ? "Writing" : "Restoring", filename.c_str());
+  }
+
+  MGCheckpoint::~MGCheckpoint()
+  {
+    if (fclose(file) != 0) errorQuda("Failed to close multigrid checkpoint %s", filename.c_str());
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("%s %lu bytes %s %s\n", writing ? "Wrote" : "Read", bytes, writing ? "to" : "from", filename.c_str());
+  }
+
+  void MGCheckpoint::write(const char *name, const void *data, size_t size, const void *norm, size_t norm_size,
+                           double scale, bool device)
+  {
+    if (!writing) errorQuda("Checkpoint %s is open for reading", filename.c_str());
+    if (strlen(name) >= sizeof(RecordHeader::name)) errorQuda("Record name %s too long", name);
+
+    RecordHeader header = {};
+    strcpy(header.name, name);
+    header.size = size;
+    header.norm_size = norm_size;
+    header.scale = scale;
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    if (device) {
+      void *buffer = pool_pinned_malloc(size + norm_size);
+      qudaMemcpy(buffer, data, size, cudaMemcpyDeviceToHost);
+      if (norm_size) qudaMemcpy(static_cast<char *>(buffer) + size, norm, norm_size, cudaMemcpyDeviceToHost);
+      ok = ok && fwrite(buffer, 1, size + norm_size, file) == size + norm_size;
+      pool_pinned_free(buffer);
+    } else {
+      ok = ok && fwrite(data, 1, size, file) == size;
+      if (norm_size) ok = ok && fwrite(norm, 1, norm_size, file) == norm_size;
+    }
+
+    if (!ok) errorQuda("Failed to write record %s to %s", name, filename.c_str());
+    bytes += size + norm_size;
+  }
+
+  double MGCheckpoint::read(const char *name, void *data, size_t size, void *norm, size_t norm_size, bool device)
+  {
+    if (writing) errorQuda("Checkpoint %s is open for writing", filename.c_str());
+
+    RecordHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1)
+      errorQuda("Failed to read record %s from %s", name, filename.c_str());
+    header.name[sizeof(header.name) - 1] = '\0';
+    if (strcmp(header.name, name) != 0)
+      errorQuda("Expected record %s in %s but found %s", name, filename.c_str(), header.name);
+    if (header.size != size || header.norm_size != norm_size)
+      errorQuda("Record %s in %s has size %lu + %lu, expected %lu + %lu (have the multigrid parameters changed?)", name,
+                filename.c_str(), header.size, header.norm_size, size, norm_size);
+
+    bool ok = true;
+    if (device) {
+      void *buffer = pool_pinned_malloc(size + norm_size);
+      ok = fread(buffer, 1, size + norm_size, file) == size + norm_size;
+      qudaMemcpy(data, buffer, size, cudaMemcpyHostToDevice);
+      if (norm_size) qudaMemcpy(norm, static_cast<char *>(buffer) + size, norm_size, cudaMemcpyHostToDevice);
+      pool_pinned_free(buffer);
+    } else {
+      ok = fread(data, 1, size, file) == size;
+      if (norm_size) ok = ok && fread(norm, 1, norm_size, file) == norm_size;
+    }
+
+    if (!ok) errorQuda("Failed to read record %s from %s", name, filename.c_str());
+    bytes += size + norm_size;
+    return header.scale;
+  }
+
+  void MGCheckpoint::save(const char *name, const ColorSpinorField &v)
+  {
+    write(name, v.V(), v.Bytes(), v.Norm(), v.NormBytes(), v.Scale(), v.Location() == QUDA_CUDA_FIELD_LOCATION);
+  }
+
+  void MGCheckpoint::load(const char *name, ColorSpinorField &v)
+  {
+    v.Scale(read(name, v.V(), v.Bytes(), v.Norm(), v.NormBytes(), v.Location() == QUDA_CUDA_FIELD_LOCATION));
+  }
+
+  void MGCheckpoint::save(const char *name, const GaugeField &u)
+  {
+    if (u.Location() != QUDA_CUDA_FIELD_LOCATION) errorQuda("Only device gauge fields can be checkpointed");
+    write(name, u.Gauge_p(), u.Bytes(), nullptr, 0, u.Scale(), true);
+  }
+
+  void MGCheckpoint::load(const char *name, GaugeField &u)
+  {
+    if (u.Location() != QUDA_CUDA_FIELD_LOCATION) errorQuda("Only device gauge fields can be restored");
+    u.Scale(read(name, u.Gauge_p(), u.Bytes(), nullptr, 0, true));
+  }
+
+  void MGCheckpoint::save(const char *name, int n) { write(name, &n, sizeof(n), nullptr, 0, 1.0, false); }
+
+  int MGCheckpoint::load(const char *name)
+  {
+    int n;
+    read(name, &n, sizeof(n), nullptr, 0, false);
+    return n;
+  }
+
+} // namespace quda
@@ -13,6 +13,25 @@ namespace quda {
 
     qudaStream_t* getStream();
 
+    /**
+       @brief Sum the local multi-reduce results over all processes.
+       In compensated mode the per-process results are promoted to
+       compensated values so that the sum over processes is
+       compensated as well.
+       @param[in,out] result Array of local results, overwritten with the global sums
+       @param[in] len Length of the array
+    */
+    void reduceMultiArray(double *result, const int len)
+    {
+#ifdef QUDA_REDUCE_COMPENSATED
+      std::vector<compensated> c(result, result + len);
+      reduceCompensatedArray(reinterpret_cast<double *>(c.data()), len);
+      for (int i = 0; i < len; i++) result[i] = c[i].value();
+#else
+      reduceDoubleArray(result, len);
+#endif
+    }
+
     template <int block_size, typename real, int len, int NXZ, typename Arg>
     typename std::enable_if<block_size!=32, qudaError_t>::type launch(Arg &arg, const TuneParam &tp, const qudaStream_t &stream)
     {
@@ -54,7 +73,7 @@ namespace quda {
 #endif
 
       std::vector<T> result_(NXZ * arg.NYW);
-      if (!commAsyncReduction()) arg.complete(result_, stream);
+      if (!commAsyncReduction()) arg.template complete<T, reduce_t>(result_, stream);
 
       // need to transpose for same order with vector thread reduction
       for (int i = 0; i < NXZ; i++) {
@@ -746,7 +765,7 @@ namespace quda {
 
       // do a single multi-node reduction only once we have computed all local dot products
       const int Nreduce = x.size() * y.size();
-      reduceDoubleArray(result_tmp, Nreduce);
+      reduceMultiArray(result_tmp, Nreduce);
 
       // multiReduce_recurse returns a column-major matrix.
       // To be consistent with the multi-blas functions, we should
@@ -799,7 +818,7 @@ namespace quda {
 
       // do a single multi-node reduction only once we have computed all local dot products
       const int Nreduce = 2*x.size()*y.size();
-      reduceDoubleArray((double*)result_tmp, Nreduce);
+      reduceMultiArray((double*)result_tmp, Nreduce);
 
       // multiReduce_recurse returns a column-major matrix.
       // To be consistent with the multi-blas functions, we should
@@ -827,7 +846,7 @@ namespace quda {
 
       // do a single multi-node reduction only once we have computed all local dot products
       const int Nreduce = 2*x.size()*y.size();
-      reduceDoubleArray((double*)result_tmp, Nreduce); // FIXME - could optimize this for Hermiticity as well
+      reduceMultiArray((double*)result_tmp, Nreduce); // FIXME - could optimize this for Hermiticity as well
 
       // Switch from col-major to row-major
       const unsigned int xlen = x.size();
@@ -856,7 +875,7 @@ namespace quda {
 
       // do a single multi-node reduction only once we have computed all local dot products
       const int Nreduce = 2*x.size()*y.size();
-      reduceDoubleArray((double*)result_tmp, Nreduce); // FIXME - could optimize this for Hermiticity as well
+      reduceMultiArray((double*)result_tmp, Nreduce); // FIXME - could optimize this for Hermiticity as well
 
       // Switch from col-major to row-major
       const unsigned int xlen = x.size();
@@ -891,7 +910,7 @@ namespace quda {
 
       // do a single multi-node reduction only once we have computed all local dot products
       const int Nreduce = 2*x.size()*y.size();
-      reduceDoubleArray((double*)result_tmp, Nreduce);
+      reduceMultiArray((double*)result_tmp, Nreduce);
 
       // Switch from col-major to row-major.
       const unsigned int xlen = x.size();
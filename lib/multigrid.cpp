@@ -2,6 +2,7 @@
 
 #include <multigrid.h>
 #include <vector_io.h>
+#include <mg_checkpoint.h>
 
 // for building the KD inverse op
 #include <staggered_kd_build_xinv.h>
@@ -44,7 +45,11 @@ namespace quda
     matCoarseResidual(nullptr),
     matCoarseSmoother(nullptr),
     matCoarseSmootherSloppy(nullptr),
-    rng(nullptr)
+    rng(nullptr),
+    coarse_solve_count(0),
+    coarse_solve_iter(0),
+    coarse_iter_baseline(-1.0),
+    restore(nullptr)
   {
     sprintf(prefix, "MG level %d (%s): ", param.level, param.location == QUDA_CUDA_FIELD_LOCATION ? "GPU" : "CPU");
     pushLevel(param.level);
@@ -78,11 +83,15 @@ namespace quda
     }
 
     rng = new RNG(*param.B[0], 1234);
-    rng->Init();
+
+    if (!param.checkpoint.empty() && param.level < param.Nlevel - 1)
+      restore = new MGCheckpoint(param.checkpoint, param.level, false);
 
     if (param.transfer_type == QUDA_TRANSFER_AGGREGATE) {
       if (param.level < param.Nlevel - 1) {
-        if (param.mg_global.compute_null_vector == QUDA_COMPUTE_NULL_VECTOR_YES) {
+        if (restore) {
+          for (auto b : param.B) restore->load("B", *b);
+        } else if (param.mg_global.compute_null_vector == QUDA_COMPUTE_NULL_VECTOR_YES) {
           if (param.mg_global.generate_all_levels == QUDA_BOOLEAN_TRUE || param.level == 0) {
 
             // Initializing to random vectors
@@ -132,12 +141,21 @@ namespace quda
     diracSmoother = param.matSmooth->Expose();
     diracSmootherSloppy = param.matSmoothSloppy->Expose();
 
+    // whether the transfer operator needs rebuilding due to a refresh
+    bool refresh_transfer = refresh;
+
     // Only refresh if we needed to generate near-nulls, that is,
     // if we aren't doing a staggered KD solve
     if (param.level != 0 || param.transfer_type == QUDA_TRANSFER_AGGREGATE) {
       // Refresh the null-space vectors if we need to
       if (refresh && param.level < param.Nlevel - 1) {
-        if (param.mg_global.setup_maxiter_refresh[param.level]) generateNullVectors(param.B, refresh);
+        if (param.mg_global.setup_maxiter_refresh[param.level]) {
+          if (param.mg_global.setup_refresh_adaptive[param.level] == QUDA_BOOLEAN_TRUE) {
+            refresh_transfer = refreshNullVectors();
+          } else {
+            generateNullVectors(param.B, refresh);
+          }
+        }
       }
     }
 
@@ -147,7 +165,7 @@ namespace quda
       if (transfer) {
         // restoring FULL parity in Transfer changed at the end of this procedure
         transfer->setSiteSubset(QUDA_FULL_SITE_SUBSET, QUDA_INVALID_PARITY);
-        if (resetTransfer || refresh) {
+        if (resetTransfer || refresh_transfer) {
           transfer->reset();
           resetTransfer = false;
         }
@@ -156,7 +174,7 @@ namespace quda
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Creating transfer operator\n");
         transfer = new Transfer(param.B, param.Nvec, param.NblockOrtho, param.geoBlockSize, param.spinBlockSize,
                                 param.mg_global.precision_null[param.level], param.mg_global.transfer_type[param.level],
-                                profile);
+                                profile, restore);
         for (int i=0; i<QUDA_MAX_MG_LEVEL; i++) param.mg_global.geo_block_size[param.level][i] = param.geoBlockSize[i];
 
         // create coarse temporary vector if not already created in verify()
@@ -243,6 +261,12 @@ namespace quda
     diracSmoother->prefetch(QUDA_CUDA_FIELD_LOCATION);
     diracSmootherSloppy->prefetch(QUDA_CUDA_FIELD_LOCATION);
 
+    // the checkpoint is only consumed by the initial setup
+    if (restore) {
+      delete restore;
+      restore = nullptr;
+    }
+
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Setup of level %d done\n", param.level);
 
     popLevel(param.level);
@@ -457,7 +481,8 @@ namespace quda
       diracParam.use_mma = param.use_mma;
 
       diracCoarseResidual = new DiracCoarse(diracParam, param.setup_location == QUDA_CUDA_FIELD_LOCATION ? true : false,
-                                            param.mg_global.setup_minimize_memory == QUDA_BOOLEAN_TRUE ? true : false);
+                                            param.mg_global.setup_minimize_memory == QUDA_BOOLEAN_TRUE ? true : false,
+                                            restore);
 
       // create smoothing operators
       diracParam.dirac = const_cast<Dirac *>(param.matSmooth->Expose());
@@ -637,10 +662,29 @@ namespace quda
 
       if (param.level == param.Nlevel - 2 && param.mg_global.use_eig_solver[param.level + 1]) {
 
+        // Restore a checkpointed deflation space, which is then transferred as a preserved one
+        if (restore) {
+          int n_defl = restore->load("n_defl");
+          if (n_defl > 0) {
+            ColorSpinorParam csParam(*r_coarse);
+            csParam.create = QUDA_NULL_FIELD_CREATE;
+            if (restore->load("defl_subset") == QUDA_PARITY_SITE_SUBSET) {
+              csParam.x[0] /= 2;
+              csParam.siteSubset = QUDA_PARITY_SITE_SUBSET;
+            }
+            csParam.setPrecision(static_cast<QudaPrecision>(restore->load("defl_precision")), QUDA_INVALID_PRECISION,
+                                 true);
+            for (int i = 0; i < n_defl; i++) {
+              evecs.push_back(ColorSpinorField::Create(csParam));
+              restore->load("defl", *evecs.back());
+            }
+          }
+        }
+
         // Test if a coarse grid deflation space needs to be transferred to the coarse solver to prevent recomputation
         int defl_size = evecs.size();
         auto &coarse_solver_inner = reinterpret_cast<PreconditionedSolver *>(coarse_solver)->ExposeSolver();
-        if (defl_size > 0 && transfer && param.mg_global.preserve_deflation) {
+        if (defl_size > 0 && transfer && (param.mg_global.preserve_deflation || restore)) {
           // We shall not recompute the deflation space, we shall transfer
           // vectors stored in the parent MG instead
           coarse_solver_inner.setDeflateCompute(false);
@@ -697,10 +741,7 @@ namespace quda
       if (param_postsmooth) delete param_postsmooth;
     }
 
-    if (rng) {
-      rng->Release();
-      delete rng;
-    }
+    if (rng) delete rng;
 
     if (presmoother) delete presmoother;
     if (param_presmooth) delete param_presmooth;
@@ -727,6 +768,7 @@ namespace quda
 
     if (param_coarse_solver) {
       flops += param_coarse_solver->gflops * 1e9;
+      if (telemetry::active()) telemetry::mgLevel(param.level + 1, "solver_flops", param_coarse_solver->gflops * 1e9);
       param_coarse_solver->gflops = 0;
     } else if (param.level < param.Nlevel-1) {
       flops += coarse->flops();
@@ -734,16 +776,20 @@ namespace quda
 
     if (param_presmooth) {
       flops += param_presmooth->gflops * 1e9;
+      if (telemetry::active()) telemetry::mgLevel(param.level, "smoother_flops", param_presmooth->gflops * 1e9);
       param_presmooth->gflops = 0;
     }
 
     if (param_postsmooth) {
       flops += param_postsmooth->gflops * 1e9;
+      if (telemetry::active()) telemetry::mgLevel(param.level, "smoother_flops", param_postsmooth->gflops * 1e9);
       param_postsmooth->gflops = 0;
     }
 
     if (transfer) {
-      flops += transfer->flops();
+      double transfer_flops = transfer->flops();
+      flops += transfer_flops;
+      if (telemetry::active()) telemetry::mgLevel(param.level, "transfer_flops", transfer_flops);
     }
 
     return flops;
@@ -1085,6 +1131,7 @@ namespace quda
 
   void MG::operator()(ColorSpinorField &x, ColorSpinorField &b) {
     pushOutputPrefix(prefix);
+    if (telemetry::active()) telemetry::mgLevel(param.level, "cycles", 1);
 
     if (param.level < param.Nlevel - 1) { // set parity for the solver in the transfer operator
       QudaSiteSubset site_subset
@@ -1165,7 +1212,13 @@ namespace quda
         if ( debug ) printfQuda("after pre-smoothing x2 = %e, r2 = %e, r_coarse2 = %e\n", norm2(x), r2, norm2(*r_coarse));
 
         // recurse to the next lower level
+        const int coarse_iter0 = param_coarse_solver ? param_coarse_solver->iter : 0;
         (*coarse_solver)(*x_coarse, *r_coarse);
+        if (param_coarse_solver) { // record the coarse-grid iteration count for adaptive refresh
+          coarse_solve_iter += param_coarse_solver->iter - coarse_iter0;
+          coarse_solve_count++;
+          if (telemetry::active()) telemetry::mgLevel(param.level, "coarse_iter", param_coarse_solver->iter - coarse_iter0);
+        }
         if (debug) printfQuda("after coarse solve x_coarse2 = %e r_coarse2 = %e\n", norm2(*x_coarse), norm2(*r_coarse));
 
         // prolongate back to this grid
@@ -1255,7 +1308,7 @@ namespace quda
       vec_outfile += std::to_string(param.level);
       vec_outfile += "_nvec_";
       vec_outfile += std::to_string(param.mg_global.n_vec[param.level]);
-      VectorIO io(vec_outfile);
+      VectorIO io(vec_outfile, false, param.mg_global.vec_archive[param.level] == QUDA_BOOLEAN_TRUE);
       io.save(B);
       popLevel(param.level);
       profile_global.TPSTOP(QUDA_PROFILE_IO);
@@ -1273,6 +1326,61 @@ namespace quda
     if (param.level < param.Nlevel - 2) coarse->dumpNullVectors();
   }
 
+  void MG::saveCheckpoint(const std::string &prefix) const
+  {
+    pushLevel(param.level);
+
+    {
+      MGCheckpoint checkpoint(prefix, param.level, true);
+
+      // records are written in the order the setup consumes them
+      if (param.transfer_type == QUDA_TRANSFER_AGGREGATE)
+        for (auto b : param.B) checkpoint.save("B", *b);
+      transfer->save(checkpoint);
+      if (diracCoarseResidual->getDiracType() == QUDA_COARSE_DIRAC)
+        static_cast<DiracCoarse *>(diracCoarseResidual)->save(checkpoint);
+
+      if (param.level == param.Nlevel - 2 && param.mg_global.use_eig_solver[param.level + 1]) {
+        auto &coarse_solver_inner = reinterpret_cast<PreconditionedSolver *>(coarse_solver)->ExposeSolver();
+        const auto &space = coarse_solver_inner.deflationSpace();
+        if (coarse_solver_inner.deflationSpaceSize() != (int)space.size()) {
+          warningQuda("Compressed coarse-grid deflation space will be recomputed on restore");
+          checkpoint.save("n_defl", 0);
+        } else {
+          checkpoint.save("n_defl", (int)space.size());
+          if (space.size() > 0) {
+            checkpoint.save("defl_subset", space[0]->SiteSubset());
+            checkpoint.save("defl_precision", space[0]->Precision());
+          }
+          for (auto e : space) checkpoint.save("defl", *e);
+        }
+      }
+    }
+
+    if (param.level < param.Nlevel - 2) coarse->saveCheckpoint(prefix);
+
+    popLevel(param.level);
+  }
+
+  /**
+     @brief Global Gram-Schmidt orthonormalization of a set of null-space vectors
+     @param[in,out] B The vectors to orthonormalize, in place
+  */
+  static void orthonormalizeNullVectors(std::vector<ColorSpinorField *> &B)
+  {
+    for (int i = 0; i < (int)B.size(); i++) {
+      for (int j = 0; j < i; j++) {
+        Complex alpha = cDotProduct(*B[j], *B[i]); // <j,i>
+        caxpy(-alpha, *B[j], *B[i]);               // i-<j,i>j
+      }
+      double nrm2 = norm2(*B[i]);
+      if (sqrt(nrm2) > 1e-16)
+        ax(1.0 / sqrt(nrm2), *B[i]); // i/<i,i>
+      else
+        errorQuda("\nCannot normalize %u vector (nrm=%e)\n", i, sqrt(nrm2));
+    }
+  }
+
   void MG::generateNullVectors(std::vector<ColorSpinorField *> &B, bool refresh)
   {
     pushLevel(param.level);
@@ -1403,17 +1511,7 @@ namespace quda
       }
 
       // global orthonormalization of the generated null-space vectors
-      if (param.mg_global.post_orthonormalize) {
-        for(int i=0; i<(int)B.size(); i++) {
-          for (int j=0; j<i; j++) {
-            Complex alpha = cDotProduct(*B[j], *B[i]);// <j,i>
-            caxpy(-alpha, *B[j], *B[i]); // i-<j,i>j
-          }
-          double nrm2 = norm2(*B[i]);
-          if (sqrt(nrm2) > 1e-16) ax(1.0/sqrt(nrm2), *B[i]);// i/<i,i>
-          else errorQuda("\nCannot normalize %u vector (nrm=%e)\n", i, sqrt(nrm2));
-        }
-      }
+      if (param.mg_global.post_orthonormalize) orthonormalizeNullVectors(B);
 
       if (solverParam.inv_type == QUDA_MG_INVERTER) {
 
@@ -1457,11 +1555,163 @@ namespace quda
       diracSmootherSloppy->setCommDim(commDim);
     }
 
-    if (param.mg_global.vec_store[param.level] == QUDA_BOOLEAN_TRUE) { // conditional store of null vectors
-      saveVectors(B);
+    // adaptive refresh may regenerate a subset of the vectors, so
+    // only store and set the refresh baseline for the complete set
+    if (&B == &param.B) {
+      if (param.mg_global.vec_store[param.level] == QUDA_BOOLEAN_TRUE) { // conditional store of null vectors
+        saveVectors(B);
+      }
+
+      if (param.mg_global.setup_refresh_adaptive[param.level] == QUDA_BOOLEAN_TRUE) {
+        null_residual = nullResidual();
+        coarse_iter_baseline = -1.0;
+      }
+      coarse_solve_count = 0;
+      coarse_solve_iter = 0;
+    }
+
+    popLevel(param.level);
+  }
+
+  std::vector<double> MG::nullResidual()
+  {
+    ColorSpinorParam csParam(*r);
+    csParam.create = QUDA_NULL_FIELD_CREATE;
+    ColorSpinorField *tmp1 = ColorSpinorField::Create(csParam);
+
+    std::vector<double> residual(param.B.size());
+
+    auto mat = dynamic_cast<const DiracM *>(param.matResidual);
+    if (mat && mat->Expose()->hasMultiRHS() && r->Location() == QUDA_CUDA_FIELD_LOCATION) {
+      // apply the operator to a batch of null-space vectors at once,
+      // taking the norms directly from the multi-RHS fields
+      constexpr int max_batch = 8;
+      for (auto i = 0u; i < param.B.size(); i += max_batch) {
+        const int n = std::min(static_cast<int>(param.B.size() - i), max_batch);
+        ColorSpinorParam batchParam(csParam);
+        batchParam.nDim = 5;
+        batchParam.x[4] = n;
+        batchParam.pc_type = QUDA_4D_PC;
+        ColorSpinorField *x = ColorSpinorField::Create(batchParam);
+        ColorSpinorField *y = ColorSpinorField::Create(batchParam);
+
+        for (int s = 0; s < n; s++) {
+          const ColorSpinorField &b = *param.B[i + s];
+          if (b.Location() == tmp1->Location() && b.Precision() == tmp1->Precision()
+              && b.GammaBasis() == tmp1->GammaBasis() && b.FieldOrder() == tmp1->FieldOrder()) {
+            copyMultiRHS(*x, b, s);
+          } else {
+            // as well as copying to the correct location this also changes basis if necessary
+            *tmp1 = b;
+            copyMultiRHS(*x, *tmp1, s);
+          }
+        }
+
+        mat->MultiRHS(*y, *x);
+
+        std::vector<double> x2, y2;
+        multiRHSNorm2(x2, *x);
+        multiRHSNorm2(y2, *y);
+        for (int s = 0; s < n; s++) residual[i + s] = sqrt(y2[s] / x2[s]);
+
+        delete y;
+        delete x;
+      }
+    } else {
+      ColorSpinorField *tmp2 = ColorSpinorField::Create(csParam);
+      for (auto i = 0u; i < param.B.size(); i++) {
+        // as well as copying to the correct location this also changes basis if necessary
+        *tmp1 = *param.B[i];
+        (*param.matResidual)(*tmp2, *tmp1);
+        residual[i] = sqrt(norm2(*tmp2) / norm2(*tmp1));
+      }
+      delete tmp2;
+    }
+
+    delete tmp1;
+
+    return residual;
+  }
+
+  std::vector<int> staleNullVectors(const std::vector<double> &residual, const std::vector<double> &baseline,
+                                    double tol, bool all)
+  {
+    if (residual.size() != baseline.size())
+      errorQuda("Residual count %lu does not match baseline count %lu", residual.size(), baseline.size());
+
+    std::vector<int> stale;
+    for (auto i = 0u; i < residual.size(); i++) {
+      if (all || residual[i] > tol * baseline[i]) stale.push_back(i);
+    }
+    return stale;
+  }
+
+  bool MG::refreshNullVectors()
+  {
+    pushLevel(param.level);
+
+    // mean coarse-grid iteration count since the last update: the
+    // first window following a setup defines the baseline
+    bool iter_growth = false;
+    if (coarse_solve_count > 0) {
+      double mean_iter = static_cast<double>(coarse_solve_iter) / coarse_solve_count;
+      if (coarse_iter_baseline < 0.0) {
+        coarse_iter_baseline = mean_iter;
+      } else {
+        iter_growth = mean_iter > param.mg_global.setup_refresh_iter_growth[param.level] * coarse_iter_baseline;
+      }
+      if (getVerbosity() >= QUDA_VERBOSE)
+        printfQuda("Mean coarse solver iterations = %g (baseline %g)\n", mean_iter, coarse_iter_baseline);
+    }
+    coarse_solve_count = 0;
+    coarse_solve_iter = 0;
+
+    // near-null residuals under the updated operator: if we have no
+    // baseline (e.g., vectors were loaded) then these define it
+    std::vector<double> residual = nullResidual();
+    if (null_residual.size() != residual.size()) null_residual = residual;
+
+    const double tol = param.mg_global.setup_refresh_tol[param.level];
+    bool refreshed = false;
+
+    for (int pass = 0; pass < param.mg_global.setup_refresh_max_pass[param.level]; pass++) {
+      std::vector<int> stale = staleNullVectors(residual, null_residual, tol, iter_growth && pass == 0);
+      if (stale.empty()) break;
+
+      if (getVerbosity() >= QUDA_SUMMARIZE)
+        printfQuda("Adaptive refresh pass %d: refreshing %lu of %lu null-space vectors\n", pass + 1, stale.size(),
+                   residual.size());
+
+      std::vector<ColorSpinorField *> B_stale;
+      for (auto i : stale) B_stale.push_back(param.B[i]);
+      generateNullVectors(B_stale, true);
+      refreshed = true;
+
+      residual = nullResidual();
+      if (getVerbosity() >= QUDA_VERBOSE)
+        for (auto i : stale)
+          printfQuda("Vector %d: near-null residual = %e (baseline %e)\n", i, residual[i], null_residual[i]);
+    }
+
+    if (refreshed) {
+      // refreshed vectors were only orthonormalized amongst themselves
+      if (param.mg_global.post_orthonormalize) orthonormalizeNullVectors(param.B);
+
+      if (param.mg_global.vec_store[param.level] == QUDA_BOOLEAN_TRUE) saveVectors(param.B);
+
+      // the refreshed null space defines the new residual baseline,
+      // else vectors that cannot regain their original quality under
+      // the updated operator would be refreshed on every update
+      null_residual = param.mg_global.post_orthonormalize ? nullResidual() : residual;
+
+      // the next window of coarse solves defines the new iteration baseline
+      coarse_iter_baseline = -1.0;
+    } else if (getVerbosity() >= QUDA_SUMMARIZE) {
+      printfQuda("Adaptive refresh: null space has not degraded, skipping refresh\n");
     }
 
     popLevel(param.level);
+    return refreshed;
   }
 
   // generate a full span of free vectors.
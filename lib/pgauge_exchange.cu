@@ -252,7 +252,12 @@ namespace quda {
   {
 #ifdef GPU_GAUGE_ALG
     if ( comm_dim_partitioned(0) || comm_dim_partitioned(1) || comm_dim_partitioned(2) || comm_dim_partitioned(3) ) {
-      instantiate<PGaugeExchanger>(data, dir, parity);
+      if (data.Location() == QUDA_CPU_FIELD_LOCATION) {
+        // the packing kernels are device only, so exchange the whole halo of host fields
+        data.exchangeExtendedGhost(data.R(), false);
+      } else {
+        instantiate<PGaugeExchanger>(data, dir, parity);
+      }
     }
 #else
     errorQuda("Pure gauge code has not been built");
@@ -11,6 +11,7 @@
 #include <index_helper.cuh>
 #include <atomic.cuh>
 #include <instantiate.h>
+#include <launch_host.h>
 
 #ifndef PI
 #define PI    3.1415926535897932384626433832795    // pi
@@ -84,10 +85,10 @@ namespace quda {
     @brief Generate full SU(2) matrix (four real numbers instead of 2x2 complex matrix) and update link matrix.
     Get from MILC code.
     @param al weight
-    @param localstate CURAND rng state
+    @param localstate rng state
  */
   template <class T>
-  __device__ static inline Matrix<T,2> generate_su2_matrix_milc(T al, cuRNGState& localState){
+  __host__ __device__ static inline Matrix<T,2> generate_su2_matrix_milc(T al, RNGState& localState){
     T xr1, xr2, xr3, xr4, d, r;
     int k;
     xr1 = Random<T>(localState);
@@ -293,11 +294,11 @@ namespace quda {
     @brief Link update by pseudo-heatbath
     @param U link to be updated
     @param F staple
-    @param localstate CURAND rng state
+    @param localstate rng state
   */
   template <class Float, int NCOLORS>
-  __device__ inline void heatBathSUN( Matrix<complex<Float>,NCOLORS>& U, Matrix<complex<Float>,NCOLORS> F,
-                                      cuRNGState& localState, Float BetaOverNc ){
+  __host__ __device__ inline void heatBathSUN( Matrix<complex<Float>,NCOLORS>& U, Matrix<complex<Float>,NCOLORS> F,
+                                               RNGState& localState, Float BetaOverNc ){
 
     if ( NCOLORS == 3 ) {
       //////////////////////////////////////////////////////////////////
@@ -428,7 +429,7 @@ namespace quda {
      @param F staple
    */
   template <class Float, int NCOLORS>
-  __device__ inline void overrelaxationSUN( Matrix<complex<Float>,NCOLORS>& U, Matrix<complex<Float>,NCOLORS> F ){
+  __host__ __device__ inline void overrelaxationSUN( Matrix<complex<Float>,NCOLORS>& U, Matrix<complex<Float>,NCOLORS> F ){
 
     if ( NCOLORS == 3 ) {
       //////////////////////////////////////////////////////////////////
@@ -584,61 +585,80 @@ namespace quda {
     }
   };
 
-  template<typename Float, typename Gauge, int NCOLORS, bool HeatbathOrRelax>
-  __global__ void compute_heatBath(MonteArg<Gauge, Float, NCOLORS> arg, int mu, int parity){
-    int idx = threadIdx.x + blockIdx.x * blockDim.x;
-    if ( idx >= arg.threads ) return;
-    int id = idx;
-    int X[4];
+  /**
+     @brief Heatbath or overrelaxation update of the links in
+     direction mu of one checkerboard.  The links updated concurrently
+     only depend on links that are not, so the sites of a checkerboard
+     may be updated in any order, by any number of threads, with the
+     same result.
+  */
+  template <typename Float, typename Gauge, int NCOLORS, bool HeatbathOrRelax> struct HeatBath {
+    MonteArg<Gauge, Float, NCOLORS> &arg;
+    const int mu;
+    const int parity;
+    __device__ __host__ HeatBath(MonteArg<Gauge, Float, NCOLORS> &arg, int mu, int parity) :
+      arg(arg), mu(mu), parity(parity) {}
+
+    __device__ __host__ inline void operator()(int idx, int = 0, int = 0) const
+    {
+      int X[4];
 #pragma unroll
-    for ( int dr = 0; dr < 4; ++dr ) X[dr] = arg.X[dr];
+      for ( int dr = 0; dr < 4; ++dr ) X[dr] = arg.X[dr];
 
-    int x[4];
-    getCoords(x, idx, X, parity);
+      int x[4];
+      getCoords(x, idx, X, parity);
+      const unsigned long long site = HeatbathOrRelax ? arg.rngstate.globalIndex(x) : 0;
 #pragma unroll
-    for ( int dr = 0; dr < 4; ++dr ) {
-      x[dr] += arg.border[dr];
-      X[dr] += 2 * arg.border[dr];
-    }
-    idx = linkIndex(x,X);
-
-    Matrix<complex<Float>,NCOLORS> staple;
-    setZero(&staple);
-
-    Matrix<complex<Float>,NCOLORS> U;
-    for ( int nu = 0; nu < 4; nu++ ) if ( mu != nu ) {
-        int dx[4] = { 0, 0, 0, 0 };
-        Matrix<complex<Float>,NCOLORS> link = arg.dataOr(nu, idx, parity);
-        dx[nu]++;
-        U = arg.dataOr(mu, linkIndexShift(x,dx,X), 1 - parity);
-        link *= U;
-        dx[nu]--;
-        dx[mu]++;
-        U = arg.dataOr(nu, linkIndexShift(x,dx,X), 1 - parity);
-        link *= conj(U);
-        staple += link;
-        dx[mu]--;
-        dx[nu]--;
-        link = arg.dataOr(nu, linkIndexShift(x,dx,X), 1 - parity);
-        U = arg.dataOr(mu, linkIndexShift(x,dx,X), 1 - parity);
-        link = conj(link) * U;
-        dx[mu]++;
-        U = arg.dataOr(nu, linkIndexShift(x,dx,X), parity);
-        link *= U;
-        staple += link;
+      for ( int dr = 0; dr < 4; ++dr ) {
+        x[dr] += arg.border[dr];
+        X[dr] += 2 * arg.border[dr];
       }
-    U = arg.dataOr(mu, idx, parity);
-    if ( HeatbathOrRelax ) {
-      cuRNGState localState = arg.rngstate.State()[ id ];
-      heatBathSUN<Float, NCOLORS>( U, conj(staple), localState, arg.BetaOverNc );
-      arg.rngstate.State()[ id ] = localState;
-    }
-    else{
-      overrelaxationSUN<Float, NCOLORS>( U, conj(staple) );
+      idx = linkIndex(x,X);
+
+      Matrix<complex<Float>,NCOLORS> staple;
+      setZero(&staple);
+
+      Matrix<complex<Float>,NCOLORS> U;
+      for ( int nu = 0; nu < 4; nu++ ) if ( mu != nu ) {
+          int dx[4] = { 0, 0, 0, 0 };
+          Matrix<complex<Float>,NCOLORS> link = arg.dataOr(nu, idx, parity);
+          dx[nu]++;
+          U = arg.dataOr(mu, linkIndexShift(x,dx,X), 1 - parity);
+          link *= U;
+          dx[nu]--;
+          dx[mu]++;
+          U = arg.dataOr(nu, linkIndexShift(x,dx,X), 1 - parity);
+          link *= conj(U);
+          staple += link;
+          dx[mu]--;
+          dx[nu]--;
+          link = arg.dataOr(nu, linkIndexShift(x,dx,X), 1 - parity);
+          U = arg.dataOr(mu, linkIndexShift(x,dx,X), 1 - parity);
+          link = conj(link) * U;
+          dx[mu]++;
+          U = arg.dataOr(nu, linkIndexShift(x,dx,X), parity);
+          link *= U;
+          staple += link;
+        }
+      U = arg.dataOr(mu, idx, parity);
+      if ( HeatbathOrRelax ) {
+        RNGState localState(arg.rngstate, site, mu);
+        heatBathSUN<Float, NCOLORS>( U, conj(staple), localState, arg.BetaOverNc );
+      }
+      else{
+        overrelaxationSUN<Float, NCOLORS>( U, conj(staple) );
+      }
+      arg.dataOr(mu, idx, parity) = U;
     }
-    arg.dataOr(mu, idx, parity) = U;
-  }
+  };
 
+  template<typename Float, typename Gauge, int NCOLORS, bool HeatbathOrRelax>
+  __global__ void compute_heatBath(MonteArg<Gauge, Float, NCOLORS> arg, int mu, int parity){
+    int idx = threadIdx.x + blockIdx.x * blockDim.x;
+    if ( idx >= arg.threads ) return;
+    HeatBath<Float, Gauge, NCOLORS, HeatbathOrRelax> f(arg, mu, parity);
+    f(idx);
+  }
 
   template<typename Float, typename Gauge, int NCOLORS, int NElems, bool HeatbathOrRelax>
   class GaugeHB : Tunable {
@@ -671,10 +691,19 @@ namespace quda {
       parity = _parity;
     }
 
+    /**
+       @brief Set the generator of the current sweep, which uses one stream per direction
+    */
+    void SetRNG(const RNG &rng) { arg.rngstate = rng; }
+
     void apply(const qudaStream_t &stream)
     {
-      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-      qudaLaunchKernel(compute_heatBath<Float, Gauge, NCOLORS, HeatbathOrRelax>, tp, stream, arg, mu, parity);
+      if (arg.data.Location() == QUDA_CPU_FIELD_LOCATION) {
+        launchHost(HeatBath<Float, Gauge, NCOLORS, HeatbathOrRelax>(arg, mu, parity), arg.threads, 1);
+      } else {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+        qudaLaunchKernel(compute_heatBath<Float, Gauge, NCOLORS, HeatbathOrRelax>, tp, stream, arg, mu, parity);
+      }
     }
 
     TuneKey tuneKey() const {
@@ -687,14 +716,8 @@ namespace quda {
       return TuneKey(vol.str().c_str(), typeid(*this).name(), aux_string);
     }
 
-    void preTune() {
-      arg.data.backup();
-      if(HeatbathOrRelax) arg.rngstate.backup();
-    }
-    void postTune() {
-      arg.data.restore();
-      if(HeatbathOrRelax) arg.rngstate.restore();
-    }
+    void preTune() { arg.data.backup(); }
+    void postTune() { arg.data.restore(); }
     long long flops() const
     {
       //NEED TO CHECK THIS!!!!!!
@@ -726,12 +749,10 @@ namespace quda {
       //NEED TO CHECK THIS!!!!!!
       if ( NCOLORS == 3 ) {
         long long byte = 20LL * NElems * sizeof(Float);
-        if ( HeatbathOrRelax ) byte += 2LL * sizeof(cuRNGState);
         byte *= arg.threads;
         return byte;
       } else {
         long long byte = 20LL * NCOLORS * NCOLORS * 2 * sizeof(Float);
-        if ( HeatbathOrRelax ) byte += 2LL * sizeof(cuRNGState);
         byte *= arg.threads;
         return byte;
       }
@@ -740,15 +761,15 @@ namespace quda {
 
   template <typename Float, int nColor, QudaReconstructType recon>
   struct MonteAlg {
-    MonteAlg(GaugeField& data, RNG &rngstate, Float Beta, int nhb, int nover)
+    template <typename Gauge> void run(GaugeField &data, RNG &rngstate, Float Beta, int nhb, int nover)
     {
       TimeProfile profileHBOVR("HeatBath_OR_Relax", false);
-      using Gauge = typename gauge_mapper<Float, recon>::type;
 
       MonteArg<Gauge, Float, nColor> montearg(Gauge(data), data, Beta, rngstate);
       if (getVerbosity() >= QUDA_SUMMARIZE) profileHBOVR.TPSTART(QUDA_PROFILE_COMPUTE);
       GaugeHB<Float, Gauge, nColor, recon, true> hb(montearg);
       for ( int step = 0; step < nhb; ++step ) {
+        hb.SetRNG(rngstate.next(4));
         for ( int parity = 0; parity < 2; ++parity ) {
           for ( int mu = 0; mu < 4; ++mu ) {
             hb.SetParam(mu, parity);
@@ -786,12 +807,21 @@ namespace quda {
         printfQuda("OVR: Time = %6.6f s, Gflop/s = %6.1f, GB/s = %6.1f\n", secs, gflops * comm_size(), gbytes * comm_size());
       }
     }
+
+    MonteAlg(GaugeField &data, RNG &rngstate, Float Beta, int nhb, int nover)
+    {
+      checkKernelOrder(data);
+      if (data.Location() == QUDA_CPU_FIELD_LOCATION)
+        run<gauge_accessor_t<Float, recon, QUDA_QDP_GAUGE_ORDER>>(data, rngstate, Beta, nhb, nover);
+      else
+        run<typename gauge_mapper<Float, recon>::type>(data, rngstate, Beta, nhb, nover);
+    }
   };
 
   /** @brief Perform heatbath and overrelaxation. Performs nhb heatbath steps followed by nover overrelaxation steps.
    *
    * @param[in,out] data Gauge field
-   * @param[in,out] rngstate state of the CURAND random number generator
+   * @param[in,out] rngstate random number generator
    * @param[in] Beta inverse of the gauge coupling, beta = 2 Nc / g_0^2
    * @param[in] nhb number of heatbath steps
    * @param[in] nover number of overrelaxation steps
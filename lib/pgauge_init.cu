@@ -10,6 +10,7 @@
 #include <random_quda.h>
 #include <index_helper.cuh>
 #include <instantiate.h>
+#include <launch_host.h>
 
 #ifndef PI
 #define PI    3.1415926535897932384626433832795    // pi
@@ -20,12 +21,13 @@
 
 namespace quda {
 
-  template <typename Float, int nColor_, QudaReconstructType recon_>
+  template <typename Float, int nColor_, QudaReconstructType recon_,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
   struct InitGaugeColdArg {
     static constexpr int nColor = nColor_;
     static constexpr QudaReconstructType recon = recon_;
     using real = typename mapper<Float>::type;
-    using Gauge = typename gauge_mapper<real, recon>::type;
+    using Gauge = gauge_accessor_t<real, recon, order>;
     int threads; // number of active threads required
     int X[4]; // grid dimensions
     Gauge dataOr;
@@ -36,6 +38,18 @@ namespace quda {
     }
   };
 
+  template <typename Arg> struct InitGaugeColdStart {
+    Arg &arg;
+    __device__ __host__ InitGaugeColdStart(Arg &arg) : arg(arg) {}
+
+    __device__ __host__ inline void operator()(int idx, int parity, int = 0) const
+    {
+      Matrix<complex<typename Arg::real>, Arg::nColor> U;
+      setIdentity(&U);
+      for ( int d = 0; d < 4; d++ ) arg.dataOr(d, idx, parity) = U;
+    }
+  };
+
   template <typename Arg> __global__ void compute_InitGauge_ColdStart(Arg arg)
   {
     int idx = threadIdx.x + blockIdx.x * blockDim.x;
@@ -45,9 +59,8 @@ namespace quda {
       parity = 1;
       idx -= arg.threads / 2;
     }
-    Matrix<complex<typename Arg::real>, Arg::nColor> U;
-    setIdentity(&U);
-    for ( int d = 0; d < 4; d++ ) arg.dataOr(d, idx, parity) = U;
+    InitGaugeColdStart<Arg> f(arg);
+    f(idx, parity);
   }
 
   template <typename Float, int nColor, QudaReconstructType recon>
@@ -64,13 +77,19 @@ namespace quda {
       arg(data),
       meta(data)
     {
+      checkKernelOrder(data);
       apply(0);
     }
 
     void apply(const qudaStream_t &stream)
     {
-      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-      qudaLaunchKernel(compute_InitGauge_ColdStart<decltype(arg)>, tp, stream, arg);
+      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
+        InitGaugeColdArg<Float, nColor, recon, QUDA_QDP_GAUGE_ORDER> arg(meta);
+        launchHost(InitGaugeColdStart<decltype(arg)>(arg), arg.threads / 2);
+      } else {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+        qudaLaunchKernel(compute_InitGauge_ColdStart<decltype(arg)>, tp, stream, arg);
+      }
     }
 
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), meta.AuxString()); }
@@ -78,28 +97,27 @@ namespace quda {
     long long bytes() const { return meta.Bytes(); }
   };
 
-  template <typename Float, int nColor_, QudaReconstructType recon_>
+  template <typename Float, int nColor_, QudaReconstructType recon_,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
   struct InitGaugeHotArg {
     static constexpr int nColor = nColor_;
     static constexpr QudaReconstructType recon = recon_;
     using real = typename mapper<Float>::type;
-    using Gauge = typename gauge_mapper<real, recon>::type;
+    using Gauge = gauge_accessor_t<real, recon, order>;
     int threads; // number of active threads required
     int X[4]; // grid dimensions
     RNG rngstate;
     int border[4];
     Gauge dataOr;
-    InitGaugeHotArg(const GaugeField &data, RNG &rngstate) :
-      dataOr(data),
-      rngstate(rngstate)
+    InitGaugeHotArg(const GaugeField &data, const RNG &rngstate) :
+      rngstate(rngstate),
+      dataOr(data)
     {
       for ( int dir = 0; dir < 4; ++dir ) {
         border[dir] = data.R()[dir];
         X[dir] = data.X()[dir] - border[dir] * 2;
       } 
 
-      //the optimal number of RNG states in rngstate array must be equal to half the lattice volume
-      //this number is the same used in heatbath...
       threads = X[0] * X[1] * X[2] * X[3] >> 1;
     }
   };
@@ -146,18 +164,18 @@ namespace quda {
 
   /**
      @brief Generate the four random real elements of the SU(2) matrix
-     @param localstate CURAND rng state
+     @param localstate rng state
      @return four real numbers of the SU(2) matrix
   */
   template <class T>
-  __device__ static inline Matrix<T,2> randomSU2(cuRNGState& localState){
+  __host__ __device__ static inline Matrix<T,2> randomSU2(RNGState& localState){
     Matrix<T,2> a;
     T aabs, ctheta, stheta, phi;
     a(0,0) = Random<T>(localState, (T)-1.0, (T)1.0);
     aabs = sqrt( 1.0 - a(0,0) * a(0,0));
     ctheta = Random<T>(localState, (T)-1.0, (T)1.0);
     phi = PII * Random<T>(localState);
-    stheta = ( curand(&localState) & 1 ? 1 : -1 ) * sqrt( (T)1.0 - ctheta * ctheta );
+    stheta = ( localState() & 1 ? 1 : -1 ) * sqrt( (T)1.0 - ctheta * ctheta );
     a(0,1) = aabs * stheta * cos( phi );
     a(1,0) = aabs * stheta * sin( phi );
     a(1,1) = aabs * ctheta;
@@ -208,11 +226,11 @@ namespace quda {
 
   /**
      @brief Generate a SU(Nc) random matrix
-     @param localstate CURAND rng state
+     @param localstate rng state
      @return SU(Nc) matrix
   */
   template <class Float, int NCOLORS>
-  __device__ inline Matrix<complex<Float>,NCOLORS> randomize( cuRNGState& localState )
+  __host__ __device__ inline Matrix<complex<Float>,NCOLORS> randomize( RNGState& localState )
   {
     Matrix<complex<Float>,NCOLORS> U;
 
@@ -232,17 +250,17 @@ namespace quda {
        return U;*/
   }
 
-  template<typename Arg> __global__ void compute_InitGauge_HotStart(Arg arg)
-  {
-    int idx = threadIdx.x + blockIdx.x * blockDim.x;
-    if ( idx >= arg.threads ) return;
-    int X[4], x[4];
-    for ( int dr = 0; dr < 4; ++dr ) X[dr] = arg.X[dr];
-    for ( int dr = 0; dr < 4; ++dr ) X[dr] += 2 * arg.border[dr];
-    int id = idx;
-    cuRNGState localState = arg.rngstate.State()[ id ];
-    for (int parity = 0; parity < 2; parity++) {
-      getCoords(x, id, arg.X, parity);
+  template <typename Arg> struct InitGaugeHotStart {
+    Arg &arg;
+    __device__ __host__ InitGaugeHotStart(Arg &arg) : arg(arg) {}
+
+    __device__ __host__ inline void operator()(int idx, int parity, int = 0) const
+    {
+      int X[4], x[4];
+      for ( int dr = 0; dr < 4; ++dr ) X[dr] = arg.X[dr];
+      for ( int dr = 0; dr < 4; ++dr ) X[dr] += 2 * arg.border[dr];
+      getCoords(x, idx, arg.X, parity);
+      RNGState localState(arg.rngstate, arg.rngstate.globalIndex(x));
       for (int dr = 0; dr < 4; dr++) x[dr] += arg.border[dr];
       idx = linkIndex(x,X);
       for (int d = 0; d < 4; d++) {
@@ -251,7 +269,14 @@ namespace quda {
         arg.dataOr(d, idx, parity) = U;
       }
     }
-    arg.rngstate.State()[ id ] = localState;
+  };
+
+  template<typename Arg> __global__ void compute_InitGauge_HotStart(Arg arg)
+  {
+    int idx = threadIdx.x + blockIdx.x * blockDim.x;
+    if ( idx >= arg.threads ) return;
+    InitGaugeHotStart<Arg> f(arg);
+    for (int parity = 0; parity < 2; parity++) f(idx, parity);
   }
 
   template<typename Float, int nColors, QudaReconstructType recon>
@@ -266,23 +291,27 @@ namespace quda {
 
   public:
     InitGaugeHot(GaugeField &data, RNG &rngstate) :
-      arg(data, rngstate),
+      arg(data, rngstate.next()),
       meta(data)
     {
+      checkKernelOrder(data);
       apply(0);
       qudaDeviceSynchronize();
       data.exchangeExtendedGhost(data.R(),false);
     }
 
     void apply(const qudaStream_t &stream){
-      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-      qudaLaunchKernel(compute_InitGauge_HotStart<decltype(arg)>, tp, stream, arg);
+      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
+        InitGaugeHotArg<Float, nColors, recon, QUDA_QDP_GAUGE_ORDER> arg(meta, this->arg.rngstate);
+        launchHost(InitGaugeHotStart<decltype(arg)>(arg), arg.threads);
+      } else {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+        qudaLaunchKernel(compute_InitGauge_HotStart<decltype(arg)>, tp, stream, arg);
+      }
     }
 
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), meta.AuxString()); }
 
-    void preTune(){ arg.rngstate.backup(); }
-    void postTune(){ arg.rngstate.restore(); }
     long long flops() const { return 0; }
     long long bytes() const { return meta.Bytes(); }
   };
@@ -303,7 +332,7 @@ namespace quda {
   /** @brief Perform a hot start to the gauge field, random SU(3) matrix, followed by reunitarization, also exchange borders links in multi-GPU case.
    *
    * @param[in,out] data Gauge field
-   * @param[in,out] rngstate state of the CURAND random number generator
+   * @param[in,out] rngstate random number generator
    */
   void InitGaugeField(GaugeField& data, RNG &rngstate) {
 #ifdef GPU_GAUGE_ALG
@@ -4,8 +4,13 @@
 #include <quda.h>
 #include <util_quda.h>
 #include <layout_hyper.h>
+#include <malloc_quda.h>
 
 #include <string>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <vector>
 
 static QIO_Layout layout;
 static int lattice_size[4];
@@ -28,35 +33,156 @@ std::ostream &operator<<(std::ostream &out, const QIO_Layout &layout)
   return out;
 }
 
-// for matrix fields this order implies [color][color][complex]
-// for vector fields this order implies [spin][color][complex]
-// templatized version to allow for precision conversion
-template <typename oFloat, typename iFloat, int len> void vput(char *s1, size_t index, int count, void *s2)
+// QIO moves record data through per-site callbacks.  Rather than
+// converting and scattering each site into the array of fields from
+// within the callback, records are staged through a site-major host
+// buffer in file precision, so the callbacks reduce to a single
+// contiguous copy.  Precision conversion and the transposition between
+// the site-major record and the vector-major fields are then done in a
+// separate threaded pass over cache-sized tiles of sites.  To bound
+// the host memory overhead, records are streamed through fixed-size
+// chunks of sites in both directions.  A record holding a single field
+// in host precision has the layout of the field, so is read and
+// written in place.  A record holding more
+// fields than a batch is read once per batch, each pass staging only
+// the fields of that batch, so the read buffers never scale with the
+// size of the record.
+constexpr size_t chunk_bytes = 16 * 1024 * 1024; // size of the chunks records are streamed through
+
+struct block_arg {
+  char *buffer;      // site-major staging buffer
+  size_t site_bytes; // bytes per site in the staging buffer
+  size_t offset;     // byte offset of the staged subset within each site of the record
+};
+
+void vput_block(char *s1, size_t index, int, void *s2)
 {
-  oFloat **field = (oFloat **)s2;
-  iFloat *src = (iFloat *)s1;
+  block_arg *arg = (block_arg *)s2;
+  memcpy(arg->buffer + index * arg->site_bytes, s1 + arg->offset, arg->site_bytes);
+}
 
-  // For the site specified by "index", move an array of "count" data
-  // from the read buffer to an array of fields
+void vget_block(char *s1, size_t index, int, void *s2)
+{
+  block_arg *arg = (block_arg *)s2;
+  memcpy(s1, arg->buffer + index * arg->site_bytes, arg->site_bytes);
+}
 
-  for (int i = 0; i < count; i++) {
-    oFloat *dest = field[i] + len * index;
-    for (int j = 0; j < len; j++) dest[j] = src[i * len + j];
+struct chunk_arg {
+  char *buffer;                                 // site-major chunk of staged sites
+  std::vector<size_t> index;                    // local index of each staged site
+  size_t site_bytes;                            // bytes per site
+  size_t offset;                                // byte offset of the staged subset within each site of the record
+  size_t n;                                     // number of sites staged
+  std::function<void(const chunk_arg &)> flush; // converts and scatters the staged sites
+};
+
+void vput_chunk(char *s1, size_t index, int, void *s2)
+{
+  chunk_arg *arg = (chunk_arg *)s2;
+  memcpy(arg->buffer + arg->n * arg->site_bytes, s1 + arg->offset, arg->site_bytes);
+  arg->index[arg->n++] = index;
+  if (arg->n == arg->index.size()) {
+    arg->flush(*arg);
+    arg->n = 0;
   }
 }
 
+// QIO requests the sites of a record in file order, which visits the
+// local sites of each parity in increasing order, so writes are
+// staged through two chunks of sites: each chunk is packed when a site
+// of it is first requested, replacing the chunk used least recently
+struct write_chunk_arg {
+  char *buffer[2];                                   // site-major chunks of packed sites
+  long chunk[2];                                     // chunk held by each buffer, or -1
+  int last;                                          // buffer used most recently
+  size_t chunk_sites;                                // sites per chunk
+  size_t sites;                                      // sites in the record
+  size_t site_bytes;                                 // bytes per site
+  std::function<void(char *, size_t, size_t)> pack; // packs the sites [begin, begin + n) into a buffer
+};
+
+void vget_chunk(char *s1, size_t index, int, void *s2)
+{
+  write_chunk_arg *arg = (write_chunk_arg *)s2;
+  const long c = index / arg->chunk_sites;
+  int b = arg->chunk[0] == c ? 0 : arg->chunk[1] == c ? 1 : -1;
+  if (b < 0) {
+    b = 1 - arg->last;
+    const size_t begin = c * arg->chunk_sites;
+    arg->pack(arg->buffer[b], begin, std::min(arg->chunk_sites, arg->sites - begin));
+    arg->chunk[b] = c;
+  }
+  arg->last = b;
+  memcpy(s1, arg->buffer[b] + (index - c * arg->chunk_sites) * arg->site_bytes, arg->site_bytes);
+}
+
+// number of sites per tile such that a tile of the staging buffer fits in L2
+inline size_t tile_sites(int count, int len, size_t prec)
+{
+  return std::max<size_t>(1, (256 * 1024) / (count * len * prec));
+}
+
+// for matrix fields this order implies [color][color][complex]
 // for vector fields this order implies [spin][color][complex]
-// templatized version of vget_M to allow for precision conversion
-template <typename oFloat, typename iFloat, int len> void vget(char *s1, size_t index, int count, void *s2)
+// scatter the "n" sites of a site-major chunk holding "count" fields per site to the
+// sites "index" of the fields, converting from iFloat to oFloat
+template <typename oFloat, typename iFloat, int len>
+void unpack_sites(void **field, const char *buffer, const size_t *index, size_t n, int count)
+{
+  const iFloat *chunk = (const iFloat *)buffer;
+
+#pragma omp parallel for schedule(static)
+  for (long x = 0; x < (long)n; x++) {
+    for (int i = 0; i < count; i++) {
+      const iFloat *src = chunk + (x * count + i) * len;
+      oFloat *dst = (oFloat *)field[i] + index[x] * len;
+#pragma omp simd
+      for (int j = 0; j < len; j++) dst[j] = src[j];
+    }
+  }
+}
+
+template <int len>
+void unpack_sites(void **field, const chunk_arg &arg, int count, QudaPrecision cpu_prec, QudaPrecision file_prec)
 {
-  iFloat **field = (iFloat **)s2;
-  oFloat *dest = (oFloat *)s1;
-
-  /* For the site specified by "index", move an array of "count" data
-     from the array of fields to the write buffer */
-  for (int i = 0; i < count; i++, dest += len) {
-    iFloat *src = field[i] + len * index;
-    for (int j = 0; j < len; j++) dest[j] = src[j];
+  const size_t *index = arg.index.data();
+  if (cpu_prec == QUDA_DOUBLE_PRECISION) {
+    if (file_prec == QUDA_DOUBLE_PRECISION) {
+      unpack_sites<double, double, len>(field, arg.buffer, index, arg.n, count);
+    } else {
+      unpack_sites<double, float, len>(field, arg.buffer, index, arg.n, count);
+    }
+  } else {
+    if (file_prec == QUDA_DOUBLE_PRECISION) {
+      unpack_sites<float, double, len>(field, arg.buffer, index, arg.n, count);
+    } else {
+      unpack_sites<float, float, len>(field, arg.buffer, index, arg.n, count);
+    }
+  }
+}
+
+// pack the sites [first, first + sites) of "count" fields into a site-major buffer, converting
+// from iFloat to oFloat
+template <typename oFloat, typename iFloat, int len>
+void pack_block(char *buffer, void **field, int count, size_t first, size_t sites)
+{
+  oFloat *block = (oFloat *)buffer;
+  const size_t tile = tile_sites(count, len, sizeof(oFloat));
+  const long n_tile = (sites + tile - 1) / tile;
+
+#pragma omp parallel for schedule(static)
+  for (long t = 0; t < n_tile; t++) {
+    const size_t begin = t * tile;
+    const size_t end = std::min(begin + tile, sites);
+    for (int i = 0; i < count; i++) {
+      const iFloat *source = (const iFloat *)field[i] + first * len;
+      for (size_t x = begin; x < end; x++) {
+        const iFloat *src = source + x * len;
+        oFloat *dst = block + (x * count + i) * len;
+#pragma omp simd
+        for (int j = 0; j < len; j++) dst[j] = src[j];
+      }
+    }
   }
 }
 
@@ -122,9 +248,39 @@ QIO_Writer *open_test_output(const char *filename, int volfmt, int serpar, int i
   return outfile;
 }
 
+// Read the fields [first, first + n) of the next record, which holds
+// count fields, through a chunk of sites, converting them to host precision
 template <int len>
-int read_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cpu_prec, QudaSiteSubset subset,
-               QudaParity parity, int nSpin, int nColor)
+int read_chunked(QIO_Reader *infile, QIO_RecordInfo *rec_info, QIO_String *xml_record_in, int count, int first, int n,
+                 void **field_in, QudaPrecision cpu_prec, QudaPrecision file_prec)
+{
+  const size_t rec_size = file_prec * count * len;
+  const size_t sites = layout.sites_on_node;
+
+  chunk_arg arg;
+  arg.site_bytes = file_prec * n * len;
+  arg.offset = file_prec * first * len;
+  arg.index.resize(std::max<size_t>(1, std::min(sites, chunk_bytes / arg.site_bytes)));
+  arg.n = 0;
+  arg.flush = [&](const chunk_arg &a) { unpack_sites<len>(field_in, a, n, cpu_prec, file_prec); };
+  arg.buffer = (char *)safe_malloc(arg.index.size() * arg.site_bytes);
+  int status = QIO_read(infile, rec_info, xml_record_in, vput_chunk, rec_size, file_prec, &arg);
+  if (status == QIO_SUCCESS && arg.n > 0) arg.flush(arg);
+  host_free(arg.buffer);
+  return status;
+}
+
+// Read the next record, which is expected to hold count fields, and
+// hand it out in batches of at most batch_size fields: for each batch
+// acquire(begin, n) returns the destinations of the fields [begin,
+// begin + n), and release(begin, n) is called once they are filled.
+// A record that spans several batches is read once per batch, with
+// rewind() reopening the file at the start of the record for every
+// pass after the first.
+template <int len>
+int read_field(QIO_Reader *infile, int count, QudaPrecision cpu_prec, QudaSiteSubset subset, QudaParity parity,
+               int nSpin, int nColor, int batch_size, const std::function<void **(int, int)> &acquire,
+               const std::function<void(int, int)> &release, const std::function<QIO_Reader *()> &rewind)
 {
   // Get the QIO record and string
   char dummy[100] = "";
@@ -170,22 +326,33 @@ int read_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cp
   // Get total size. Could probably check the filesize better, but tbd.
   size_t rec_size = file_prec * count * len;
 
-  /* Read the field record and convert to cpu precision*/
-  if (cpu_prec == QUDA_DOUBLE_PRECISION) {
-    if (file_prec == QUDA_DOUBLE_PRECISION) {
-      status = QIO_read(infile, rec_info, xml_record_in, vput<double, double, len>, rec_size, QUDA_DOUBLE_PRECISION,
-                        field_in);
+  if (batch_size <= 0) errorQuda("Invalid batch size %d", batch_size);
+
+  if (batch_size >= count) {
+    void **field_in = acquire(0, count);
+    if (count == 1 && file_prec == cpu_prec) {
+      /* Read the field record straight into the field */
+      block_arg arg = {(char *)field_in[0], rec_size, 0};
+      status = QIO_read(infile, rec_info, xml_record_in, vput_block, rec_size, file_prec, &arg);
     } else {
-      status
-        = QIO_read(infile, rec_info, xml_record_in, vput<double, float, len>, rec_size, QUDA_SINGLE_PRECISION, field_in);
+      /* Read the field record through a chunk of sites */
+      status = read_chunked<len>(infile, rec_info, xml_record_in, count, 0, count, field_in, cpu_prec, file_prec);
     }
+    release(0, count);
   } else {
-    if (file_prec == QUDA_DOUBLE_PRECISION) {
-      status
-        = QIO_read(infile, rec_info, xml_record_in, vput<float, double, len>, rec_size, QUDA_DOUBLE_PRECISION, field_in);
-    } else {
-      status
-        = QIO_read(infile, rec_info, xml_record_in, vput<float, float, len>, rec_size, QUDA_SINGLE_PRECISION, field_in);
+    if (!rewind)
+      errorQuda("Reading a record of %d fields in batches of %d requires a rewindable reader", count, batch_size);
+    /* Read the field record once per batch, each pass through a chunk of the sites of that batch */
+    for (int begin = 0; status == QIO_SUCCESS && begin < count; begin += batch_size) {
+      if (begin > 0) {
+        infile = rewind();
+        status = QIO_read_record_info(infile, rec_info, xml_record_in);
+        if (status != QIO_SUCCESS) break;
+      }
+      const int n = std::min(batch_size, count - begin);
+      void **field_in = acquire(begin, n);
+      status = read_chunked<len>(infile, rec_info, xml_record_in, count, begin, n, field_in, cpu_prec, file_prec);
+      release(begin, n);
     }
   }
 
@@ -196,6 +363,15 @@ int read_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cp
   return 0;
 }
 
+template <int len>
+int read_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cpu_prec, QudaSiteSubset subset,
+               QudaParity parity, int nSpin, int nColor)
+{
+  return read_field<len>(
+    infile, count, cpu_prec, subset, parity, nSpin, nColor, count, [&](int, int) { return field_in; },
+    [](int, int) {}, nullptr);
+}
+
 int read_su3_field(QIO_Reader *infile, int count, void *field_in[], QudaPrecision cpu_prec)
 {
   return read_field<18>(infile, count, field_in, cpu_prec, QUDA_FULL_SITE_SUBSET, QUDA_INVALID_PARITY, 1, 9);
@@ -253,44 +429,158 @@ void read_gauge_field(const char *filename, void *gauge[], QudaPrecision precisi
 
 // count is the number of vectors
 // Ninternal is the size of the "inner struct" (24 for Wilson spinor)
-int read_field(QIO_Reader *infile, int Ninternal, int count, void *field_in[], QudaPrecision cpu_prec,
-               QudaSiteSubset subset, QudaParity parity, int nSpin, int nColor)
+int read_field(QIO_Reader *infile, int Ninternal, int count, QudaPrecision cpu_prec, QudaSiteSubset subset,
+               QudaParity parity, int nSpin, int nColor, int batch_size,
+               const std::function<void **(int, int)> &acquire, const std::function<void(int, int)> &release,
+               const std::function<QIO_Reader *()> &rewind)
 {
   int status = 0;
   switch (Ninternal) {
-  case 6: status = read_field<6>(infile, count, field_in, cpu_prec, subset, parity, nSpin, nColor); break;
-  case 24: status = read_field<24>(infile, count, field_in, cpu_prec, subset, parity, nSpin, nColor); break;
-  case 96: status = read_field<96>(infile, count, field_in, cpu_prec, subset, parity, nSpin, nColor); break;
-  case 128: status = read_field<128>(infile, count, field_in, cpu_prec, subset, parity, nSpin, nColor); break;
-  case 256: status = read_field<256>(infile, count, field_in, cpu_prec, subset, parity, nSpin, nColor); break;
-  case 384: status = read_field<384>(infile, count, field_in, cpu_prec, subset, parity, nSpin, nColor); break;
+  case 6:
+    status = read_field<6>(infile, count, cpu_prec, subset, parity, nSpin, nColor, batch_size, acquire, release,
+                           rewind);
+    break;
+  case 24:
+    status = read_field<24>(infile, count, cpu_prec, subset, parity, nSpin, nColor, batch_size, acquire, release,
+                            rewind);
+    break;
+  case 96:
+    status = read_field<96>(infile, count, cpu_prec, subset, parity, nSpin, nColor, batch_size, acquire, release,
+                            rewind);
+    break;
+  case 128:
+    status = read_field<128>(infile, count, cpu_prec, subset, parity, nSpin, nColor, batch_size, acquire, release,
+                             rewind);
+    break;
+  case 256:
+    status = read_field<256>(infile, count, cpu_prec, subset, parity, nSpin, nColor, batch_size, acquire, release,
+                             rewind);
+    break;
+  case 384:
+    status = read_field<384>(infile, count, cpu_prec, subset, parity, nSpin, nColor, batch_size, acquire, release,
+                             rewind);
+    break;
   default:
     errorQuda("Undefined %d", Ninternal);
   }
   return status;
 }
 
-void read_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X, QudaSiteSubset subset,
-                       QudaParity parity, int nColor, int nSpin, int Nvec, int argc, char *argv[])
+// Return the number of fields stored in the next record without consuming it
+int read_record_count(QIO_Reader *infile)
+{
+  char dummy[100] = "";
+  QIO_RecordInfo *rec_info = QIO_create_record_info(0, NULL, NULL, 0, dummy, dummy, 0, 0, 0, 0);
+  QIO_String *xml_record_in = QIO_string_create();
+
+  int status = QIO_read_record_info(infile, rec_info, xml_record_in);
+  if (status != QIO_SUCCESS) { errorQuda("QIO_read_record_info failed %d\n", status); }
+  int count = QIO_get_datacount(rec_info);
+
+  QIO_string_destroy(xml_record_in);
+  QIO_destroy_record_info(rec_info);
+  return count;
+}
+
+// Reopen a file for reading, positioned at the start of record "record"
+QIO_Reader *reopen_at_record(QIO_Reader *infile, const char *filename, int record)
+{
+  QIO_close_read(infile);
+  infile = open_test_input(filename, QIO_UNKNOWN, QIO_PARALLEL);
+  if (infile == NULL) { errorQuda("Reopen file failed\n"); }
+  for (int i = 0; i < record; i++) {
+    read_record_count(infile);
+    if (QIO_next_record(infile) != QIO_SUCCESS) { errorQuda("QIO_next_record failed on record %d\n", i); }
+  }
+  return infile;
+}
+
+void read_spinor_field_batched(const char *filename, QudaPrecision precision, const int *X, QudaSiteSubset subset,
+                               QudaParity parity, int nColor, int nSpin, int Nvec, int batch_size,
+                               const std::function<void **(int, int)> &acquire,
+                               const std::function<void(int, int)> &release)
 {
   quda_this_node = QMP_get_node_number();
 
   set_layout(X, subset);
 
+  if (batch_size <= 0) errorQuda("Invalid batch size %d", batch_size);
+
   /* Open the test file for reading */
   QIO_Reader *infile = open_test_input(filename, QIO_UNKNOWN, QIO_PARALLEL);
   if (infile == NULL) { errorQuda("Open file failed\n"); }
 
-  /* Read the spinor field record */
-  printfQuda("%s: reading %d vector fields\n", __func__, Nvec); fflush(stdout);
-  int status = read_field(infile, 2 * nSpin * nColor, Nvec, V, precision, subset, parity, nSpin, nColor);
-  if (status) { errorQuda("read_spinor_fields failed %d\n", status); }
+  printfQuda("%s: reading %d vector fields in batches of at most %d\n", __func__, Nvec, batch_size); fflush(stdout);
+
+  /* Read the spinor field records in turn */
+  int record_start = 0;
+  for (int record = 0; record_start < Nvec; record++) {
+    int record_count = read_record_count(infile);
+    if (record_start + record_count > Nvec)
+      errorQuda("File %s holds more than the expected %d vector fields", filename, Nvec);
+
+    // a record is handed out in batches, rereading it for each batch after the first
+    int status = read_field(
+      infile, 2 * nSpin * nColor, record_count, precision, subset, parity, nSpin, nColor, batch_size,
+      [&](int begin, int n) { return acquire(record_start + begin, n); },
+      [&](int begin, int n) { release(record_start + begin, n); },
+      [&]() { return infile = reopen_at_record(infile, filename, record); });
+    if (status) { errorQuda("read_spinor_fields failed %d\n", status); }
+
+    record_start += record_count;
+  }
 
   /* Close the file */
   QIO_close_read(infile);
   printfQuda("%s: Closed file for reading\n",__func__);
 }
 
+void read_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X, QudaSiteSubset subset,
+                       QudaParity parity, int nColor, int nSpin, int Nvec, int argc, char *argv[])
+{
+  // read all fields at once, allowing for files that store them across multiple records
+  read_spinor_field_batched(
+    filename, precision, X, subset, parity, nColor, nSpin, Nvec, Nvec, [&](int start, int) { return &V[start]; },
+    [](int, int) {});
+}
+
+// Write the field record through chunks of sites, converting the fields to file precision
+template <int len>
+int write_chunked(QIO_Writer *outfile, QIO_RecordInfo *rec_info, QIO_String *xml_record_out, int count,
+                  void *field_out[], QudaPrecision file_prec, QudaPrecision cpu_prec)
+{
+  size_t rec_size = file_prec * count * len;
+
+  write_chunk_arg arg;
+  arg.sites = layout.sites_on_node;
+  arg.site_bytes = rec_size;
+  arg.chunk_sites = std::max<size_t>(1, std::min(arg.sites, chunk_bytes / rec_size));
+  arg.last = 1;
+  for (int b = 0; b < 2; b++) {
+    arg.buffer[b] = (char *)safe_malloc(arg.chunk_sites * rec_size);
+    arg.chunk[b] = -1;
+  }
+  arg.pack = [&](char *buffer, size_t first, size_t sites) {
+    if (cpu_prec == QUDA_DOUBLE_PRECISION) {
+      if (file_prec == QUDA_DOUBLE_PRECISION) {
+        pack_block<double, double, len>(buffer, field_out, count, first, sites);
+      } else {
+        pack_block<float, double, len>(buffer, field_out, count, first, sites);
+      }
+    } else {
+      if (file_prec == QUDA_DOUBLE_PRECISION) {
+        pack_block<double, float, len>(buffer, field_out, count, first, sites);
+      } else {
+        pack_block<float, float, len>(buffer, field_out, count, first, sites);
+      }
+    }
+  };
+
+  int status = QIO_write(outfile, rec_info, xml_record_out, vget_chunk, rec_size, file_prec, &arg);
+  for (int b = 0; b < 2; b++) host_free(arg.buffer[b]);
+  return status;
+}
+
 template <int len>
 int write_field(QIO_Writer *outfile, int count, void *field_out[], QudaPrecision file_prec, QudaPrecision cpu_prec,
                 QudaSiteSubset subset, QudaParity parity, int nSpin, int nColor, const char *type)
@@ -364,24 +654,15 @@ int write_field(QIO_Writer *outfile, int count, void *field_out[], QudaPrecision
   QIO_String *xml_record_out = QIO_string_create();
   QIO_string_set(xml_record_out, xml_record.c_str());
 
-  /* Write the field record converting to desired file precision*/
   size_t rec_size = file_prec*count*len;
-  if (cpu_prec == QUDA_DOUBLE_PRECISION) {
-    if (file_prec == QUDA_DOUBLE_PRECISION) {
-      status = QIO_write(outfile, rec_info, xml_record_out, vget<double, double, len>, rec_size, QUDA_DOUBLE_PRECISION,
-                         field_out);
-    } else {
-      status = QIO_write(outfile, rec_info, xml_record_out, vget<double, float, len>, rec_size, QUDA_SINGLE_PRECISION,
-                         field_out);
-    }
+
+  if (count == 1 && file_prec == cpu_prec) {
+    /* Write the field record straight from the field */
+    block_arg arg = {(char *)field_out[0], rec_size, 0};
+    status = QIO_write(outfile, rec_info, xml_record_out, vget_block, rec_size, file_prec, &arg);
   } else {
-    if (file_prec == QUDA_DOUBLE_PRECISION) {
-      status = QIO_write(outfile, rec_info, xml_record_out, vget<float, double, len>, rec_size, QUDA_DOUBLE_PRECISION,
-                         field_out);
-    } else {
-      status = QIO_write(outfile, rec_info, xml_record_out, vget<float, float, len>, rec_size, QUDA_SINGLE_PRECISION,
-                         field_out);
-    }
+    /* Write the field record through chunks of sites */
+    status = write_chunked<len>(outfile, rec_info, xml_record_out, count, field_out, file_prec, cpu_prec);
   }
 
   printfQuda("%s: QIO_write_record_data returns status %d\n", __func__, status);
@@ -481,3 +762,39 @@ void write_spinor_field(const char *filename, void *V[], QudaPrecision precision
   QIO_close_write(outfile);
   printfQuda("%s: Closed file for writing\n",__func__);
 }
+
+void write_spinor_field_batched(const char *filename, QudaPrecision precision, const int *X, QudaSiteSubset subset,
+                                QudaParity parity, int nColor, int nSpin, int Nvec, int batch_size,
+                                const std::function<void **(int, int)> &acquire,
+                                const std::function<void(int, int)> &release)
+{
+  quda_this_node = QMP_get_node_number();
+
+  set_layout(X, subset);
+
+  if (batch_size <= 0) errorQuda("Invalid batch size %d", batch_size);
+
+  QudaPrecision file_prec = precision;
+
+  char type[128];
+  sprintf(type, "QUDA_%sNs%dNc%d_ColorSpinorField", (file_prec == QUDA_DOUBLE_PRECISION) ? "D" : "F", nSpin, nColor);
+
+  /* Open the test file for writing */
+  QIO_Writer *outfile = open_test_output(filename, QIO_SINGLEFILE, QIO_PARALLEL, QIO_ILDGNO);
+  if (outfile == NULL) { errorQuda("Open file failed\n"); }
+
+  /* Write the spinor fields with one record per batch */
+  printfQuda("%s: writing %d vector fields in batches of at most %d\n", __func__, Nvec, batch_size); fflush(stdout);
+  for (int begin = 0; begin < Nvec; begin += batch_size) {
+    int count = std::min(batch_size, Nvec - begin);
+    void **V = acquire(begin, count);
+    int status
+      = write_field(outfile, 2 * nSpin * nColor, count, V, precision, precision, subset, parity, nSpin, nColor, type);
+    if (status) { errorQuda("write_spinor_fields failed %d\n", status); }
+    release(begin, count);
+  }
+
+  /* Close the file */
+  QIO_close_write(outfile);
+  printfQuda("%s: Closed file for writing\n",__func__);
+}
@@ -67,7 +67,7 @@ namespace quda
         hd_reduce = (device_reduce_t *)get_mapped_device_pointer(h_reduce); // set the matching device pointer
 
 #ifdef HETEROGENEOUS_ATOMIC
-        using system_atomic_t = device_reduce_t;
+        using system_atomic_t = atomic_type<device_reduce_t>::type;
         size_t n_reduce = bytes / sizeof(system_atomic_t);
         auto *atomic_buf = reinterpret_cast<system_atomic_t *>(h_reduce);               // FIXME
         for (size_t i = 0; i < n_reduce; i++) new (atomic_buf + i) system_atomic_t {0}; // placement new constructor
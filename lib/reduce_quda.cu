@@ -3,6 +3,7 @@
 #include <color_spinor_field_order.h>
 #include <jitify_helper.cuh>
 #include <kernels/reduce_core.cuh>
+#include <blas_expr.cuh>
 
 namespace quda {
 
@@ -35,10 +36,10 @@ namespace quda {
    /**
        Generic reduction kernel launcher
     */
-    template <typename host_reduce_t, typename real, int len, typename Arg>
+    template <typename real, int len, typename Arg>
     auto reduceLaunch(Arg &arg, const TuneParam &tp, const qudaStream_t &stream, Tunable &tunable)
     {
-      using device_reduce_t = typename Arg::Reducer::reduce_t;
+      using reduce_t = typename Arg::Reducer::reduce_t;
       if (tp.grid.x > (unsigned int)deviceProp.maxGridSize[0])
         errorQuda("Grid size %d greater than maximum %d\n", tp.grid.x, deviceProp.maxGridSize[0]);
 
@@ -53,7 +54,7 @@ namespace quda {
       arg.launch_error = launch<max_block_size(), real, len>(arg, tp, stream);
 #endif
 
-      host_reduce_t result;
+      reduce_t result;
       ::quda::zero(result);
       if (!commAsyncReduction()) arg.complete(result, stream);
       return result;
@@ -66,8 +67,10 @@ namespace quda {
       using real = typename mapper<y_store_t>::type;
       using host_reduce_t = typename Reducer<double, real>::reduce_t;
       Reducer<device_reduce_t, real> r;
+      using reduce_t = typename decltype(r)::reduce_t;
       const int nParity; // for composite fields this includes the number of composites
       host_reduce_t &result;
+      reduce_t partial; // local result prior to the sum over processes
 
       const coeff_t &a, &b;
       ColorSpinorField &x, &y, &z, &w, &v;
@@ -104,6 +107,7 @@ namespace quda {
         result(result),
         location(checkLocation(x, y, z, w, v))
       {
+        ::quda::zero(partial);
         checkLength(x, y, z, w, v);
         auto x_prec = checkPrecision(x, z, w, v);
         auto y_prec = y.Precision();
@@ -131,8 +135,7 @@ namespace quda {
         blas::bytes += bytes();
         blas::flops += flops();
 
-        const int Nreduce = sizeof(host_reduce_t) / sizeof(double);
-        reduceDoubleArray((double *)&result, Nreduce);
+        reduce_global(result, partial);
       }
 
       TuneKey tuneKey() const { return TuneKey(x.VolString(), typeid(r).name(), aux); }
@@ -159,7 +162,7 @@ namespace quda {
           const int length = x.Length() / (nParity * M);
 
           ReductionArg<device_store_t, N, device_y_store_t, Ny, decltype(r_)> arg(x, y, z, w, v, r_, length, nParity, tp);
-          result = reduceLaunch<host_reduce_t, device_real_t, M>(arg, tp, stream, *this);
+          partial = reduceLaunch<device_real_t, M>(arg, tp, stream, *this);
         } else {
           if (checkOrder(x, y, z, w, v) != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
             warningQuda("CPU Blas functions expect AoS field order");
@@ -169,7 +172,7 @@ namespace quda {
           using host_store_t = typename host_type_mapper<store_t>::type;
           using host_y_store_t = typename host_type_mapper<y_store_t>::type;
           using host_real_t = typename mapper<host_y_store_t>::type;
-          Reducer<double, host_real_t> r_(a, b);
+          Reducer<device_reduce_t, host_real_t> r_(a, b);
 
           // redefine site_unroll with host_store types to ensure we have correct N/Ny/M values
           constexpr bool site_unroll = !std::is_same<host_store_t, host_y_store_t>::value || isFixed<host_store_t>::value || decltype(r)::site_unroll;
@@ -179,7 +182,7 @@ namespace quda {
           const int length = x.Length() / (nParity * M);
 
           ReductionArg<host_store_t, N, host_y_store_t, Ny, decltype(r_)> arg(x, y, z, w, v, r_, length, nParity, tp);
-          result = reduceCPU<host_real_t, M>(arg);
+          partial = reduceCPU<host_real_t, M>(arg);
         }
       }
 
@@ -299,12 +302,24 @@ namespace quda {
     double3 caxpbypzYmbwcDotProductUYNormY(const Complex &a, ColorSpinorField &x, const Complex &b, ColorSpinorField &y,
                                            ColorSpinorField &z, ColorSpinorField &w, ColorSpinorField &u)
     {
+      using expr::_0;
+      using expr::_1;
+      using expr::_2;
+      using expr::_3;
+      using expr::_4;
+      if (expr::fusable({&x, &y, &z, &w, &u}))
+        return expr::eval({&x, &y, &z, &w, &u}, _2 = _2 + a * _0 + b * _1, _1 = _1 - b * _3, cDotProduct(_4, _1),
+                          norm2(_1));
       return instantiateReduce<caxpbypzYmbwcDotProductUYNormY_, true>(a, b, Complex(0.0), x, z, y, w, u);
     }
 
     Complex axpyCGNorm(double a, ColorSpinorField &x, ColorSpinorField &y)
     {
-      double2 cg_norm = instantiateReduce<axpyCGNorm2, true>(a, 0.0, 0.0, x, y, x, x, x);
+      using expr::_0;
+      using expr::_1;
+      double2 cg_norm = expr::fusable({&x, &y}) ?
+        expr::eval({&x, &y}, norm2(_1 + a * _0), reDotProduct(_1 + a * _0, (_1 + a * _0) - _1), _1 = _1 + a * _0) :
+        instantiateReduce<axpyCGNorm2, true>(a, 0.0, 0.0, x, y, x, x, x);
       return Complex(cg_norm.x, cg_norm.y);
     }
 
@@ -2,6 +2,8 @@
 #include <invert_quda.h>
 #include <multigrid.h>
 #include <eigensolve_quda.h>
+#include <deflation.h>
+#include <solver_telemetry.h>
 #include <cmath>
 
 namespace quda {
@@ -22,7 +24,8 @@ namespace quda {
     eig_solve(nullptr),
     deflate_init(false),
     deflate_compute(true),
-    recompute_evals(!param.eig_param.preserve_evals)
+    recompute_evals(!param.eig_param.preserve_evals),
+    evecs_compressed(nullptr)
   {
     // compute parity of the node
     for (int i=0; i<4; i++) node_parity += commCoords(i);
@@ -186,7 +189,29 @@ namespace quda {
 
       deflation_space *space = reinterpret_cast<deflation_space *>(param.eig_param.preserve_deflation_space);
 
-      if (space && space->evecs.size() != 0) {
+      if (space && space->compressed) {
+        if (getVerbosity() >= QUDA_VERBOSE)
+          printfQuda("Restoring compressed deflation space of size %d\n", space->compressed->size());
+
+        if (param.eig_param.n_conv != space->compressed->size())
+          errorQuda("Preserved deflation space size %d does not match expected %d", space->compressed->size(),
+                    param.eig_param.n_conv);
+        if (param.eig_param.n_conv != (int)space->evals.size())
+          errorQuda("Preserved eigenvalues %lu does not match expected %d", space->evals.size(), param.eig_param.n_conv);
+
+        // move the compressed space and eigenvalues to the local space
+        evecs_compressed = space->compressed;
+        for (auto &val : space->evals) evals.push_back(val);
+
+        space->compressed = nullptr;
+        space->evals.resize(0);
+
+        delete space;
+        param.eig_param.preserve_deflation_space = nullptr;
+
+        // we successfully got the deflation space so disable any subsequent recalculation
+        deflate_compute = false;
+      } else if (space && space->evecs.size() != 0) {
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Restoring deflation space of size %lu\n", space->evecs.size());
 
         if ((!space->svd && param.eig_param.n_conv != (int)space->evecs.size())
@@ -237,6 +262,7 @@ namespace quda {
           for (auto &vec : space->evecs)
             if (vec) delete vec;
           space->evecs.resize(0);
+          if (space->compressed) delete space->compressed;
           delete space;
         }
 
@@ -245,6 +271,8 @@ namespace quda {
         // if evecs size = 2x evals size then we are doing an SVD deflation
         space->svd = (evecs.size() == 2 * evals.size()) ? true : false;
 
+        space->compressed = evecs_compressed;
+
         space->evecs.reserve(evecs.size());
         for (auto &vec : evecs) space->evecs.push_back(vec);
 
@@ -255,9 +283,11 @@ namespace quda {
       } else {
         for (auto &vec : evecs)
           if (vec) delete vec;
+        if (evecs_compressed) delete evecs_compressed;
       }
 
       evecs.resize(0);
+      evecs_compressed = nullptr;
       deflate_init = false;
     }
   }
@@ -297,6 +327,41 @@ namespace quda {
     }
   }
 
+  void Solver::compressDeflationSpace()
+  {
+    if (!param.eig_param.compress_deflation || evecs_compressed) return;
+    if (evecs.size() == 2 * evals.size()) errorQuda("Compressed deflation is not supported for SVD deflation");
+
+    bool profile_running = profile.isRunning(QUDA_PROFILE_INIT);
+    if (!param.is_preconditioner && !profile_running) profile.TPSTART(QUDA_PROFILE_INIT);
+
+    evecs_compressed = new CompressedDeflationSpace(param.eig_param, evecs,
+                                                    impliedParityFromMatPC(matEig.getMatPCType()));
+    for (auto &vec : evecs)
+      if (vec) delete vec;
+    evecs.resize(0);
+
+    if (!param.is_preconditioner && !profile_running) profile.TPSTOP(QUDA_PROFILE_INIT);
+  }
+
+  void Solver::computeDeflationEvals()
+  {
+    if (evecs_compressed)
+      evecs_compressed->computeEvals(matEig, param.precision_eigensolver, evals);
+    else
+      eig_solve->computeEvals(matEig, evecs, evals);
+  }
+
+  void Solver::deflate(ColorSpinorField &sol, const ColorSpinorField &src, bool accumulate)
+  {
+    if (evecs_compressed)
+      evecs_compressed->deflate(sol, src, evals, accumulate);
+    else
+      eig_solve->deflate(sol, src, evecs, evals, accumulate);
+  }
+
+  int Solver::deflationSpaceSize() const { return evecs_compressed ? evecs_compressed->size() : (int)evecs.size(); }
+
   void Solver::blocksolve(ColorSpinorField& out, ColorSpinorField& in)
   {
     for (int i = 0; i < param.num_src; i++) {
@@ -379,11 +444,20 @@ namespace quda {
       }
     }
 
+    // hq2 here is the heavy-quark residual itself, while telemetry takes its square
+    if (!param.is_preconditioner && telemetry::active()) telemetry::residual(k, r2, b2, hq2 * hq2);
+
     if (std::isnan(r2) || std::isinf(r2)) errorQuda("Solver appears to have diverged");
   }
 
   void Solver::PrintSummary(const char *name, int k, double r2, double b2,
                             double r2_tol, double hq_tol) {
+    PrintSummary(name, k, r2, b2, r2_tol, hq_tol, blas::flops);
+  }
+
+  void Solver::PrintSummary(const char *name, int k, double r2, double b2, double r2_tol, double hq_tol,
+                            unsigned long long blas_flops)
+  {
     if (getVerbosity() >= QUDA_SUMMARIZE) {
       if (param.compute_true_res) {
 	if (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL) {
@@ -405,6 +479,8 @@ namespace quda {
 	}
       }
     }
+
+    if (!param.is_preconditioner && telemetry::active()) telemetry::solve(name, k, blas_flops);
   }
 
   bool MultiShiftSolver::convergence(const double *r2, const double *r2_tol, int n) const {
@@ -0,0 +1,237 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include <quda_internal.h>
+#include <blas_quda.h>
+#include <comm_quda.h>
+#include <solver_telemetry.h>
+
+namespace quda
+{
+
+  namespace telemetry
+  {
+
+    bool recording = false;
+
+    struct SolveRecord {
+      std::string name;
+      int iter;
+      unsigned long long blas_flops;
+    };
+
+    struct ResidualRecord {
+      int k;
+      double r;
+      double hq;
+    };
+
+    /** The record being collected for the current top-level solve */
+    struct Record {
+      std::string name;
+      double time[QUDA_PROFILE_COUNT];
+      unsigned long long blas_bytes;
+      std::vector<ResidualRecord> history;
+      std::vector<SolveRecord> solves;
+      std::map<std::string, long> counters;
+      std::map<std::string, unsigned long long> flops;
+      std::map<int, std::map<std::string, double>> mg;
+    };
+
+    static Record record;
+    static int depth = 0;
+
+    /**
+       @return The sink named by QUDA_TELEMETRY_FILE, or nullptr if
+       telemetry is disabled.  The environment is only queried once.
+    */
+    static FILE *sink()
+    {
+      static bool init = false;
+      static FILE *file = nullptr;
+      if (!init) {
+        char *path = getenv("QUDA_TELEMETRY_FILE");
+        if (path && strlen(path) > 0 && comm_rank() == 0) {
+          if (strcmp(path, "stdout") == 0) {
+            file = stdout;
+          } else {
+            file = fopen(path, "a");
+            if (!file) warningQuda("Cannot open telemetry file %s, telemetry disabled", path);
+          }
+          if (file && getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Writing solver telemetry to %s\n", path);
+        }
+        init = true;
+      }
+      return file;
+    }
+
+    static std::string quote(const std::string &s)
+    {
+      std::string q = "\"";
+      for (auto c : s) {
+        if (c == '"' || c == '\\') q += '\\';
+        q += (c >= 0 && c < 0x20) ? ' ' : c;
+      }
+      return q + "\"";
+    }
+
+    /** JSON has no representation of nan or inf */
+    static std::string number(double x)
+    {
+      if (!std::isfinite(x)) return "null";
+      char buf[32];
+      snprintf(buf, sizeof(buf), "%.10g", x);
+      return buf;
+    }
+
+    void begin(const char *name, TimeProfile &profile)
+    {
+      if (depth++ > 0 || !sink()) return;
+
+      record = Record();
+      record.name = name;
+      for (int i = 0; i < QUDA_PROFILE_COUNT; i++) record.time[i] = profile.Time(static_cast<QudaProfileType>(i));
+      record.blas_bytes = blas::bytes;
+      recording = true;
+    }
+
+    void end(const QudaInvertParam &param, TimeProfile &profile)
+    {
+      if (--depth > 0 || !recording) return;
+      recording = false;
+
+      std::ostringstream json;
+      json << "{\"function\":" << quote(record.name);
+      json << ",\"inv_type\":" << param.inv_type;
+      json << ",\"iter\":" << param.iter;
+      json << ",\"secs\":" << number(param.secs);
+      json << ",\"gflops\":" << number(param.gflops);
+      json << ",\"true_res\":" << number(param.true_res);
+      json << ",\"true_res_hq\":" << number(param.true_res_hq);
+
+      // always report the common counters, even if zero
+      for (auto key : {"reliable_updates", "restarts"}) record.counters[key] += 0;
+      for (auto &c : record.counters) json << "," << quote(c.first) << ":" << c.second;
+
+      json << ",\"solves\":[";
+      for (auto it = record.solves.begin(); it != record.solves.end(); it++) {
+        json << (it == record.solves.begin() ? "" : ",") << "{\"name\":" << quote(it->name) << ",\"iter\":" << it->iter
+             << "}";
+      }
+      json << "]";
+
+      json << ",\"residual_history\":[";
+      for (auto it = record.history.begin(); it != record.history.end(); it++) {
+        json << (it == record.history.begin() ? "" : ",") << "[" << it->k << "," << number(it->r) << ","
+             << number(it->hq) << "]";
+      }
+      json << "]";
+
+      json << ",\"profile\":{";
+      bool first = true;
+      for (int i = 0; i < QUDA_PROFILE_COUNT; i++) {
+        auto idx = static_cast<QudaProfileType>(i);
+        if (idx == QUDA_PROFILE_LOWER_LEVEL) continue;
+        double t = profile.Time(idx) - record.time[i];
+        if (t <= 0.0) continue;
+        json << (first ? "" : ",") << quote(TimeProfile::Name(idx)) << ":" << number(t);
+        first = false;
+      }
+      json << "}";
+
+      unsigned long long blas_flops = 0;
+      for (auto &s : record.solves) blas_flops += s.blas_flops;
+      json << ",\"flops\":{\"blas\":" << blas_flops;
+      for (auto &f : record.flops) json << "," << quote(f.first) << ":" << f.second;
+      json << "}";
+
+      json << ",\"bytes\":{\"blas\":" << blas::bytes - record.blas_bytes << "}";
+
+      json << ",\"mg_levels\":[";
+      for (auto it = record.mg.begin(); it != record.mg.end(); it++) {
+        json << (it == record.mg.begin() ? "" : ",") << "{\"level\":" << it->first;
+        for (auto &v : it->second) json << "," << quote(v.first) << ":" << number(v.second);
+        json << "}";
+      }
+      json << "]}\n";
+
+      FILE *file = sink();
+      fputs(json.str().c_str(), file);
+      fflush(file);
+    }
+
+    void residual(int k, double r2, double b2, double hq2)
+    {
+      if (!recording) return;
+      record.history.push_back({k, sqrt(r2 / b2), sqrt(hq2)});
+    }
+
+    void solve(const char *name, int k, unsigned long long blas_flops)
+    {
+      if (!recording) return;
+      record.solves.push_back({name, k, blas_flops});
+    }
+
+    void counter(const char *key, long n)
+    {
+      if (!recording) return;
+      record.counters[key] += n;
+    }
+
+    /** Stable name of each operator type, independent of the compiler's type mangling */
+    static const char *diracName(QudaDiracType type)
+    {
+      switch (type) {
+      case QUDA_WILSON_DIRAC: return "wilson";
+      case QUDA_WILSONPC_DIRAC: return "wilson-pc";
+      case QUDA_CLOVER_DIRAC: return "clover";
+      case QUDA_CLOVERPC_DIRAC: return "clover-pc";
+      case QUDA_CLOVER_HASENBUSCH_TWIST_DIRAC: return "clover-hasenbusch-twist";
+      case QUDA_CLOVER_HASENBUSCH_TWISTPC_DIRAC: return "clover-hasenbusch-twist-pc";
+      case QUDA_DOMAIN_WALL_DIRAC: return "domain-wall";
+      case QUDA_DOMAIN_WALLPC_DIRAC: return "domain-wall-pc";
+      case QUDA_DOMAIN_WALL_4D_DIRAC: return "domain-wall-4d";
+      case QUDA_DOMAIN_WALL_4DPC_DIRAC: return "domain-wall-4d-pc";
+      case QUDA_MOBIUS_DOMAIN_WALL_DIRAC: return "mobius";
+      case QUDA_MOBIUS_DOMAIN_WALLPC_DIRAC: return "mobius-pc";
+      case QUDA_MOBIUS_DOMAIN_WALL_EOFA_DIRAC: return "mobius-eofa";
+      case QUDA_MOBIUS_DOMAIN_WALLPC_EOFA_DIRAC: return "mobius-eofa-pc";
+      case QUDA_STAGGERED_DIRAC: return "staggered";
+      case QUDA_STAGGEREDPC_DIRAC: return "staggered-pc";
+      case QUDA_STAGGEREDKD_DIRAC: return "staggered-kd";
+      case QUDA_ASQTAD_DIRAC: return "asqtad";
+      case QUDA_ASQTADPC_DIRAC: return "asqtad-pc";
+      case QUDA_ASQTADKD_DIRAC: return "asqtad-kd";
+      case QUDA_TWISTED_MASS_DIRAC: return "twisted-mass";
+      case QUDA_TWISTED_MASSPC_DIRAC: return "twisted-mass-pc";
+      case QUDA_TWISTED_CLOVER_DIRAC: return "twisted-clover";
+      case QUDA_TWISTED_CLOVERPC_DIRAC: return "twisted-clover-pc";
+      case QUDA_COARSE_DIRAC: return "coarse";
+      case QUDA_COARSEPC_DIRAC: return "coarse-pc";
+      case QUDA_GAUGE_LAPLACE_DIRAC: return "laplace";
+      case QUDA_GAUGE_LAPLACEPC_DIRAC: return "laplace-pc";
+      case QUDA_GAUGE_COVDEV_DIRAC: return "covdev";
+      default: return "unknown";
+      }
+    }
+
+    void operatorFlops(QudaDiracType type, unsigned long long flops)
+    {
+      if (!recording) return;
+      record.flops[diracName(type)] += flops;
+    }
+
+    void mgLevel(int level, const char *key, double value)
+    {
+      if (!recording) return;
+      record.mg[level][key] += value;
+    }
+
+  } // namespace telemetry
+
+} // namespace quda
@@ -13,6 +13,7 @@
 #include <tune_quda.h>
 #include <utility> // for std::swap
 #include <random_quda.h>
+#include <launch_host.h>
 
 namespace quda {
 
@@ -25,11 +26,11 @@ namespace quda {
     const int nParity;
     const int volumeCB;
     RNG rng;
-    Arg(ColorSpinorField &v, RNG &rng) : v(v), nParity(v.SiteSubset()), volumeCB(v.VolumeCB()), rng(rng) { }
+    Arg(ColorSpinorField &v, RNG &rng) : v(v), nParity(v.SiteSubset()), volumeCB(v.VolumeCB()), rng(rng.next()) { }
   };
 
   template<typename real, typename Arg> // Gauss
-  __device__ __host__ inline void genGauss(Arg &arg, cuRNGState& localState, int parity, int x_cb, int s, int c) {
+  __device__ __host__ inline void genGauss(Arg &arg, RNGState &localState, int parity, int x_cb, int s, int c) {
     real phi = 2.0*M_PI*Random<real>(localState);
     real radius = Random<real>(localState);
     radius = sqrt(-1.0 * log(radius));
@@ -37,33 +38,33 @@ namespace quda {
   }
 
   template<typename real, typename Arg> // Uniform
-  __device__ __host__ inline void genUniform(Arg &arg, cuRNGState& localState, int parity, int x_cb, int s, int c) {
+  __device__ __host__ inline void genUniform(Arg &arg, RNGState &localState, int parity, int x_cb, int s, int c) {
     real x = Random<real>(localState);
     real y = Random<real>(localState);
     arg.v(parity, x_cb, s, c) = complex<real>(x, y);
   }
 
-  /** CPU function to reorder spinor fields.  */
-  template <typename real, int Ns, int Nc, QudaNoiseType type, typename Arg> void SpinorNoiseCPU(Arg &arg)
+  /** Generate the noise at one site; the random numbers depend only on the global site index */
+  template <typename real, int Ns, int Nc, QudaNoiseType type, typename Arg>
+  __device__ __host__ inline void genNoise(Arg &arg, int parity, int x_cb)
   {
-
-    for (int parity = 0; parity < arg.nParity; parity++) {
-      for (int x_cb = 0; x_cb < arg.volumeCB; x_cb++) {
-        for (int s = 0; s < Ns; s++) {
-          for (int c = 0; c < Nc; c++) {
-            cuRNGState localState = arg.rng.State()[parity * arg.volumeCB + x_cb];
-            if (type == QUDA_NOISE_GAUSS)
-              genGauss<real>(arg, localState, parity, x_cb, s, c);
-            else if (type == QUDA_NOISE_UNIFORM)
-              genUniform<real>(arg, localState, parity, x_cb, s, c);
-            arg.rng.State()[parity * arg.volumeCB + x_cb] = localState;
-          }
-        }
+    RNGState localState(arg.rng, arg.rng.globalIndex(x_cb, parity));
+    for (int s = 0; s < Ns; s++) {
+      for (int c = 0; c < Nc; c++) {
+        if (type == QUDA_NOISE_GAUSS) genGauss<real>(arg, localState, parity, x_cb, s, c);
+        else if (type == QUDA_NOISE_UNIFORM) genUniform<real>(arg, localState, parity, x_cb, s, c);
       }
     }
   }
 
-  /** CUDA kernel to reorder spinor fields.  Adopts a similar form as the CPU version, using the same inlined functions. */
+  /** CPU function to generate spinor noise.  */
+  template <typename real, int Ns, int Nc, QudaNoiseType type, typename Arg> void SpinorNoiseCPU(Arg &arg)
+  {
+    launchHost([&](int x_cb, int parity, int) { genNoise<real, Ns, Nc, type>(arg, parity, x_cb); }, arg.volumeCB,
+               arg.nParity);
+  }
+
+  /** CUDA kernel to generate spinor noise.  Adopts a similar form as the CPU version, using the same inlined functions. */
   template <typename real, int Ns, int Nc, QudaNoiseType type, typename Arg>
     __global__ void SpinorNoiseGPU(Arg arg) {
 
@@ -73,14 +74,7 @@ namespace quda {
     int parity = blockIdx.y * blockDim.y + threadIdx.y;
     if (parity >= arg.nParity) return;
 
-    cuRNGState localState = arg.rng.State()[parity * arg.volumeCB + x_cb];
-    for (int s=0; s<Ns; s++) {
-      for (int c=0; c<Nc; c++) {
-        if (type == QUDA_NOISE_GAUSS) genGauss<real>(arg, localState, parity, x_cb, s, c);
-        else if (type == QUDA_NOISE_UNIFORM) genUniform<real>(arg, localState, parity, x_cb, s, c);
-      }
-    }
-    arg.rng.State()[parity * arg.volumeCB + x_cb] = localState;
+    genNoise<real, Ns, Nc, type>(arg, parity, x_cb);
   }
 
   template <typename real, int Ns, int Nc, QudaNoiseType type, typename Arg>
@@ -102,8 +96,12 @@ namespace quda {
     }
 
     void apply(const qudaStream_t &stream) {
-      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-      qudaLaunchKernel(SpinorNoiseGPU<real, Ns, Nc, type, Arg>, tp, stream, arg);
+      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
+        SpinorNoiseCPU<real, Ns, Nc, type>(arg);
+      } else {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+        qudaLaunchKernel(SpinorNoiseGPU<real, Ns, Nc, type, Arg>, tp, stream, arg);
+      }
     }
 
     bool advanceTuneParam(TuneParam &param) const {
@@ -114,8 +112,6 @@ namespace quda {
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
     long long flops() const { return 0; }
     long long bytes() const { return meta.Bytes(); }
-    void preTune() { arg.rng.backup(); }
-    void postTune(){ arg.rng.restore(); }
   };
 
   template <typename real, int Ns, int Nc, QudaFieldOrder order>
@@ -147,6 +143,8 @@ namespace quda {
       spinorNoise<real,Ns,Nc,QUDA_FLOAT2_FIELD_ORDER>(in, rngstate, type);
     } else if (in.FieldOrder() == QUDA_FLOAT4_FIELD_ORDER) {
       spinorNoise<real,Ns,Nc,QUDA_FLOAT4_FIELD_ORDER>(in, rngstate, type);
+    } else if (in.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
+      spinorNoise<real,Ns,Nc,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER>(in, rngstate, type);
     } else {
       errorQuda("Order %d not defined (Ns=%d, Nc=%d)", in.FieldOrder(), Ns, Nc);
     }
@@ -200,9 +198,10 @@ namespace quda {
 
   void spinorNoise(ColorSpinorField &src_, RNG &randstates, QudaNoiseType type)
   {
-    // if src is a CPU field then create GPU field
+    // if src is not in a supported order or precision then create GPU field
     ColorSpinorField *src = &src_;
-    if (src_.Location() == QUDA_CPU_FIELD_LOCATION || src_.Precision() < QUDA_SINGLE_PRECISION) {
+    if ((src_.Location() == QUDA_CPU_FIELD_LOCATION && src_.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+        || src_.Precision() < QUDA_SINGLE_PRECISION) {
       ColorSpinorParam param(src_);
       QudaPrecision prec = std::max(src_.Precision(), QUDA_SINGLE_PRECISION);
       param.setPrecision(prec, prec, true); // change to native field order
@@ -225,11 +224,8 @@ namespace quda {
 
   void spinorNoise(ColorSpinorField &src, unsigned long long seed, QudaNoiseType type)
   {
-    RNG *randstates = new RNG(src, seed);
-    randstates->Init();
-    spinorNoise(src, *randstates, type);
-    randstates->Release();
-    delete randstates;
+    RNG randstates(src, seed);
+    spinorNoise(src, randstates, type);
   }
 
 } // namespace quda
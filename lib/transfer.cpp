@@ -6,6 +6,7 @@
 #include <transfer.h>
 #include <multigrid.h>
 #include <malloc_quda.h>
+#include <mg_checkpoint.h>
 
 #include <iostream>
 #include <algorithm>
@@ -19,7 +20,8 @@ namespace quda {
   * however we do even-odd to preserve chirality (that is straightforward)
   */
   Transfer::Transfer(const std::vector<ColorSpinorField *> &B, int Nvec, int n_block_ortho, int *geo_bs, int spin_bs,
-                     QudaPrecision null_precision, const QudaTransferType transfer_type, TimeProfile &profile) :
+                     QudaPrecision null_precision, const QudaTransferType transfer_type, TimeProfile &profile,
+                     MGCheckpoint *checkpoint) :
     B(B),
     Nvec(Nvec),
     NblockOrtho(n_block_ortho),
@@ -121,7 +123,10 @@ namespace quda {
     for (int s = 0; s < B[0]->Nspin(); s++) spin_map[s] = static_cast<int*>(safe_malloc(2*sizeof(int)));
     createSpinMap(spin_bs);
 
-    reset();
+    if (checkpoint)
+      restore(*checkpoint);
+    else
+      reset();
     postTrace();
   }
 
@@ -248,6 +253,26 @@ namespace quda {
     postTrace();
   }
 
+  void Transfer::save(MGCheckpoint &checkpoint) const
+  {
+    if (transfer_type == QUDA_TRANSFER_COARSE_KD || transfer_type == QUDA_TRANSFER_OPTIMIZED_KD) { return; }
+    checkpoint.save("V", Vectors());
+  }
+
+  void Transfer::restore(MGCheckpoint &checkpoint)
+  {
+    if (transfer_type == QUDA_TRANSFER_COARSE_KD || transfer_type == QUDA_TRANSFER_OPTIMIZED_KD) { return; }
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Transfer: restoring prolongator\n");
+
+    if (B[0]->Location() == QUDA_CUDA_FIELD_LOCATION) {
+      checkpoint.load("V", *V_d);
+      if (enable_cpu) *V_h = *V_d;
+    } else {
+      checkpoint.load("V", *V_h);
+      if (enable_gpu) *V_d = *V_h;
+    }
+  }
+
   Transfer::~Transfer() {
     if (spin_map)
     {
@@ -0,0 +1,389 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <comm_quda.h>
+#include <timer.h>
+#include <vector_io.h>
+
+/**
+   Native vector archive for fixed-point eigenvectors and null-space
+   vectors.  After a fixed 256-byte header, the file holds n_vec
+   vectors back to back, each of vector_bytes bytes, so that any
+   contiguous slice of vectors can be read independently.  Within a
+   vector, sites are stored in the checkerboarded order of QUDA's
+   host fields, independent of the process decomposition:
+
+     parity (full fields only) -> s (fifth dimension) -> t -> z -> y -> x_cb
+
+   The x_cb direction is divided into blocks of "block" sites.  Each
+   block is stored as a single float scale factor (the maximum
+   absolute component in the block) followed by the block's
+   spin-color components as 16-bit or 8-bit integers, scaled such
+   that the maximum maps to the largest integer, exactly as QUDA's
+   half and quarter precision fields do with their norm field.
+
+   Every rank reads and writes only the rows of its own sub-volume,
+   with the conversion to and from fixed point done in one threaded
+   pass over a host field in the space-spin-color order.
+*/
+
+namespace quda
+{
+
+  namespace
+  {
+
+    constexpr char archive_magic[8] = {'Q', 'U', 'D', 'A', 'V', 'E', 'C', '1'};
+    constexpr size_t archive_header_bytes = 256;
+    constexpr int32_t archive_endian = 0x01020304;
+
+    /** The archive header, stored at the start of the file */
+    struct ArchiveHeader {
+      char magic[8];
+      int32_t endian;       // archive_endian as written by the host
+      int32_t n_vec;        // number of vectors stored
+      int32_t n_spin;
+      int32_t n_color;
+      int32_t n_parity;     // 2 for full fields, 1 for single-parity fields
+      int32_t parity;       // the suggested parity of single-parity fields
+      int32_t X[5];         // global dimensions, with X[0] checkerboarded and X[4] the fifth dimension
+      int32_t bits;         // bits per component (16 or 8)
+      int32_t block;        // sites per scale factor along x_cb
+      int64_t vector_bytes; // bytes per vector
+
+      size_t reals() const { return 2 * n_spin * n_color; }
+      size_t blockBytes() const { return sizeof(float) + block * reals() * bits / 8; }
+      size_t rows() const { return (size_t)n_parity * X[4] * X[3] * X[2] * X[1]; }
+      size_t rowBytes() const { return (X[0] / block) * blockBytes(); }
+    };
+
+    static_assert(sizeof(ArchiveHeader) <= archive_header_bytes, "ArchiveHeader exceeds the reserved header size");
+
+    /** The local sub-volume of a vector and its placement in the archive */
+    struct ArchiveGeometry {
+      int X[5];   // local dimensions, with X[0] checkerboarded
+      int o[4];   // offset of this rank in global (checkerboarded) coordinates
+      int n_parity;
+
+      ArchiveGeometry(const ColorSpinorField &v)
+      {
+        n_parity = v.SiteSubset() == QUDA_FULL_SITE_SUBSET ? 2 : 1;
+        X[0] = v.SiteSubset() == QUDA_FULL_SITE_SUBSET ? v.X(0) / 2 : v.X(0);
+        for (int d = 1; d < 4; d++) X[d] = v.X(d);
+        X[4] = v.Ndim() == 5 ? v.X(4) : 1;
+        for (int d = 0; d < 4; d++) o[d] = comm_coord(d) * X[d];
+      }
+
+      int rows() const { return n_parity * X[4] * X[3] * X[2] * X[1]; }
+
+      /**
+         @return The byte offset of local row r within a vector
+      */
+      size_t offset(const ArchiveHeader &h, int r) const
+      {
+        const int y = r % X[1];
+        const int z = (r / X[1]) % X[2];
+        const int t = (r / (X[1] * X[2])) % X[3];
+        const int s = (r / (X[1] * X[2] * X[3])) % X[4];
+        const int p = r / (X[1] * X[2] * X[3] * X[4]);
+        const size_t grow = (((size_t)(p * h.X[4] + s) * h.X[3] + (t + o[3])) * h.X[2] + (z + o[2])) * h.X[1] + (y + o[1]);
+        return grow * h.rowBytes() + (o[0] / h.block) * h.blockBytes();
+      }
+    };
+
+    /**
+       @brief Quantize one row of a vector to fixed point
+       @param[out] buffer The encoded row
+       @param[in] v The row of the space-spin-color host field
+       @param[in] n_block The number of blocks in the row
+       @param[in] n The number of reals per block
+    */
+    template <typename Int, typename Float>
+    void encodeRow(unsigned char *buffer, const Float *v, int n_block, int n)
+    {
+      constexpr Float max = std::numeric_limits<Int>::max();
+      for (int b = 0; b < n_block; b++, v += n) {
+        Float scale = 0.0;
+        for (int i = 0; i < n; i++) scale = std::max(scale, std::fabs(v[i]));
+        const float scale_f = scale;
+        memcpy(buffer, &scale_f, sizeof(float));
+        buffer += sizeof(float);
+
+        const Float inv = scale_f > 0.0f ? max / scale_f : 0.0;
+        Int *q = reinterpret_cast<Int *>(buffer);
+        for (int i = 0; i < n; i++) q[i] = static_cast<Int>(std::max(-max, std::min(max, std::round(v[i] * inv))));
+        buffer += n * sizeof(Int);
+      }
+    }
+
+    /**
+       @brief Expand one row of a vector from fixed point
+       @param[out] v The row of the space-spin-color host field
+       @param[in] buffer The encoded row
+       @param[in] n_block The number of blocks in the row
+       @param[in] n The number of reals per block
+    */
+    template <typename Int, typename Float>
+    void decodeRow(Float *v, const unsigned char *buffer, int n_block, int n)
+    {
+      constexpr Float max = std::numeric_limits<Int>::max();
+      for (int b = 0; b < n_block; b++, v += n) {
+        float scale;
+        memcpy(&scale, buffer, sizeof(float));
+        buffer += sizeof(float);
+
+        const Float s = scale / max;
+        const Int *q = reinterpret_cast<const Int *>(buffer);
+        for (int i = 0; i < n; i++) v[i] = s * q[i];
+        buffer += n * sizeof(Int);
+      }
+    }
+
+    /**
+       @brief Write the local sub-volume of one vector
+       @return Whether all writes succeeded
+    */
+    template <typename Int, typename Float>
+    bool encode(int fd, off_t base, const Float *v, const ArchiveHeader &h, const ArchiveGeometry &g)
+    {
+      const int n_block = g.X[0] / h.block;
+      const int n = h.block * h.reals();
+      const size_t row_bytes = n_block * h.blockBytes();
+
+      bool failed = false;
+#pragma omp parallel reduction(|| : failed)
+      {
+        std::vector<unsigned char> buffer(row_bytes);
+#pragma omp for schedule(static)
+        for (int r = 0; r < g.rows(); r++) {
+          encodeRow<Int>(buffer.data(), v + (size_t)r * n_block * n, n_block, n);
+          if (pwrite(fd, buffer.data(), row_bytes, base + g.offset(h, r)) != static_cast<ssize_t>(row_bytes))
+            failed = true;
+        }
+      }
+      return !failed;
+    }
+
+    /**
+       @brief Read the local sub-volume of one vector
+       @return Whether all reads succeeded
+    */
+    template <typename Int, typename Float>
+    bool decode(Float *v, int fd, off_t base, const ArchiveHeader &h, const ArchiveGeometry &g)
+    {
+      const int n_block = g.X[0] / h.block;
+      const int n = h.block * h.reals();
+      const size_t row_bytes = n_block * h.blockBytes();
+
+      bool failed = false;
+#pragma omp parallel reduction(|| : failed)
+      {
+        std::vector<unsigned char> buffer(row_bytes);
+#pragma omp for schedule(static)
+        for (int r = 0; r < g.rows(); r++) {
+          if (pread(fd, buffer.data(), row_bytes, base + g.offset(h, r)) != static_cast<ssize_t>(row_bytes)) {
+            failed = true;
+            continue;
+          }
+          decodeRow<Int>(v + (size_t)r * n_block * n, buffer.data(), n_block, n);
+        }
+      }
+      return !failed;
+    }
+
+    template <typename Float>
+    bool encodeVector(int fd, off_t base, const Float *v, const ArchiveHeader &h, const ArchiveGeometry &g)
+    {
+      return h.bits == 16 ? encode<int16_t>(fd, base, v, h, g) : encode<int8_t>(fd, base, v, h, g);
+    }
+
+    template <typename Float>
+    bool decodeVector(Float *v, int fd, off_t base, const ArchiveHeader &h, const ArchiveGeometry &g)
+    {
+      return h.bits == 16 ? decode<int16_t>(v, fd, base, h, g) : decode<int8_t>(v, fd, base, h, g);
+    }
+
+    /**
+       @return Whether v can be encoded or decoded in place
+    */
+    bool directAccess(const ColorSpinorField &v)
+    {
+      return v.Location() == QUDA_CPU_FIELD_LOCATION && v.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER
+        && v.Precision() >= QUDA_SINGLE_PRECISION;
+    }
+
+    /**
+       @return A host space-spin-color field through which v is staged
+    */
+    ColorSpinorField *stagingField(const ColorSpinorField &v)
+    {
+      ColorSpinorParam param(v);
+      param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+      param.setPrecision(v.Precision() < QUDA_SINGLE_PRECISION ? QUDA_SINGLE_PRECISION : v.Precision());
+      param.location = QUDA_CPU_FIELD_LOCATION;
+      param.create = QUDA_NULL_FIELD_CREATE;
+      return ColorSpinorField::Create(param);
+    }
+
+  } // namespace
+
+  bool VectorIO::isArchive() const
+  {
+    char magic[sizeof(archive_magic)] = {};
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool archive = read(fd, magic, sizeof(magic)) == sizeof(magic) && memcmp(magic, archive_magic, sizeof(magic)) == 0;
+    close(fd);
+    return archive;
+  }
+
+  void VectorIO::saveArchive(const std::vector<ColorSpinorField *> &vecs)
+  {
+    const int Nvec = vecs.size();
+    const ColorSpinorField &meta = *vecs[0];
+    if (meta.Precision() != QUDA_HALF_PRECISION && meta.Precision() != QUDA_QUARTER_PRECISION)
+      errorQuda("Vector archives store half or quarter precision, not %d", meta.Precision());
+
+    ArchiveGeometry g(meta);
+    ArchiveHeader h = {};
+    memcpy(h.magic, archive_magic, sizeof(archive_magic));
+    h.endian = archive_endian;
+    h.n_vec = Nvec;
+    h.n_spin = meta.Nspin();
+    h.n_color = meta.Ncolor();
+    h.n_parity = g.n_parity;
+    h.parity = meta.SuggestedParity();
+    for (int d = 0; d < 4; d++) h.X[d] = g.X[d] * comm_dim(d);
+    h.X[4] = g.X[4];
+    h.bits = meta.Precision() == QUDA_HALF_PRECISION ? 16 : 8;
+
+    char *block_env = getenv("QUDA_VECTOR_ARCHIVE_BLOCK");
+    h.block = block_env ? atoi(block_env) : 1;
+    if (h.block <= 0 || g.X[0] % h.block != 0)
+      errorQuda("Vector archive block size %d does not divide the local checkerboarded x dimension %d", h.block, g.X[0]);
+    h.vector_bytes = h.rows() * h.rowBytes();
+
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Start saving %d vectors to archive %s (%d-bit, %d sites per scale)\n", Nvec, filename.c_str(), h.bits,
+                 h.block);
+
+    TimeProfile profile("VectorIO::saveArchive", false);
+    profile.TPSTART(QUDA_PROFILE_IO);
+
+    const off_t data_bytes = archive_header_bytes + Nvec * h.vector_bytes;
+    if (comm_rank() == 0) {
+      int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd < 0 || ftruncate(fd, data_bytes) != 0) errorQuda("Cannot create vector archive %s", filename.c_str());
+      std::vector<char> header(archive_header_bytes, 0);
+      memcpy(header.data(), &h, sizeof(h));
+      if (pwrite(fd, header.data(), header.size(), 0) != static_cast<ssize_t>(header.size()))
+        errorQuda("Failed to write vector archive header to %s", filename.c_str());
+      close(fd);
+    }
+    comm_barrier();
+
+    int fd = open(filename.c_str(), O_WRONLY);
+    if (fd < 0) errorQuda("Cannot open vector archive %s", filename.c_str());
+
+    ColorSpinorField *tmp = stagingField(meta);
+    bool ok = true;
+    for (int i = 0; i < Nvec; i++) {
+      *tmp = *vecs[i];
+      const off_t base = archive_header_bytes + i * h.vector_bytes;
+      if (tmp->Precision() == QUDA_DOUBLE_PRECISION)
+        ok = encodeVector(fd, base, static_cast<const double *>(tmp->V()), h, g) && ok;
+      else
+        ok = encodeVector(fd, base, static_cast<const float *>(tmp->V()), h, g) && ok;
+    }
+    delete tmp;
+    close(fd);
+
+    if (!ok) errorQuda("Failed to write vector archive %s", filename.c_str());
+    comm_barrier();
+    profile.TPSTOP(QUDA_PROFILE_IO);
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      double secs = profile.Last(QUDA_PROFILE_IO);
+      printfQuda("Done saving vectors: %.3f GB in %.3f secs (%.3f GB/s)\n", data_bytes / 1e9, secs,
+                 data_bytes / (1e9 * secs));
+    }
+  }
+
+  void VectorIO::loadArchive(std::vector<ColorSpinorField *> &vecs, int first)
+  {
+    const int Nvec = vecs.size();
+    const ColorSpinorField &meta = *vecs[0];
+    ArchiveGeometry g(meta);
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) errorQuda("Cannot open vector archive %s", filename.c_str());
+    ArchiveHeader h;
+    if (pread(fd, &h, sizeof(h), 0) != sizeof(h)) errorQuda("Cannot read vector archive header from %s", filename.c_str());
+
+    if (h.endian != archive_endian) errorQuda("Vector archive %s was written with a different byte order", filename.c_str());
+    if (h.n_spin != meta.Nspin() || h.n_color != meta.Ncolor())
+      errorQuda("Vector archive nSpin = %d, nColor = %d does not match nSpin = %d, nColor = %d", h.n_spin, h.n_color,
+                meta.Nspin(), meta.Ncolor());
+    if (h.n_parity != g.n_parity)
+      errorQuda("Vector archive site subset (%d parities) does not match the field (%d parities)", h.n_parity,
+                g.n_parity);
+    for (int d = 0; d < 4; d++) {
+      if (h.X[d] != g.X[d] * comm_dim(d))
+        errorQuda("Vector archive dimension %d = %d does not match %d", d, h.X[d], g.X[d] * comm_dim(d));
+    }
+    if (h.X[4] != g.X[4]) errorQuda("Vector archive fifth dimension %d does not match %d", h.X[4], g.X[4]);
+    if (h.bits != 16 && h.bits != 8) errorQuda("Unsupported vector archive component size %d", h.bits);
+    if (h.block <= 0 || g.X[0] % h.block != 0)
+      errorQuda("Vector archive block size %d does not divide the local checkerboarded x dimension %d", h.block, g.X[0]);
+    if (first < 0 || first + Nvec > h.n_vec)
+      errorQuda("Requested vectors [%d, %d) but archive %s holds %d", first, first + Nvec, filename.c_str(), h.n_vec);
+
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Start loading %04d vectors from archive %s (%d-bit, %d sites per scale)\n", Nvec, filename.c_str(),
+                 h.bits, h.block);
+
+    TimeProfile profile("VectorIO::loadArchive", false);
+    profile.TPSTART(QUDA_PROFILE_IO);
+
+    ColorSpinorField *tmp = nullptr;
+    bool ok = true;
+    for (int i = 0; i < Nvec; i++) {
+      // decode directly into host fields of a compatible order, else stage and reorder
+      ColorSpinorField &dst = *vecs[i];
+      ColorSpinorField *v = &dst;
+      if (!directAccess(dst)) {
+        if (!tmp) tmp = stagingField(meta);
+        v = tmp;
+      }
+
+      const off_t base = archive_header_bytes + (first + i) * h.vector_bytes;
+      if (v->Precision() == QUDA_DOUBLE_PRECISION)
+        ok = decodeVector(static_cast<double *>(v->V()), fd, base, h, g) && ok;
+      else
+        ok = decodeVector(static_cast<float *>(v->V()), fd, base, h, g) && ok;
+      if (v != &dst) dst = *v;
+    }
+    if (tmp) delete tmp;
+    close(fd);
+
+    if (!ok) errorQuda("Failed to read vector archive %s", filename.c_str());
+    profile.TPSTOP(QUDA_PROFILE_IO);
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      double secs = profile.Last(QUDA_PROFILE_IO);
+      double bytes = static_cast<double>(Nvec) * h.vector_bytes;
+      printfQuda("Done loading vectors: %.3f GB in %.3f secs (%.3f GB/s)\n", bytes / 1e9, secs, bytes / (1e9 * secs));
+    }
+  }
+
+} // namespace quda
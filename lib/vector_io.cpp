@@ -2,24 +2,299 @@
 #include <qio_field.h>
 #include <vector_io.h>
 #include <blas_quda.h>
+#include <algorithm>
 
 namespace quda
 {
 
-  VectorIO::VectorIO(const std::string &filename, bool parity_inflate) :
-#ifdef HAVE_QIO
+  VectorIO::VectorIO(const std::string &filename, bool parity_inflate, bool archive) :
     filename(filename),
-    parity_inflate(parity_inflate)
-#else
-    filename(filename)
+    archive(archive)
+#ifdef HAVE_QIO
+    ,
+    parity_inflate(parity_inflate),
+    buffer_bytes(0)
 #endif
   {
     if (strcmp(filename.c_str(), "") == 0) { errorQuda("No eigenspace input file defined."); }
+
+    char *archive_env = getenv("QUDA_VECTOR_ARCHIVE");
+    if (archive_env && strcmp(archive_env, "0") != 0) this->archive = true;
+
+#ifdef HAVE_QIO
+    char *buffer_size_env = getenv("QUDA_IO_BUFFER_SIZE");
+    if (buffer_size_env) {
+      long buffer_size = atol(buffer_size_env);
+      if (buffer_size <= 0) errorQuda("Invalid QUDA_IO_BUFFER_SIZE=%s", buffer_size_env);
+      buffer_bytes = static_cast<size_t>(buffer_size) << 20;
+    }
+#endif
+  }
+
+#ifdef HAVE_QIO
+  /**
+     @brief A ring of two host staging slots through which vectors
+     are streamed for I/O.  Each slot holds a batch of host fields
+     that reference a single pinned allocation, and for device
+     vectors a device buffer of the same size.  All QUDA kernels and
+     communication are issued from the calling thread: only the raw
+     host-device transfers of a slot run asynchronously on the
+     default stream, overlapping with the file I/O of the other slot.
+   */
+  struct StagingRing {
+    int batch;                                  /** Number of vectors per slot */
+    int Ls;                                     /** Number of 4-d slices per vector */
+    size_t bytes;                               /** Bytes per vector */
+    size_t stride;                              /** Bytes per 4-d slice */
+    void *buffer[2];                            /** Pinned allocation per slot */
+    void *device_buffer[2];                     /** Device allocation per slot (device vectors only) */
+    cudaEvent_t event[2];                       /** Completion of the last transfer into or out of each slot */
+    std::vector<ColorSpinorField *> field[2];   /** Host fields per slot */
+    std::vector<void *> V[2];                   /** Pointers to the 4-d slices handed to QIO per slot */
+
+    StagingRing(const ColorSpinorField &meta, bool inflate, int batch) :
+      batch(batch), device_buffer {nullptr, nullptr}
+    {
+      ColorSpinorParam csParam(meta);
+      csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+      csParam.setPrecision(meta.Precision() < QUDA_SINGLE_PRECISION ? QUDA_SINGLE_PRECISION : meta.Precision());
+      csParam.location = QUDA_CPU_FIELD_LOCATION;
+      if (inflate) {
+        csParam.x[0] *= 2;
+        csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+      }
+      csParam.create = QUDA_REFERENCE_FIELD_CREATE;
+
+      size_t volume = 1;
+      for (int d = 0; d < csParam.nDim; d++) volume *= csParam.x[d];
+      bytes = volume * csParam.nSpin * csParam.nColor * 2 * csParam.Precision();
+      Ls = csParam.nDim == 5 ? csParam.x[4] : 1;
+      stride = bytes / Ls;
+
+      for (int s = 0; s < 2; s++) {
+        buffer[s] = pool_pinned_malloc(batch * bytes);
+        if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) device_buffer[s] = pool_device_malloc(batch * bytes);
+        cudaEventCreateWithFlags(&event[s], cudaEventDisableTiming);
+        for (int i = 0; i < batch; i++) {
+          csParam.v = static_cast<char *>(buffer[s]) + i * bytes;
+          field[s].push_back(ColorSpinorField::Create(csParam));
+        }
+        V[s].resize(batch * Ls);
+      }
+    }
+
+    ~StagingRing()
+    {
+      for (int s = 0; s < 2; s++) {
+        wait(s);
+        cudaEventDestroy(event[s]);
+        for (auto &f : field[s]) delete f;
+        if (device_buffer[s]) pool_device_free(device_buffer[s]);
+        pool_pinned_free(buffer[s]);
+      }
+    }
+
+    /**
+       @brief Wait for the outstanding transfer (if any) of a slot to complete
+       @param[in] s The slot
+    */
+    void wait(int s) { qudaEventSynchronize(event[s]); }
+
+    /**
+       @brief Return the device copy of part of a staged vector
+       @param[in] s The slot
+       @param[in] i The vector within the slot
+       @param[in] host The host field (or parity subset thereof) being mirrored
+    */
+    void *device(int s, int i, const ColorSpinorField &host)
+    {
+      size_t offset = static_cast<const char *>(host.V()) - static_cast<const char *>(field[s][i]->V());
+      return static_cast<char *>(device_buffer[s]) + i * bytes + offset;
+    }
+
+    /**
+       @brief Return the QIO pointers to the 4-d slices of the first n
+       vectors of a slot
+       @param[in] s The slot
+       @param[in] n The number of vectors
+    */
+    void **pointers(int s, int n)
+    {
+      for (int i = 0; i < n; i++)
+        for (int j = 0; j < Ls; j++) V[s][i * Ls + j] = static_cast<char *>(field[s][i]->V()) + j * stride;
+      return V[s].data();
+    }
+  };
+
+  // number of vectors per batch such that the two staging slots fit within the budget
+  static int batchSize(const ColorSpinorField &meta, bool inflate, size_t buffer_bytes, int Nvec)
+  {
+    size_t bytes = meta.Volume() * meta.Nspin() * meta.Ncolor() * 2
+      * (meta.Precision() < QUDA_SINGLE_PRECISION ? QUDA_SINGLE_PRECISION : meta.Precision()) * (inflate ? 2 : 1);
+    int batch = std::min(static_cast<size_t>(Nvec), buffer_bytes / (2 * bytes));
+    if (batch == 0) {
+      if (buffer_bytes > 0)
+        warningQuda("I/O buffer size %lu is too small to stage two vectors of %lu bytes, using a batch size of one",
+                    buffer_bytes, bytes);
+      batch = 1;
+    }
+    return batch;
+  }
+
+  void VectorIO::loadBatched(std::vector<ColorSpinorField *> &vecs)
+  {
+    const int Nvec = vecs.size();
+    const ColorSpinorField &meta = *vecs[0];
+    auto spinor_parity = meta.SuggestedParity();
+    const bool inflate = meta.SiteSubset() == QUDA_PARITY_SITE_SUBSET && parity_inflate;
+    if (inflate && spinor_parity != QUDA_EVEN_PARITY && spinor_parity != QUDA_ODD_PARITY)
+      errorQuda("When loading single parity vectors, the suggested parity must be set.");
+    const bool device = meta.Location() == QUDA_CUDA_FIELD_LOCATION;
+
+    const int batch = batchSize(meta, inflate, buffer_bytes, Nvec);
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Start loading %04d vectors from %s in batches of %d\n", Nvec, filename.c_str(), batch);
+
+    StagingRing ring(meta, inflate, batch);
+    const int Ls = ring.Ls;
+    int slot = 0;
+
+    // the part of a staged host vector that holds the destination
+    auto part = [inflate, spinor_parity](ColorSpinorField &src) -> ColorSpinorField & {
+      return !inflate ? src : spinor_parity == QUDA_EVEN_PARITY ? src.Even() : src.Odd();
+    };
+
+    // convert the staged vectors [first, first + n) of slot s to their destinations
+    auto convert = [&](int s, int first, int n) {
+      for (int i = 0; i < n; i++) {
+        ColorSpinorField &src = part(*ring.field[s][i]);
+        ColorSpinorField &dst = *vecs[first + i];
+        if (device)
+          copyGenericColorSpinor(dst, src, QUDA_CUDA_FIELD_LOCATION, nullptr, ring.device(s, i, src));
+        else if (inflate)
+          blas::copy(dst, src);
+        else
+          dst = src;
+      }
+    };
+
+    int pending_first = 0, pending_n = 0; // device batch whose transfer is in flight
+
+    auto acquire = [&](int start, int count) -> void ** {
+      if (start % Ls != 0 || count % Ls != 0) errorQuda("File records are not aligned with %d-slice vectors", Ls);
+      ring.wait(slot); // QIO must not overwrite the pinned buffer while it is being transferred
+      return ring.pointers(slot, count / Ls);
+    };
+
+    auto release = [&](int start, int count) {
+      const int first = start / Ls;
+      const int n = count / Ls;
+      if (!device) {
+        convert(slot, first, n);
+      } else {
+        // the conversion of the previous batch is queued ahead of this transfer, and both overlap with
+        // the read of the next batch
+        if (pending_n > 0) convert(1 - slot, pending_first, pending_n);
+        for (int i = 0; i < n; i++) {
+          ColorSpinorField &src = part(*ring.field[slot][i]);
+          qudaMemcpyAsync(ring.device(slot, i, src), src.V(), src.Bytes(), cudaMemcpyHostToDevice, 0);
+        }
+        qudaEventRecord(ring.event[slot], 0);
+        pending_first = first;
+        pending_n = n;
+      }
+      slot = 1 - slot;
+    };
+
+    auto &field = *ring.field[0][0];
+    read_spinor_field_batched(filename.c_str(), field.Precision(), field.X(), field.SiteSubset(), spinor_parity,
+                              field.Ncolor(), field.Nspin(), Nvec * Ls, batch * Ls, acquire, release);
+    if (pending_n > 0) convert(1 - slot, pending_first, pending_n);
+    if (device) qudaDeviceSynchronize();
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Done loading vectors\n");
+  }
+
+  void VectorIO::saveBatched(const std::vector<ColorSpinorField *> &vecs)
+  {
+    const int Nvec = vecs.size();
+    const ColorSpinorField &meta = *vecs[0];
+    auto spinor_parity = meta.SuggestedParity();
+    const bool inflate = meta.SiteSubset() == QUDA_PARITY_SITE_SUBSET && parity_inflate;
+    if (inflate && spinor_parity != QUDA_EVEN_PARITY && spinor_parity != QUDA_ODD_PARITY)
+      errorQuda("When saving single parity vectors, the suggested parity must be set.");
+    const bool device = meta.Location() == QUDA_CUDA_FIELD_LOCATION;
+
+    const int batch = batchSize(meta, inflate, buffer_bytes, Nvec);
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Start saving %d vectors to %s in batches of %d\n", Nvec, filename.c_str(), batch);
+
+    StagingRing ring(meta, inflate, batch);
+    const int Ls = ring.Ls;
+
+    // stage the vectors [first, first + n) into slot s: device vectors are reordered into the device
+    // buffer and transferred asynchronously, host vectors are converted in place
+    auto stage = [&](int s, int first, int n) {
+      for (int i = 0; i < n; i++) {
+        const ColorSpinorField &src = *vecs[first + i];
+        ColorSpinorField &dst = *ring.field[s][i];
+        if (inflate) blas::zero(dst); // the other parity is saved as zero
+        ColorSpinorField &part = !inflate ? dst : spinor_parity == QUDA_EVEN_PARITY ? dst.Even() : dst.Odd();
+        if (device) {
+          copyGenericColorSpinor(part, src, QUDA_CUDA_FIELD_LOCATION, ring.device(s, i, part), nullptr);
+          qudaMemcpyAsync(part.V(), ring.device(s, i, part), part.Bytes(), cudaMemcpyDeviceToHost, 0);
+        } else if (inflate) {
+          blas::copy(part, src);
+        } else {
+          dst = src;
+        }
+      }
+      if (device) qudaEventRecord(ring.event[s], 0);
+    };
+
+    int slot = 0;
+    auto acquire = [&](int start, int count) -> void ** {
+      const int first = start / Ls;
+      const int n = count / Ls;
+      if (first == 0) stage(slot, first, n); // nothing has been prefetched for the first batch
+      ring.wait(slot);
+
+      // overlap staging of the next batch with the write of this one; the other slot was written
+      // out by the previous batch, and its transfer was waited on when that batch was acquired
+      const int next = first + n;
+      if (next < Nvec) stage(1 - slot, next, std::min(batch, Nvec - next));
+      return ring.pointers(slot, n);
+    };
+
+    auto release = [&](int, int) { slot = 1 - slot; };
+
+    auto &field = *ring.field[0][0];
+    write_spinor_field_batched(filename.c_str(), field.Precision(), field.X(), field.SiteSubset(), spinor_parity,
+                               field.Ncolor(), field.Nspin(), Nvec * Ls, batch * Ls, acquire, release);
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Done saving vectors\n");
   }
+#endif
 
-  void VectorIO::load(std::vector<ColorSpinorField *> &vecs)
+  void VectorIO::load(std::vector<ColorSpinorField *> &vecs, int first)
   {
+    if (isArchive()) {
+      loadArchive(vecs, first);
+      return;
+    }
+    if (first != 0) errorQuda("Loading a slice of vectors is only supported for vector archives");
+
 #ifdef HAVE_QIO
+    // host fields that need no staging are read directly regardless of the buffer size, while
+    // fixed-point host fields are always staged through single precision
+    bool compressed = vecs[0]->Location() == QUDA_CPU_FIELD_LOCATION && vecs[0]->Precision() < QUDA_SINGLE_PRECISION;
+    bool staged = vecs[0]->Location() == QUDA_CUDA_FIELD_LOCATION
+      || (vecs[0]->SiteSubset() == QUDA_PARITY_SITE_SUBSET && parity_inflate);
+    if ((buffer_bytes > 0 && staged) || compressed) {
+      loadBatched(vecs);
+      return;
+    }
+
     const int Nvec = vecs.size();
     auto spinor_parity = vecs[0]->SuggestedParity();
     if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Start loading %04d vectors from %s\n", Nvec, filename.c_str());
@@ -118,7 +393,23 @@ namespace quda
 
   void VectorIO::save(const std::vector<ColorSpinorField *> &vecs)
   {
+    // the archive stores fixed-point vectors natively, but is only written when requested
+    if (archive && vecs[0]->Precision() < QUDA_SINGLE_PRECISION) {
+      saveArchive(vecs);
+      return;
+    }
+
 #ifdef HAVE_QIO
+    // host fields that need no staging are written directly regardless of the buffer size, while
+    // fixed-point host fields are always staged through single precision
+    bool compressed = vecs[0]->Location() == QUDA_CPU_FIELD_LOCATION && vecs[0]->Precision() < QUDA_SINGLE_PRECISION;
+    bool staged = vecs[0]->Location() == QUDA_CUDA_FIELD_LOCATION
+      || (vecs[0]->SiteSubset() == QUDA_PARITY_SITE_SUBSET && parity_inflate);
+    if ((buffer_bytes > 0 && staged) || compressed) {
+      saveBatched(vecs);
+      return;
+    }
+
     const int Nvec = vecs.size();
     std::vector<ColorSpinorField *> tmp;
     tmp.reserve(Nvec);
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <quda_internal.h>
+#include <blas_quda.h>
+#include <workspace.h>
+
+namespace quda
+{
+
+  namespace workspace
+  {
+
+    struct Entry {
+      ColorSpinorField *field;
+      ColorSpinorParam param; // parameters the field was created with
+      size_t bytes;
+      bool live;
+      const void *owner; // owner the field is pinned to, if any
+    };
+
+    static std::vector<Entry> arena;
+    static size_t live = 0;
+    static size_t peak = 0;
+    static const void *current_owner = nullptr;
+    static size_t n_created = 0;
+
+    /**
+       @brief Whether a field created with parameters b can serve a request for parameters a
+    */
+    static bool match(const ColorSpinorParam &a, const ColorSpinorParam &b)
+    {
+      if (a.location != b.location || a.Precision() != b.Precision() || a.GhostPrecision() != b.GhostPrecision()
+          || a.nColor != b.nColor || a.nSpin != b.nSpin || a.nVec != b.nVec || a.twistFlavor != b.twistFlavor
+          || a.siteSubset != b.siteSubset || a.siteOrder != b.siteOrder || a.fieldOrder != b.fieldOrder
+          || a.gammaBasis != b.gammaBasis || a.pc_type != b.pc_type || a.nDim != b.nDim || a.pad != b.pad
+          || a.mem_type != b.mem_type || a.ghostExchange != b.ghostExchange || a.is_composite != b.is_composite
+          || a.composite_dim != b.composite_dim)
+        return false;
+      for (int d = 0; d < a.nDim; d++)
+        if (a.x[d] != b.x[d] || a.r[d] != b.r[d]) return false;
+      return true;
+    }
+
+    ColorSpinorField *checkout(const ColorSpinorParam &param)
+    {
+      if (param.is_component) errorQuda("Cannot check out a composite component");
+      if (param.create != QUDA_NULL_FIELD_CREATE && param.create != QUDA_ZERO_FIELD_CREATE)
+        errorQuda("Unsupported create type %d", param.create);
+
+      auto it = std::find_if(arena.begin(), arena.end(),
+                             [&](const Entry &e) { return !e.live && match(param, e.param); });
+
+      if (it == arena.end()) {
+        ColorSpinorParam create_param(param);
+        create_param.create = QUDA_NULL_FIELD_CREATE;
+        ColorSpinorField *field = ColorSpinorField::Create(create_param);
+        arena.push_back({field, create_param, field->Bytes() + field->NormBytes(), false, nullptr});
+        it = arena.end() - 1;
+        n_created++;
+        if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+          printfQuda("Workspace: created field of %lu bytes (%lu fields, %lu bytes held)\n", it->bytes, arena.size(),
+                     pool_bytes());
+      }
+
+      it->live = true;
+      if (!it->owner) it->owner = current_owner;
+      live += it->bytes;
+      peak = std::max(peak, live);
+
+      it->field->setSuggestedParity(param.suggested_parity);
+      if (param.create == QUDA_ZERO_FIELD_CREATE) blas::zero(*it->field);
+      return it->field;
+    }
+
+    void checkin(ColorSpinorField *field)
+    {
+      if (!field) return;
+      auto it = std::find_if(arena.begin(), arena.end(), [&](const Entry &e) { return e.field == field; });
+      if (it == arena.end()) errorQuda("Field %p was not checked out of the workspace", field);
+      if (!it->live) errorQuda("Field %p checked in twice", field);
+      it->live = false;
+      live -= it->bytes;
+    }
+
+    void flush()
+    {
+      for (auto &e : arena) e.owner = nullptr;
+      trim(0);
+    }
+
+    void trim(size_t max_bytes)
+    {
+      // live and pinned fields rank below every other idle field, so are never picked
+      auto idle_bytes = [](const Entry &e) { return e.live || e.owner ? 0 : e.bytes; };
+      size_t held = pool_bytes();
+      while (held > max_bytes) {
+        auto it = std::max_element(arena.begin(), arena.end(),
+                                   [&](const Entry &a, const Entry &b) { return idle_bytes(a) < idle_bytes(b); });
+        if (it == arena.end() || idle_bytes(*it) == 0) break;
+        held -= it->bytes;
+        delete it->field;
+        arena.erase(it);
+      }
+    }
+
+    void set_owner(const void *owner) { current_owner = owner; }
+
+    void release(const void *owner)
+    {
+      for (auto &e : arena)
+        if (e.owner == owner) e.owner = nullptr;
+    }
+
+    size_t retain_bytes()
+    {
+      static const size_t bytes = []() -> size_t {
+        char *retain_env = getenv("QUDA_WORKSPACE_RETAIN");
+        return retain_env ? static_cast<size_t>(std::max(atol(retain_env), 0l)) << 20 : 0;
+      }();
+      return bytes;
+    }
+
+    size_t live_bytes() { return live; }
+
+    size_t peak_bytes() { return peak; }
+
+    size_t pool_bytes()
+    {
+      size_t bytes = 0;
+      for (auto &e : arena) bytes += e.bytes;
+      return bytes;
+    }
+
+    size_t created() { return n_created; }
+
+    void reset_peak() { peak = live; }
+
+  } // namespace workspace
+
+} // namespace quda
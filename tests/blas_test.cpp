@@ -1,9 +1,18 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits>
+#include <random>
+#include <algorithm>
 
 #include <quda_internal.h>
 #include <color_spinor_field.h>
 #include <blas_quda.h>
+#include <workspace.h>
+#include <compensated.h>
+#ifdef GPU_MULTIGRID
+#include <gauge_field.h>
+#include <multigrid.h>
+#endif
 
 #include <host_utils.h>
 #include <command_line_params.h>
@@ -112,7 +121,9 @@ enum class Kernel {
   reDotProduct_block,
   cDotProductNorm_block,
   cDotProduct_block,
-  caxpyXmazMR
+  caxpyXmazMR,
+  fusedCGUpdate,
+  fusedBiCGstabUpdate
 };
 
 // For googletest names must be non-empty, unique, and may only contain ASCII
@@ -155,7 +166,9 @@ const std::map<Kernel, std::string> kernel_map
      {Kernel::reDotProduct_block, "reDotProduct_block"},
      {Kernel::cDotProductNorm_block, "cDotProductNorm_block"},
      {Kernel::cDotProduct_block, "cDotProduct_block"},
-     {Kernel::caxpyXmazMR, "caxpyXmazMR"}};
+     {Kernel::caxpyXmazMR, "caxpyXmazMR"},
+     {Kernel::fusedCGUpdate, "fusedCGUpdate"},
+     {Kernel::fusedBiCGstabUpdate, "fusedBiCGstabUpdate"}};
 
 const int Nkernels = kernel_map.size();
 
@@ -525,6 +538,20 @@ double benchmark(Kernel kernel, const int niter)
       commAsyncReductionSet(false);
       break;
 
+    case Kernel::fusedCGUpdate:
+      for (int i = 0; i < niter; ++i) {
+        blas::axpyCGNorm(a, *xD, *yD);
+        blas::tripleCGUpdate(a, b, *xD, *yD, *zD, *wD);
+      }
+      break;
+
+    case Kernel::fusedBiCGstabUpdate:
+      for (int i = 0; i < niter; ++i) {
+        blas::caxpbypzYmbwcDotProductUYNormY(a2, *xD, b2, *yD, *zD, *wD, *vD);
+        blas::cxpaypbz(*yD, -b2, *vD, b2, *xD);
+      }
+      break;
+
     default: errorQuda("Undefined blas kernel %s\n", kernel_map.at(kernel).c_str());
     }
   }
@@ -976,6 +1003,63 @@ double test(Kernel kernel)
     error = ERROR(x) + ERROR(y);
     break;
 
+  // the fused updates used by CG and BiCGstab, evaluated as blas::expr programs on the device, against the same
+  // updates composed from the elementary kernels on the host
+  case Kernel::fusedCGUpdate:
+    *xD = *xH;
+    *yD = *yH;
+    *zD = *zH;
+    *wD = *wH;
+    {
+      Complex d = blas::axpyCGNorm(-a, *xD, *yD);
+      blas::copy(*vH, *yH);
+      blas::axpy(-a, *xH, *yH);
+      blas::xpay(*yH, -1.0, *vH); // v = y_new - y_old
+      Complex h(blas::norm2(*yH), blas::reDotProduct(*yH, *vH));
+      error = ERROR(y) + fabs(d.real() - h.real()) / fabs(h.real()) + fabs(d.imag() - h.imag()) / fabs(h.imag());
+
+      blas::tripleCGUpdate(a, b, *xD, *yD, *zD, *wD);
+      blas::axpy(a, *wH, *yH);
+      blas::axpy(-a, *xH, *zH);
+      blas::xpay(*zH, b, *wH);
+      error += ERROR(y) + ERROR(z) + ERROR(w);
+
+      blas::axpyZpbx(a, *xD, *yD, *zD, b);
+      blas::axpy(a, *xH, *yH);
+      blas::xpay(*zH, b, *xH);
+      error += ERROR(x) + ERROR(y);
+    }
+    break;
+
+  case Kernel::fusedBiCGstabUpdate:
+    *vD = *vH;
+    *wD = *wH;
+    *xD = *xH;
+    *yD = *yH;
+    *zD = *zH;
+    {
+      blas::caxpbypzYmbw(a2, *xD, b2, *yD, *zD, *wD);
+      blas::caxpy(a2, *xH, *zH);
+      blas::caxpy(b2, *yH, *zH);
+      blas::caxpy(-b2, *wH, *yH);
+      error = ERROR(y) + ERROR(z);
+
+      double3 d = blas::caxpbypzYmbwcDotProductUYNormY(a2, *xD, b2, *yD, *zD, *wD, *vD);
+      blas::caxpy(a2, *xH, *zH);
+      blas::caxpy(b2, *yH, *zH);
+      blas::caxpy(-b2, *wH, *yH);
+      Complex h = blas::cDotProduct(*vH, *yH);
+      double h2 = blas::norm2(*yH);
+      error += ERROR(y) + ERROR(z) + fabs(d.x - h.real()) / fabs(h.real()) + fabs(d.y - h.imag()) / fabs(h.imag())
+        + fabs(d.z - h2) / fabs(h2);
+
+      blas::cxpaypbz(*yD, c2, *vD, b2, *xD);
+      blas::caxpby(c2, *vH, b2, *xH);
+      blas::xpy(*yH, *xH);
+      error += ERROR(x);
+    }
+    break;
+
   default: errorQuda("Undefined blas kernel %s\n", kernel_map.at(kernel).c_str());
   }
   delete[] A;
@@ -1139,3 +1223,319 @@ std::string getblasname(testing::TestParamInfo<::testing::tuple<int, int>> param
 
 // instantiate all test cases
 INSTANTIATE_TEST_SUITE_P(QUDA, BlasTest, Combine(Range(0, (Nprec * (Nprec + 1)) / 2), Range(0, Nkernels)), getblasname);
+
+/**
+   @brief Largest deviation between two single-precision host fields at
+   any site, relative to the largest component of the reference at that
+   site: the per-site norm sets the resolution of a half-precision field.
+*/
+double siteDeviation(const ColorSpinorField &ref, const ColorSpinorField &x)
+{
+  const int len = 2 * ref.Nspin() * ref.Ncolor();
+  const float *r = static_cast<const float *>(ref.V());
+  const float *v = static_cast<const float *>(x.V());
+  double deviation = 0.0;
+  for (size_t i = 0; i < ref.Volume(); i++) {
+    double scale = 0.0;
+    double diff = 0.0;
+    for (int j = 0; j < len; j++) {
+      scale = std::max(scale, std::abs(static_cast<double>(r[i * len + j])));
+      diff = std::max(diff, std::abs(static_cast<double>(r[i * len + j]) - v[i * len + j]));
+    }
+    if (scale > 0.0) deviation = std::max(deviation, diff / scale);
+  }
+  return deviation;
+}
+
+/**
+   Half-precision host fields round-trip through single precision to
+   within the resolution of their per-site norm, and host blas and
+   reductions on them agree with single precision on the rounded values.
+*/
+TEST(HostHalfTest, copy_blas)
+{
+  ColorSpinorParam param;
+  param.nColor = Ncolor;
+  param.nSpin = Nspin;
+  param.nDim = 4;
+  param.pad = 0;
+  param.siteSubset = QUDA_PARITY_SITE_SUBSET;
+  param.x[0] = xdim / 2;
+  param.x[1] = ydim;
+  param.x[2] = zdim;
+  param.x[3] = tdim;
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.location = QUDA_CPU_FIELD_LOCATION;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+  param.setPrecision(QUDA_SINGLE_PRECISION);
+
+  cpuColorSpinorField x(param), y(param), x_round(param), y_round(param), y_half(param);
+  x.Source(QUDA_RANDOM_SOURCE);
+  y.Source(QUDA_RANDOM_SOURCE);
+
+  ColorSpinorParam half_param(param);
+  half_param.setPrecision(QUDA_HALF_PRECISION);
+  cpuColorSpinorField xh(half_param), yh(half_param);
+
+  // one unit in the last place of a 16-bit component, relative to the per-site norm
+  const double tol = 1.0 / std::numeric_limits<short>::max();
+
+  xh = x;
+  yh = y;
+  x_round = xh;
+  y_round = yh;
+  EXPECT_LE(siteDeviation(x, x_round), tol) << "copy round trip";
+  EXPECT_LE(siteDeviation(y, y_round), tol) << "copy round trip";
+
+  double nrm_half = blas::norm2(xh);
+  double nrm_single = blas::norm2(x_round);
+  EXPECT_LE(std::abs(nrm_half - nrm_single), 1e-6 * nrm_single) << "norm2";
+
+  Complex dot_half = blas::cDotProduct(xh, yh);
+  Complex dot_single = blas::cDotProduct(x_round, y_round);
+  EXPECT_LE(std::abs(dot_half - dot_single), 1e-6 * sqrt(nrm_single * blas::norm2(y_round))) << "cDotProduct";
+
+  // the result is rounded once more when it is stored
+  const double a = 0.37;
+  blas::axpy(a, xh, yh);
+  blas::axpy(a, x_round, y_round);
+  y_half = yh;
+  EXPECT_LE(siteDeviation(y_round, y_half), tol) << "axpy";
+}
+
+#ifdef GPU_MULTIGRID
+/**
+   The host coarse dslash on half-precision fields agrees with the
+   single-precision stencil applied to the same rounded input, up to
+   the rounding of the result to the per-site norm.
+*/
+TEST(HostHalfTest, coarse_dslash)
+{
+  const int nSpin = 2;
+  const int nColor = 24;
+
+  ColorSpinorParam param;
+  param.nColor = nColor;
+  param.nSpin = nSpin;
+  param.nDim = 4;
+  param.pad = 0;
+  param.siteSubset = QUDA_FULL_SITE_SUBSET;
+  param.x[0] = xdim;
+  param.x[1] = ydim;
+  param.x[2] = zdim;
+  param.x[3] = tdim;
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.location = QUDA_CPU_FIELD_LOCATION;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+  param.setPrecision(QUDA_SINGLE_PRECISION);
+  cpuColorSpinorField in(param), in_round(param), out(param), out_half_single(param);
+  in.Source(QUDA_RANDOM_SOURCE);
+
+  ColorSpinorParam half_param(param);
+  half_param.setPrecision(QUDA_HALF_PRECISION);
+  half_param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  cpuColorSpinorField in_half(half_param), out_half(half_param);
+  in_half = in;
+  in_round = in_half;
+
+  GaugeFieldParam gParam;
+  for (int d = 0; d < 4; d++) gParam.x[d] = param.x[d];
+  gParam.nColor = nSpin * nColor;
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParam.order = QUDA_QDP_GAUGE_ORDER;
+  gParam.link_type = QUDA_COARSE_LINKS;
+  gParam.t_boundary = QUDA_PERIODIC_T;
+  gParam.create = QUDA_ZERO_FIELD_CREATE;
+  gParam.setPrecision(QUDA_SINGLE_PRECISION);
+  gParam.nDim = 4;
+  gParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  gParam.nFace = 1;
+  gParam.geometry = QUDA_COARSE_GEOMETRY;
+  cpuGaugeField Y(gParam);
+
+  gParam.geometry = QUDA_SCALAR_GEOMETRY;
+  gParam.nFace = 0;
+  cpuGaugeField X(gParam);
+
+  // random links, seeded by rank
+  std::mt19937 rng(1234 + comm_rank());
+  std::uniform_real_distribution<float> dist(-1.0, 1.0);
+  for (auto U : {&Y, &X}) {
+    const size_t n = U->Volume() * U->Ncolor() * U->Ncolor() * 2;
+    for (int g = 0; g < U->Geometry(); g++) {
+      float *u = static_cast<float **>(U->Gauge_p())[g];
+      std::generate(u, u + n, [&]() { return dist(rng); });
+    }
+  }
+  Y.exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+
+  const double kappa = 0.1;
+  ApplyCoarse(out, in_round, in_round, Y, X, kappa);
+  ApplyCoarse(out_half, in_half, in_half, Y, X, kappa);
+  out_half_single = out_half;
+
+  // one unit in the last place of a 16-bit component, relative to the per-site norm
+  EXPECT_LE(siteDeviation(out, out_half_single), 1.0 / std::numeric_limits<short>::max());
+}
+#endif
+
+/**
+   The workspace arena hands idle fields back out to matching requests,
+   never hands out a live field twice, and releases idle fields when
+   trimmed, largest first, while leaving checked-out fields alone.
+*/
+TEST(WorkspaceTest, reuse_release)
+{
+  ColorSpinorParam param;
+  param.nColor = Ncolor;
+  param.nSpin = Nspin;
+  param.nDim = 4;
+  param.siteSubset = QUDA_PARITY_SITE_SUBSET;
+  param.x[0] = xdim / 2;
+  param.x[1] = ydim;
+  param.x[2] = zdim;
+  param.x[3] = tdim;
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.gammaBasis = Nspin == 4 ? QUDA_UKQCD_GAMMA_BASIS : QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.location = QUDA_CUDA_FIELD_LOCATION;
+  param.create = QUDA_NULL_FIELD_CREATE;
+  param.setPrecision(QUDA_SINGLE_PRECISION, QUDA_SINGLE_PRECISION, true);
+
+  workspace::flush();
+  ASSERT_EQ(workspace::pool_bytes(), 0u) << "fields left checked out of the workspace";
+  workspace::reset_peak();
+
+  ColorSpinorField *a = workspace::checkout(param);
+  const size_t bytes = workspace::live_bytes();
+  ASSERT_GT(bytes, 0u);
+  workspace::checkin(a);
+  EXPECT_EQ(workspace::live_bytes(), 0u);
+  EXPECT_EQ(workspace::pool_bytes(), bytes) << "idle field not retained";
+
+  {
+    WorkspaceField b(param);
+    EXPECT_EQ(b.get(), a) << "idle field not reused";
+    WorkspaceField c(param);
+    EXPECT_NE(c.get(), a) << "live field handed out twice";
+    EXPECT_EQ(workspace::peak_bytes(), 2 * bytes);
+  }
+  EXPECT_EQ(workspace::live_bytes(), 0u);
+  EXPECT_EQ(workspace::pool_bytes(), 2 * bytes);
+
+  // a request for a different precision cannot reuse the idle fields
+  ColorSpinorParam param_double(param);
+  param_double.setPrecision(QUDA_DOUBLE_PRECISION, QUDA_DOUBLE_PRECISION, true);
+  ColorSpinorField *d = workspace::checkout(param_double);
+  EXPECT_NE(d, a);
+  const size_t bytes_double = workspace::live_bytes();
+  EXPECT_EQ(workspace::pool_bytes(), 2 * bytes + bytes_double);
+
+  // trimming releases the idle fields but not the field checked out
+  workspace::trim(0);
+  EXPECT_EQ(workspace::pool_bytes(), bytes_double);
+  workspace::checkin(d);
+
+  // with the double field and two single fields idle, the largest is released first
+  {
+    WorkspaceField b(param);
+    WorkspaceField c(param);
+  }
+  EXPECT_EQ(workspace::pool_bytes(), 2 * bytes + bytes_double);
+  workspace::trim(2 * bytes);
+  EXPECT_EQ(workspace::pool_bytes(), 2 * bytes);
+
+  workspace::flush();
+  EXPECT_EQ(workspace::pool_bytes(), 0u);
+}
+
+/**
+   Ill-conditioned sum: large values and their negations interleaved
+   with small values.  All terms are multiples of 1/8 and small enough
+   that every rounding error, and their sum, is exactly representable,
+   so the compensated sum must reproduce the sum of the small values
+   exactly, however the terms are partitioned.
+*/
+static std::vector<double> illConditionedTerms(int n, double &exact)
+{
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<long long> mantissa(1ll << 40, (1ll << 52) - 1);
+  std::uniform_int_distribution<int> exponent(0, 10);
+  std::uniform_int_distribution<int> small(-800, 800);
+
+  std::vector<double> terms;
+  exact = 0.0;
+  for (int i = 0; i < n; i++) {
+    double big = std::ldexp(static_cast<double>(mantissa(rng)), exponent(rng));
+    terms.push_back(big);
+    terms.push_back(-big);
+    terms.push_back(small(rng) / 8.0);
+    exact += terms.back();
+  }
+  std::shuffle(terms.begin(), terms.end(), rng);
+  return terms;
+}
+
+/**
+   Compensated sums of the partitions of terms, combined in rank
+   order, in reverse order and pairwise as in a reduction tree
+*/
+static std::vector<compensated> partitionedSums(const std::vector<double> &terms, int n_part)
+{
+  std::vector<compensated> partial(n_part);
+  for (size_t i = 0; i < terms.size(); i++) partial[i * n_part / terms.size()] += terms[i];
+
+  compensated forward, reverse;
+  for (int p = 0; p < n_part; p++) forward = forward + partial[p];
+  for (int p = n_part - 1; p >= 0; p--) reverse = partial[p] + reverse;
+  for (int stride = 1; stride < n_part; stride *= 2)
+    for (int p = 0; p + stride < n_part; p += 2 * stride) partial[p] = partial[p] + partial[p + stride];
+
+  return {forward, reverse, partial[0]};
+}
+
+TEST(CompensatedTest, ill_conditioned)
+{
+  double exact;
+  auto terms = illConditionedTerms(1000, exact);
+
+  double naive = 0.0;
+  compensated sum;
+  for (auto t : terms) {
+    naive += t;
+    sum += t;
+  }
+  printfQuda("Ill-conditioned sum: exact %.16e, double %.16e, compensated %.16e\n", exact, naive, sum.value());
+  EXPECT_EQ(sum.value(), exact);
+
+  // a sum that lies exactly on a rounding tie must be flagged, one just off it must not
+  EXPECT_FALSE(is_exact(compensated(1.0, std::ldexp(1.0, -53))));
+  EXPECT_TRUE(is_exact(compensated(1.0, std::ldexp(1.0, -60))));
+}
+
+TEST(CompensatedTest, partition_invariance)
+{
+  double exact;
+  auto ill = illConditionedTerms(1000, exact);
+
+  // for generic terms the rounding is only guaranteed to be stable where is_exact holds
+  std::mt19937 rng(5678);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  std::vector<double> generic(100000);
+  for (auto &t : generic) t = uniform(rng);
+  compensated reference;
+  for (auto t : generic) reference += t;
+  ASSERT_TRUE(is_exact(reference));
+
+  for (int n_part : {1, 2, 3, 5, 8, 16, 64}) {
+    for (auto &sum : partitionedSums(ill, n_part)) EXPECT_EQ(sum.value(), exact) << n_part << " partitions";
+    for (auto &sum : partitionedSums(generic, n_part)) {
+      EXPECT_TRUE(is_exact(sum)) << n_part << " partitions";
+      EXPECT_EQ(sum.value(), reference.value()) << n_part << " partitions";
+    }
+  }
+}
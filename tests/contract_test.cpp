@@ -174,6 +174,143 @@ int test(int contractionType, int Prec)
   return faults;
 }
 
+// Performs the CPU GPU comparison of the momentum-projected, timeslice-summed contraction
+int testFT(int contractionType, int Prec)
+{
+  QudaPrecision test_prec = QUDA_INVALID_PRECISION;
+  switch (Prec) {
+  case 0: test_prec = QUDA_SINGLE_PRECISION; break;
+  case 1: test_prec = QUDA_DOUBLE_PRECISION; break;
+  default: errorQuda("Undefined QUDA precision type %d\n", Prec);
+  }
+
+  int X[4] = {xdim, ydim, zdim, tdim};
+
+  QudaInvertParam inv_param = newQudaInvertParam();
+  setContractInvertParam(inv_param);
+  inv_param.cpu_prec = test_prec;
+  inv_param.cuda_prec = test_prec;
+  inv_param.cuda_prec_sloppy = test_prec;
+  inv_param.cuda_prec_precondition = test_prec;
+
+  size_t data_size = (test_prec == QUDA_DOUBLE_PRECISION) ? sizeof(double) : sizeof(float);
+  void *spinorX = malloc(V * spinor_site_size * data_size);
+  void *spinorY = malloc(V * spinor_site_size * data_size);
+
+  if (test_prec == QUDA_SINGLE_PRECISION) {
+    for (int i = 0; i < V * spinor_site_size; i++) {
+      ((float *)spinorX)[i] = rand() / (float)RAND_MAX;
+      ((float *)spinorY)[i] = rand() / (float)RAND_MAX;
+    }
+  } else {
+    for (int i = 0; i < V * spinor_site_size; i++) {
+      ((double *)spinorX)[i] = rand() / (double)RAND_MAX;
+      ((double *)spinorY)[i] = rand() / (double)RAND_MAX;
+    }
+  }
+
+  QudaContractType cType = QUDA_CONTRACT_TYPE_INVALID;
+  switch (contractionType) {
+  case 0: cType = QUDA_CONTRACT_TYPE_OPEN; break;
+  case 1: cType = QUDA_CONTRACT_TYPE_DR; break;
+  default: errorQuda("Undefined contraction type %d\n", contractionType);
+  }
+
+  // a few momenta, including negative components, and every gamma structure
+  const int mom[] = {0, 0, 0, 1, 0, 0, 0, 1, 1, -1, 0, 0, 1, -1, 2};
+  const int n_mom = sizeof(mom) / (3 * sizeof(int));
+  int gamma[16];
+  for (int g = 0; g < 16; g++) gamma[g] = g;
+  const int n_gamma = 16;
+
+  int n_result = 2 * tdim * comm_dim(3) * n_mom * n_gamma;
+  double *d_result = (double *)malloc(n_result * sizeof(double));
+
+  contractFTQuda(spinorX, spinorY, d_result, cType, mom, n_mom, gamma, n_gamma, &inv_param, X);
+
+  int faults = 0;
+  if (test_prec == QUDA_DOUBLE_PRECISION) {
+    faults = contraction_ft_reference((double *)spinorX, (double *)spinorY, d_result, cType, mom, n_mom, gamma,
+                                      n_gamma, X);
+  } else {
+    faults = contraction_ft_reference((float *)spinorX, (float *)spinorY, d_result, cType, mom, n_mom, gamma,
+                                      n_gamma, X);
+  }
+
+  printfQuda("Momentum-projected contraction comparison for contraction type %s complete with %d/%d faults\n",
+             get_contract_str(cType), faults, n_result);
+
+  free(spinorX);
+  free(spinorY);
+  free(d_result);
+
+  return faults;
+}
+
+// Performs the CPU reference comparison of the meson and nucleon propagator contractions
+int testPropagator(int Prec)
+{
+  QudaPrecision test_prec = QUDA_INVALID_PRECISION;
+  switch (Prec) {
+  case 0: test_prec = QUDA_SINGLE_PRECISION; break;
+  case 1: test_prec = QUDA_DOUBLE_PRECISION; break;
+  default: errorQuda("Undefined QUDA precision type %d\n", Prec);
+  }
+
+  int X[4] = {xdim, ydim, zdim, tdim};
+
+  QudaInvertParam inv_param = newQudaInvertParam();
+  setContractInvertParam(inv_param);
+  inv_param.cpu_prec = test_prec;
+  inv_param.cuda_prec = test_prec;
+  inv_param.cuda_prec_sloppy = test_prec;
+  inv_param.cuda_prec_precondition = test_prec;
+
+  // two propagators of 12 spin-color columns each
+  size_t data_size = (test_prec == QUDA_DOUBLE_PRECISION) ? sizeof(double) : sizeof(float);
+  void *prop1[12], *prop2[12];
+  for (int i = 0; i < 12; i++) {
+    prop1[i] = malloc(V * spinor_site_size * data_size);
+    prop2[i] = malloc(V * spinor_site_size * data_size);
+    for (int j = 0; j < V * spinor_site_size; j++) {
+      if (test_prec == QUDA_SINGLE_PRECISION) {
+        ((float *)prop1[i])[j] = rand() / (float)RAND_MAX - 0.5f;
+        ((float *)prop2[i])[j] = rand() / (float)RAND_MAX - 0.5f;
+      } else {
+        ((double *)prop1[i])[j] = rand() / (double)RAND_MAX - 0.5;
+        ((double *)prop2[i])[j] = rand() / (double)RAND_MAX - 0.5;
+      }
+    }
+  }
+
+  const int mom[] = {0, 0, 0, 1, 0, 0, 0, -1, 1};
+  const int n_mom = sizeof(mom) / (3 * sizeof(int));
+
+  int n_result = 2 * tdim * comm_dim(3) * n_mom * 16;
+  double *meson = (double *)malloc(n_result * sizeof(double));
+  double *baryon = (double *)malloc(n_result * sizeof(double));
+
+  contractPropagatorsQuda(prop1, prop2, meson, baryon, mom, n_mom, &inv_param, X);
+
+  int faults = 0;
+  if (test_prec == QUDA_DOUBLE_PRECISION) {
+    faults = contraction_propagator_reference((double **)prop1, (double **)prop2, meson, baryon, mom, n_mom, X);
+  } else {
+    faults = contraction_propagator_reference((float **)prop1, (float **)prop2, meson, baryon, mom, n_mom, X);
+  }
+
+  printfQuda("Propagator contraction comparison complete with %d/%d faults\n", faults, 2 * n_result);
+
+  for (int i = 0; i < 12; i++) {
+    free(prop1[i]);
+    free(prop2[i]);
+  }
+  free(meson);
+  free(baryon);
+
+  return faults;
+}
+
 // The following tests gets each contraction type and precision using google testing framework
 using ::testing::Bool;
 using ::testing::Combine;
@@ -213,3 +350,43 @@ std::string getContractName(testing::TestParamInfo<::testing::tuple<int, int>> p
 
 // Instantiate all test cases
 INSTANTIATE_TEST_SUITE_P(QUDA, ContractionTest, Combine(Range(0, 2), Range(0, NcontractType)), getContractName);
+
+class ContractionFTTest : public ::testing::TestWithParam<::testing::tuple<int, int>>
+{
+  protected:
+  ::testing::tuple<int, int> param;
+
+  public:
+  virtual ~ContractionFTTest() {}
+  virtual void SetUp() { param = GetParam(); }
+};
+
+TEST_P(ContractionFTTest, verify)
+{
+  int prec = ::testing::get<0>(GetParam());
+  int contractionType = ::testing::get<1>(GetParam());
+  auto faults = testFT(contractionType, prec);
+  EXPECT_EQ(faults, 0) << "CPU and GPU implementations do not agree";
+}
+
+INSTANTIATE_TEST_SUITE_P(QUDA, ContractionFTTest, Combine(Range(0, 2), Range(0, NcontractType)), getContractName);
+
+class ContractionPropagatorTest : public ::testing::TestWithParam<int>
+{
+  protected:
+  int param;
+
+  public:
+  virtual ~ContractionPropagatorTest() {}
+  virtual void SetUp() { param = GetParam(); }
+};
+
+TEST_P(ContractionPropagatorTest, verify)
+{
+  auto faults = testPropagator(GetParam());
+  EXPECT_EQ(faults, 0) << "Propagator contraction and CPU reference do not agree";
+}
+
+std::string getPropagatorName(testing::TestParamInfo<int> param) { return std::string(prec_str[param.param]); }
+
+INSTANTIATE_TEST_SUITE_P(QUDA, ContractionPropagatorTest, Range(0, 2), getPropagatorName);
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <quda.h>
+#include <quda_internal.h>
+#include <comm_quda.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <random_quda.h>
+#include <deflation.h>
+
+#include <host_utils.h>
+#include <command_line_params.h>
+
+#include <gtest/gtest.h>
+
+using namespace quda;
+
+// tests of the compressed deflation space
+
+namespace
+{
+
+  // the size of the block basis, which must be a block orthogonalization instantiated for Wilson fields
+  constexpr int n_basis = 6;
+  constexpr int n_ev = 2 * n_basis;
+
+  ColorSpinorParam wilsonParam()
+  {
+    ColorSpinorParam param;
+    param.nColor = 3;
+    param.nSpin = 4;
+    param.nDim = 4;
+    param.pad = 0;
+    param.siteSubset = QUDA_FULL_SITE_SUBSET;
+    param.x[0] = xdim;
+    param.x[1] = ydim;
+    param.x[2] = zdim;
+    param.x[3] = tdim;
+    param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+    param.gammaBasis = QUDA_UKQCD_GAMMA_BASIS;
+    param.location = QUDA_CUDA_FIELD_LOCATION;
+    param.create = QUDA_ZERO_FIELD_CREATE;
+    param.setPrecision(QUDA_SINGLE_PRECISION, QUDA_SINGLE_PRECISION, true);
+    return param;
+  }
+
+  // n_basis random vectors followed by global combinations of them, so
+  // every vector lies in the span of the block basis and is compressed
+  // up to the precision of the basis and coefficients
+  std::vector<ColorSpinorField *> spanVectors()
+  {
+    ColorSpinorParam param = wilsonParam();
+    std::vector<ColorSpinorField *> v;
+    for (int i = 0; i < n_ev; i++) v.push_back(ColorSpinorField::Create(param));
+
+    RNG rng(*v[0], 1234);
+    for (int i = 0; i < n_basis; i++) spinorNoise(*v[i], rng, QUDA_NOISE_GAUSS);
+    for (int i = n_basis; i < n_ev; i++)
+      for (int j = 0; j < n_basis; j++) blas::caxpy(Complex(cos(i + 2.0 * j), sin(i * j + 1.0)), *v[j], *v[i]);
+    for (auto &vi : v) blas::ax(1.0 / sqrt(blas::norm2(*vi)), *vi);
+    return v;
+  }
+
+  QudaEigParam compressParam(QudaPrecision precision)
+  {
+    QudaEigParam eig_param = newQudaEigParam();
+    eig_param.compress_deflation = QUDA_BOOLEAN_TRUE;
+    eig_param.compress_n_basis = n_basis;
+    for (int d = 0; d < 4; d++) eig_param.compress_block_size[d] = 2;
+    eig_param.compress_precision = precision;
+    return eig_param;
+  }
+
+  double tolerance(QudaPrecision precision) { return precision == QUDA_SINGLE_PRECISION ? 1e-5 : 5e-3; }
+
+} // namespace
+
+TEST(CompressedDeflation, reconstruct)
+{
+  auto evecs = spanVectors();
+  ColorSpinorField *v = ColorSpinorField::Create(wilsonParam());
+
+  for (auto precision : {QUDA_SINGLE_PRECISION, QUDA_HALF_PRECISION}) {
+    CompressedDeflationSpace space(compressParam(precision), evecs, QUDA_INVALID_PARITY);
+    ASSERT_EQ(space.size(), n_ev);
+
+    double max_error = 0.0;
+    for (int i = 0; i < n_ev; i++) {
+      space.reconstruct(*v, i);
+      max_error = std::max(max_error, sqrt(blas::xmyNorm(*evecs[i], *v)));
+    }
+    printfQuda("Compressed precision %d: maximum relative reconstruction error %e\n", precision, max_error);
+    EXPECT_LT(max_error, tolerance(precision));
+  }
+
+  delete v;
+  for (auto &e : evecs) delete e;
+}
+
+TEST(CompressedDeflation, deflate)
+{
+  // deflating on the coarse grid must match the deflation with the uncompressed vectors
+  auto evecs = spanVectors();
+  std::vector<Complex> evals(n_ev);
+  for (int i = 0; i < n_ev; i++) evals[i] = 0.1 * (i + 1);
+
+  ColorSpinorField *src = ColorSpinorField::Create(wilsonParam());
+  ColorSpinorField *ref = ColorSpinorField::Create(wilsonParam());
+  ColorSpinorField *sol = ColorSpinorField::Create(wilsonParam());
+  RNG rng(*src, 5678);
+  spinorNoise(*src, rng, QUDA_NOISE_GAUSS);
+
+  for (int i = 0; i < n_ev; i++) blas::caxpy(blas::cDotProduct(*evecs[i], *src) / evals[i].real(), *evecs[i], *ref);
+  const double ref2 = blas::norm2(*ref);
+
+  for (auto precision : {QUDA_SINGLE_PRECISION, QUDA_HALF_PRECISION}) {
+    CompressedDeflationSpace space(compressParam(precision), evecs, QUDA_INVALID_PARITY);
+    space.deflate(*sol, *src, evals, false);
+    double error = sqrt(blas::xmyNorm(*ref, *sol) / ref2);
+    printfQuda("Compressed precision %d: relative deflation error %e\n", precision, error);
+    EXPECT_LT(error, tolerance(precision));
+  }
+
+  delete sol;
+  delete ref;
+  delete src;
+  for (auto &e : evecs) delete e;
+}
+
+int main(int argc, char **argv)
+{
+  // initalize google test, includes command line options
+  ::testing::InitGoogleTest(&argc, argv);
+  xdim = ydim = zdim = 4;
+  tdim = 8;
+
+  // command line options
+  auto app = make_app();
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+
+  // Ensure gtest prints only from rank 0
+  ::testing::TestEventListeners &listeners = ::testing::UnitTest::GetInstance()->listeners();
+  if (comm_rank() != 0) { delete listeners.Release(listeners.default_result_printer()); }
+
+  initQuda(device_ordinal);
+  int test_rc = RUN_ALL_TESTS();
+  endQuda();
+
+  finalizeComms();
+
+  return test_rc;
+}
@@ -1096,6 +1096,57 @@ TEST_P(DslashTest, verify)
   ASSERT_LE(deviation, tol) << "CPU and CUDA implementations do not agree";
 }
 
+TEST_P(DslashTest, multi_rhs)
+{
+  if (transfer || !dirac->hasMultiRHS()) GTEST_SKIP();
+
+  // not a multiple of the right-hand side tile, so the last tile is partial
+  constexpr int n_rhs = 5;
+  ColorSpinorParam param(*cudaSpinor);
+  param.create = QUDA_NULL_FIELD_CREATE;
+  std::vector<ColorSpinorField *> in(n_rhs);
+  for (auto &v : in) {
+    v = ColorSpinorField::Create(param);
+    v->Source(QUDA_RANDOM_SOURCE);
+  }
+  ColorSpinorField *ref = ColorSpinorField::Create(param);
+  ColorSpinorField *out = ColorSpinorField::Create(param);
+
+  param.nDim = 5;
+  param.x[4] = n_rhs;
+  param.pc_type = QUDA_4D_PC;
+  ColorSpinorField *x = ColorSpinorField::Create(param);
+  ColorSpinorField *y = ColorSpinorField::Create(param);
+  for (int s = 0; s < n_rhs; s++) copyMultiRHS(*x, *in[s], s);
+
+  double tol = getTolerance(inv_param.cuda_prec);
+  if (gauge_param.reconstruct == QUDA_RECONSTRUCT_8 && inv_param.cuda_prec >= QUDA_HALF_PRECISION) tol *= 10;
+
+  for (auto dag : {QUDA_DAG_NO, QUDA_DAG_YES}) {
+    dirac->Dagger(dag);
+    dirac->MMultiRHS(*y, *x);
+
+    std::vector<double> y2;
+    multiRHSNorm2(y2, *y);
+
+    for (int s = 0; s < n_rhs; s++) {
+      dirac->M(*ref, *in[s]);
+      copyMultiRHS(*out, *y, s);
+      double ref2 = blas::norm2(*ref);
+      double deviation = sqrt(blas::xmyNorm(*ref, *out) / ref2);
+      EXPECT_LE(deviation, tol) << "right-hand side " << s << (dag == QUDA_DAG_YES ? " (dagger)" : "");
+      EXPECT_LE(std::abs(y2[s] - ref2), tol * ref2) << "norm of right-hand side " << s;
+    }
+  }
+  dirac->Dagger(inv_param.dagger);
+
+  delete y;
+  delete x;
+  delete out;
+  delete ref;
+  for (auto v : in) delete v;
+}
+
 TEST_P(DslashTest, benchmark)
 {
   dslashCUDA(1); // warm-up run
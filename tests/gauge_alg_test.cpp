@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <functional>
+#include <vector>
+
 #include <quda.h>
 #include <quda_internal.h>
 #include <gauge_field.h>
@@ -61,6 +64,94 @@ class GaugeAlgTest : public ::testing::Test {
     return false;
   }
 
+  /**
+     @brief Copy the interior of an extended device gauge field to a
+     double-precision host field in QDP order
+  */
+  cpuGaugeField *interiorToHost(const GaugeField &u)
+  {
+    GaugeFieldParam param(u);
+    for (int d = 0; d < 4; d++) {
+      param.x[d] = u.X()[d] - 2 * u.R()[d];
+      param.r[d] = 0;
+    }
+    param.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    param.reconstruct = QUDA_RECONSTRUCT_NO;
+    param.setPrecision(param.Precision(), true);
+    cudaGaugeField interior(param);
+    copyExtendedGauge(interior, u, QUDA_CUDA_FIELD_LOCATION);
+
+    param.location = QUDA_CPU_FIELD_LOCATION;
+    param.order = QUDA_QDP_GAUGE_ORDER;
+    param.setPrecision(QUDA_DOUBLE_PRECISION);
+    auto host = new cpuGaugeField(param);
+    interior.saveCPUField(*host);
+    return host;
+  }
+
+  /**
+     @brief Copy an extended device gauge field to a double-precision
+     extended host field in QDP order, with its halo exchanged
+  */
+  cpuGaugeField *extendedToHost(const GaugeField &u)
+  {
+    cpuGaugeField *interior = interiorToHost(u);
+    GaugeFieldParam param(*interior);
+    for (int d = 0; d < 4; d++) {
+      param.x[d] += 2 * u.R()[d];
+      param.r[d] = u.R()[d];
+    }
+    param.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    auto host = new cpuGaugeField(param);
+    copyExtendedGauge(*host, *interior, QUDA_CPU_FIELD_LOCATION);
+    host->exchangeExtendedGhost(host->R(), true);
+    delete interior;
+    return host;
+  }
+
+  /**
+     @brief Maximum difference between the links of the interiors of an
+     extended device gauge field and an extended host gauge field from extendedToHost
+  */
+  double hostLinkDifference(const GaugeField &device, const cpuGaugeField &host)
+  {
+    cpuGaugeField *hd = interiorToHost(device);
+    GaugeFieldParam param(*hd);
+    param.create = QUDA_NULL_FIELD_CREATE;
+    cpuGaugeField hh(param);
+    copyExtendedGauge(hh, host, QUDA_CPU_FIELD_LOCATION);
+    double diff = 0.0;
+    for (int d = 0; d < 4; d++) {
+      auto pa = static_cast<double *const *>(hd->Gauge_p())[d];
+      auto pb = static_cast<double *const *>(hh.Gauge_p())[d];
+      for (int i = 0; i < hd->Volume() * 18; i++) diff = std::max(diff, std::abs(pa[i] - pb[i]));
+    }
+    comm_allreduce_max(&diff);
+    delete hd;
+    return diff;
+  }
+
+  /**
+     @brief Maximum difference between the links of the interiors of two extended gauge fields
+  */
+  double maxLinkDifference(const GaugeField &a, const GaugeField &b)
+  {
+    cpuGaugeField *ha = interiorToHost(a);
+    cpuGaugeField *hb = interiorToHost(b);
+    double diff = 0.0;
+    for (int d = 0; d < 4; d++) {
+      auto pa = static_cast<double *const *>(ha->Gauge_p())[d];
+      auto pb = static_cast<double *const *>(hb->Gauge_p())[d];
+      for (int i = 0; i < ha->Volume() * 18; i++) diff = std::max(diff, std::abs(pa[i] - pb[i]));
+    }
+    comm_allreduce_max(&diff);
+    delete ha;
+    delete hb;
+    return diff;
+  }
+
   virtual void SetUp() {
     setVerbosity(QUDA_VERBOSE);
 
@@ -114,9 +205,8 @@ class GaugeAlgTest : public ::testing::Test {
 #else
     U = new cudaGaugeField(gParam);
 #endif
-    // CURAND random generator initialization
+    // random number generator initialization
     randstates = new RNG(gParam, 1234);
-    randstates->Init();
 
     nsteps = 10;
     nhbsteps = 4;
@@ -172,7 +262,6 @@ class GaugeAlgTest : public ::testing::Test {
 
     a0.Stop(__func__, __FILE__, __LINE__);
     printfQuda("Time -> %.6f s\n", a0.Last());
-    randstates->Release();
     delete randstates;
   }
 
@@ -244,6 +333,299 @@ TEST_F(GaugeAlgTest, Coulomb_FFT)
   }
 }
 
+TEST_F(GaugeAlgTest, WFlowIntegrate)
+{
+  // The integrator skips halo exchanges where the extended halo is
+  // still valid, so must reproduce single flow steps that exchange
+  // after every step, in particular when the lattice is partitioned.
+  const double epsilon = 0.02;
+  const int n_steps = 5;
+  const double tol = prec == QUDA_DOUBLE_PRECISION ? 1e-12 : 1e-5;
+  U->exchangeExtendedGhost(U->R(), false);
+
+  for (auto type : {QUDA_WFLOW_TYPE_WILSON, QUDA_WFLOW_TYPE_SYMANZIK}) {
+    GaugeFieldParam gParam(*U);
+    gParam.create = QUDA_NULL_FIELD_CREATE;
+    cudaGaugeField flow(gParam), step_a(gParam), step_b(gParam);
+    flow.copy(*U);
+    step_a.copy(*U);
+    gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+    gParam.setPrecision(gParam.Precision(), true);
+    cudaGaugeField temp(gParam);
+
+    cudaGaugeField *in = &step_a, *out = &step_b;
+    for (int i = 0; i < n_steps; i++) {
+      WFlowStep(*out, temp, *in, epsilon, type);
+      std::swap(in, out);
+    }
+    WFlowIntegrate(flow, epsilon, n_steps * epsilon, type);
+
+    double diff = maxLinkDifference(flow, *in);
+    printfQuda("Wilson flow type %d: max link difference between integrator and single steps %e\n", type, diff);
+    EXPECT_LT(diff, tol);
+  }
+}
+
+TEST_F(GaugeAlgTest, WFlowAdaptive)
+{
+  // An initial step size far too large for the tolerance must be
+  // rejected and reduced, and the adaptive flow must then agree at the
+  // target flow time with a fixed-step flow of a much smaller step size.
+  const double t_max = 0.5;
+  const double epsilon = 0.25;
+  const double epsilon_fine = 0.005;
+  const double step_tol = 1e-5;
+  const double tol = 1e-3;
+  U->exchangeExtendedGhost(U->R(), false);
+
+  for (auto type : {QUDA_WFLOW_TYPE_WILSON, QUDA_WFLOW_TYPE_SYMANZIK}) {
+    GaugeFieldParam gParam(*U);
+    gParam.create = QUDA_NULL_FIELD_CREATE;
+    cudaGaugeField adaptive(gParam), fine(gParam);
+    adaptive.copy(*U);
+    fine.copy(*U);
+
+    // measuring after every step records the flow time of each accepted step
+    auto meas = WFlowIntegrate(adaptive, epsilon, t_max, type, step_tol, 1);
+    auto meas_fine = WFlowIntegrate(fine, epsilon_fine, t_max, type);
+    ASSERT_GE(meas.size(), 3u);
+    const int n_steps = meas.size() - 1;
+
+    double diff = maxLinkDifference(adaptive, fine);
+    auto plaq_fine = plaquette(fine);
+    printfQuda("Wilson flow type %d: %d adaptive steps, first accepted step %e, max link difference %e from %d fixed "
+               "steps, plaquette %.16e vs %.16e\n",
+               type, n_steps, meas[1].t, diff, static_cast<int>(t_max / epsilon_fine), meas.back().plaquette[0],
+               plaq_fine.x);
+
+    // the first step was rejected if the first accepted step is shorter than the initial step size
+    EXPECT_LT(meas[1].t, epsilon);
+    EXPECT_NEAR(meas.back().t, t_max, 1e-10 * t_max);
+    EXPECT_LT(n_steps, t_max / epsilon_fine);
+    EXPECT_TRUE(meas_fine.empty());
+    EXPECT_LT(diff, tol);
+    EXPECT_LT(std::abs(meas.back().plaquette[0] - plaq_fine.x), tol);
+  }
+}
+
+TEST_F(GaugeAlgTest, HostReconstruct)
+{
+  // Compressed host fields must reproduce the full field, including
+  // the anti-periodic sign on the last time slice and the ghost zone
+  // decoded at the volumeCB + x halo index.
+  cpuGaugeField *periodic = interiorToHost(*U);
+  GaugeFieldParam gParam(*periodic);
+  gParam.t_boundary = QUDA_ANTI_PERIODIC_T;
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  cpuGaugeField ref(gParam);
+
+  const int X[4] = {ref.X()[0], ref.X()[1], ref.X()[2], ref.X()[3]};
+  const size_t last_slice_cb = static_cast<size_t>(X[3] - 1) * X[0] * X[1] * X[2] / 2;
+  const bool last_rank = comm_coord(3) == comm_dim(3) - 1;
+  for (int d = 0; d < 4; d++) {
+    auto src = static_cast<double *const *>(periodic->Gauge_p())[d];
+    auto dst = static_cast<double **>(ref.Gauge_p())[d];
+    for (size_t i = 0; i < ref.Volume() * 18; i++) dst[i] = src[i];
+    if (d != 3 || !last_rank) continue;
+    for (int parity = 0; parity < 2; parity++)
+      for (size_t x_cb = last_slice_cb; x_cb < ref.VolumeCB(); x_cb++)
+        for (int i = 0; i < 18; i++) dst[(parity * ref.VolumeCB() + x_cb) * 18 + i] *= -1.0;
+  }
+  delete periodic;
+  ref.exchangeGhost();
+
+  int R[4] = {0, 0, 0, 0};
+  for (int d = 0; d < 4; d++)
+    if (comm_dim_partitioned(d)) R[d] = 2;
+  auto hostPlaquette = [&](const cpuGaugeField &u) {
+    GaugeFieldParam eParam(u);
+    for (int d = 0; d < 4; d++) {
+      eParam.x[d] += 2 * R[d];
+      eParam.r[d] = R[d];
+    }
+    eParam.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+    eParam.create = QUDA_NULL_FIELD_CREATE;
+    cpuGaugeField extended(eParam);
+    copyExtendedGauge(extended, u, QUDA_CPU_FIELD_LOCATION);
+    extended.exchangeExtendedGhost(R, true);
+    return plaquette(extended);
+  };
+  auto plaq_ref = hostPlaquette(ref);
+
+  for (auto recon : {QUDA_RECONSTRUCT_12, QUDA_RECONSTRUCT_8}) {
+    const double tol = recon == QUDA_RECONSTRUCT_12 ? 1e-13 : 1e-9;
+
+    gParam.reconstruct = recon;
+    cpuGaugeField compressed(gParam);
+    compressed.copy(ref);
+    compressed.exchangeGhost();
+
+    gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+    cpuGaugeField full(gParam);
+    full.copy(compressed);
+
+    double diff = 0.0;
+    for (int d = 0; d < 4; d++) {
+      auto a = static_cast<double *const *>(ref.Gauge_p())[d];
+      auto b = static_cast<double *const *>(full.Gauge_p())[d];
+      for (size_t i = 0; i < ref.Volume() * 18; i++) diff = std::max(diff, std::abs(a[i] - b[i]));
+    }
+
+    double ghost_diff = 0.0;
+    for (int d = 0; d < 4; d++) {
+      if (!comm_dim_partitioned(d)) continue;
+      auto a = static_cast<const double *>(ref.Ghost()[d]);
+      auto b = static_cast<const double *>(full.Ghost()[d]);
+      for (int i = 0; i < ref.Nface() * ref.SurfaceCB(d) * 2 * 18; i++)
+        ghost_diff = std::max(ghost_diff, std::abs(a[i] - b[i]));
+    }
+    comm_allreduce_max(&diff);
+    comm_allreduce_max(&ghost_diff);
+
+    auto plaq_recon = hostPlaquette(compressed);
+    printfQuda("Host reconstruct %d: max link difference %e, max ghost difference %e, plaquette %.16e vs %.16e\n",
+               recon, diff, ghost_diff, plaq_recon.x, plaq_ref.x);
+    EXPECT_LT(diff, tol);
+    EXPECT_LT(ghost_diff, tol);
+    EXPECT_LT(std::abs(plaq_recon.x - plaq_ref.x), tol);
+    EXPECT_LT(std::abs(plaq_recon.y - plaq_ref.y), tol);
+    EXPECT_LT(std::abs(plaq_recon.z - plaq_ref.z), tol);
+  }
+}
+
+TEST_F(GaugeAlgTest, FusedObservables)
+{
+  // The fused observables sweep forms the clover-leaf field strength
+  // in registers, so must agree with the plaquette kernel and with the
+  // charge measured from a stored Fmunu field, both on device fields
+  // and on host QDP fields that run through the host reduction.
+  U->exchangeExtendedGhost(U->R(), false);
+  int x[4];
+  for (int d = 0; d < 4; d++) x[d] = U->X()[d] - 2 * U->R()[d];
+  const size_t volume = static_cast<size_t>(x[0]) * x[1] * x[2] * x[3];
+
+  GaugeFieldParam tensorParam(x, U->Precision(), QUDA_RECONSTRUCT_NO, 0, QUDA_TENSOR_GEOMETRY);
+  tensorParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  tensorParam.order = QUDA_FLOAT2_GAUGE_ORDER;
+  tensorParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  cudaGaugeField Fmunu(tensorParam);
+  computeFmunu(Fmunu, *U);
+
+  double3 plaq_ref = plaquette(*U);
+  double energy_ref[3], qcharge_ref;
+  computeQCharge(energy_ref, qcharge_ref, Fmunu);
+
+  // charge densities are returned in the precision of the field they were computed from
+  auto toDouble = [&](const void *density, QudaPrecision precision) {
+    std::vector<double> q(volume);
+    for (size_t i = 0; i < volume; i++)
+      q[i] = precision == QUDA_DOUBLE_PRECISION ? static_cast<const double *>(density)[i] :
+                                                  static_cast<const float *>(density)[i];
+    return q;
+  };
+
+  const size_t size = volume * U->Precision();
+  void *d_density = pool_device_malloc(size);
+  std::vector<char> density(size);
+  double energy_density_ref[3], qcharge_density_ref;
+  computeQChargeDensity(energy_density_ref, qcharge_density_ref, d_density, Fmunu);
+  qudaMemcpy(density.data(), d_density, size, cudaMemcpyDeviceToHost);
+  auto q_ref = toDouble(density.data(), U->Precision());
+
+  auto check = [&](const char *label, const double plaq[3], const double energy[3], double qcharge,
+                   const std::vector<double> &q, double tol) {
+    printfQuda("%s: plaquette %.16e, energy %.16e, charge %.16e vs %.16e, %.16e, %.16e\n", label, plaq[0], energy[0],
+               qcharge, plaq_ref.x, energy_ref[0], qcharge_ref);
+    EXPECT_NEAR(plaq[0], plaq_ref.x, tol);
+    EXPECT_NEAR(plaq[1], plaq_ref.y, tol);
+    EXPECT_NEAR(plaq[2], plaq_ref.z, tol);
+    for (int i = 0; i < 3; i++) EXPECT_NEAR(energy[i], energy_ref[i], tol * std::max(1.0, std::abs(energy_ref[i])));
+    EXPECT_NEAR(qcharge, qcharge_ref, tol * std::max(1.0, std::abs(qcharge_ref)));
+
+    double diff = 0.0;
+    for (size_t i = 0; i < volume; i++) diff = std::max(diff, std::abs(q[i] - q_ref[i]));
+    comm_allreduce_max(&diff);
+    EXPECT_LT(diff, tol);
+  };
+
+  const double tol = prec == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-4;
+  {
+    double plaq[3], energy[3], qcharge;
+    computeGaugeObservables(*U, plaq, energy, qcharge, d_density);
+    qudaMemcpy(density.data(), d_density, size, cudaMemcpyDeviceToHost);
+    check("Device fused observables", plaq, energy, qcharge, toDouble(density.data(), U->Precision()), tol);
+
+    // without a density destination only the reductions are formed
+    double plaq_nod[3], energy_nod[3], qcharge_nod;
+    computeGaugeObservables(*U, plaq_nod, energy_nod, qcharge_nod);
+    check("Device fused observables without density", plaq_nod, energy_nod, qcharge_nod, q_ref, tol);
+  }
+  pool_device_free(d_density);
+
+  {
+    cpuGaugeField *host = extendedToHost(*U);
+    double plaq[3], energy[3], qcharge;
+    std::vector<double> q(volume);
+    computeGaugeObservables(*host, plaq, energy, qcharge, q.data());
+    delete host;
+    check("Host fused observables", plaq, energy, qcharge, q, tol);
+  }
+}
+
+TEST_F(GaugeAlgTest, HostSmearing)
+{
+  // The host dispatch of the smearing and flow kernels must reproduce
+  // the device kernels applied to the same links.
+  const double tol = prec == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-5;
+  U->exchangeExtendedGhost(U->R(), false);
+
+  GaugeFieldParam gParam(*U);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  cudaGaugeField device(gParam), device_tmp(gParam);
+
+  // each smearing step takes the links in the first field and uses the second as a temporary
+  const std::vector<std::pair<const char *, std::function<void(GaugeField &, GaugeField &)>>> steps
+    = {{"APE", [](GaugeField &u, GaugeField &tmp) { APEStep(u, tmp, 0.6); }},
+       {"STOUT", [](GaugeField &u, GaugeField &tmp) { STOUTStep(u, tmp, 0.1); }},
+       {"Over-improved STOUT", [](GaugeField &u, GaugeField &tmp) { OvrImpSTOUTStep(u, tmp, 0.06, -0.25); }}};
+
+  for (auto &step : steps) {
+    cpuGaugeField *host = extendedToHost(*U);
+    GaugeFieldParam hParam(*host);
+    hParam.create = QUDA_NULL_FIELD_CREATE;
+    cpuGaugeField host_tmp(hParam);
+    device.copy(*U);
+
+    step.second(device, device_tmp);
+    step.second(*host, host_tmp);
+
+    double diff = hostLinkDifference(device, *host);
+    printfQuda("%s: max link difference between host and device %e\n", step.first, diff);
+    EXPECT_LT(diff, tol) << step.first;
+    delete host;
+  }
+
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParam.setPrecision(gParam.Precision(), true);
+  cudaGaugeField device_temp(gParam);
+  for (auto type : {QUDA_WFLOW_TYPE_WILSON, QUDA_WFLOW_TYPE_SYMANZIK}) {
+    cpuGaugeField *host = extendedToHost(*U);
+    GaugeFieldParam hParam(*host);
+    hParam.create = QUDA_NULL_FIELD_CREATE;
+    cpuGaugeField host_out(hParam), host_temp(hParam);
+
+    // the flow step overwrites its input with an intermediate field
+    device_tmp.copy(*U);
+    WFlowStep(device, device_temp, device_tmp, 0.02, type);
+    WFlowStep(host_out, host_temp, *host, 0.02, type);
+
+    double diff = hostLinkDifference(device, host_out);
+    printfQuda("Wilson flow type %d: max link difference between host and device %e\n", type, diff);
+    EXPECT_LT(diff, tol) << "Wilson flow type " << type;
+    delete host;
+  }
+}
+
 int main(int argc, char **argv)
 {
   // initalize google test, includes command line options
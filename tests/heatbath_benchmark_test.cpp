@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <chrono>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <quda.h>
+#include <gauge_field.h>
+
+#include <comm_quda.h>
+#include <host_utils.h>
+#include <command_line_params.h>
+#include <gauge_tools.h>
+#include "misc.h"
+
+#include <pgauge_monte.h>
+#include <random_quda.h>
+
+// Benchmark of the host heatbath and overrelaxation sweeps: the same
+// update chain is run with an increasing number of host threads, and
+// the resulting fields are required to be bitwise identical.
+
+void display_test_info(const std::vector<int> &threads)
+{
+  printfQuda("running the following test:\n");
+
+  printfQuda("prec    S_dimension T_dimension beta     HB/step OVR/step steps\n");
+  printfQuda("%s   %d/%d/%d       %d         %6.3f   %d       %d        %d\n", get_prec_str(prec), xdim, ydim, zdim,
+             tdim, heatbath_beta_value, heatbath_num_heatbath_per_step, heatbath_num_overrelax_per_step,
+             heatbath_num_steps);
+
+  printfQuda("Host threads:");
+  for (auto t : threads) printfQuda(" %d", t);
+  printfQuda("\n");
+
+  printfQuda("Grid partition info:     X  Y  Z  T\n");
+  printfQuda("                         %d  %d  %d  %d\n", dimPartitioned(0), dimPartitioned(1), dimPartitioned(2),
+             dimPartitioned(3));
+}
+
+int main(int argc, char **argv)
+{
+  // command line options
+  auto app = make_app();
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  // initialize QMP/MPI, QUDA comms grid and RNG (host_utils.cpp)
+  initComms(argc, argv, gridsize_from_cmdline);
+
+  std::vector<int> threads;
+#ifdef _OPENMP
+  const int max_threads = omp_get_max_threads();
+  for (int t = 1; t < max_threads; t *= 2) threads.push_back(t);
+  threads.push_back(max_threads);
+#else
+  threads.push_back(1);
+#endif
+
+  display_test_info(threads);
+
+  // initialize the QUDA library
+  initQuda(device_ordinal);
+
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  setWilsonGaugeParam(gauge_param);
+  setDims(gauge_param.X);
+
+  int failures = 0;
+  {
+    using namespace quda;
+    int y[4];
+    int R[4] = {0, 0, 0, 0};
+    for (int dir = 0; dir < 4; ++dir)
+      if (comm_dim_partitioned(dir)) R[dir] = 2;
+    for (int dir = 0; dir < 4; ++dir) y[dir] = gauge_param.X[dir] + 2 * R[dir];
+
+    GaugeFieldParam gParamEx(y, prec, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
+    gParamEx.create = QUDA_ZERO_FIELD_CREATE;
+    gParamEx.order = QUDA_QDP_GAUGE_ORDER;
+    gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
+    gParamEx.t_boundary = QUDA_PERIODIC_T;
+    gParamEx.nFace = 1;
+    for (int dir = 0; dir < 4; ++dir) gParamEx.r[dir] = R[dir];
+
+    // hot start on the host
+    cpuGaugeField start(gParamEx);
+    RNG hot(start, 1234);
+    InitGaugeField(start, hot);
+
+    const double updates = 4.0 * V * comm_size()
+      * (heatbath_num_heatbath_per_step + heatbath_num_overrelax_per_step) * heatbath_num_steps;
+    uint64_t reference = 0;
+
+    for (auto t : threads) {
+#ifdef _OPENMP
+      omp_set_num_threads(t);
+#endif
+      cpuGaugeField u(gParamEx);
+      copyExtendedGauge(u, start, QUDA_CPU_FIELD_LOCATION);
+      RNG rng(u, 5678);
+
+      auto begin = std::chrono::steady_clock::now();
+      for (int step = 0; step < heatbath_num_steps; ++step)
+        Monte(u, rng, heatbath_beta_value, heatbath_num_heatbath_per_step, heatbath_num_overrelax_per_step);
+      auto end = std::chrono::steady_clock::now();
+      double secs = std::chrono::duration<double>(end - begin).count();
+
+      double plaq[3], energy[3], qcharge;
+      computeGaugeObservables(u, plaq, energy, qcharge);
+      uint64_t checksum = u.checksum();
+      if (t == threads[0]) reference = checksum;
+
+      printfQuda("threads = %3d: time = %8.3f s, %.3e link updates/s, plaquette = %.16e, checksum = %016" PRIx64 "%s\n",
+                 t, secs, updates / secs, plaq[0], checksum, checksum == reference ? "" : " MISMATCH");
+      if (checksum != reference) failures++;
+    }
+
+    // Release all temporary memory used for data exchange between GPUs in multi-GPU mode
+    PGaugeExchangeFree();
+  }
+
+  if (failures) printfQuda("\n%d thread counts gave a different result\n", failures);
+
+  // finalize the QUDA library
+  endQuda();
+
+  // finalize the communications layer
+  finalizeComms();
+
+  return failures;
+}
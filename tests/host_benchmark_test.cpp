@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <multigrid.h>
+#include <dirac_quda.h>
+#include <eigensolve_quda.h>
+#include <tune_quda.h>
+
+#include <host_utils.h>
+#include <command_line_params.h>
+#include <misc.h>
+#include <benchmark.h>
+
+// include because of nasty globals used in the tests
+#include <dslash_reference.h>
+#include <wilson_dslash_reference.h>
+
+using namespace quda;
+
+/**
+   Micro-benchmarks of the host-executable components of QUDA and of
+   the test reference code: the reference Wilson dslash, host field
+   reorders, gauge checksums, tune-cache lookups, host blas, the CPU
+   coarse dslash and the host-side kernels of the eigensolvers.  All
+   benchmarks run through the common harness in utils/benchmark.h;
+   with --bench-json the results are written as JSON, which can be
+   checked against a stored baseline with
+   utils/compare_benchmarks.py.
+*/
+
+std::string bench_json;
+int bench_warmup = 3;
+int coarse_ncolor = 24;
+
+void display_test_info()
+{
+  printfQuda("running the following test:\n");
+  printfQuda("prec    S_dimension T_dimension coarse Ncolor reps warmup\n");
+  printfQuda("%6s   %3d/%3d/%3d     %3d         %3d       %4d %4d\n", get_prec_str(prec), xdim, ydim, zdim, tdim,
+             coarse_ncolor, niter, bench_warmup);
+  printfQuda("Grid partition info:     X  Y  Z  T\n");
+  printfQuda("                         %d  %d  %d  %d\n", dimPartitioned(0), dimPartitioned(1), dimPartitioned(2),
+             dimPartitioned(3));
+}
+
+ColorSpinorParam spinorParam(int nSpin, int nColor, const int *x, QudaSiteSubset subset)
+{
+  ColorSpinorParam param;
+  param.nColor = nColor;
+  param.nSpin = nSpin;
+  param.nDim = 4;
+  for (int d = 0; d < 4; d++) param.x[d] = x[d];
+  if (subset == QUDA_PARITY_SITE_SUBSET) param.x[0] /= 2;
+  param.pad = 0;
+  param.siteSubset = subset;
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.setPrecision(prec);
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.location = QUDA_CPU_FIELD_LOCATION;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+  return param;
+}
+
+void benchmarkReference(BenchmarkHarness &bench, void **gauge, QudaGaugeParam &gauge_param)
+{
+  ColorSpinorParam param = spinorParam(4, 3, gauge_param.X, QUDA_PARITY_SITE_SUBSET);
+  cpuColorSpinorField in(param);
+  cpuColorSpinorField out(param);
+  in.Source(QUDA_RANDOM_SOURCE);
+
+  bench.run("wilson_dslash_reference", [&]() { wil_dslash(out.V(), gauge, in.V(), 0, 0, prec, gauge_param); },
+            1320.0 * Vh, (8 * (gauge_site_size + 24) + 24) * (double)prec * Vh);
+
+  // host blas on the same parity fields
+  int len = Vh * 24;
+  bench.run("host_blas_axpy", [&]() { axpy(0.5, in.V(), out.V(), len, prec); }, 2.0 * len, 3.0 * len * prec);
+  bench.run("host_blas_xpay", [&]() { xpay(in.V(), 0.5, out.V(), len, prec); }, 2.0 * len, 3.0 * len * prec);
+  bench.run("host_blas_ax", [&]() { ax(1.0, out.V(), len, prec); }, 1.0 * len, 2.0 * len * prec);
+  bench.run("host_blas_norm2", [&]() { norm_2(in.V(), len, prec); }, 2.0 * len, 1.0 * len * prec);
+}
+
+void benchmarkReorder(BenchmarkHarness &bench, void **gauge, QudaGaugeParam &gauge_param)
+{
+  ColorSpinorParam param = spinorParam(4, 3, gauge_param.X, QUDA_FULL_SITE_SUBSET);
+  cpuColorSpinorField ssc(param);
+  ssc.Source(QUDA_RANDOM_SOURCE);
+  param.fieldOrder = QUDA_SPACE_COLOR_SPIN_FIELD_ORDER;
+  cpuColorSpinorField scs(param);
+
+  bench.run("spinor_reorder_space_spin_color_to_space_color_spin", [&]() { scs = ssc; }, 0.0, 2.0 * ssc.Bytes());
+
+  GaugeFieldParam qdp_param(gauge, gauge_param);
+  cpuGaugeField qdp(qdp_param);
+
+  GaugeFieldParam milc_param(qdp_param);
+  milc_param.order = QUDA_MILC_GAUGE_ORDER;
+  milc_param.create = QUDA_NULL_FIELD_CREATE;
+  milc_param.gauge = nullptr;
+  cpuGaugeField milc(milc_param);
+
+  bench.run("gauge_reorder_qdp_to_milc", [&]() { milc.copy(qdp); }, 0.0, 2.0 * qdp.Bytes());
+  bench.run("gauge_checksum", [&]() { qdp.checksum(false); }, 0.0, qdp.Bytes());
+  bench.run("gauge_checksum_mini", [&]() { qdp.checksum(true); });
+}
+
+void benchmarkTuneCache(BenchmarkHarness &bench)
+{
+  // every launch constructs its key and looks it up, so time both
+  struct Key {
+    std::string volume, name, aux;
+  };
+  std::vector<Key> keys;
+  const auto &cache = getTuneCache();
+  for (auto &entry : cache) keys.push_back({entry.first.volume, entry.first.name, entry.first.aux});
+  keys.push_back({"0x0x0x0", "host_benchmark_test", "type=miss"});
+  bench.addContext("tunecache_entries", std::to_string(cache.size()));
+
+  volatile size_t found = 0;
+  bench.run("tunecache_lookup", [&]() {
+    for (auto &k : keys) found += cache.find(TuneKey(k.volume.c_str(), k.name.c_str(), k.aux.c_str())) != cache.end();
+  });
+}
+
+void benchmarkCoarse(BenchmarkHarness &bench)
+{
+#ifdef GPU_MULTIGRID
+  // block the fine lattice by 2^4, which keeps the coarse links in host memory
+  int x[4] = {std::max(xdim / 2, 2), std::max(ydim / 2, 2), std::max(zdim / 2, 2), std::max(tdim / 2, 2)};
+  const int nSpin = 2;
+
+  ColorSpinorParam param = spinorParam(nSpin, coarse_ncolor, x, QUDA_FULL_SITE_SUBSET);
+  cpuColorSpinorField in(param);
+  cpuColorSpinorField out(param);
+  in.Source(QUDA_RANDOM_SOURCE);
+
+  GaugeFieldParam gParam;
+  for (int d = 0; d < 4; d++) gParam.x[d] = x[d];
+  gParam.nColor = nSpin * coarse_ncolor;
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParam.order = QUDA_QDP_GAUGE_ORDER;
+  gParam.link_type = QUDA_COARSE_LINKS;
+  gParam.t_boundary = QUDA_PERIODIC_T;
+  gParam.create = QUDA_ZERO_FIELD_CREATE;
+  gParam.setPrecision(prec);
+  gParam.nDim = 4;
+  gParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  gParam.nFace = 1;
+  gParam.geometry = QUDA_COARSE_GEOMETRY;
+  cpuGaugeField Y(gParam);
+
+  gParam.geometry = QUDA_SCALAR_GEOMETRY;
+  gParam.nFace = 0;
+  cpuGaugeField X(gParam);
+
+  const int Ns = nSpin, Nc = coarse_ncolor;
+  double flops = ((2 * 4 + 1) * (8.0 * Ns * Nc * Ns * Nc) - 2 * Ns * Nc) * in.Volume();
+  double bytes = out.Bytes() + 8 * in.Bytes() + in.Bytes() + Y.Bytes() + X.Bytes();
+
+  bench.run("coarse_dslash_cpu_nc" + std::to_string(Nc),
+            [&]() { ApplyCoarse(out, in, in, Y, X, 0.1, QUDA_INVALID_PARITY, true, true, false); }, flops, bytes);
+#endif
+}
+
+/**
+   Exposes the restart state of the TRLM eigensolver so that its host
+   kernels can be driven with synthetic Lanczos coefficients.
+*/
+class BenchmarkTRLM : public TRLM
+{
+public:
+  BenchmarkTRLM(const DiracMatrix &mat, QudaEigParam *eig_param, TimeProfile &profile) :
+    TRLM(mat, eig_param, profile)
+  {
+  }
+
+  void setKept(int keep) { num_keep = keep; }
+};
+
+void benchmarkEigensolver(BenchmarkHarness &bench)
+{
+  // the TRLM host kernels never apply the operator, so an operator
+  // without a gauge field suffices
+  DiracParam dirac_param;
+  DiracWilson dirac(dirac_param);
+  DiracMdagM mat(dirac);
+
+  QudaEigParam eig_param = newQudaEigParam();
+  eig_param.eig_type = QUDA_EIG_TR_LANCZOS;
+  eig_param.spectrum = QUDA_SPECTRUM_SR_EIG;
+  eig_param.n_kr = eig_n_kr;
+  eig_param.n_ev = eig_n_ev;
+  eig_param.n_conv = eig_n_ev;
+  eig_param.n_ev_deflate = eig_n_ev;
+  TimeProfile profile("benchmarkEigensolver");
+  BenchmarkTRLM trlm(mat, &eig_param, profile);
+
+  // the restart diagonalizes the arrowhead matrix formed from the
+  // Lanczos coefficients and the kept Ritz values
+  const int dim = eig_n_kr;
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> alpha(dim), beta(dim);
+  for (int i = 0; i < dim; i++) {
+    alpha[i] = dist(gen);
+    beta[i] = dist(gen);
+  }
+  trlm.setKept(eig_n_ev);
+
+  bench.run("trlm_arrow_eigensolve_n" + std::to_string(dim), [&]() {
+    // the solve overwrites alpha with the Ritz values
+    std::copy(alpha.begin(), alpha.end(), trlm.alpha);
+    std::copy(beta.begin(), beta.end(), trlm.beta);
+    trlm.eigensolveFromArrowMat();
+  }, 9.0 * dim * dim * dim);
+
+  std::vector<Complex> ritz(dim), ritz_y(dim), x(dim), y(dim);
+  for (int i = 0; i < dim; i++) {
+    ritz[i] = Complex(dist(gen), dist(gen));
+    ritz_y[i] = Complex(dist(gen), 0.0);
+  }
+  bench.run("ritz_sort_lm_n" + std::to_string(dim), [&]() {
+    x = ritz;
+    y = ritz_y;
+    trlm.sortArrays(QUDA_SPECTRUM_LM_EIG, dim, x, y);
+  });
+}
+
+int main(int argc, char **argv)
+{
+  // Set some defaults that lets the benchmark fit in memory if you run it
+  // with default parameters.
+  xdim = ydim = zdim = tdim = 8;
+
+  // command line options
+  auto app = make_app();
+  add_eigen_option_group(app);
+  app->add_option("--bench-json", bench_json, "Write the benchmark results as JSON to this file (or stdout)");
+  app->add_option("--bench-warmup", bench_warmup, "The number of untimed calls before each benchmark (default 3)");
+  app->add_option("--bench-coarse-ncolor", coarse_ncolor, "Number of colors of the coarse dslash (default 24)");
+
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  // all benchmarked fields live on the host in the benchmark precision
+  cpu_prec = prec;
+  host_gauge_data_type_size = prec;
+  host_spinor_data_type_size = prec;
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  display_test_info();
+  initQuda(device_ordinal);
+
+  setVerbosity(verbosity);
+
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  setWilsonGaugeParam(gauge_param);
+  gauge_param.cpu_prec = prec;
+  setDims(gauge_param.X);
+  setSpinorSiteSize(24);
+
+  void *gauge[4];
+  for (int dir = 0; dir < 4; dir++) gauge[dir] = malloc(V * gauge_site_size * host_gauge_data_type_size);
+  constructHostGaugeField(gauge, gauge_param, argc, argv);
+
+  BenchmarkHarness bench(bench_warmup, niter);
+  bench.addContext("precision", get_prec_str(prec));
+  bench.addContext("lattice", std::to_string(xdim) + "x" + std::to_string(ydim) + "x" + std::to_string(zdim) + "x"
+                     + std::to_string(tdim));
+  bench.addContext("ranks", std::to_string(comm_size()));
+
+  printfQuda("\nBenchmarking host routines in %s precision with %d repetitions...\n\n", get_prec_str(prec), niter);
+  benchmarkReference(bench, gauge, gauge_param);
+  benchmarkReorder(bench, gauge, gauge_param);
+  benchmarkTuneCache(bench);
+  benchmarkCoarse(bench);
+  benchmarkEigensolver(bench);
+
+  bench.print();
+  if (!bench_json.empty()) bench.writeJSON(bench_json);
+
+  for (int dir = 0; dir < 4; dir++) free(gauge[dir]);
+
+  endQuda();
+
+  finalizeComms();
+}
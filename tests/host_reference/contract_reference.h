@@ -1,6 +1,10 @@
 #pragma once
 
+#include <complex>
+#include <vector>
+
 #include <host_utils.h>
+#include <comm_quda.h>
 #include <quda_internal.h>
 #include "color_spinor_field.h"
 
@@ -231,3 +235,182 @@ int contraction_reference(Float *spinorX, Float *spinorY, Float *d_result, QudaC
   free(h_result);
   return faults;
 };
+
+/**
+   @brief Check the momentum-projected, timeslice-summed contraction
+   against the site contractions computed on the host
+   @return The number of correlator values that do not agree
+*/
+template <typename Float>
+int contraction_ft_reference(Float *spinorX, Float *spinorY, const double *d_result, QudaContractType cType,
+                             const int *mom, int n_mom, const int *gamma, int n_gamma, int X[])
+{
+  int faults = 0;
+  double tol = (sizeof(Float) == sizeof(double) ? 1e-9 : 1e-5);
+  Float *h_site = (Float *)malloc(V * 2 * 16 * sizeof(Float));
+
+  // compute the site contractions
+  contractColor(spinorX, spinorY, h_site);
+  if (cType == QUDA_CONTRACT_TYPE_DR) contractDegrandRossi(h_site);
+
+  int L[4], offset[4];
+  for (int d = 0; d < 4; d++) {
+    L[d] = comm_dim(d) * X[d];
+    offset[d] = comm_coord(d) * X[d];
+  }
+
+  // project onto the momenta and sum over timeslices
+  std::vector<std::complex<double>> h_result(L[3] * n_mom * n_gamma, 0.0);
+  for (int i = 0; i < V; i++) {
+    int lex = fullLatticeIndex(i % Vh, i / Vh);
+    int x[4] = {lex % X[0], (lex / X[0]) % X[1], (lex / (X[0] * X[1])) % X[2], lex / (X[0] * X[1] * X[2])};
+    for (int p = 0; p < n_mom; p++) {
+      double theta = 0.0;
+      for (int d = 0; d < 3; d++) theta += (double)mom[3 * p + d] * (x[d] + offset[d]) / L[d];
+      std::complex<double> phase = std::polar(1.0, -2.0 * M_PI * theta);
+      for (int g = 0; g < n_gamma; g++) {
+        std::complex<double> c(h_site[2 * (16 * i + gamma[g]) + 0], h_site[2 * (16 * i + gamma[g]) + 1]);
+        h_result[((x[3] + offset[3]) * n_mom + p) * n_gamma + g] += phase * c;
+      }
+    }
+  }
+  comm_allreduce_array((double *)h_result.data(), 2 * h_result.size());
+
+  for (auto i = 0u; i < h_result.size(); i++) {
+    double scale = std::max(1.0, std::abs(h_result[i]));
+    if (std::abs(h_result[i].real() - d_result[2 * i + 0]) > tol * scale) faults++;
+    if (std::abs(h_result[i].imag() - d_result[2 * i + 1]) > tol * scale) faults++;
+  }
+
+  free(h_site);
+  return faults;
+}
+
+/**
+   @brief Check the meson and nucleon correlators of the propagator
+   contraction against a dense evaluation of their definitions, with
+   the DeGrand-Rossi gamma matrices obtained from contractDegrandRossi
+   @return The number of correlator values that do not agree
+*/
+template <typename Float>
+int contraction_propagator_reference(Float **prop1, Float **prop2, const double *d_meson, const double *d_baryon,
+                                     const int *mom, int n_mom, int X[])
+{
+  using complex_t = std::complex<double>;
+  double tol = (sizeof(Float) == sizeof(double) ? 1e-9 : 1e-4);
+
+  // Gamma[g][mu][nu] from the projection of the unit spin elementals
+  if (V < 16) errorQuda("Lattice volume %d too small for the propagator contraction test", V);
+  std::vector<Float> unit(V * 2 * 16, 0.0);
+  for (int k = 0; k < 16; k++) unit[2 * (16 * k + k)] = 1.0;
+  contractDegrandRossi(unit.data());
+  complex_t Gamma[16][4][4];
+  for (int g = 0; g < 16; g++)
+    for (int k = 0; k < 16; k++) Gamma[g][k / 4][k % 4] = complex_t(unit[2 * (16 * k + g)], unit[2 * (16 * k + g) + 1]);
+
+  // C gamma_5 = gamma_2 gamma_4 gamma_5
+  complex_t Cg5[4][4] = {};
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+      for (int k = 0; k < 4; k++)
+        for (int l = 0; l < 4; l++) Cg5[i][l] += Gamma[2][i][j] * Gamma[4][j][k] * Gamma[5][k][l];
+
+  const int eps[6][4] = {{0, 1, 2, 1}, {1, 2, 0, 1}, {2, 0, 1, 1}, {0, 2, 1, -1}, {2, 1, 0, -1}, {1, 0, 2, -1}};
+
+  int L[4], offset[4];
+  for (int d = 0; d < 4; d++) {
+    L[d] = comm_dim(d) * X[d];
+    offset[d] = comm_coord(d) * X[d];
+  }
+
+  std::vector<complex_t> h_meson(L[3] * n_mom * 16, 0.0);
+  std::vector<complex_t> h_baryon(L[3] * n_mom * 16, 0.0);
+  std::vector<complex_t> U(144), D(144), T(144);
+  for (int i = 0; i < V; i++) {
+    // S[3 * s + c][3 * s' + c'] = component (s, c) of column 3 * s' + c'
+    for (int r = 0; r < 12; r++) {
+      for (int col = 0; col < 12; col++) {
+        U[12 * r + col] = complex_t(prop1[col][24 * i + 2 * r], prop1[col][24 * i + 2 * r + 1]);
+        D[12 * r + col] = complex_t(prop2[col][24 * i + 2 * r], prop2[col][24 * i + 2 * r + 1]);
+      }
+    }
+
+    // T = gamma_5 S2^dagger gamma_5
+    for (int l = 0; l < 4; l++)
+      for (int b = 0; b < 3; b++)
+        for (int k = 0; k < 4; k++)
+          for (int a = 0; a < 3; a++) {
+            complex_t t = 0.0;
+            for (int m = 0; m < 4; m++)
+              for (int n = 0; n < 4; n++)
+                t += Gamma[5][l][m] * std::conj(D[12 * (3 * n + a) + 3 * m + b]) * Gamma[5][n][k];
+            T[12 * (3 * l + b) + 3 * k + a] = t;
+          }
+
+    complex_t meson[16];
+    for (int g = 0; g < 16; g++) {
+      meson[g] = 0.0;
+      for (int ii = 0; ii < 4; ii++)
+        for (int j = 0; j < 4; j++)
+          for (int k = 0; k < 4; k++)
+            for (int l = 0; l < 4; l++) {
+              complex_t gg = Gamma[g][ii][j] * Gamma[g][k][l];
+              if (gg == 0.0) continue;
+              for (int a = 0; a < 3; a++)
+                for (int b = 0; b < 3; b++)
+                  meson[g] += gg * U[12 * (3 * j + a) + 3 * k + b] * T[12 * (3 * l + b) + 3 * ii + a];
+            }
+    }
+
+    complex_t baryon[16] = {};
+    for (int e = 0; e < 6; e++) {
+      for (int ep = 0; ep < 6; ep++) {
+        const int a = eps[e][0], b = eps[e][1], c = eps[e][2];
+        const int ap = eps[ep][0], bp = eps[ep][1], cp = eps[ep][2];
+        const double sign = eps[e][3] * eps[ep][3];
+        complex_t Q[4][4] = {};
+        for (int be = 0; be < 4; be++)
+          for (int bep = 0; bep < 4; bep++)
+            for (int ga = 0; ga < 4; ga++)
+              for (int gap = 0; gap < 4; gap++)
+                Q[be][bep] += Cg5[be][ga] * D[12 * (3 * ga + c) + 3 * gap + cp] * Cg5[gap][bep];
+        for (int al = 0; al < 4; al++)
+          for (int alp = 0; alp < 4; alp++)
+            for (int be = 0; be < 4; be++)
+              for (int bep = 0; bep < 4; bep++) {
+                complex_t direct = U[12 * (3 * al + a) + 3 * alp + ap] * U[12 * (3 * be + b) + 3 * bep + bp];
+                complex_t exchange = U[12 * (3 * al + a) + 3 * bep + bp] * U[12 * (3 * be + b) + 3 * alp + ap];
+                baryon[4 * al + alp] += sign * Q[be][bep] * (direct - exchange);
+              }
+      }
+    }
+
+    int lex = fullLatticeIndex(i % Vh, i / Vh);
+    int x[4] = {lex % X[0], (lex / X[0]) % X[1], (lex / (X[0] * X[1])) % X[2], lex / (X[0] * X[1] * X[2])};
+    for (int p = 0; p < n_mom; p++) {
+      double theta = 0.0;
+      for (int d = 0; d < 3; d++) theta += (double)mom[3 * p + d] * (x[d] + offset[d]) / L[d];
+      complex_t phase = std::polar(1.0, -2.0 * M_PI * theta);
+      for (int g = 0; g < 16; g++) {
+        h_meson[((x[3] + offset[3]) * n_mom + p) * 16 + g] += phase * meson[g];
+        h_baryon[((x[3] + offset[3]) * n_mom + p) * 16 + g] += phase * baryon[g];
+      }
+    }
+  }
+  comm_allreduce_array((double *)h_meson.data(), 2 * h_meson.size());
+  comm_allreduce_array((double *)h_baryon.data(), 2 * h_baryon.size());
+
+  // compare relative to the largest correlator value, since channels can vanish
+  int faults = 0;
+  for (auto h : {std::make_pair(&h_meson, d_meson), std::make_pair(&h_baryon, d_baryon)}) {
+    const std::vector<complex_t> &ref = *h.first;
+    double scale = 1.0;
+    for (auto &r : ref) scale = std::max(scale, std::abs(r));
+    for (auto i = 0u; i < ref.size(); i++) {
+      if (std::abs(ref[i].real() - h.second[2 * i + 0]) > tol * scale) faults++;
+      if (std::abs(ref[i].imag() - h.second[2 * i + 1]) > tol * scale) faults++;
+    }
+  }
+
+  return faults;
+}
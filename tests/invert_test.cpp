@@ -3,10 +3,13 @@
 #include <time.h>
 #include <math.h>
 #include <string.h>
+#include <fstream>
 
 // QUDA headers
 #include <quda.h>
 #include <color_spinor_field.h> // convenient quark field container
+#include <blas_quda.h>
+#include <workspace.h>
 
 // External headers
 #include <misc.h>
@@ -16,6 +19,18 @@
 
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 
+// whether to also check the solve-context interface against invertQuda
+bool solve_context = false;
+
+// if set, round-trip the multigrid preconditioner through a checkpoint with this prefix
+std::string mg_checkpoint;
+
+// if set, write solver telemetry to this file and check the record of the last solve
+std::string telemetry_file;
+
+// whether to also compare deflated solves with a compressed and an uncompressed deflation space
+bool compressed_deflation_check = false;
+
 void display_test_info()
 {
   printfQuda("running the following test:\n");
@@ -97,6 +112,216 @@ void display_test_info()
              dimPartitioned(3));
 }
 
+/**
+   Solve the same source with invertQuda and with a solve context and
+   compare the iteration counts and solutions.
+   @return Whether the two paths agree
+*/
+bool compareSolveContext(void *context, quda::ColorSpinorField &in, quda::ColorSpinorField &ref,
+                         quda::ColorSpinorField &x, QudaInvertParam &inv_param)
+{
+  QudaInvertParam ref_param = inv_param;
+  QudaInvertParam ctx_param = inv_param;
+  invertQuda(ref.V(), in.V(), &ref_param);
+  solveWithContextQuda(context, x.V(), in.V(), &ctx_param);
+
+  double nrm = quda::blas::norm2(ref);
+  double diff = sqrt(quda::blas::xmyNorm(ref, x) / nrm);
+  printfQuda("Solve context: iter %d (invertQuda %d), relative solution difference %e\n", ctx_param.iter,
+             ref_param.iter, diff);
+  return abs(ctx_param.iter - ref_param.iter) <= 1 && diff <= 10 * inv_param.tol;
+}
+
+/**
+   Check that a solve context reproduces invertQuda, reuses its state
+   and workspace across repeated solves and when only per-solve
+   parameters change, and rebuilds it when the resident gauge field is
+   reloaded or an operator parameter changes.
+   @return The number of failed checks
+*/
+int testSolveContext(void **gauge, QudaGaugeParam &gauge_param, QudaInvertParam inv_param,
+                     quda::ColorSpinorField &in, quda::ColorSpinorParam &cs_param)
+{
+  int fails = 0;
+  auto check = [&](bool pass, const char *what) {
+    printfQuda("Solve context %s: %s\n", what, pass ? "PASSED" : "FAILED");
+    if (!pass) fails++;
+  };
+
+  quda::ColorSpinorField *ref = quda::ColorSpinorField::Create(cs_param);
+  quda::ColorSpinorField *x = quda::ColorSpinorField::Create(cs_param);
+  void *context = newSolveContextQuda(&inv_param);
+
+  check(compareSolveContext(context, in, *ref, *x, inv_param), "first solve matches invertQuda");
+  check(getSolveContextBuildsQuda(context) == 1, "built on first solve");
+
+  // repeated solves neither rebuild the state nor reallocate its workspace, whatever QUDA_WORKSPACE_RETAIN is
+  {
+    QudaInvertParam param = inv_param;
+    solveWithContextQuda(context, x->V(), in.V(), &param);
+    size_t pool = quda::workspace::pool_bytes();
+    size_t created = quda::workspace::created();
+    for (int i = 0; i < 3; i++) {
+      param = inv_param;
+      solveWithContextQuda(context, x->V(), in.V(), &param);
+    }
+    printfQuda("Solve context workspace: %lu bytes held after first solve, %lu after repeats, %lu fields created\n",
+               pool, quda::workspace::pool_bytes(), quda::workspace::created() - created);
+    check(getSolveContextBuildsQuda(context) == 1, "reused across repeated solves");
+    check(quda::workspace::pool_bytes() == pool, "workspace does not grow across repeated solves");
+    check(quda::workspace::created() == created, "workspace is not reallocated across repeated solves");
+  }
+
+  // per-solve parameters reuse the state
+  inv_param.tol *= 10;
+  inv_param.maxiter += 1;
+  check(compareSolveContext(context, in, *ref, *x, inv_param), "solve with new tolerance matches invertQuda");
+  check(getSolveContextBuildsQuda(context) == 1, "reused after per-solve parameter change");
+
+  // reloading the gauge field bumps the resident generation
+  loadGaugeQuda((void *)gauge, &gauge_param);
+  check(compareSolveContext(context, in, *ref, *x, inv_param), "solve after gauge reload matches invertQuda");
+  check(getSolveContextBuildsQuda(context) == 2, "rebuilt after gauge reload");
+
+  // an operator parameter is not a per-solve parameter
+  inv_param.kappa *= 0.99;
+  check(compareSolveContext(context, in, *ref, *x, inv_param), "solve with new kappa matches invertQuda");
+  check(getSolveContextBuildsQuda(context) == 3, "rebuilt after operator parameter change");
+
+  destroySolveContextQuda(context);
+  delete ref;
+  delete x;
+  return fails;
+}
+
+/**
+   Checkpoint the multigrid preconditioner, restore it into a new
+   instance, and check that solving the same source with either
+   instance gives the same iteration count and solution.
+   @return The number of failed checks
+*/
+int testMultigridCheckpoint(void *mg_preconditioner, QudaMultigridParam &mg_param, QudaInvertParam inv_param,
+                            quda::ColorSpinorField &in, quda::ColorSpinorParam &cs_param)
+{
+  quda::ColorSpinorField *ref = quda::ColorSpinorField::Create(cs_param);
+  quda::ColorSpinorField *x = quda::ColorSpinorField::Create(cs_param);
+
+  // checkpoint before solving, since a solve may refresh the null space
+  checkpointMultigridQuda(mg_preconditioner, &mg_param, mg_checkpoint.c_str());
+
+  QudaInvertParam ref_param = inv_param;
+  ref_param.preconditioner = mg_preconditioner;
+  invertQuda(ref->V(), in.V(), &ref_param);
+
+  void *mg_restored = restoreMultigridQuda(&mg_param, mg_checkpoint.c_str());
+  QudaInvertParam restored_param = inv_param;
+  restored_param.preconditioner = mg_restored;
+  invertQuda(x->V(), in.V(), &restored_param);
+  destroyMultigridQuda(mg_restored);
+
+  double nrm = quda::blas::norm2(*ref);
+  double diff = sqrt(quda::blas::xmyNorm(*ref, *x) / nrm);
+  printfQuda("Multigrid checkpoint: iter %d (original %d), relative solution difference %e\n", restored_param.iter,
+             ref_param.iter, diff);
+
+  int fails = 0;
+  auto check = [&](bool pass, const char *what) {
+    printfQuda("Multigrid checkpoint %s: %s\n", what, pass ? "PASSED" : "FAILED");
+    if (!pass) fails++;
+  };
+  check(restored_param.iter == ref_param.iter, "iteration count matches");
+  check(diff <= inv_param.tol, "solution matches");
+
+  delete ref;
+  delete x;
+  return fails;
+}
+
+/**
+   Solve the same source without deflation, with an uncompressed
+   deflation space and with a compressed one, and check that the
+   compressed space retains most of the reduction in the iteration
+   count that deflation gives.
+   @return The number of failed checks
+*/
+int testCompressedDeflation(QudaInvertParam inv_param, QudaEigParam eig_param, quda::ColorSpinorField &in,
+                            quda::ColorSpinorParam &cs_param)
+{
+  quda::ColorSpinorField *x = quda::ColorSpinorField::Create(cs_param);
+  eig_param.preserve_deflation = QUDA_BOOLEAN_FALSE;
+
+  auto solve = [&](bool deflate, bool compress) {
+    QudaInvertParam param = inv_param;
+    eig_param.compress_deflation = compress ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+    param.eig_param = deflate ? &eig_param : nullptr;
+    invertQuda(x->V(), in.V(), &param);
+    return param.iter;
+  };
+  int undeflated = solve(false, false);
+  int uncompressed = solve(true, false);
+  int compressed = solve(true, true);
+  printfQuda("Compressed deflation: iter %d (uncompressed %d, undeflated %d)\n", compressed, uncompressed, undeflated);
+
+  int fails = 0;
+  auto check = [&](bool pass, const char *what) {
+    printfQuda("Compressed deflation %s: %s\n", what, pass ? "PASSED" : "FAILED");
+    if (!pass) fails++;
+  };
+  check(uncompressed < undeflated, "uncompressed space reduces the iteration count");
+  check(compressed <= uncompressed + (undeflated - uncompressed) / 2, "compressed space retains the reduction");
+
+  delete x;
+  return fails;
+}
+
+/**
+   Parse the last record written to the telemetry file and check that
+   the counters of the solve were collected.
+   @return The number of failed checks
+*/
+int checkTelemetry(const QudaInvertParam &inv_param)
+{
+  if (comm_rank() != 0) return 0; // only rank 0 writes the records
+
+  std::ifstream file(telemetry_file);
+  std::string line, record;
+  while (std::getline(file, line))
+    if (!line.empty()) record = line;
+
+  // the text following the first "key": in text, or an empty string if the key is missing
+  auto find = [](const std::string &text, const std::string &key) {
+    auto pos = text.find("\"" + key + "\":");
+    return pos == std::string::npos ? std::string() : text.substr(pos + key.size() + 3);
+  };
+  auto field = [&](const std::string &key) { return find(record, key); };
+
+  int fails = 0;
+  auto check = [&](bool pass, const char *what) {
+    printfQuda("Telemetry %s: %s\n", what, pass ? "PASSED" : "FAILED");
+    if (!pass) fails++;
+  };
+
+  check(!record.empty(), "record written");
+  check(atoi(field("iter").c_str()) == inv_param.iter && inv_param.iter > 0, "iteration count");
+  check(strtod(field("gflops").c_str(), nullptr) > 0.0, "gflops");
+  check(field("residual_history").compare(0, 2, "[[") == 0, "residual history");
+  check(field("solves").compare(0, 2, "[{") == 0, "solver list");
+
+  // "flops":{"blas":n,"<operator>":n,...} and "bytes":{"blas":n}
+  std::string flops = field("flops");
+  flops = flops.substr(0, flops.find('}'));
+  check(strtoull(find(flops, "blas").c_str(), nullptr, 10) > 0, "blas flops");
+  bool operator_flops = false;
+  for (auto pos = flops.find(','); pos != std::string::npos; pos = flops.find(',', pos + 1)) {
+    auto colon = flops.find(':', pos);
+    if (colon != std::string::npos && strtoull(flops.c_str() + colon + 1, nullptr, 10) > 0) operator_flops = true;
+  }
+  check(operator_flops, "operator flops");
+  check(strtoull(find(field("bytes"), "blas").c_str(), nullptr, 10) > 0, "blas bytes");
+
+  return fails;
+}
+
 int main(int argc, char **argv)
 {
   setQudaDefaultMgTestParams();
@@ -106,6 +331,15 @@ int main(int argc, char **argv)
   add_deflation_option_group(app);
   add_eofa_option_group(app);
   add_multigrid_option_group(app);
+  app->add_option("--solve-context", solve_context,
+                  "Also check newSolveContextQuda/solveWithContextQuda against invertQuda (default false)");
+  app->add_option("--mg-checkpoint", mg_checkpoint,
+                  "Round-trip the multigrid preconditioner through checkpointMultigridQuda/restoreMultigridQuda "
+                  "with this filename prefix and compare the solves (default unset)");
+  app->add_option("--telemetry-check", telemetry_file,
+                  "Write solver telemetry to this file and check the record of the last solve (default unset)");
+  app->add_option("--compressed-deflation-check", compressed_deflation_check,
+                  "Also compare deflated solves with a compressed and an uncompressed deflation space (default false)");
   try {
     app->parse(argc, argv);
   } catch (const CLI::ParseError &e) {
@@ -288,12 +522,17 @@ int main(int argc, char **argv)
     }
   }
 
+  if (!telemetry_file.empty()) {
+    // records are appended, so start from an empty file
+    if (comm_rank() == 0) remove(telemetry_file.c_str());
+    setenv("QUDA_TELEMETRY_FILE", telemetry_file.c_str(), 1);
+  }
+
   std::vector<double> time(Nsrc);
   std::vector<double> gflops(Nsrc);
   std::vector<int> iter(Nsrc);
 
   auto *rng = new quda::RNG(quda::LatticeFieldParam(gauge_param), 1234);
-  rng->Init();
 
   for (int i = 0; i < Nsrc; i++) {
 
@@ -317,7 +556,44 @@ int main(int argc, char **argv)
   // QUDA invert test COMPLETE
   //----------------------------------------------------------------------------
 
-  rng->Release();
+  int telemetry_fails = telemetry_file.empty() ? 0 : checkTelemetry(inv_param);
+
+  int solve_context_fails = 0;
+  if (solve_context) {
+    if (multishift > 1 || inv_deflate || inv_multigrid) {
+      printfQuda("The solve-context test does not support multi-shift, deflated or multigrid solves, skipping\n");
+    } else {
+      quda::ColorSpinorField *src = quda::ColorSpinorField::Create(cs_param);
+      constructRandomSpinorSource(src->V(), 4, 3, inv_param.cpu_prec, inv_param.solution_type, gauge_param.X, *rng);
+      solve_context_fails = testSolveContext(gauge, gauge_param, inv_param, *src, cs_param);
+      delete src;
+    }
+  }
+
+  int mg_checkpoint_fails = 0;
+  if (!mg_checkpoint.empty()) {
+    if (!inv_multigrid || multishift > 1) {
+      printfQuda("The multigrid checkpoint test requires a single-shift multigrid solve, skipping\n");
+    } else {
+      quda::ColorSpinorField *src = quda::ColorSpinorField::Create(cs_param);
+      constructRandomSpinorSource(src->V(), 4, 3, inv_param.cpu_prec, inv_param.solution_type, gauge_param.X, *rng);
+      mg_checkpoint_fails = testMultigridCheckpoint(mg_preconditioner, mg_param, inv_param, *src, cs_param);
+      delete src;
+    }
+  }
+
+  int compressed_deflation_fails = 0;
+  if (compressed_deflation_check) {
+    if (!inv_deflate || multishift > 1) {
+      printfQuda("The compressed deflation test requires a single-shift deflated solve, skipping\n");
+    } else {
+      quda::ColorSpinorField *src = quda::ColorSpinorField::Create(cs_param);
+      constructRandomSpinorSource(src->V(), 4, 3, inv_param.cpu_prec, inv_param.solution_type, gauge_param.X, *rng);
+      compressed_deflation_fails = testCompressedDeflation(inv_param, eig_param, *src, cs_param);
+      delete src;
+    }
+  }
+
   delete rng;
 
   // free the multigrid solver
@@ -353,5 +629,5 @@ int main(int argc, char **argv)
   endQuda();
   finalizeComms();
 
-  return 0;
+  return solve_context_fails + mg_checkpoint_fails + telemetry_fails + compressed_deflation_fails > 0 ? 1 : 0;
 }
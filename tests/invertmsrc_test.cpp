@@ -113,7 +113,6 @@ int main(int argc, char **argv)
   }
 
   auto *rng = new quda::RNG(quda::LatticeFieldParam(gauge_param), 1234);
-  rng->Init();
 
   // Vector construct START
   //-----------------------------------------------------------------------------------
@@ -167,7 +166,6 @@ int main(int argc, char **argv)
   // QUDA invert test COMPLETE
   //----------------------------------------------------------------------------
 
-  rng->Release();
   delete rng;
 
   // Clean up memory allocations
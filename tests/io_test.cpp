@@ -0,0 +1,443 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <quda.h>
+#include <quda_internal.h>
+#include <comm_quda.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+
+#include <host_utils.h>
+#include <command_line_params.h>
+
+#include <qio_field.h>
+#include <vector_io.h>
+
+#include <gtest/gtest.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace quda;
+
+// round-trip tests of the field I/O
+
+namespace
+{
+
+#ifdef HAVE_QIO
+  // local lattice dimensions from the command line
+  std::vector<int> localDims() { return {xdim, ydim, zdim, tdim}; }
+
+  // Nvec host Wilson vectors of random numbers, seeded by rank
+  std::vector<std::vector<double>> randomVectors(int Nvec, size_t volume)
+  {
+    std::mt19937 rng(1234 + comm_rank());
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<std::vector<double>> v(Nvec, std::vector<double>(volume * 24));
+    for (auto &x : v) std::generate(x.begin(), x.end(), [&]() { return dist(rng); });
+    return v;
+  }
+#endif
+
+  // remove a file once every rank is done with it
+  void removeFile(const char *filename)
+  {
+    comm_barrier();
+    if (comm_rank() == 0) remove(filename);
+  }
+
+  // a single-parity host Wilson field of the local volume
+  ColorSpinorParam hostParam(QudaPrecision precision)
+  {
+    ColorSpinorParam param;
+    param.nColor = 3;
+    param.nSpin = 4;
+    param.nDim = 4;
+    param.pad = 0;
+    param.siteSubset = QUDA_PARITY_SITE_SUBSET;
+    param.x[0] = xdim / 2;
+    param.x[1] = ydim;
+    param.x[2] = zdim;
+    param.x[3] = tdim;
+    param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+    param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+    param.location = QUDA_CPU_FIELD_LOCATION;
+    param.create = QUDA_ZERO_FIELD_CREATE;
+    param.setPrecision(precision);
+    return param;
+  }
+
+  // whether filename starts with the vector archive magic
+  bool hasArchiveMagic(const char *filename)
+  {
+    char magic[8] = {};
+    FILE *f = fopen(filename, "rb");
+    if (!f) return false;
+    bool archive = fread(magic, 1, sizeof(magic), f) == sizeof(magic) && memcmp(magic, "QUDAVEC1", sizeof(magic)) == 0;
+    fclose(f);
+    return archive;
+  }
+
+  /**
+     @brief Save vectors to a block-scaled archive, load them back in
+     single precision and check every component against the archive's
+     error bound: half a unit in the last place of the fixed-point
+     format, relative to the largest component of its block.
+     @param[in] vecs The vectors to save
+     @param[in] ref The values of the vectors in single precision
+     @param[in] block The number of sites per scale factor
+  */
+  void checkArchive(std::vector<ColorSpinorField *> &vecs, const std::vector<ColorSpinorField *> &ref, int block)
+  {
+    const char *filename = "io_test_archive.qvec";
+    setenv("QUDA_VECTOR_ARCHIVE_BLOCK", std::to_string(block).c_str(), 1);
+    VectorIO(filename, false, true).save(vecs);
+    unsetenv("QUDA_VECTOR_ARCHIVE_BLOCK");
+    EXPECT_TRUE(hasArchiveMagic(filename));
+
+    std::vector<ColorSpinorField *> out;
+    for (size_t i = 0; i < vecs.size(); i++) out.push_back(ColorSpinorField::Create(hostParam(QUDA_SINGLE_PRECISION)));
+    VectorIO(filename).load(out);
+
+    const double max = vecs[0]->Precision() == QUDA_HALF_PRECISION ? std::numeric_limits<int16_t>::max() :
+                                                                     std::numeric_limits<int8_t>::max();
+    const size_t n = block * 24;
+    for (size_t i = 0; i < vecs.size(); i++) {
+      const float *r = static_cast<const float *>(ref[i]->V());
+      const float *v = static_cast<const float *>(out[i]->V());
+      double deviation = 0.0;
+      for (size_t b = 0; b < ref[i]->Volume() / block; b++) {
+        double scale = 0.0;
+        for (size_t j = b * n; j < (b + 1) * n; j++) scale = std::max(scale, std::abs(static_cast<double>(r[j])));
+        for (size_t j = b * n; j < (b + 1) * n; j++) {
+          // allow for the single-precision scale factor and arithmetic
+          const double bound = 0.5 * scale / max + 4 * std::numeric_limits<float>::epsilon() * scale;
+          deviation = std::max(deviation, std::abs(r[j] - static_cast<double>(v[j])) - bound);
+        }
+      }
+      EXPECT_LE(deviation, 0.0) << "vector " << i << " with " << block << " sites per scale";
+      delete out[i];
+    }
+
+    removeFile(filename);
+  }
+
+  /**
+     @brief A host gauge field of the local volume in QDP order
+     @param[in] precision The precision of the field
+     @param[in] random Whether to fill the field with random SU(3) links
+  */
+  cpuGaugeField *hostGauge(QudaPrecision precision, bool random)
+  {
+    QudaGaugeParam gauge_param = newQudaGaugeParam();
+    setWilsonGaugeParam(gauge_param);
+    gauge_param.cpu_prec = precision;
+    gauge_param.t_boundary = QUDA_PERIODIC_T;
+    setDims(gauge_param.X);
+
+    GaugeFieldParam param(nullptr, gauge_param);
+    param.create = QUDA_NULL_FIELD_CREATE;
+    param.pad = 0;
+    auto u = new cpuGaugeField(param);
+    if (random) constructQudaGaugeField(static_cast<void **>(u->Gauge_p()), 1, precision, &gauge_param);
+    return u;
+  }
+
+  // maximum difference between the links of two host gauge fields of the same precision
+  template <typename Float> double linkDifference(const GaugeField &a, const GaugeField &b)
+  {
+    double diff = 0.0;
+    for (int d = 0; d < 4; d++) {
+      auto pa = static_cast<Float *const *>(a.Gauge_p())[d];
+      auto pb = static_cast<Float *const *>(b.Gauge_p())[d];
+      for (size_t i = 0; i < a.Volume() * 18; i++) diff = std::max(diff, std::abs(double(pa[i]) - double(pb[i])));
+    }
+    comm_allreduce_max(&diff);
+    return diff;
+  }
+
+  // the gauge file formats, selected by GaugeField::write from the extension
+  const std::vector<std::string> gauge_files = {"io_test_gauge.nersc", "io_test_gauge.lime", "io_test_gauge.milc"};
+
+} // namespace
+
+// a gauge field written in each format reads back with the same links,
+// and the checksums and plaquette stored in the file are verified on read
+TEST(GaugeIO, round_trip)
+{
+  for (auto precision : {QUDA_DOUBLE_PRECISION, QUDA_SINGLE_PRECISION}) {
+    cpuGaugeField *u = hostGauge(precision, true);
+    for (auto filename : gauge_files) {
+      u->write(&filename[0]);
+      cpuGaugeField *v = hostGauge(precision, false);
+      v->read(&filename[0]);
+
+      // MILC files are always single precision, so double-precision links are rounded
+      bool exact = precision == QUDA_SINGLE_PRECISION || filename.find(".milc") == std::string::npos;
+      double diff = precision == QUDA_DOUBLE_PRECISION ? linkDifference<double>(*u, *v) : linkDifference<float>(*u, *v);
+      if (exact) {
+        EXPECT_EQ(diff, 0.0) << filename << " precision " << precision;
+        EXPECT_EQ(u->checksum(), v->checksum()) << filename << " precision " << precision;
+      } else {
+        EXPECT_LE(diff, std::numeric_limits<float>::epsilon()) << filename << " precision " << precision;
+      }
+
+      delete v;
+      removeFile(filename.c_str());
+    }
+    delete u;
+  }
+}
+
+// reading a file whose link data no longer matches its checksum is an error
+TEST(GaugeIO, corrupted_checksum)
+{
+#ifdef MULTI_GPU
+  // errorQuda aborts every rank, which cannot be caught by a death test
+  GTEST_SKIP();
+#else
+  ::testing::GTEST_FLAG(death_test_style) = "threadsafe";
+  cpuGaugeField *u = hostGauge(QUDA_SINGLE_PRECISION, true);
+  for (auto filename : gauge_files) {
+    u->write(&filename[0]);
+
+    // the link data make up almost all of the file, so flip a bit in its middle
+    FILE *f = fopen(filename.c_str(), "r+b");
+    ASSERT_NE(f, nullptr);
+    fseek(f, 0, SEEK_END);
+    long middle = ftell(f) / 2;
+    fseek(f, middle, SEEK_SET);
+    int c = fgetc(f);
+    fseek(f, middle, SEEK_SET);
+    fputc(c ^ 0x1, f);
+    fclose(f);
+
+    cpuGaugeField *v = hostGauge(QUDA_SINGLE_PRECISION, false);
+    EXPECT_EXIT(v->read(&filename[0]), ::testing::ExitedWithCode(1), "") << filename;
+    delete v;
+    removeFile(filename.c_str());
+  }
+  delete u;
+#endif
+}
+
+// the checksum accumulated by a host reorder or a file read equals the
+// checksum of the field, whatever the number of threads
+TEST(GaugeChecksum, stream)
+{
+#ifdef _OPENMP
+  const int max_threads = omp_get_max_threads();
+  const std::vector<int> threads = {1, 2, std::max(max_threads, 3)};
+#else
+  const std::vector<int> threads = {1};
+#endif
+
+  cpuGaugeField *u = hostGauge(QUDA_DOUBLE_PRECISION, true);
+  const uint64_t ref = u->checksum();
+  const std::string filename = gauge_files[0];
+  u->write(&filename[0]);
+
+  GaugeFieldParam param(*u);
+  param.create = QUDA_NULL_FIELD_CREATE;
+  param.order = QUDA_MILC_GAUGE_ORDER;
+  param.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  cpuGaugeField milc(param);
+  param.setPrecision(QUDA_SINGLE_PRECISION);
+  cpuGaugeField single(param);
+
+  for (int n : threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(n);
+#endif
+    uint64_t checksum = 0;
+    EXPECT_EQ(u->checksum(), ref) << n << " threads";
+
+    checksumStreamBegin();
+    milc.copy(*u);
+    EXPECT_TRUE(checksumStreamEnd(checksum));
+    EXPECT_EQ(checksum, ref) << n << " threads";
+
+    // summing the destination of a reorder that changes the precision
+    checksumStreamBegin(true);
+    single.copy(*u);
+    EXPECT_TRUE(checksumStreamEnd(checksum));
+    EXPECT_EQ(checksum, single.checksum()) << n << " threads";
+
+    cpuGaugeField *v = hostGauge(QUDA_DOUBLE_PRECISION, false);
+    checksumStreamBegin();
+    v->read(&filename[0]);
+    EXPECT_TRUE(checksumStreamEnd(checksum));
+    EXPECT_EQ(checksum, ref) << n << " threads";
+    delete v;
+  }
+#ifdef _OPENMP
+  omp_set_num_threads(max_threads);
+#endif
+
+  removeFile(filename.c_str());
+  delete u;
+}
+
+// half-precision host vectors and quarter-precision device vectors
+// round-trip through the archive to within its per-block resolution
+TEST(VectorIO, archive_error_bound)
+{
+  const int Nvec = 3;
+  std::vector<ColorSpinorField *> ref, half, quarter;
+  for (int i = 0; i < Nvec; i++) {
+    ColorSpinorField *x = ColorSpinorField::Create(hostParam(QUDA_SINGLE_PRECISION));
+    x->Source(QUDA_RANDOM_SOURCE);
+
+    half.push_back(ColorSpinorField::Create(hostParam(QUDA_HALF_PRECISION)));
+    *half[i] = *x;
+
+    ColorSpinorParam param = hostParam(QUDA_QUARTER_PRECISION);
+    param.location = QUDA_CUDA_FIELD_LOCATION;
+    param.fieldOrder = QUDA_FLOAT4_FIELD_ORDER;
+    quarter.push_back(ColorSpinorField::Create(param));
+    *quarter[i] = *x;
+
+    // the references are the values the fixed-point fields hold
+    *x = *half[i];
+    ref.push_back(x);
+  }
+
+  for (int block : {1, 2}) checkArchive(half, ref, block);
+
+  for (int i = 0; i < Nvec; i++) *ref[i] = *quarter[i];
+  for (int block : {1, 2}) checkArchive(quarter, ref, block);
+
+  for (auto v : ref) delete v;
+  for (auto v : half) delete v;
+  for (auto v : quarter) delete v;
+}
+
+#ifdef HAVE_QIO
+
+// fixed-point vectors are only archived when requested, and otherwise
+// keep the QIO format
+TEST(VectorIO, archive_is_opt_in)
+{
+  const char *filename = "io_test_default_format.lime";
+  ColorSpinorField *x = ColorSpinorField::Create(hostParam(QUDA_SINGLE_PRECISION));
+  x->Source(QUDA_RANDOM_SOURCE);
+  std::vector<ColorSpinorField *> vecs = {ColorSpinorField::Create(hostParam(QUDA_HALF_PRECISION))};
+  *vecs[0] = *x;
+
+  VectorIO(filename).save(vecs);
+  EXPECT_FALSE(hasArchiveMagic(filename));
+
+  delete vecs[0];
+  delete x;
+  removeFile(filename);
+}
+
+// a file written before saves were batched holds every vector in a
+// single record, which must still load in batches smaller than the record
+TEST(VectorIO, batched_load_of_single_record)
+{
+  const char *filename = "io_test_single_record.lime";
+  const int Nvec = 5;
+  const int batch_size = 2;
+  auto X = localDims();
+  const size_t volume = X[0] * X[1] * X[2] * X[3];
+
+  auto ref = randomVectors(Nvec, volume);
+  std::vector<void *> V(Nvec);
+  for (int i = 0; i < Nvec; i++) V[i] = ref[i].data();
+  write_spinor_field(filename, V.data(), QUDA_DOUBLE_PRECISION, X.data(), QUDA_FULL_SITE_SUBSET,
+                     QUDA_INVALID_PARITY, 3, 4, Nvec, 0, nullptr);
+
+  // read through a single batch-sized slot, as VectorIO does
+  std::vector<std::vector<double>> slot(batch_size, std::vector<double>(volume * 24));
+  std::vector<void *> slot_ptr(batch_size);
+  for (int i = 0; i < batch_size; i++) slot_ptr[i] = slot[i].data();
+  std::vector<std::vector<double>> out(Nvec);
+  int batches = 0;
+
+  auto acquire = [&](int start, int count) -> void ** {
+    EXPECT_LE(count, batch_size);
+    for (auto &s : slot) std::fill(s.begin(), s.end(), 0.0);
+    return slot_ptr.data();
+  };
+  auto release = [&](int start, int count) {
+    for (int i = 0; i < count; i++) out[start + i] = slot[i];
+    batches++;
+  };
+  read_spinor_field_batched(filename, QUDA_DOUBLE_PRECISION, X.data(), QUDA_FULL_SITE_SUBSET, QUDA_INVALID_PARITY,
+                            3, 4, Nvec, batch_size, acquire, release);
+
+  EXPECT_EQ(batches, (Nvec + batch_size - 1) / batch_size);
+  for (int i = 0; i < Nvec; i++) EXPECT_EQ(out[i], ref[i]) << "vector " << i;
+
+  removeFile(filename);
+}
+
+// a record larger than the 64 MiB that was formerly the largest staged
+// write is written through chunks of sites, and must read back intact
+TEST(VectorIO, chunked_write_of_large_record)
+{
+  const char *filename = "io_test_large_record.lime";
+  const int Nvec = 6;
+  std::vector<int> X = {16, 16, 16, 16};
+  const size_t volume = X[0] * X[1] * X[2] * X[3];
+  ASSERT_GT(Nvec * volume * 24 * sizeof(double), 64lu << 20);
+
+  auto ref = randomVectors(Nvec, volume);
+  std::vector<void *> V(Nvec);
+  for (int i = 0; i < Nvec; i++) V[i] = ref[i].data();
+  write_spinor_field(filename, V.data(), QUDA_DOUBLE_PRECISION, X.data(), QUDA_FULL_SITE_SUBSET,
+                     QUDA_INVALID_PARITY, 3, 4, Nvec, 0, nullptr);
+
+  std::vector<std::vector<double>> out(Nvec, std::vector<double>(volume * 24, 0.0));
+  for (int i = 0; i < Nvec; i++) V[i] = out[i].data();
+  read_spinor_field(filename, V.data(), QUDA_DOUBLE_PRECISION, X.data(), QUDA_FULL_SITE_SUBSET, QUDA_INVALID_PARITY,
+                    3, 4, Nvec, 0, nullptr);
+
+  for (int i = 0; i < Nvec; i++) EXPECT_EQ(out[i], ref[i]) << "vector " << i;
+
+  removeFile(filename);
+}
+
+#endif
+
+int main(int argc, char **argv)
+{
+  // initalize google test, includes command line options
+  ::testing::InitGoogleTest(&argc, argv);
+  xdim = ydim = zdim = 4;
+  tdim = 8;
+
+  // command line options
+  auto app = make_app();
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+
+  // Ensure gtest prints only from rank 0
+  ::testing::TestEventListeners &listeners = ::testing::UnitTest::GetInstance()->listeners();
+  if (comm_rank() != 0) { delete listeners.Release(listeners.default_result_printer()); }
+
+  initQuda(device_ordinal);
+  int test_rc = RUN_ALL_TESTS();
+  endQuda();
+
+  finalizeComms();
+
+  return test_rc;
+}
@@ -0,0 +1,137 @@
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <quda.h>
+#include <comm_quda.h>
+#include <multigrid.h>
+
+#include <host_utils.h>
+#include <command_line_params.h>
+
+#include <gtest/gtest.h>
+
+using namespace quda;
+
+// tests of the trigger of the adaptive null-space refresh, and of the
+// refresh of a null space degraded by an operator update
+
+TEST(MultigridRefresh, trigger)
+{
+  const double tol = 2.0;
+  const std::vector<double> baseline = {1.0, 1.0, 1.0, 1.0};
+
+  // unchanged operator: nothing to refresh
+  EXPECT_TRUE(staleNullVectors(baseline, baseline, tol, false).empty());
+
+  // only the vectors whose residual grew by more than tol are refreshed
+  EXPECT_EQ(staleNullVectors({1.5, 2.5, 2.0, 4.0}, baseline, tol, false), std::vector<int>({1, 3}));
+
+  // growth of the coarse-grid iteration count refreshes every vector
+  EXPECT_EQ(staleNullVectors(baseline, baseline, tol, true), std::vector<int>({0, 1, 2, 3}));
+}
+
+TEST(MultigridRefresh, rebaseline)
+{
+  // following an update to a rougher operator, a refreshed vector
+  // need not regain its original residual
+  const double tol = 2.0;
+  const std::vector<double> setup = {1.0, 1.0, 1.0};
+  const std::vector<double> updated = {1.5, 4.0, 1.0};
+  const std::vector<double> refreshed = {1.5, 2.5, 1.0};
+  EXPECT_EQ(staleNullVectors(updated, setup, tol, false), std::vector<int>({1}));
+
+  // against the setup baseline it would be refreshed on every later
+  // update, even with the operator unchanged ...
+  EXPECT_EQ(staleNullVectors(refreshed, setup, tol, false), std::vector<int>({1}));
+
+  // ... while against the post-refresh baseline nothing is stale until the operator degrades again
+  EXPECT_TRUE(staleNullVectors(refreshed, refreshed, tol, false).empty());
+  EXPECT_EQ(staleNullVectors({1.5, 5.5, 1.0}, refreshed, tol, false), std::vector<int>({1}));
+}
+
+TEST(MultigridRefresh, restore)
+{
+  const double tol = 2.0;
+
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  setWilsonGaugeParam(gauge_param);
+  setDims(gauge_param.X);
+  void *gauge[4];
+  for (int dir = 0; dir < 4; dir++) gauge[dir] = malloc(V * gauge_site_size * host_gauge_data_type_size);
+  constructQudaGaugeField(gauge, 1, gauge_param.cpu_prec, &gauge_param);
+  loadGaugeQuda(gauge, &gauge_param);
+
+  QudaInvertParam inv_param = newQudaInvertParam();
+  QudaMultigridParam mg_param = newQudaMultigridParam();
+  QudaInvertParam mg_inv_param = newQudaInvertParam();
+  setQudaMgSolveTypes();
+  setMultigridInvertParam(inv_param);
+  mg_param.invert_param = &mg_inv_param;
+  for (int i = 0; i < mg_levels; i++) mg_param.eig_param[i] = nullptr;
+  setMultigridParam(mg_param);
+  mg_param.setup_refresh_adaptive[0] = QUDA_BOOLEAN_TRUE;
+  mg_param.setup_refresh_tol[0] = tol;
+
+  void *mg_preconditioner = newMultigridQuda(&mg_param);
+  MG &mg = *static_cast<multigrid_solver *>(mg_preconditioner)->mg;
+  const std::vector<double> setup = mg.nullResidual();
+
+  // update to a new random gauge field without refreshing: the
+  // near-null vectors of the old operator are far from null under the new one
+  constructQudaGaugeField(gauge, 1, gauge_param.cpu_prec, &gauge_param);
+  freeGaugeQuda();
+  loadGaugeQuda(gauge, &gauge_param);
+  const int maxiter_refresh = mg_param.setup_maxiter_refresh[0];
+  mg_param.setup_maxiter_refresh[0] = 0;
+  updateMultigridQuda(mg_preconditioner, &mg_param);
+  const std::vector<double> degraded = mg.nullResidual();
+  EXPECT_FALSE(staleNullVectors(degraded, setup, tol, false).empty());
+
+  // the same update with refresh enabled regenerates the stale vectors
+  mg_param.setup_maxiter_refresh[0] = std::max(maxiter_refresh, mg_param.setup_maxiter[0]);
+  updateMultigridQuda(mg_preconditioner, &mg_param);
+  const std::vector<double> restored = mg.nullResidual();
+  EXPECT_TRUE(staleNullVectors(restored, setup, tol, false).empty());
+
+  for (auto i = 0u; i < setup.size(); i++)
+    printfQuda("Vector %u: near-null residual setup %e, degraded %e, restored %e\n", i, setup[i], degraded[i],
+               restored[i]);
+
+  destroyMultigridQuda(mg_preconditioner);
+  freeGaugeQuda();
+  for (int dir = 0; dir < 4; dir++) free(gauge[dir]);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  setQudaDefaultMgTestParams();
+  xdim = ydim = zdim = 4;
+  tdim = 8;
+  solve_type = QUDA_DIRECT_PC_SOLVE;
+  for (int d = 0; d < 4; d++) geo_block_size[0][d] = 2;
+
+  auto app = make_app();
+  add_multigrid_option_group(app);
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+  setQudaPrecisions();
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  initRand();
+
+  ::testing::TestEventListeners &listeners = ::testing::UnitTest::GetInstance()->listeners();
+  if (comm_rank() != 0) { delete listeners.Release(listeners.default_result_printer()); }
+
+  initQuda(device_ordinal);
+  int result = RUN_ALL_TESTS();
+  endQuda();
+
+  finalizeComms();
+  return result;
+}
@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <quda.h>
+#include <quda_internal.h>
+#include <comm_quda.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <gauge_tools.h>
+#include <random_quda.h>
+
+#include <host_utils.h>
+#include <command_line_params.h>
+
+#include <gtest/gtest.h>
+
+using namespace quda;
+
+// tests of the counter-based random number generator and the random
+// fields generated from it.  The fields are checked against references
+// built from global site coordinates, so running this test on any
+// process grid checks that the fields do not depend on the partitioning.
+
+namespace
+{
+
+  const unsigned long long seed = 1234;
+
+  ColorSpinorParam spinorParam(QudaFieldLocation location)
+  {
+    ColorSpinorParam param;
+    param.nColor = 3;
+    param.nSpin = 4;
+    param.nDim = 4;
+    param.pad = 0;
+    param.siteSubset = QUDA_FULL_SITE_SUBSET;
+    param.x[0] = xdim;
+    param.x[1] = ydim;
+    param.x[2] = zdim;
+    param.x[3] = tdim;
+    param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+    param.fieldOrder
+      = location == QUDA_CPU_FIELD_LOCATION ? QUDA_SPACE_SPIN_COLOR_FIELD_ORDER : QUDA_FLOAT2_FIELD_ORDER;
+    param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+    param.location = location;
+    param.create = QUDA_ZERO_FIELD_CREATE;
+    param.setPrecision(QUDA_DOUBLE_PRECISION);
+    return param;
+  }
+
+  GaugeFieldParam gaugeParam(QudaFieldLocation location)
+  {
+    QudaGaugeParam gauge_param = newQudaGaugeParam();
+    setWilsonGaugeParam(gauge_param);
+    gauge_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+    gauge_param.t_boundary = QUDA_PERIODIC_T;
+    setDims(gauge_param.X);
+
+    GaugeFieldParam param(nullptr, gauge_param);
+    param.create = QUDA_NULL_FIELD_CREATE;
+    param.pad = 0;
+    param.link_type = QUDA_SU3_LINKS;
+    if (location == QUDA_CUDA_FIELD_LOCATION) {
+      param.location = location;
+      param.reconstruct = QUDA_RECONSTRUCT_NO;
+      param.setPrecision(QUDA_DOUBLE_PRECISION, true);
+    }
+    return param;
+  }
+
+  // calls f(x, parity, x_cb, global) for every local site, with the global
+  // lexicographic site index computed from the process grid coordinates
+  template <typename F> void forEachSite(F f)
+  {
+    const int X[4] = {xdim, ydim, zdim, tdim};
+    int x[4];
+    for (x[3] = 0; x[3] < X[3]; x[3]++)
+      for (x[2] = 0; x[2] < X[2]; x[2]++)
+        for (x[1] = 0; x[1] < X[1]; x[1]++)
+          for (x[0] = 0; x[0] < X[0]; x[0]++) {
+            unsigned long long global = 0;
+            for (int d = 3; d >= 0; d--) global = global * X[d] * comm_dim(d) + x[d] + comm_coord(d) * X[d];
+            int parity = (x[0] + x[1] + x[2] + x[3]) & 1;
+            int x_cb = (((x[3] * X[2] + x[2]) * X[1] + x[1]) * X[0] + x[0]) / 2;
+            f(x, parity, x_cb, global);
+          }
+  }
+
+  // maximum difference between two spinor fields of the same order
+  double spinorDifference(const ColorSpinorField &a, const ColorSpinorField &b)
+  {
+    auto pa = static_cast<const double *>(a.V());
+    auto pb = static_cast<const double *>(b.V());
+    double diff = 0.0;
+    for (size_t i = 0; i < a.Volume() * a.Nspin() * a.Ncolor() * 2; i++) diff = std::max(diff, std::abs(pa[i] - pb[i]));
+    comm_allreduce_max(&diff);
+    return diff;
+  }
+
+} // namespace
+
+TEST(Philox, known_answer)
+{
+  // the Philox4x32-10 known-answer vectors published with Random123
+  struct {
+    unsigned int counter[4];
+    unsigned int key[2];
+    unsigned int result[4];
+  } kat[] = {{{0x00000000, 0x00000000, 0x00000000, 0x00000000},
+              {0x00000000, 0x00000000},
+              {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+             {{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+              {0xffffffff, 0xffffffff},
+              {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+             {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+              {0xa4093822, 0x299f31d0},
+              {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}};
+
+  for (auto &v : kat) {
+    RNGState::philox(v.counter, v.key);
+    for (int i = 0; i < 4; i++) EXPECT_EQ(v.counter[i], v.result[i]);
+  }
+}
+
+TEST(Philox, site_stream)
+{
+  // the stream of a site draws the counters (draw, stream, site) in turn, keyed on the seed
+  ColorSpinorField *field = ColorSpinorField::Create(spinorParam(QUDA_CPU_FIELD_LOCATION));
+
+  RNG zero(*field, 0);
+  RNGState state(zero, 0);
+  const unsigned int kat[4] = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+  for (int i = 0; i < 4; i++) EXPECT_EQ(state(), kat[i]);
+
+  RNG rng(*field, 0x0123456789abcdefull);
+  rng.next(3);
+  const unsigned long long site = 0xfedcba9876ull;
+  const unsigned int sub = 2;
+  RNGState site_state(rng, site, sub);
+  const unsigned int key[2] = {0x89abcdef, 0x01234567};
+  for (unsigned int draw = 0; draw < 3; draw++) {
+    unsigned int c[4] = {draw, 3 + sub, static_cast<unsigned int>(site), static_cast<unsigned int>(site >> 32)};
+    RNGState::philox(c, key);
+    for (int i = 0; i < 4; i++) EXPECT_EQ(site_state(), c[i]);
+  }
+
+  delete field;
+}
+
+TEST(RNG, global_index)
+{
+  ColorSpinorField *field = ColorSpinorField::Create(spinorParam(QUDA_CPU_FIELD_LOCATION));
+  RNG rng(*field, seed);
+
+  int errors = 0;
+  forEachSite([&](const int x[4], int parity, int x_cb, unsigned long long global) {
+    if (rng.globalIndex(x) != global) errors++;
+    if (rng.globalIndex(x_cb, parity) != global) errors++;
+  });
+  comm_allreduce_int(&errors);
+  EXPECT_EQ(errors, 0);
+
+  delete field;
+}
+
+TEST(RNG, spinor_noise_reference)
+{
+  // uniform noise at each site is the site stream of the global site index
+  ColorSpinorField *field = ColorSpinorField::Create(spinorParam(QUDA_CPU_FIELD_LOCATION));
+  spinorNoise(*field, seed, QUDA_NOISE_UNIFORM);
+
+  RNG rng(*field, seed);
+  auto v = static_cast<const std::complex<double> *>(field->V());
+  const int n = field->Nspin() * field->Ncolor();
+  int errors = 0;
+  forEachSite([&](const int *, int parity, int x_cb, unsigned long long global) {
+    RNGState state(rng, global);
+    for (int i = 0; i < n; i++) {
+      double re = Random<double>(state);
+      double im = Random<double>(state);
+      auto z = v[(parity * field->VolumeCB() + x_cb) * n + i];
+      if (z.real() != re || z.imag() != im) errors++;
+    }
+  });
+  comm_allreduce_int(&errors);
+  EXPECT_EQ(errors, 0);
+
+  delete field;
+}
+
+TEST(RNG, spinor_noise_host_device)
+{
+  ColorSpinorField *host = ColorSpinorField::Create(spinorParam(QUDA_CPU_FIELD_LOCATION));
+  ColorSpinorField *ref = ColorSpinorField::Create(spinorParam(QUDA_CPU_FIELD_LOCATION));
+  ColorSpinorField *device = ColorSpinorField::Create(spinorParam(QUDA_CUDA_FIELD_LOCATION));
+
+  for (auto type : {QUDA_NOISE_UNIFORM, QUDA_NOISE_GAUSS}) {
+    spinorNoise(*host, seed, type);
+    spinorNoise(*device, seed, type);
+    *ref = *device;
+
+    // uniform noise is exact, while the Gaussian transform may differ in the last bits between host and device math
+    double diff = spinorDifference(*host, *ref);
+    printfQuda("Noise type %d: max host-device difference %e\n", type, diff);
+    if (type == QUDA_NOISE_UNIFORM)
+      EXPECT_EQ(diff, 0.0);
+    else
+      EXPECT_LT(diff, 1e-12);
+  }
+
+  delete device;
+  delete ref;
+  delete host;
+}
+
+TEST(RNG, gauge_gauss_host_device)
+{
+  GaugeFieldParam param = gaugeParam(QUDA_CPU_FIELD_LOCATION);
+  cpuGaugeField host(param), ref(param);
+  cudaGaugeField device(gaugeParam(QUDA_CUDA_FIELD_LOCATION));
+
+  for (double sigma : {0.0, 0.5}) {
+    gaugeGauss(host, seed, sigma);
+    gaugeGauss(device, seed, sigma);
+    device.saveCPUField(ref);
+
+    double diff = 0.0;
+    for (int d = 0; d < 4; d++) {
+      auto a = static_cast<const double *const *>(host.Gauge_p())[d];
+      auto b = static_cast<const double *const *>(ref.Gauge_p())[d];
+      for (size_t i = 0; i < host.Volume() * 18; i++) diff = std::max(diff, std::abs(a[i] - b[i]));
+    }
+    comm_allreduce_max(&diff);
+    printfQuda("Gauge sigma %e: max host-device link difference %e\n", sigma, diff);
+    EXPECT_LT(diff, 1e-12);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  // initalize google test, includes command line options
+  ::testing::InitGoogleTest(&argc, argv);
+  xdim = ydim = zdim = 4;
+  tdim = 8;
+
+  // command line options
+  auto app = make_app();
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+
+  // Ensure gtest prints only from rank 0
+  ::testing::TestEventListeners &listeners = ::testing::UnitTest::GetInstance()->listeners();
+  if (comm_rank() != 0) { delete listeners.Release(listeners.default_result_printer()); }
+
+  initQuda(device_ordinal);
+  int test_rc = RUN_ALL_TESTS();
+  endQuda();
+
+  finalizeComms();
+
+  return test_rc;
+}
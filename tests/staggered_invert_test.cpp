@@ -284,7 +284,6 @@ int main(int argc, char **argv)
 
   // Prepare rng
   auto *rng = new quda::RNG(quda::LatticeFieldParam(gauge_param), 1234);
-  rng->Init();
 
   // Performance measuring
   std::vector<double> time(Nsrc);
@@ -373,7 +372,6 @@ int main(int argc, char **argv)
   } // switch
 
   // Free RNG
-  rng->Release();
   delete rng;
 
   // Free the multigrid solver
@@ -0,0 +1,97 @@
+#include <cmath>
+#include <cstdio>
+
+#include <comm_quda.h>
+#include <util_quda.h>
+
+#include "benchmark.h"
+
+BenchmarkHarness::BenchmarkHarness(int warmup, int reps, double min_rep_time) :
+  warmup(warmup), reps(std::max(reps, 1)), min_rep_time(min_rep_time)
+{
+}
+
+const BenchmarkResult &BenchmarkHarness::summarize(const std::string &name, int calls, std::vector<double> &times,
+                                                   double flops, double bytes)
+{
+  BenchmarkResult r;
+  r.name = name;
+  r.warmup = warmup;
+  r.reps = times.size();
+  r.calls = calls;
+  r.flops = flops;
+  r.bytes = bytes;
+
+  double sum = 0.0;
+  for (auto t : times) sum += t;
+  r.mean = sum / r.reps;
+
+  double sum2 = 0.0;
+  for (auto t : times) sum2 += (t - r.mean) * (t - r.mean);
+  r.stddev = r.reps > 1 ? std::sqrt(sum2 / (r.reps - 1)) : 0.0;
+
+  std::sort(times.begin(), times.end());
+  r.min = times.front();
+  r.max = times.back();
+  r.median = r.reps % 2 ? times[r.reps / 2] : 0.5 * (times[r.reps / 2 - 1] + times[r.reps / 2]);
+
+  results.push_back(r);
+  return results.back();
+}
+
+void BenchmarkHarness::print() const
+{
+  printfQuda("%-40s %12s %12s %12s %12s %10s %10s\n", "benchmark", "median (us)", "mean (us)", "stddev (us)",
+             "min (us)", "Gflop/s", "GB/s");
+  for (auto &r : results) {
+    printfQuda("%-40s %12.3f %12.3f %12.3f %12.3f %10.2f %10.2f\n", r.name.c_str(), 1e6 * r.median, 1e6 * r.mean,
+               1e6 * r.stddev, 1e6 * r.min, 1e-9 * r.flops / r.median, 1e-9 * r.bytes / r.median);
+  }
+}
+
+static std::string quote(const std::string &s)
+{
+  std::string q = "\"";
+  for (auto c : s) {
+    if (c == '"' || c == '\\') q += '\\';
+    q += (c >= 0 && c < 0x20) ? ' ' : c;
+  }
+  return q + "\"";
+}
+
+/** JSON has no representation of nan or inf */
+static std::string number(double x)
+{
+  if (!std::isfinite(x)) return "null";
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.10g", x);
+  return buf;
+}
+
+void BenchmarkHarness::writeJSON(const std::string &filename) const
+{
+  if (comm_rank() != 0) return;
+
+  FILE *file = filename == "stdout" ? stdout : fopen(filename.c_str(), "w");
+  if (!file) {
+    warningQuda("Cannot open benchmark output file %s", filename.c_str());
+    return;
+  }
+
+  fprintf(file, "{\n  \"context\": {");
+  for (auto it = context.begin(); it != context.end(); it++)
+    fprintf(file, "%s%s: %s", it == context.begin() ? "" : ", ", quote(it->first).c_str(), quote(it->second).c_str());
+  fprintf(file, "},\n  \"benchmarks\": [\n");
+  for (auto it = results.begin(); it != results.end(); it++) {
+    fprintf(file, "    {\"name\": %s, \"warmup\": %d, \"reps\": %d, \"calls\": %d", quote(it->name).c_str(), it->warmup,
+            it->reps, it->calls);
+    fprintf(file, ", \"mean\": %s, \"stddev\": %s", number(it->mean).c_str(), number(it->stddev).c_str());
+    fprintf(file, ", \"min\": %s, \"median\": %s, \"max\": %s", number(it->min).c_str(), number(it->median).c_str(),
+            number(it->max).c_str());
+    fprintf(file, ", \"flops\": %s, \"bytes\": %s}%s\n", number(it->flops).c_str(), number(it->bytes).c_str(),
+            it + 1 == results.end() ? "" : ",");
+  }
+  fprintf(file, "  ]\n}\n");
+
+  if (file != stdout) fclose(file);
+}
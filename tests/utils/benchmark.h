@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+   @file benchmark.h
+
+   @section DESCRIPTION
+   Common harness for micro-benchmarks of host-executable routines.
+   Each benchmark is warmed up, calibrated so that a single timed
+   repetition is long enough to be resolved by the host clock, and
+   then timed over a fixed number of repetitions.  The per-call times
+   of the repetitions are summarized by their mean, standard
+   deviation, minimum, median and maximum, and the results of a run
+   can be written as JSON for comparison against a stored baseline
+   with tests/utils/compare_benchmarks.py.
+*/
+
+/**
+   @brief Summary statistics of a single benchmark
+*/
+struct BenchmarkResult {
+  std::string name;   /** benchmark name, the key used when comparing runs */
+  int warmup;         /** number of untimed calls */
+  int reps;           /** number of timed repetitions */
+  int calls;          /** number of calls per repetition */
+  double mean;        /** mean time per call (seconds) */
+  double stddev;      /** sample standard deviation of the time per call (seconds) */
+  double min;         /** fastest repetition, time per call (seconds) */
+  double median;      /** median repetition, time per call (seconds) */
+  double max;         /** slowest repetition, time per call (seconds) */
+  double flops;       /** flops per call */
+  double bytes;       /** bytes moved per call */
+};
+
+class BenchmarkHarness
+{
+  std::vector<BenchmarkResult> results;
+  std::vector<std::pair<std::string, std::string>> context;
+  int warmup;
+  int reps;
+  double min_rep_time;
+
+  /**
+     @brief Compute the summary statistics of a set of repetitions
+     and append them to the results
+     @param[in] name Benchmark name
+     @param[in] calls Calls per repetition
+     @param[in] times Time of each repetition (seconds)
+     @param[in] flops Flops per call
+     @param[in] bytes Bytes per call
+  */
+  const BenchmarkResult &summarize(const std::string &name, int calls, std::vector<double> &times, double flops,
+                                   double bytes);
+
+public:
+  /**
+     @param[in] warmup Number of untimed calls before timing
+     @param[in] reps Number of timed repetitions
+     @param[in] min_rep_time Minimum duration of a repetition
+     (seconds): fast routines are called repeatedly within a
+     repetition so that the clock resolution is negligible
+  */
+  BenchmarkHarness(int warmup, int reps, double min_rep_time = 1e-3);
+
+  /**
+     @brief Add a key-value pair describing the run (lattice size,
+     precision, ...) to the JSON output
+  */
+  void addContext(const std::string &key, const std::string &value) { context.emplace_back(key, value); }
+
+  /**
+     @brief Benchmark a callable
+     @param[in] name Benchmark name
+     @param[in] f The callable to time
+     @param[in] flops Flops per call
+     @param[in] bytes Bytes moved per call
+     @return The summary statistics
+  */
+  template <typename F>
+  const BenchmarkResult &run(const std::string &name, F &&f, double flops = 0.0, double bytes = 0.0)
+  {
+    using clock = std::chrono::steady_clock;
+    auto elapsed = [](clock::time_point start) {
+      return std::chrono::duration<double>(clock::now() - start).count();
+    };
+
+    // the last warm-up call sets the number of calls per repetition
+    double t = 0.0;
+    for (int i = 0; i < std::max(warmup, 1); i++) {
+      auto start = clock::now();
+      f();
+      t = elapsed(start);
+    }
+    int calls = t < min_rep_time ? static_cast<int>(std::min(min_rep_time / std::max(t, 1e-9), 1e6)) + 1 : 1;
+
+    std::vector<double> times(reps);
+    for (auto &time : times) {
+      auto start = clock::now();
+      for (int i = 0; i < calls; i++) f();
+      time = elapsed(start) / calls;
+    }
+
+    return summarize(name, calls, times, flops, bytes);
+  }
+
+  /**
+     @return The results collected so far
+  */
+  const std::vector<BenchmarkResult> &Results() const { return results; }
+
+  /**
+     @brief Print a table of the results
+  */
+  void print() const;
+
+  /**
+     @brief Write the results as JSON (only on rank 0)
+     @param[in] filename Output file, or "stdout"
+  */
+  void writeJSON(const std::string &filename) const;
+};
@@ -58,6 +58,7 @@ int test_type = 0;
 quda::mgarray<int> nvec = {};
 quda::mgarray<char[256]> mg_vec_infile;
 quda::mgarray<char[256]> mg_vec_outfile;
+quda::mgarray<bool> mg_vec_archive = {};
 QudaInverterType inv_type;
 bool inv_deflate = false;
 bool inv_multigrid = false;
@@ -111,6 +112,10 @@ quda::mgarray<int> num_setup_iter = {};
 quda::mgarray<double> setup_tol = {};
 quda::mgarray<int> setup_maxiter = {};
 quda::mgarray<int> setup_maxiter_refresh = {};
+quda::mgarray<bool> setup_refresh_adaptive = {};
+quda::mgarray<double> setup_refresh_tol = {};
+quda::mgarray<double> setup_refresh_iter_growth = {};
+quda::mgarray<int> setup_refresh_max_pass = {};
 quda::mgarray<QudaCABasis> setup_ca_basis = {};
 quda::mgarray<int> setup_ca_basis_size = {};
 quda::mgarray<double> setup_ca_lambda_min = {};
@@ -191,6 +196,10 @@ char eig_vec_infile[256] = "";
 char eig_vec_outfile[256] = "";
 bool eig_io_parity_inflate = false;
 QudaPrecision eig_save_prec = QUDA_DOUBLE_PRECISION;
+bool eig_compress_deflation = false;
+int eig_compress_n_basis = 24;
+std::array<int, 4> eig_compress_block_size = {4, 4, 4, 4};
+QudaPrecision eig_compress_prec = QUDA_HALF_PRECISION;
 
 // Parameters for the MG eigensolver.
 // The coarsest grid params are for deflation,
@@ -700,6 +709,18 @@ void add_eigen_option_group(std::shared_ptr<QUDAApp> quda_app)
                       "Use Eigen to eigensolve the upper Hessenberg in IRAM, else use QUDA's QR code. (default true)");
   opgroup->add_option("--eig-compute-svd", eig_compute_svd,
                       "Solve the MdagM problem, use to compute SVD of M (default false)");
+  opgroup->add_option("--eig-compress-deflation", eig_compress_deflation,
+                      "Store the deflation space compressed onto a block-orthogonalized basis (default false)");
+  opgroup->add_option("--eig-compress-n-basis", eig_compress_n_basis,
+                      "The number of basis vectors used to compress the deflation space (default 24)");
+  opgroup
+    ->add_option("--eig-compress-block-size", eig_compress_block_size,
+                 "The geometric block size used to compress the deflation space (default 4 4 4 4)")
+    ->expected(4);
+  opgroup
+    ->add_option("--eig-compress-prec", eig_compress_prec,
+                 "The precision of the compressed deflation space basis and coefficients (default half)")
+    ->transform(prec_transform);
   opgroup->add_option("--eig-max-restarts", eig_max_restarts, "Perform n iterations of the restart in the eigensolver");
   opgroup->add_option("--eig-block-size", eig_block_size, "The block size to use in the block variant eigensolver");
   opgroup->add_option(
@@ -876,6 +897,9 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
                          "Load the vectors <file> for the multigrid_test (requires QIO)");
   quda_app->add_mgoption(opgroup, "--mg-save-vec", mg_vec_outfile, CLI::Validator(),
                          "Save the generated null-space vectors <file> from the multigrid_test (requires QIO)");
+  quda_app->add_mgoption(opgroup, "--mg-save-vec-archive", mg_vec_archive, CLI::Validator(),
+                         "Save half or quarter precision null-space vectors to a native block-scaled archive, which "
+                         "does not require QIO (default false)");
 
   quda_app
     ->add_mgoption("--mg-eig-save-prec", mg_eig_save_prec, CLI::Validator(),
@@ -934,6 +958,16 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
   quda_app->add_mgoption(
     opgroup, "--mg-setup-maxiter-refresh", setup_maxiter_refresh, CLI::Validator(),
     "The maximum number of solver iterations to use when refreshing the pre-existing null space vectors (default 100)");
+  quda_app->add_mgoption(opgroup, "--mg-setup-refresh-adaptive", setup_refresh_adaptive, CLI::Validator(),
+                         "Only refresh those null space vectors that have degraded under the updated operator (default false)");
+  quda_app->add_mgoption(
+    opgroup, "--mg-setup-refresh-tol", setup_refresh_tol, CLI::PositiveNumber,
+    "Growth factor of the near-null residual beyond which a null space vector is refreshed in adaptive mode (default 2)");
+  quda_app->add_mgoption(
+    opgroup, "--mg-setup-refresh-iter-growth", setup_refresh_iter_growth, CLI::PositiveNumber,
+    "Growth factor of the mean coarse solver iteration count beyond which all null space vectors are refreshed in adaptive mode (default 1.5)");
+  quda_app->add_mgoption(opgroup, "--mg-setup-refresh-max-pass", setup_refresh_max_pass, CLI::PositiveNumber,
+                         "The maximum number of adaptive refresh passes over the degraded null space vectors (default 4)");
   quda_app->add_mgoption(opgroup, "--mg-setup-tol", setup_tol, CLI::Validator(),
                          "The tolerance to use for the setup of multigrid (default 5e-6)");
 
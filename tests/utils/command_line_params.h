@@ -191,6 +191,7 @@ extern int test_type;
 extern quda::mgarray<int> nvec;
 extern quda::mgarray<char[256]> mg_vec_infile;
 extern quda::mgarray<char[256]> mg_vec_outfile;
+extern quda::mgarray<bool> mg_vec_archive;
 extern QudaInverterType inv_type;
 extern bool inv_deflate;
 extern bool inv_multigrid;
@@ -244,6 +245,10 @@ extern quda::mgarray<int> num_setup_iter;
 extern quda::mgarray<double> setup_tol;
 extern quda::mgarray<int> setup_maxiter;
 extern quda::mgarray<int> setup_maxiter_refresh;
+extern quda::mgarray<bool> setup_refresh_adaptive;
+extern quda::mgarray<double> setup_refresh_tol;
+extern quda::mgarray<double> setup_refresh_iter_growth;
+extern quda::mgarray<int> setup_refresh_max_pass;
 extern quda::mgarray<QudaCABasis> setup_ca_basis;
 extern quda::mgarray<int> setup_ca_basis_size;
 extern quda::mgarray<double> setup_ca_lambda_min;
@@ -316,6 +321,10 @@ extern char eig_vec_infile[256];
 extern char eig_vec_outfile[256];
 extern bool eig_io_parity_inflate;
 extern QudaPrecision eig_save_prec;
+extern bool eig_compress_deflation;
+extern int eig_compress_n_basis;
+extern std::array<int, 4> eig_compress_block_size;
+extern QudaPrecision eig_compress_prec;
 
 // Parameters for the MG eigensolver.
 // The coarsest grid params are for deflation,
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Compare the JSON output of a benchmark run against a stored baseline.
+
+Benchmarks are matched by name.  A benchmark is flagged as a regression
+when its time per call has grown by more than the relative threshold and
+the growth is also larger than the combined run-to-run noise of the two
+measurements, so that noisy benchmarks do not trip the gate.  A baseline
+benchmark that is missing from the current run, or either of whose
+timings is missing or not positive, is an error unless --allow-missing
+is given.  The exit status is 1 if any regression or error is found, so
+the script can be used as a check in scripts and CI:
+
+  host_benchmark_test --bench-json current.json
+  compare_benchmarks.py baseline.json current.json --threshold 0.10
+"""
+
+import argparse
+import json
+import math
+import sys
+
+
+def load(filename):
+    with open(filename) as f:
+        data = json.load(f)
+    return data.get("context", {}), {b["name"]: b for b in data["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="baseline JSON file")
+    parser.add_argument("current", help="JSON file of the run to check")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative slowdown flagged as a regression (default 0.05)")
+    parser.add_argument("--metric", choices=["median", "min", "mean"], default="median",
+                        help="statistic compared between the runs (default median)")
+    parser.add_argument("--sigma", type=float, default=2.0,
+                        help="slowdowns within this many standard deviations are treated as noise (default 2)")
+    parser.add_argument("--allow-missing", action="store_true",
+                        help="report missing or invalid benchmarks without failing")
+    args = parser.parse_args()
+
+    base_context, base = load(args.baseline)
+    curr_context, curr = load(args.current)
+
+    for key in sorted(set(base_context) | set(curr_context)):
+        if base_context.get(key) != curr_context.get(key):
+            print("warning: context %s differs: baseline %s, current %s" %
+                  (key, base_context.get(key), curr_context.get(key)))
+
+    regressions = 0
+    errors = 0
+    print("%-52s %12s %12s %8s  %s" % ("benchmark", "baseline", "current", "change", "status"))
+    for name in sorted(set(base) | set(curr)):
+        if name not in curr:
+            print("%-52s %12s %12s %8s  %s" % (name, "", "", "", "MISSING"))
+            errors += 1
+            continue
+        if name not in base:
+            print("%-52s %12s %12s %8s  %s" % (name, "", "", "", "new"))
+            continue
+
+        b = base[name].get(args.metric)
+        c = curr[name].get(args.metric)
+        if not isinstance(b, (int, float)) or not isinstance(c, (int, float)) or b <= 0.0 or c <= 0.0:
+            print("%-52s %12s %12s %8s  %s" % (name, "", "", "", "INVALID"))
+            errors += 1
+            continue
+
+        change = c / b - 1.0
+        noise = args.sigma * math.hypot(base[name].get("stddev") or 0.0, curr[name].get("stddev") or 0.0)
+        if change > args.threshold and c - b > noise:
+            status = "REGRESSION"
+            regressions += 1
+        elif change < -args.threshold and b - c > noise:
+            status = "improved"
+        else:
+            status = "ok"
+        print("%-52s %10.3fus %10.3fus %+7.1f%%  %s" % (name, 1e6 * b, 1e6 * c, 100.0 * change, status))
+
+    if regressions:
+        print("%d benchmark(s) regressed by more than %.1f%%" % (regressions, 100.0 * args.threshold))
+    if errors:
+        print("%d benchmark(s) missing or invalid%s" % (errors, " (allowed)" if args.allow_missing else ""))
+        if args.allow_missing:
+            errors = 0
+    return 1 if regressions or errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
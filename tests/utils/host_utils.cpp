@@ -97,6 +97,10 @@ void setQudaDefaultMgTestParams()
     setup_tol[i] = 5e-6;
     setup_maxiter[i] = 500;
     setup_maxiter_refresh[i] = 20;
+    setup_refresh_adaptive[i] = false;
+    setup_refresh_tol[i] = 2.0;
+    setup_refresh_iter_growth[i] = 1.5;
+    setup_refresh_max_pass[i] = 4;
     mu_factor[i] = 1.;
     coarse_solve_type[i] = QUDA_INVALID_SOLVE;
     smoother_solve_type[i] = QUDA_INVALID_SOLVE;
@@ -143,6 +147,7 @@ void setQudaDefaultMgTestParams()
 
     strcpy(mg_vec_infile[i], "");
     strcpy(mg_vec_outfile[i], "");
+    mg_vec_archive[i] = false;
   }
 }
 
@@ -304,6 +304,11 @@ void setEigParam(QudaEigParam &eig_param)
   strcpy(eig_param.vec_outfile, eig_vec_outfile);
   eig_param.save_prec = eig_save_prec;
   eig_param.io_parity_inflate = eig_io_parity_inflate ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+
+  eig_param.compress_deflation = eig_compress_deflation ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  eig_param.compress_n_basis = eig_compress_n_basis;
+  for (int i = 0; i < 4; i++) eig_param.compress_block_size[i] = eig_compress_block_size[i];
+  eig_param.compress_precision = eig_compress_prec;
 }
 
 void setMultigridParam(QudaMultigridParam &mg_param)
@@ -386,6 +391,10 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     mg_param.setup_tol[i] = setup_tol[i];
     mg_param.setup_maxiter[i] = setup_maxiter[i];
     mg_param.setup_maxiter_refresh[i] = setup_maxiter_refresh[i];
+    mg_param.setup_refresh_adaptive[i] = setup_refresh_adaptive[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+    mg_param.setup_refresh_tol[i] = setup_refresh_tol[i];
+    mg_param.setup_refresh_iter_growth[i] = setup_refresh_iter_growth[i];
+    mg_param.setup_refresh_max_pass[i] = setup_refresh_max_pass[i];
 
     // Basis to use for CA-CGN(E/R) setup
     mg_param.setup_ca_basis[i] = setup_ca_basis[i];
@@ -546,6 +555,7 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     strcpy(mg_param.vec_outfile[i], mg_vec_outfile[i]);
     if (strcmp(mg_param.vec_infile[i], "") != 0) mg_param.vec_load[i] = QUDA_BOOLEAN_TRUE;
     if (strcmp(mg_param.vec_outfile[i], "") != 0) mg_param.vec_store[i] = QUDA_BOOLEAN_TRUE;
+    mg_param.vec_archive[i] = mg_vec_archive[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   }
 
   mg_param.coarse_guess = mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
@@ -1107,6 +1117,7 @@ void setStaggeredMultigridParam(QudaMultigridParam &mg_param)
     strcpy(mg_param.vec_outfile[i], mg_vec_outfile[i]);
     if (strcmp(mg_param.vec_infile[i], "") != 0) mg_param.vec_load[i] = QUDA_BOOLEAN_TRUE;
     if (strcmp(mg_param.vec_outfile[i], "") != 0) mg_param.vec_store[i] = QUDA_BOOLEAN_TRUE;
+    mg_param.vec_archive[i] = mg_vec_archive[i] ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   }
 
   mg_param.coarse_guess = mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;